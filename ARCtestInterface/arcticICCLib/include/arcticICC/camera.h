@@ -3,6 +3,7 @@
 #include <chrono>
 #include <string>
 #include <map>
+#include <vector>
 
 #ifdef _PCIe
     #include "CArcPCIe.h"
@@ -12,6 +13,7 @@
 #include "CArcDevice.h"
 
 #include "arcticICC/basics.h"
+#include "arcticICC/fitsWriter.h"
 
 namespace arcticICC {
 
@@ -107,6 +109,15 @@ namespace arcticICC {
         See notes for computeBinnedHeight
         */
         int computeBinnedHeight(int unbHeight) const { return (unbHeight / (2 * binFacRow)) * 2; }
+
+        /**
+        Return the region of the deinterlaced image read by each amplifier, with its data and overscan sections
+
+        For quad readout each amplifier has one quadrant: the prescan is at the outer edge, the overscan
+        toward the center, and a border row at the center. For a single amplifier the image is in readout order:
+        prescan, data, then overscan.
+        */
+        std::vector<arc::gen3::fits::AmpSection> getAmpSections() const;
     };
 
     /**
@@ -201,14 +212,55 @@ namespace arcticICC {
         /**
         Save image to a FITS file
 
-        @param[in] expTime  exposure time (sec); if <0 then the internal timer is used.
-            If taking a bias then expTime is ignored; the reported exposure time is 0;
-            If you have feedback from the shutter then you can provide a better value than the internal timer.
+        Copy the image out of the common buffer and queue it to be deinterlaced and written
+        by a background thread, then return the camera to idle, so the next exposure can be started at once.
+        If every frame buffer is still waiting to be written then this waits for one to be freed.
+        Use waitForSaves to wait for the file to be written and find out if it failed.
 
         @throw std::runtime_error if no image is available to be saved
         */
         void saveImage();
 
+        /**
+        Wait until all images queued by saveImage have been written
+
+        @throw std::runtime_error if any image could not be written since the last call;
+            the message names each file and the reason
+        */
+        void waitForSaves() { _fitsWriter.waitAll(); }
+
+        /**
+        Return the number of images queued by saveImage that have not yet been written
+        */
+        int getNumPendingSaves() const { return _fitsWriter.getNumPending(); }
+
+        /**
+        Set whether saveImage writes multi-extension FITS files
+
+        @param[in] saveMEF  if true then each image is saved as an empty primary HDU followed by
+            one image extension per amplifier, with DATASEC and BIASSEC keywords (see CameraConfig::getAmpSections);
+            if false (the default) then each image is saved as a single image
+        */
+        void setSaveMEF(bool saveMEF) { _saveMEF = saveMEF; }
+
+        /**
+        Return true if saveImage writes multi-extension FITS files
+        */
+        bool getSaveMEF() const { return _saveMEF; }
+
+        /**
+        Set whether saveImage adds FITS checksums
+
+        @param[in] saveChecksum  if true then each HDU of a saved image gets CHECKSUM and DATASUM keywords,
+            computed while the image is written; if false (the default) then no checksums are written
+        */
+        void setSaveChecksum(bool saveChecksum) { _saveChecksum = saveChecksum; }
+
+        /**
+        Return true if saveImage adds FITS checksums
+        */
+        bool getSaveChecksum() const { return _saveChecksum; }
+
         /**
         Open the shutter
 
@@ -249,11 +301,14 @@ namespace arcticICC {
             /// updated when an exposure is paused or resumed; invalid if isExposing false
         bool _segmentStartValid;    /// true if exposing, reading out or read out, but not paused or idle
         bool _bufferCleared;        /// true when idle or exposing; getExposureStatus sets it when reading out
+        bool _saveMEF;              /// true to save one FITS extension per amplifier
+        bool _saveChecksum;         /// true to add CHECKSUM and DATASUM keywords to saved images
 #ifdef _PCIe
         arc::gen3::CArcPCIe _device;  /// the Leach API's representation of a camera controller
 #elif _PCI
         arc::gen3::CArcPCI _device;  /// the Leach API's representation of a camera controller
 #endif
+        FitsWriter _fitsWriter;     /// writes saved images to FITS files in the background
 	
     };
 
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CArcDeinterlace.h"
+#include "CArcFitsFile.h"
+
+namespace arcticICC {
+
+    /**
+    Asynchronous FITS writer
+
+    Owns a fixed set of preallocated frame buffers. submit copies a raw (interlaced) frame into a free buffer
+    and queues it; background threads deinterlace each queued frame, write it to a FITS file
+    and return the buffer to the free list. This lets the caller release the controller's common buffer,
+    and start the next exposure, as soon as the copy is done.
+
+    Backpressure: if every buffer is in use then submit waits for one to be freed
+    (or throws std::runtime_error if it cannot get one within the specified timeout).
+
+    Failures: each frame's future rethrows the error that prevented it from being written,
+    the optional callback receives the same error, and waitAll rethrows failures that have not yet been reported.
+
+    The destructor writes all queued frames before returning.
+    */
+    class FitsWriter {
+    public:
+        /**
+        Function called on a writer thread once a frame has been written or has failed
+
+        @param[in] fileName  name of FITS file
+        @param[in] error  the error that prevented the file from being written; null on success
+        */
+        using Callback = std::function<void(std::string const &fileName, std::exception_ptr error)>;
+
+        /**
+        Construct a FitsWriter: allocate the frame buffers and start the writer threads
+
+        @param[in] maxWidth  maximum frame width (pixels)
+        @param[in] maxHeight  maximum frame height (pixels)
+        @param[in] numBuffers  number of frame buffers, i.e. the maximum number of frames waiting to be written
+        @param[in] numThreads  number of writer threads
+        @throw std::runtime_error if any argument < 1
+        */
+        explicit FitsWriter(int maxWidth, int maxHeight, int numBuffers=2, int numThreads=1);
+
+        /**
+        Destructor: write all queued frames, then stop the writer threads
+        */
+        ~FitsWriter();
+
+        FitsWriter(FitsWriter const &) = delete;
+        FitsWriter &operator=(FitsWriter const &) = delete;
+
+        /**
+        Copy a raw frame into a free buffer and queue it for writing
+
+        @param[in] data  raw frame as read out by the controller (width * height pixels)
+        @param[in] width  frame width (pixels)
+        @param[in] height  frame height (pixels)
+        @param[in] alg  deinterlace algorithm
+        @param[in] fileName  name of FITS file
+        @param[in] amps  amplifier sections; if not empty then write a multi-extension FITS file
+            with one extension per amplifier, else write a single image
+        @param[in] checksum  if true then add CHECKSUM and DATASUM keywords to each HDU,
+            computed as the data is written, so the file need not be read back
+        @param[in] timeoutSec  maximum time to wait for a free buffer (sec); if <0 then wait as long as necessary
+        @param[in] callback  function to call when the frame has been written or has failed (optional)
+        @return a future that is ready once the file has been written; get() rethrows any write error
+
+        @throw std::runtime_error if width or height is out of range
+        @throw std::runtime_error if no buffer is freed within timeoutSec
+        */
+        std::future<void> submit(
+            std::uint16_t const *data,
+            int width,
+            int height,
+            arc::gen3::dlace::e_Alg alg,
+            std::string const &fileName,
+            std::vector<arc::gen3::fits::AmpSection> const &amps={},
+            bool checksum=false,
+            double timeoutSec=-1,
+            Callback callback={}
+        );
+
+        /**
+        Wait until all queued frames have been written
+
+        @throw std::runtime_error if any frame failed since the last call to waitAll;
+            the message lists the failures (the list is then cleared)
+        */
+        void waitAll();
+
+        /**
+        Return the number of frames queued or being written
+        */
+        int getNumPending() const;
+
+        /**
+        Return the number of free frame buffers
+        */
+        int getNumFree() const;
+
+    private:
+        /// a frame waiting to be written
+        struct Job {
+            int bufferIndex;            /// index of frame buffer
+            int width;                  /// frame width (pixels)
+            int height;                 /// frame height (pixels)
+            arc::gen3::dlace::e_Alg alg;    /// deinterlace algorithm
+            std::string fileName;       /// name of FITS file
+            std::vector<arc::gen3::fits::AmpSection> amps;  /// amplifier sections; empty for a single image
+            bool checksum;              /// add CHECKSUM and DATASUM keywords
+            std::promise<void> promise; /// completion of this frame
+            Callback callback;          /// optional completion callback
+        };
+
+        void _run();    /// writer thread: write queued frames until stopped and the queue is empty
+        void _write(Job &job);  /// deinterlace and write one frame
+
+        int const _maxPixels;       /// number of pixels in each frame buffer
+        std::vector<std::unique_ptr<std::uint16_t[]>> _buffers;   /// preallocated frame buffers
+        std::vector<int> _freeBuffers;  /// indices of buffers not in use
+        std::deque<Job> _jobs;      /// frames waiting for a writer thread
+        int _numActive;             /// number of frames being written
+        bool _stopping;             /// true once the destructor has been called
+        std::vector<std::string> _errors;   /// failures not yet reported by waitAll
+        mutable std::mutex _mutex;  /// guards all of the above except _maxPixels and _buffers
+        std::condition_variable _jobReady;      /// signalled when a job is queued or when stopping
+        std::condition_variable _bufferFreed;   /// signalled when a frame has been written
+        std::vector<std::thread> _threads;      /// writer threads
+    };
+
+} // namespace
@@ -54,6 +54,18 @@ namespace arc
 		#define throwArcGen3NoDeviceError()			arc::gen3::CArcBase::throwNoDeviceError( __FUNCTION__, __LINE__ )
 
 
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Macro - arcGen3Restrict                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Restrict pointer qualifier ( MSVC, GCC and Clang all spell it __restrict )                              |
+		// +----------------------------------------------------------------------------------------------------------+
+
+		/** Promises the compiler that the data behind a pointer is only reached through that pointer in the current
+		 *  scope, so loops that read one buffer and write another can be vectorized without runtime overlap checks.
+		 */
+		#define arcGen3Restrict						__restrict
+
+
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  CArcBase Class                                                                                          |
 		// +----------------------------------------------------------------------------------------------------------+
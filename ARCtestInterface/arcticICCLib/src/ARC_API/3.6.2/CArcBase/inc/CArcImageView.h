@@ -0,0 +1,170 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcImageView.h  ( Gen3 )                                                                                |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines a non-owning, strided view onto image data shared by the image, deinterlace and     |
+// |           FITS libraries.                                                                                        |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+/**< @file CArcImageView.h */
+
+#ifndef _GEN3_CARCIMAGEVIEW_H_
+#define _GEN3_CARCIMAGEVIEW_H_
+
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		/** @class CArcImageView
+		 *  Non-owning view onto a rectangle of image pixels. The view is described by a pointer to its first ( origin )
+		 *  pixel, its width and height, and the row stride ( in pixels ) of the buffer it looks into. A view of a
+		 *  sub-region is created by offsetting the origin and keeping the parent stride, so no pixels are copied and
+		 *  nothing is allocated. The caller must keep the underlying buffer alive for as long as the view is used.
+		 *
+		 *  Use CArcImageView<const T> for read-only access; a CArcImageView<T> converts to it implicitly.
+		 */
+		template <typename T>
+		class CArcImageView
+		{
+			public:
+
+				/** Pixel type without any const qualifier */
+				using value_type = std::remove_const_t<T>;
+
+				/** Default constructor. Creates an empty view.
+				 */
+				CArcImageView( void ) = default;
+
+				/** Constructor. Creates a view of an entire contiguous image.
+				 *  @param pBuf		- Pointer to the image buffer.
+				 *  @param uiCols	- The image column size ( in pixels ).
+				 *  @param uiRows	- The image row size ( in pixels ).
+				 *  @throws std::invalid_argument
+				 */
+				CArcImageView( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows ) : CArcImageView( pBuf, uiCols, uiRows, uiCols )
+				{
+				}
+
+				/** Constructor. Creates a view with an explicit row stride.
+				 *  @param pBuf		- Pointer to the first ( origin ) pixel of the view.
+				 *  @param uiCols	- The view column size ( in pixels ).
+				 *  @param uiRows	- The view row size ( in pixels ).
+				 *  @param uiStride	- The distance between the start of consecutive rows ( in pixels ). Must be >= uiCols.
+				 *  @throws std::invalid_argument
+				 */
+				CArcImageView( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiStride )
+					: m_pBuf( pBuf ), m_uiCols( uiCols ), m_uiRows( uiRows ), m_uiStride( uiStride )
+				{
+					if ( pBuf == nullptr )
+					{
+						throwArcGen3InvalidArgument( std::string( "Invalid image view buffer ( nullptr )!" ) );
+					}
+
+					if ( uiCols == 0 || uiRows == 0 )
+					{
+						throwArcGen3InvalidArgument( "Invalid image view size [ %u x %u ]! Cannot be zero!", uiCols, uiRows );
+					}
+
+					if ( uiStride < uiCols )
+					{
+						throwArcGen3InvalidArgument( "Invalid image view stride [ %u ]! Must be at least the column size [ %u ]!", uiStride, uiCols );
+					}
+				}
+
+				/** Converting constructor. Allows a writable view to be passed where a read-only view is expected.
+				 *  @param rView - The view to convert.
+				 */
+				template <typename U> requires std::is_same_v<const U, T>
+				CArcImageView( const CArcImageView<U>& rView ) noexcept
+					: m_pBuf( rView.data() ), m_uiCols( rView.cols() ), m_uiRows( rView.rows() ), m_uiStride( rView.stride() )
+				{
+				}
+
+				/** Returns a pointer to the first ( origin ) pixel of the view.
+				 */
+				T* data( void ) const noexcept { return m_pBuf; }
+
+				/** Returns the view column size ( in pixels ).
+				 */
+				std::uint32_t cols( void ) const noexcept { return m_uiCols; }
+
+				/** Returns the view row size ( in pixels ).
+				 */
+				std::uint32_t rows( void ) const noexcept { return m_uiRows; }
+
+				/** Returns the distance between the start of consecutive rows ( in pixels ).
+				 */
+				std::uint32_t stride( void ) const noexcept { return m_uiStride; }
+
+				/** Returns the total number of pixels in the view.
+				 */
+				std::uint64_t size( void ) const noexcept { return ( static_cast< std::uint64_t >( m_uiCols ) * m_uiRows ); }
+
+				/** Returns true if the view rows follow each other in memory with no gap ( i.e. stride == cols ).
+				 */
+				bool isContiguous( void ) const noexcept { return ( m_uiStride == m_uiCols ); }
+
+				/** Returns true if the view does not reference any pixels.
+				 */
+				bool empty( void ) const noexcept { return ( m_pBuf == nullptr ); }
+
+				/** Returns a pointer to the first pixel of the specified view row. The row is not range checked.
+				 *  @param uiRow - The view row number.
+				 */
+				T* row( const std::uint32_t uiRow ) const noexcept { return ( m_pBuf + static_cast< std::size_t >( uiRow ) * m_uiStride ); }
+
+				/** Returns a reference to the pixel at the specified view column and row. The position is not range checked.
+				 *  @param uiCol - The view column number.
+				 *  @param uiRow - The view row number.
+				 */
+				T& operator()( const std::uint32_t uiCol, const std::uint32_t uiRow ) const noexcept { return row( uiRow )[ uiCol ]; }
+
+				/** Returns a view of a sub-region of this view. No pixels are copied.
+				 *  @param uiCol	- The sub-region start column, relative to this view.
+				 *  @param uiRow	- The sub-region start row, relative to this view.
+				 *  @param uiCols	- The sub-region column size ( in pixels ).
+				 *  @param uiRows	- The sub-region row size ( in pixels ).
+				 *  @return A view that shares this view's buffer and stride.
+				 *  @throws std::invalid_argument
+				 */
+				CArcImageView subView( const std::uint32_t uiCol, const std::uint32_t uiRow, const std::uint32_t uiCols, const std::uint32_t uiRows ) const
+				{
+					if ( static_cast< std::uint64_t >( uiCol ) + uiCols > m_uiCols || static_cast< std::uint64_t >( uiRow ) + uiRows > m_uiRows )
+					{
+						throwArcGen3InvalidArgument( "Invalid sub-view [ %u, %u, %u x %u ]! Must lie within the %u x %u parent view!",
+													 uiCol, uiRow, uiCols, uiRows, m_uiCols, m_uiRows );
+					}
+
+					return CArcImageView( row( uiRow ) + uiCol, uiCols, uiRows, m_uiStride );
+				}
+
+			private:
+
+				/** Pointer to the first ( origin ) pixel */
+				T* m_pBuf = nullptr;
+
+				/** View column size ( in pixels ) */
+				std::uint32_t m_uiCols = 0;
+
+				/** View row size ( in pixels ) */
+				std::uint32_t m_uiRows = 0;
+
+				/** Row stride ( in pixels ) */
+				std::uint32_t m_uiStride = 0;
+		};
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+#endif		// _GEN3_CARCIMAGEVIEW_H_
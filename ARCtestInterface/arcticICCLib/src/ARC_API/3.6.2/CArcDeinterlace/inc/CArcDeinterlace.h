@@ -26,6 +26,7 @@
 #include <CArcDeinterlaceDllMain.h>
 #include <CArcPluginManager.h>
 #include <CArcBase.h>
+#include <CArcImageView.h>
 
 
 
@@ -109,6 +110,47 @@ namespace arc
 				 */
 				void run( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::string& sAlg, const std::initializer_list<std::uint32_t>& tArgList = {} );
 
+				/** Deinterlace an image view using the specified algorithm. A contiguous view is deinterlaced in place. A
+				 *  view with a row stride larger than its width is packed into a temporary buffer, deinterlaced and then
+				 *  written back, so the pixels outside the view are never touched.
+				 *  @param cView	- The image view to deinterlace.
+				 *  @param eAlg		- The algorithm to use to deinterlace the view.
+				 *  @param tArgList	- A reference to a list of algorithm dependent arguments ( default = {}, empty list ).
+				 *  @see CArcDeinterlace::e_Alg
+				 *  @throws std::exception on error.
+				 */
+				void run( const arc::gen3::CArcImageView<T>& cView, arc::gen3::dlace::e_Alg eAlg, const std::initializer_list<std::uint32_t>& tArgList = {} );
+
+				/** Deinterlace an image view using a custom algorithm loaded through the plugin manager. See above.
+				 *  @param cView	- The image view to deinterlace.
+				 *  @param sAlg		- The name of the algorithm to use for deinterlacing the view.
+				 *  @param tArgList	- A reference to a list of algorithm dependent arguments ( default = {}, empty list ).
+				 *  @throws std::exception on error.
+				 */
+				void run( const arc::gen3::CArcImageView<T>& cView, const std::string& sAlg, const std::initializer_list<std::uint32_t>& tArgList = {} );
+
+				/** Interlace the buffer data using the specified algorithm. This is the inverse of run(): it rearranges an
+				 *  image into the order the controller reads it out in, so that run() restores the image. Useful for
+				 *  generating raw test frames, e.g. from CArcImage::fillWithSynthetic.
+				 *  @param pBuf		- Pointer to the buffer to interlace.
+				 *  @param uiCols	- The number of columns in the buffer.
+				 *  @param uiRows	- The number of rows in the buffer.
+				 *  @param eAlg		- The algorithm whose readout order to produce.
+				 *  @param tArgList	- A reference to a list of algorithm dependent arguments ( default = {}, empty list ).
+				 *  @see CArcDeinterlace::e_Alg
+				 *  @throws std::exception on error.
+				 */
+				void interlace( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, arc::gen3::dlace::e_Alg eAlg, const std::initializer_list<std::uint32_t>& tArgList = {} );
+
+				/** Interlace an image view using the specified algorithm. See above and run().
+				 *  @param cView	- The image view to interlace.
+				 *  @param eAlg		- The algorithm whose readout order to produce.
+				 *  @param tArgList	- A reference to a list of algorithm dependent arguments ( default = {}, empty list ).
+				 *  @see CArcDeinterlace::e_Alg
+				 *  @throws std::exception on error.
+				 */
+				void interlace( const arc::gen3::CArcImageView<T>& cView, arc::gen3::dlace::e_Alg eAlg, const std::initializer_list<std::uint32_t>& tArgList = {} );
+
 				/** Returns the deinterlace plugin manager.
 				 *  @return The plugin manager.
 				 */
@@ -155,12 +197,20 @@ namespace arc
 
 				/** Quad IR CDS ( correlated double sampling ) deinterlace algorithm.
 				 *  @param pBuf   - Pointer to the buffer data to deinterlace.
-				 *  @param uiCols - The number of columns in the buffer.
-				 *  @param uiRows - The number of rows in the buffer.
+				 *  @param uiCols - The number of columns in the buffer. Must be even.
+				 *  @param uiRows - The number of rows in the buffer. Must be a multiple of 4, so each half has an even row count.
 				 *  @throws std::exception on error.
 				 */
 				void quadIRCDS( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
 
+				/** Deinterlaces one quad IR section from a raw buffer into a separate output buffer.
+				 *  @param pRaw				- Pointer to the raw section pixels.
+				 *  @param pNew				- Pointer to the output section pixels. Must not overlap pRaw.
+				 *  @param uiCols			- The number of columns in the section.
+				 *  @param uiSectionRows	- The number of rows in the section.
+				 */
+				static void quadIRSection( const T* arcGen3Restrict pRaw, T* arcGen3Restrict pNew, const std::uint32_t uiCols, const std::uint32_t uiSectionRows );
+
 				/** Hawaii RG deinterlace algorithm.
 				 *  @param pBuf			- Pointer to the buffer data to deinterlace.
 				 *  @param uiCols		- The number of columns in the buffer.
@@ -178,6 +228,13 @@ namespace arc
 				 */
 				void sta1600( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
 
+				/** Copies the rows of a strided image view into a contiguous buffer, or back from it.
+				 *  @param cView	- The image view.
+				 *  @param pPacked	- Pointer to a contiguous buffer of cView.cols() x cView.rows() pixels.
+				 *  @param bToBuf	- true to copy from the view to the buffer, false to copy from the buffer to the view.
+				 */
+				static void packView( const arc::gen3::CArcImageView<T>& cView, T* pPacked, const bool bToBuf );
+
 				/** version() text holder */
 				static const std::string m_sVersion;
 
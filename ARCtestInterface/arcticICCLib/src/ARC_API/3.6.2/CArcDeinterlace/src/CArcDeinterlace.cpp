@@ -319,6 +319,383 @@ namespace arc
 		}
 
 
+		// +----------------------------------------------------------------------------------------------------------+
+		// | run                                                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Deinterlaces an image view. A contiguous view is passed straight to the buffer version. Otherwise the    |
+		// | view rows are packed into a temporary buffer, deinterlaced and copied back into the view.                |
+		// |                                                                                                          |
+		// |  <IN>  -> cView	- The image view to deinterlace                                                       |
+		// |  <IN>  -> eAlg		- Algorithm number that corresponds to deinterlacing method                           |
+		// |  <IN>  -> tArgList - An optional argument list ( default = {}, empty list }.                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlace<T>::run( const arc::gen3::CArcImageView<T>& cView, arc::gen3::dlace::e_Alg eAlg, const std::initializer_list<std::uint32_t>& tArgList )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( cView.isContiguous() )
+			{
+				run( cView.data(), cView.cols(), cView.rows(), eAlg, tArgList );
+			}
+
+			else
+			{
+				std::vector<T> vPacked( static_cast< std::size_t >( cView.size() ) );
+
+				packView( cView, vPacked.data(), true );
+
+				run( vPacked.data(), cView.cols(), cView.rows(), eAlg, tArgList );
+
+				packView( cView, vPacked.data(), false );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | run                                                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Calls a custom deinterlace routine on an image view. See above.                                          |
+		// |                                                                                                          |
+		// |  <IN>  -> cView	- The image view to deinterlace                                                       |
+		// |  <IN>  -> sAlg		- Algorithm name that corresponds to deinterlacing method                             |
+		// |  <IN>  -> tArgList - An optional argument list ( default = {}, empty list }.                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlace<T>::run( const arc::gen3::CArcImageView<T>& cView, const std::string& sAlg, const std::initializer_list<std::uint32_t>& tArgList )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( cView.isContiguous() )
+			{
+				run( cView.data(), cView.cols(), cView.rows(), sAlg, tArgList );
+			}
+
+			else
+			{
+				std::vector<T> vPacked( static_cast< std::size_t >( cView.size() ) );
+
+				packView( cView, vPacked.data(), true );
+
+				run( vPacked.data(), cView.cols(), cView.rows(), sAlg, tArgList );
+
+				packView( cView, vPacked.data(), false );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | packView                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Copies the rows of an image view into a contiguous buffer, or back from it.                              |
+		// |                                                                                                          |
+		// |  <IN>  -> cView	- The image view                                                                      |
+		// |  <IN>  -> pPacked	- Pointer to a contiguous buffer of cView.cols() x cView.rows() pixels                |
+		// |  <IN>  -> bToBuf	- true to copy from the view to the buffer, false to copy from the buffer to the view |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlace<T>::packView( const arc::gen3::CArcImageView<T>& cView, T* pPacked, const bool bToBuf )
+		{
+			std::size_t uiRowBytes = ( static_cast< std::size_t >( cView.cols() ) * sizeof( T ) );
+
+			for ( std::uint32_t row = 0; row < cView.rows(); row++, pPacked += cView.cols() )
+			{
+				if ( bToBuf )
+				{
+					copyMemory( pPacked, cView.row( row ), uiRowBytes );
+				}
+
+				else
+				{
+					copyMemory( cView.row( row ), pPacked, uiRowBytes );
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | interlace                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | The inverse of run(). Rearranges an image into the order the controller reads it out in for the          |
+		// | specified algorithm, so that run() with the same algorithm and arguments restores the image. Each case   |
+		// | walks the same pixel order as its deinterlace routine, with the copies reversed.                         |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf		- Pointer to the image to interlace                                                   |
+		// |  <IN>  -> uiCols	- Number of columns in the image                                                      |
+		// |  <IN>  -> uiRows	- Number of rows in the image                                                         |
+		// |  <IN>  -> eAlg		- Algorithm number whose readout order to produce                                     |
+		// |  <IN>  -> tArgList - An optional argument list ( default = {}, empty list }.                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlace<T>::interlace( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, arc::gen3::dlace::e_Alg eAlg, const std::initializer_list<std::uint32_t>& tArgList )
+		{
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+			}
+
+			if ( uiCols > m_uiNewCols || uiRows > m_uiNewRows )
+			{
+				m_pNewData.reset( new T[ static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows ) ] );
+
+				m_uiNewCols = uiCols;
+				m_uiNewRows = uiRows;
+			}
+
+			const std::size_t uiCount = ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) );
+
+			const T* pImage = pBuf;
+
+			T* pRaw = m_pNewData.get();
+
+			// Readout order of an IR quad section of uiSectionRows rows, starting at the given pointers
+			auto fnQuadIR = [ uiCols ]( T* pRawStart, const T* pImageStart, const std::size_t uiSectionRows )
+			{
+				const std::size_t uiHalfCols = ( uiCols / 2 );
+
+				std::size_t i = 0;
+
+				for ( std::size_t j = ( uiSectionRows - 1 ), uiGroup = 0; uiGroup < ( uiSectionRows / 2 ); j--, uiGroup++ )
+				{
+					const T* pBegin = ( pImageStart + j * uiCols );
+					const T* pEnd = ( pImageStart + ( j - ( uiSectionRows / 2 ) ) * uiCols );
+
+					for ( std::size_t k = 0; k < uiHalfCols; k++ )
+					{
+						pRawStart[ i++ ] = pBegin[ k ];
+						pRawStart[ i++ ] = pBegin[ uiHalfCols + k ];
+						pRawStart[ i++ ] = pEnd[ uiHalfCols + k ];
+						pRawStart[ i++ ] = pEnd[ k ];
+					}
+				}
+			};
+
+			switch ( eAlg )
+			{
+				case arc::gen3::dlace::e_Alg::NONE:
+				{
+					return;
+				}
+
+				case arc::gen3::dlace::e_Alg::PARALLEL:
+				{
+					if ( ( uiRows % 2 ) != 0 )
+					{
+						throwArcGen3Error( "Number of ROWS must be EVEN for PARALLEL interlace."s );
+					}
+
+					for ( std::size_t i = 0; i < ( uiCount / 2 ); i++ )
+					{
+						pRaw[ 2 * i ] = pImage[ i ];
+						pRaw[ 2 * i + 1 ] = pImage[ uiCount - i - 1 ];
+					}
+				}
+				break;
+
+				case arc::gen3::dlace::e_Alg::SERIAL:
+				{
+					if ( ( uiCols % 2 ) != 0 )
+					{
+						throwArcGen3Error( "Number of COLS must be EVEN for SERIAL interlace."s );
+					}
+
+					for ( std::size_t r = 0; r < uiRows; r++ )
+					{
+						const T* pRow = ( pImage + r * uiCols );
+
+						T* pRawRow = ( pRaw + r * uiCols );
+
+						for ( std::size_t k = 0; k < ( uiCols / 2 ); k++ )
+						{
+							pRawRow[ 2 * k ] = pRow[ k ];
+							pRawRow[ 2 * k + 1 ] = pRow[ uiCols - 1 - k ];
+						}
+					}
+				}
+				break;
+
+				case arc::gen3::dlace::e_Alg::QUAD_CCD:
+				{
+					if ( ( uiCols % 2 ) != 0 || ( uiRows % 2 ) != 0 )
+					{
+						throwArcGen3Error( "Number of COLS and ROWS must be EVEN for QUAD CCD interlace."s );
+					}
+
+					std::size_t i = 0;
+
+					for ( std::size_t j = 0; j < ( uiRows / 2 ); j++ )
+					{
+						const T* pBegin = ( pImage + j * uiCols );
+						const T* pEnd = ( pImage + uiCount - j * uiCols - 1 );
+
+						for ( std::size_t k = 0; k < ( uiCols / 2 ); k++ )
+						{
+							pRaw[ i++ ] = pBegin[ k ];
+							pRaw[ i++ ] = pBegin[ uiCols - 1 - k ];
+							pRaw[ i++ ] = *( pEnd - k );
+							pRaw[ i++ ] = *( pEnd - uiCols + 1 + k );
+						}
+					}
+				}
+				break;
+
+				case arc::gen3::dlace::e_Alg::QUAD_IR:
+				{
+					if ( ( uiCols % 2 ) != 0 || ( uiRows % 2 ) != 0 )
+					{
+						throwArcGen3Error( "Number of COLS and ROWS must be EVEN for QUAD IR interlace."s );
+					}
+
+					fnQuadIR( pRaw, pImage, uiRows );
+				}
+				break;
+
+				case arc::gen3::dlace::e_Alg::QUAD_IR_CDS:
+				{
+					if ( ( uiCols % 2 ) != 0 || ( uiRows % 4 ) != 0 )
+					{
+						throwArcGen3Error( "Number of COLS must be EVEN and ROWS a multiple of 4 for QUAD IR CDS interlace."s );
+					}
+
+					fnQuadIR( pRaw, pImage, ( uiRows / 2 ) );
+
+					fnQuadIR( pRaw + ( uiCount / 2 ), pImage + ( uiCount / 2 ), ( uiRows / 2 ) );
+				}
+				break;
+
+				case arc::gen3::dlace::e_Alg::HAWAII_RG:
+				{
+					if ( tArgList.size() != 1 )
+					{
+						throwArcGen3Error( "Invalid number of arguments. Expected 1, found: %d", tArgList.size() );
+					}
+
+					const std::uint32_t uiChannels = *tArgList.begin();
+
+					if ( ( uiCols % 2 ) != 0 )
+					{
+						throwArcGen3Error( "Number of COLS must be EVEN for HAWAII RG interlace."s );
+					}
+
+					else if ( uiChannels <= 1 )
+					{
+						// Matches run(), which leaves single channel data as is
+						return;
+					}
+
+					else if ( uiChannels % 2 != 0 )
+					{
+						throwArcGen3Error( "The readout channel count must be EVEN for HAWAII RG interlace."s );
+					}
+
+					const std::size_t uiOffset = ( uiCols / uiChannels );
+
+					std::size_t i = 0;
+
+					for ( std::size_t r = 0; r < uiRows; r++ )
+					{
+						const T* pRow = ( pImage + r * uiCols );
+
+						for ( std::size_t c = 0; c < uiOffset; c++ )
+						{
+							for ( std::size_t uiChannel = 0; uiChannel < uiChannels; uiChannel++ )
+							{
+								pRaw[ i++ ] = pRow[ c + uiChannel * uiOffset ];
+							}
+						}
+					}
+				}
+				break;
+
+				case arc::gen3::dlace::e_Alg::STA1600:
+				{
+					if ( ( uiCols % 16 ) != 0 )
+					{
+						throwArcGen3Error( "Number of COLS must be a multiple of 16 for STA1600 interlace."s );
+					}
+
+					if ( ( uiRows % 2 ) != 0 )
+					{
+						throwArcGen3Error( "Number of ROWS must be a multiple of 2 for STA1600 interlace."s );
+					}
+
+					const std::size_t uiOffset = ( uiCols / 8 );
+
+					std::size_t i = 0;
+
+					for ( std::size_t r = 0; r < ( uiRows / 2 ); r++ )
+					{
+						const T* pTop = ( pImage + uiCols * ( uiRows - r - 1 ) );
+						const T* pBot = ( pImage + uiCols * r );
+
+						for ( std::size_t c = 0; c < uiOffset; c++ )
+						{
+							for ( std::size_t uiTap = 8; uiTap-- > 0; )
+							{
+								pRaw[ i++ ] = pBot[ c + uiTap * uiOffset ];
+							}
+
+							for ( std::size_t uiTap = 8; uiTap-- > 0; )
+							{
+								pRaw[ i++ ] = pTop[ c + uiTap * uiOffset ];
+							}
+						}
+					}
+				}
+				break;
+
+				default:
+				{
+					throwArcGen3Error( "Invalid deinterlace algorithm [ %d ]!", eAlg );
+				}
+				break;
+			}
+
+			copyMemory( pBuf, m_pNewData.get(), ( uiCount * sizeof( T ) ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | interlace                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Interlaces an image view. See above and run().                                                           |
+		// |                                                                                                          |
+		// |  <IN>  -> cView	- The image view to interlace                                                         |
+		// |  <IN>  -> eAlg		- Algorithm number whose readout order to produce                                     |
+		// |  <IN>  -> tArgList - An optional argument list ( default = {}, empty list }.                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlace<T>::interlace( const arc::gen3::CArcImageView<T>& cView, arc::gen3::dlace::e_Alg eAlg, const std::initializer_list<std::uint32_t>& tArgList )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( cView.isContiguous() )
+			{
+				interlace( cView.data(), cView.cols(), cView.rows(), eAlg, tArgList );
+			}
+
+			else
+			{
+				std::vector<T> vPacked( static_cast< std::size_t >( cView.size() ) );
+
+				packView( cView, vPacked.data(), true );
+
+				interlace( vPacked.data(), cView.cols(), cView.rows(), eAlg, tArgList );
+
+				packView( cView, vPacked.data(), false );
+			}
+		}
+
+
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  maxTVal                                                                                                 |
 		// +----------------------------------------------------------------------------------------------------------+
@@ -359,13 +736,19 @@ namespace arc
 				throwArcGen3Error( "Number of ROWS must be EVEN for PARALLEL deinterlace."s );
 			}
 
-			for ( std::uint64_t i = 0; i < ( ( uiCols * uiRows ) / 2 ); i++ )
+			const std::size_t uiCount = ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) );
+
+			const T* arcGen3Restrict pRaw = pBuf;
+
+			T* arcGen3Restrict pNew = m_pNewData.get();
+
+			for ( std::size_t i = 0; i < ( uiCount / 2 ); i++ )
 			{
-				*( m_pNewData.get() + i ) = *( pBuf + ( 2 * i ) );
-				*( m_pNewData.get() + ( static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows ) ) - i - 1 ) = *( pBuf + ( 2 * i ) + 1 );
+				pNew[ i ] = pRaw[ 2 * i ];
+				pNew[ uiCount - i - 1 ] = pRaw[ 2 * i + 1 ];
 			}
 
-			copyMemory( pBuf, m_pNewData.get(), ( static_cast<std::size_t>( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
+			copyMemory( pBuf, m_pNewData.get(), ( uiCount * sizeof( T ) ) );
 		}
 
 
@@ -391,34 +774,21 @@ namespace arc
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T> void CArcDeinterlace<T>::serial( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
 		{
-			std::uint32_t p1 = 0;
-			std::uint32_t p2 = 0;
-			std::uint32_t begin = 0;
-			std::uint32_t end = 0;
-
 			if ( ( uiCols % 2 ) != 0 )
 			{
 				throwArcGen3Error( "Number of COLS must be EVEN for SERIAL deinterlace."s );
 			}
 
-			for ( std::remove_const_t<decltype( uiRows )> i = 0; i < uiRows; i++ )
+			for ( std::size_t i = 0; i < uiRows; i++ )
 			{
-				// Leave in +0 for clarity
-				p1 = i * uiCols + 0;	// Position in raw image
-				p2 = i * uiCols + 1;
-				begin = i * uiCols + 0;	// Position in deinterlaced image
-				end = i * uiCols + uiCols - 1;
-
-				for ( std::remove_const_t<decltype( uiCols )> j = 0; j < uiCols; j += 2 )
-				{
-					*( m_pNewData.get() + begin ) = *( pBuf + p1 );
-					*( m_pNewData.get() + end ) = *( pBuf + p2 );
+				const T* arcGen3Restrict pRaw = ( pBuf + i * uiCols );				// Row in raw image
 
-					++begin;
-					--end;
+				T* arcGen3Restrict pNew = ( m_pNewData.get() + i * uiCols );		// Row in deinterlaced image
 
-					p1 += 2;
-					p2 += 2;
+				for ( std::size_t j = 0; j < ( uiCols / 2 ); j++ )
+				{
+					pNew[ j ] = pRaw[ 2 * j ];
+					pNew[ uiCols - 1 - j ] = pRaw[ 2 * j + 1 ];
 				}
 			}
 
@@ -448,38 +818,33 @@ namespace arc
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T> void CArcDeinterlace<T>::quadCCD( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
 		{
-			std::uint32_t i = 0;
-			std::uint32_t j = 0;
-			std::uint32_t counter = 0;
-			std::uint32_t end = 0;
-			std::uint32_t begin = 0;
-
 			if ( ( uiCols % 2 ) != 0 || ( uiRows % 2 ) != 0 )
 			{
 				throwArcGen3Error( "Number of COLS and ROWS must be EVEN for QUAD CCD deinterlace."s );
 			}
 
-			while ( i < ( uiCols * uiRows ) )
-			{
-				if ( counter % ( uiCols / 2 ) == 0 )
-				{
-					end = ( uiCols * uiRows ) - ( uiCols * j ) - 1;
-					begin = ( uiCols * j ) + 0;	// Left in 0 for clarity
+			const std::size_t uiCount = ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) );
 
-					j++;							// Number of completed rows
+			const T* arcGen3Restrict pRaw = pBuf;
 
-					counter = 0;					// Reset for next convergece
-				}
+			T* arcGen3Restrict pNew = m_pNewData.get();
 
-				*( m_pNewData.get() + begin + counter ) = *( pBuf + i++ );		// front_row--->
-				*( m_pNewData.get() + begin + uiCols - 1 - counter ) = *( pBuf + i++ );		// front_row<--
-				*( m_pNewData.get() + end - counter ) = *( pBuf + i++ );		// end_row<----
-				*( m_pNewData.get() + end - uiCols + 1 + counter ) = *( pBuf + i++ );		// end_row---->
+			// Each pass converges on row j from the bottom and row ( uiRows - 1 - j ) from the top
+			for ( std::size_t j = 0, i = 0; j < ( uiRows / 2 ); j++ )
+			{
+				const std::size_t begin = ( uiCols * j );
+				const std::size_t end = ( uiCount - ( uiCols * j ) - 1 );
 
-				counter++;
+				for ( std::size_t counter = 0; counter < ( uiCols / 2 ); counter++, i += 4 )
+				{
+					pNew[ begin + counter ] = pRaw[ i ];						// front_row--->
+					pNew[ begin + uiCols - 1 - counter ] = pRaw[ i + 1 ];		// front_row<--
+					pNew[ end - counter ] = pRaw[ i + 2 ];						// end_row<----
+					pNew[ end - uiCols + 1 + counter ] = pRaw[ i + 3 ];			// end_row---->
+				}
 			}
 
-			copyMemory( pBuf, m_pNewData.get(), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
+			copyMemory( pBuf, m_pNewData.get(), ( uiCount * sizeof( T ) ) );
 		}
 
 
@@ -505,36 +870,12 @@ namespace arc
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T> void CArcDeinterlace<T>::quadIR( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
 		{
-			std::uint32_t i = 0;
-			std::uint32_t j = uiRows - 1;
-			std::uint32_t counter = 0;
-			std::uint32_t end = 0;
-			std::uint32_t begin = 0;
-
 			if ( ( uiCols % 2 ) != 0 || ( uiRows % 2 ) != 0 )
 			{
 				throwArcGen3Error( "Number of COLS and ROWS must be EVEN for QUAD IR deinterlace."s );
 			}
 
-			while ( i < ( uiCols * uiRows ) )
-			{
-				if ( counter % ( uiCols / 2 ) == 0 )
-				{
-					end = ( j - ( uiRows / 2 ) ) * uiCols;
-					begin = j * uiCols;
-
-					j--; 						// Nnumber of completed rows
-
-					counter = 0; 				// Reset for next convergece
-				}
-
-				*( m_pNewData.get() + begin + counter ) = *( pBuf + i++ );	// front_row--->
-				*( m_pNewData.get() + begin + ( uiCols / 2 ) + counter ) = *( pBuf + i++ );	// front_row<--
-				*( m_pNewData.get() + end + ( uiCols / 2 ) + counter ) = *( pBuf + i++ );	// end_row<----
-				*( m_pNewData.get() + end + counter ) = *( pBuf + i++ );	// end_row---->
-
-				counter++;
-			}
+			quadIRSection( pBuf, m_pNewData.get(), uiCols, uiRows );
 
 			copyMemory( pBuf, m_pNewData.get(), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
 		}
@@ -571,59 +912,21 @@ namespace arc
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T> void CArcDeinterlace<T>::quadIRCDS( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
 		{
-			std::uint32_t i			= 0;
-			std::uint32_t j			= 0;
-			std::uint32_t counter	= 0;
-			std::uint32_t end		= 0;
-			std::uint32_t begin		= 0;
-
-			T* pOldStart = pBuf;
-			T* pNewStart = m_pNewData.get();
-
-			auto uiLocalRows = uiRows;
-
-			if ( ( uiCols % 2 ) != 0 || ( uiLocalRows % 2 ) != 0 )
+			if ( ( uiCols % 2 ) != 0 || ( uiRows % 4 ) != 0 )
 			{
-				throwArcGen3Error( "Number of COLS and ROWS must be EVEN for QUAD IR CDS deinterlace."s );
+				throwArcGen3Error( "Number of COLS must be EVEN and ROWS a multiple of 4 for QUAD IR CDS deinterlace."s );
 			}
 
-			// Set the the number of rows to half the image size.
-			uiLocalRows	= ( uiLocalRows / 2U );
-
 			// Deinterlace the two image halves separately.
-			for ( int imageSection = 0; imageSection < 2; imageSection++ )
-			{
-				i = 0;
-				j = uiLocalRows - 1;
-				counter = 0;
-				end = 0;
-				begin = 0;
+			const std::uint32_t uiLocalRows = ( uiRows / 2U );
 
-				while ( i < ( uiCols * uiLocalRows ) )
-				{
-					if ( ( counter % ( uiCols / 2 ) ) == 0 )
-					{
-						end = ( j - ( uiLocalRows / 2 ) ) * uiCols;
-						begin = j * uiCols;
+			const std::size_t uiHalfCount = ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiLocalRows ) );
 
-						j--; 			// Number of completed rows
-
-						counter = 0; 	// Reset for next convergece
-					}
+			quadIRSection( pBuf, m_pNewData.get(), uiCols, uiLocalRows );
 
-					*( pNewStart + begin + counter ) = *( pOldStart + i++ );		// front_row--->
-					*( pNewStart + begin + ( uiCols / 2 ) + counter ) = *( pOldStart + i++ );		// front_row<--
-					*( pNewStart + end + ( uiCols / 2 ) + counter ) = *( pOldStart + i++ );		// end_row<----
-					*( pNewStart + end + counter ) = *( pOldStart + i++ );		// end_row---->
-
-					counter++;
-				}
-
-				pOldStart += ( static_cast< std::uint64_t >( uiLocalRows ) * static_cast< std::uint64_t >( uiCols ) );
-				pNewStart += ( static_cast< std::uint64_t >( uiLocalRows ) * static_cast< std::uint64_t >( uiCols ) );
-			}
+			quadIRSection( pBuf + uiHalfCount, m_pNewData.get() + uiHalfCount, uiCols, uiLocalRows );
 
-			copyMemory( pBuf, m_pNewData.get(), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiLocalRows ) * sizeof( T ) ) );
+			copyMemory( pBuf, m_pNewData.get(), ( 2 * uiHalfCount * sizeof( T ) ) );
 		}
 
 
@@ -676,20 +979,21 @@ namespace arc
 
 			else
 			{
-				T* pRow = m_pNewData.get();
+				const T* arcGen3Restrict pRaw = pBuf;
 
-				std::uint32_t offset = uiCols / uChannels;
-				std::uint32_t dataIndex = 0;
+				const std::size_t offset = ( uiCols / uChannels );
 
-				for ( std::uint64_t r = 0; r < uiRows; r++ )
+				std::size_t dataIndex = 0;
+
+				for ( std::size_t r = 0; r < uiRows; r++ )
 				{
-					pRow = m_pNewData.get() + ( uiCols * r );
+					T* arcGen3Restrict pRow = ( m_pNewData.get() + ( uiCols * r ) );
 
-					for ( std::remove_const_t<decltype( uiCols )> c = 0; c < ( uiCols / uChannels ); c++ )
+					for ( std::size_t c = 0; c < offset; c++ )
 					{
-						for ( std::remove_const_t<decltype( uChannels )> i = 0; i < uChannels; i++ )
+						for ( std::size_t i = 0; i < uChannels; i++ )
 						{
-							pRow[ c + i * offset ] = pBuf[ dataIndex++ ];
+							pRow[ c + i * offset ] = pRaw[ dataIndex++ ];
 						}
 					}
 				}
@@ -699,6 +1003,40 @@ namespace arc
 		}
 
 
+		// +----------------------------------------------------------------------------------------------------------+
+		// | quadIRSection                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Deinterlaces one IR quad section ( see quadIR ) from the raw buffer into the new buffer. Each pass fills |
+		// | one row of the top amplifier pair, starting from the top, and the matching row of the bottom pair.       |
+		// |                                                                                                          |
+		// |  <IN>  -> pRaw          - Pointer to the raw section pixels                                              |
+		// |  <OUT> -> pNew          - Pointer to the deinterlaced section pixels                                     |
+		// |  <IN>  -> uiCols        - Number of columns in the section                                               |
+		// |  <IN>  -> uiSectionRows - Number of rows in the section                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlace<T>::quadIRSection( const T* arcGen3Restrict pRaw, T* arcGen3Restrict pNew, const std::uint32_t uiCols, const std::uint32_t uiSectionRows )
+		{
+			const std::size_t uiHalfCols = ( uiCols / 2 );
+
+			std::size_t i = 0;
+
+			for ( std::size_t j = ( uiSectionRows - 1 ), uiPass = 0; uiPass < ( uiSectionRows / 2 ); j--, uiPass++ )
+			{
+				const std::size_t begin = ( j * uiCols );
+				const std::size_t end = ( ( j - ( uiSectionRows / 2 ) ) * uiCols );
+
+				for ( std::size_t counter = 0; counter < uiHalfCols; counter++, i += 4 )
+				{
+					pNew[ begin + counter ] = pRaw[ i ];						// front_row--->
+					pNew[ begin + uiHalfCols + counter ] = pRaw[ i + 1 ];		// front_row<--
+					pNew[ end + uiHalfCols + counter ] = pRaw[ i + 2 ];			// end_row<----
+					pNew[ end + counter ] = pRaw[ i + 3 ];						// end_row---->
+				}
+			}
+		}
+
+
 		// +----------------------------------------------------------------------------------------------------------+
 		// | sta1600                                                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
@@ -736,36 +1074,36 @@ namespace arc
 				throwArcGen3Error( "Number of ROWS must be a multiple of 2 for STA1600 deinterlace."s );
 			}
 
-			T* botPtr = m_pNewData.get();
-			T* topPtr = m_pNewData.get() + ( static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows - 1 ) );
+			const T* arcGen3Restrict pRaw = pBuf;
+
+			const std::size_t offset = ( uiCols / 8 );
 
-			std::uint32_t offset = uiCols / 8;
-			std::uint32_t dataIndex = 0;
+			std::size_t dataIndex = 0;
 
-			for ( std::uint64_t r = 0; r < ( uiRows / 2 ); r++ )
+			for ( std::size_t r = 0; r < ( uiRows / 2 ); r++ )
 			{
-				topPtr = m_pNewData.get() + ( uiCols * ( uiRows - r - 1 ) );
-				botPtr = m_pNewData.get() + ( uiCols * r );
+				T* arcGen3Restrict topPtr = ( m_pNewData.get() + ( uiCols * ( uiRows - r - 1 ) ) );
+				T* arcGen3Restrict botPtr = ( m_pNewData.get() + ( uiCols * r ) );
 
-				for ( std::remove_const_t<decltype( uiCols )> c = 0; c < ( uiCols / 8 ); c++ )
+				for ( std::size_t c = 0; c < offset; c++ )
 				{
-					botPtr[ c + 7 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 6 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 5 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 4 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 3 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 2 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 1 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 0 * offset ] = pBuf[ dataIndex++ ];
-
-					topPtr[ c + 7 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 6 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 5 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 4 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 3 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 2 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 1 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 0 * offset ] = pBuf[ dataIndex++ ];
+					botPtr[ c + 7 * offset ] = pRaw[ dataIndex++ ];
+					botPtr[ c + 6 * offset ] = pRaw[ dataIndex++ ];
+					botPtr[ c + 5 * offset ] = pRaw[ dataIndex++ ];
+					botPtr[ c + 4 * offset ] = pRaw[ dataIndex++ ];
+					botPtr[ c + 3 * offset ] = pRaw[ dataIndex++ ];
+					botPtr[ c + 2 * offset ] = pRaw[ dataIndex++ ];
+					botPtr[ c + 1 * offset ] = pRaw[ dataIndex++ ];
+					botPtr[ c + 0 * offset ] = pRaw[ dataIndex++ ];
+
+					topPtr[ c + 7 * offset ] = pRaw[ dataIndex++ ];
+					topPtr[ c + 6 * offset ] = pRaw[ dataIndex++ ];
+					topPtr[ c + 5 * offset ] = pRaw[ dataIndex++ ];
+					topPtr[ c + 4 * offset ] = pRaw[ dataIndex++ ];
+					topPtr[ c + 3 * offset ] = pRaw[ dataIndex++ ];
+					topPtr[ c + 2 * offset ] = pRaw[ dataIndex++ ];
+					topPtr[ c + 1 * offset ] = pRaw[ dataIndex++ ];
+					topPtr[ c + 0 * offset ] = pRaw[ dataIndex++ ];
 				}
 			}
 
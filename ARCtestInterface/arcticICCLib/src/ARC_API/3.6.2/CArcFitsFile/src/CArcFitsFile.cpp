@@ -8,11 +8,33 @@
 // |  Copyright 2013 Astronomical Research Cameras, Inc. All rights reserved.                                         |
 // +------------------------------------------------------------------------------------------------------------------+
 
+#ifdef _WINDOWS
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <cerrno>
+#endif
+
 #include <version>
 #include <type_traits>
 #include <typeinfo>
 #include <sstream>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <exception>
+#include <system_error>
+#include <algorithm>
 #include <memory>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <bit>
+#include <vector>
 #include <cmath>
 
 #ifdef __cpp_lib_filesystem
@@ -28,6 +50,361 @@
 using namespace std::string_literals;
 
 
+// +------------------------------------------------------------------------------------------------------------------+
+// |  cfitsio internal header. Declares the Rice compressors fits_rcomp() and fits_rcomp_short(). Unlike fitsio.h     |
+// |  it has no C++ linkage guard of its own.                                                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+extern "C"
+{
+	#include <fitsio2.h>
+}
+
+namespace
+{
+	/** Rice block size, as written by cfitsio to the ZVAL1 ( BLOCKSIZE ) keyword */
+	constexpr int RICE_BLOCK_SIZE = 32;
+
+	/** Default image rows per tile for H-compress, which needs tiles of at least 4 x 4 pixels */
+	constexpr std::uint32_t HCOMPRESS_TILE_ROWS = 16;
+
+	/** Default maximum bytes of compressed tile buffers */
+	constexpr std::uint64_t COMPRESS_BUDGET = ( 64 * 1024 * 1024 );
+
+	int riceCompress( short* pData, int iCount, unsigned char* pOut, int iOutSize ) { return fits_rcomp_short( pData, iCount, pOut, iOutSize, RICE_BLOCK_SIZE ); }
+
+	int riceCompress( int* pData, int iCount, unsigned char* pOut, int iOutSize ) { return fits_rcomp( pData, iCount, pOut, iOutSize, RICE_BLOCK_SIZE ); }
+
+	/** FITS header and data block size ( in bytes ) */
+	constexpr std::uint64_t FITS_BLOCK = 2880;
+
+	/** Header keyword card length, value column and default value field widths ( in characters ) */
+	constexpr std::uint32_t HEADER_CARD = 80;
+	constexpr std::uint32_t HEADER_VALUE_COL = 10;
+	constexpr std::uint32_t HEADER_NUMBER_WIDTH = 20;
+	constexpr std::uint32_t HEADER_STRING_WIDTH = 18;
+
+	/** The COMMENT cards cfitsio writes to every primary header */
+	const std::string FITS_COMMENT_1 = "COMMENT   FITS (Flexible Image Transport System) format is defined in 'Astronomy";
+	const std::string FITS_COMMENT_2 = "COMMENT   and Astrophysics', volume 376, page 359; bibcode: 2001A&A...376..359H";
+
+	/** writeDirect staging buffer size and alignment ( in bytes ). Both are multiples of the O_DIRECT block size. */
+	constexpr std::size_t DIRECT_CHUNK = ( 4 * 1024 * 1024 );
+	constexpr std::size_t DIRECT_ALIGN = 4096;
+
+	/** compareData chunk size ( in pixels ) */
+	constexpr std::uint64_t COMPARE_CHUNK = ( 1024 * 1024 );
+
+	/** Converts a pixel between big-endian ( FITS ) and host byte order. Written with shifts so the loops vectorize. */
+	constexpr std::uint16_t bigEndian( std::uint16_t uwValue )
+	{
+		if constexpr ( std::endian::native == std::endian::little )
+		{
+			return static_cast< std::uint16_t >( ( uwValue >> 8 ) | ( uwValue << 8 ) );
+		}
+
+		return uwValue;
+	}
+
+	constexpr std::uint32_t bigEndian( std::uint32_t uiValue )
+	{
+		if constexpr ( std::endian::native == std::endian::little )
+		{
+			return ( ( uiValue >> 24 ) | ( ( uiValue >> 8 ) & 0xFF00 ) | ( ( uiValue << 8 ) & 0xFF0000 ) | ( uiValue << 24 ) );
+		}
+
+		return uiValue;
+	}
+
+	/** Rounds a byte count up to a whole number of FITS blocks */
+	constexpr std::uint64_t fitsBlocks( std::uint64_t u64Bytes )
+	{
+		return ( ( u64Bytes + FITS_BLOCK - 1 ) / FITS_BLOCK ) * FITS_BLOCK;
+	}
+
+	/** Appends a keyword card to a header, padded with spaces to 80 characters */
+	void appendCard( std::string& sHeader, const std::string& sCard )
+	{
+		sHeader += sCard;
+
+		sHeader.append( HEADER_CARD - sCard.size(), ' ' );
+	}
+
+	/** Appends a fixed format keyword card: name in columns 1 - 8 and the value right justified to column 30 */
+	void appendValueCard( std::string& sHeader, const std::string& sKey, const std::string& sValue, const std::string& sComment )
+	{
+		appendCard( sHeader, sKey + std::string( 8 - sKey.size(), ' ' ) + "= " + std::string( HEADER_NUMBER_WIDTH - sValue.size(), ' ' ) + sValue + " / " + sComment );
+	}
+
+	/** Appends a fixed format string keyword card: the quoted value, padded to 8 characters, starts in column 11 */
+	void appendStringCard( std::string& sHeader, const std::string& sKey, const std::string& sValue, const std::string& sComment )
+	{
+		std::string sQuoted = "'" + sValue + std::string( ( sValue.size() < 8 ? 8 - sValue.size() : 0 ), ' ' ) + "'";
+
+		sQuoted.resize( std::max<std::size_t>( sQuoted.size(), HEADER_NUMBER_WIDTH ), ' ' );
+
+		auto sCard = ( sKey + std::string( 8 - sKey.size(), ' ' ) + "= " + sQuoted + " / " + sComment );
+
+		sCard.resize( HEADER_CARD, ' ' );
+
+		appendCard( sHeader, sCard );
+	}
+
+	/** Appends the BZERO and BSCALE cards that cfitsio writes for unsigned images */
+	template <typename T> void appendScalingCards( std::string& sHeader )
+	{
+		if constexpr ( sizeof( T ) == sizeof( std::uint16_t ) )
+		{
+			appendValueCard( sHeader, "BZERO", "32768", "offset data range to that of unsigned short" );
+		}
+		else
+		{
+			appendValueCard( sHeader, "BZERO", "2147483648", "offset data range to that of unsigned long" );
+		}
+
+		appendValueCard( sHeader, "BSCALE", "1", "default scaling factor" );
+	}
+
+	/** Converts unsigned pixels to FITS order: offset by BZERO ( the sign bit ) and big-endian. Vectorizes. */
+	template <typename T> void encodePixels( const T* arcGen3Restrict pSrc, T* arcGen3Restrict pDst, std::size_t szPixels )
+	{
+		constexpr T tSignBit = static_cast< T >( T( 1 ) << ( sizeof( T ) * 8 - 1 ) );
+
+		for ( std::size_t i = 0; i < szPixels; i++ )
+		{
+			pDst[ i ] = bigEndian( static_cast< T >( pSrc[ i ] ^ tSignBit ) );
+		}
+	}
+
+	/** Adds to a 32 bit ones' complement sum, folding the carries back in */
+	constexpr std::uint32_t onesComplementAdd( std::uint32_t uiSum, std::uint64_t u64Value )
+	{
+		u64Value += uiSum;
+
+		while ( ( u64Value >> 32 ) != 0 )
+		{
+			u64Value = ( ( u64Value & 0xFFFFFFFF ) + ( u64Value >> 32 ) );
+		}
+
+		return static_cast< std::uint32_t >( u64Value );
+	}
+
+	/** Adds bytes, in file order, to a FITS checksum: the ones' complement sum of an HDU's big-endian 32 bit words.
+	 *  u64Offset is the position of the bytes within the header or data; it and szBytes must be even. The words are
+	 *  summed as 16 bit halves, so the loop vectorizes and a run of bytes may start or end half way through a word. */
+	std::uint32_t checksumAdd( std::uint32_t uiSum, const std::uint8_t* arcGen3Restrict pData, std::size_t szBytes, std::uint64_t u64Offset )
+	{
+		std::uint64_t u64Hi = 0;
+		std::uint64_t u64Lo = 0;
+
+		if ( ( u64Offset & 2 ) != 0 && szBytes >= 2 )
+		{
+			u64Lo += ( ( pData[ 0 ] << 8 ) | pData[ 1 ] );
+
+			pData += 2;
+
+			szBytes -= 2;
+		}
+
+		auto szWords = ( szBytes / 4 );
+
+		for ( std::size_t i = 0; i < szWords; i++ )
+		{
+			u64Hi += static_cast< std::uint32_t >( ( pData[ 4 * i ] << 8 ) | pData[ 4 * i + 1 ] );
+			u64Lo += static_cast< std::uint32_t >( ( pData[ 4 * i + 2 ] << 8 ) | pData[ 4 * i + 3 ] );
+		}
+
+		if ( ( szBytes & 2 ) != 0 )
+		{
+			u64Hi += ( ( pData[ 4 * szWords ] << 8 ) | pData[ 4 * szWords + 1 ] );
+		}
+
+		//
+		// Multiplying by 2^16 is exact in ones' complement arithmetic once the high halves are folded to 32 bits
+		//
+		return onesComplementAdd( onesComplementAdd( uiSum, u64Lo ), static_cast< std::uint64_t >( onesComplementAdd( 0, u64Hi ) ) << 16 );
+	}
+
+	/** Encodes the complement of an HDU sum as the 16 character CHECKSUM value, as defined by the FITS checksum
+	 *  convention: each byte is spread over four characters, avoiding punctuation, and the result rotated by one. */
+	std::string encodeChecksum( std::uint32_t uiSum )
+	{
+		constexpr std::uint8_t EXCLUDE[] = { 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F, 0x40, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F, 0x60 };
+
+		auto uiValue = ~uiSum;
+
+		char szEncoded[ 16 ];
+
+		for ( std::uint32_t uiByte = 0; uiByte < 4; uiByte++ )
+		{
+			std::int32_t iByte = static_cast< std::int32_t >( ( uiValue >> ( 24 - 8 * uiByte ) ) & 0xFF );
+
+			std::int32_t iChar[ 4 ] = { 0, 0, 0, 0 };
+
+			for ( auto& iValue : iChar )
+			{
+				iValue = ( iByte / 4 + '0' );
+			}
+
+			iChar[ 0 ] += ( iByte % 4 );
+
+			for ( bool bMoved = true; bMoved; )
+			{
+				bMoved = false;
+
+				for ( auto uExclude : EXCLUDE )
+				{
+					for ( std::uint32_t j = 0; j < 4; j += 2 )
+					{
+						if ( iChar[ j ] == uExclude || iChar[ j + 1 ] == uExclude )
+						{
+							iChar[ j ]++;
+							iChar[ j + 1 ]--;
+
+							bMoved = true;
+						}
+					}
+				}
+			}
+
+			for ( std::uint32_t j = 0; j < 4; j++ )
+			{
+				szEncoded[ 4 * j + uiByte ] = static_cast< char >( iChar[ j ] );
+			}
+		}
+
+		std::string sChecksum( 16, ' ' );
+
+		for ( std::uint32_t i = 0; i < 16; i++ )
+		{
+			sChecksum[ i ] = szEncoded[ ( i + 15 ) % 16 ];
+		}
+
+		return sChecksum;
+	}
+
+	/** Appends the CHECKSUM and DATASUM cards, holding the all zero values the header is summed with, and returns
+	 *  the offset of the CHECKSUM card */
+	std::size_t appendChecksumCards( std::string& sHeader, std::uint32_t uiDataSum = 0 )
+	{
+		auto szOffset = sHeader.size();
+
+		appendStringCard( sHeader, "CHECKSUM", "0000000000000000", "HDU checksum" );
+		appendStringCard( sHeader, "DATASUM", std::to_string( uiDataSum ), "data unit checksum" );
+
+		return szOffset;
+	}
+
+	/** Fills in the CHECKSUM and DATASUM cards of a complete header ( whole FITS blocks ), given the data sum */
+	void setChecksumCards( std::string& sHeader, std::size_t szOffset, std::uint32_t uiDataSum )
+	{
+		std::string sCards;
+
+		appendChecksumCards( sCards, uiDataSum );
+
+		sHeader.replace( szOffset, sCards.size(), sCards );
+
+		auto uiSum = checksumAdd( uiDataSum, reinterpret_cast< const std::uint8_t* >( sHeader.data() ), sHeader.size(), 0 );
+
+		sHeader.replace( szOffset + HEADER_VALUE_COL + 1, 16, encodeChecksum( uiSum ) );
+	}
+
+	/** Ends a header: appends the reserved blank cards, then END, and pads the header to whole FITS blocks. The blank
+	 *  cards go before END, as cfitsio writes them, so END is always in the last header block and the data unit starts
+	 *  in the block after it. */
+	void endHeader( std::string& sHeader, std::uint32_t uiReserved )
+	{
+		sHeader.append( static_cast< std::size_t >( uiReserved ) * HEADER_CARD, ' ' );
+
+		appendCard( sHeader, "END" );
+
+		sHeader.resize( static_cast< std::size_t >( fitsBlocks( sHeader.size() ) ), ' ' );
+	}
+
+	/** Builds a single image primary header exactly as fits_create_img() writes it, followed by the template keywords,
+	 *  the checksum cards, if any, and the template's reserved blank cards. szChecksumOffset receives the offset of the
+	 *  CHECKSUM card. */
+	template <typename T>
+	std::string imageHeader( std::uint32_t uiCols, std::uint32_t uiRows, const arc::gen3::fits::CHeaderTemplate* pHeader, bool bChecksum,
+							 std::size_t& szChecksumOffset )
+	{
+		std::string sHeader;
+
+		appendValueCard( sHeader, "SIMPLE", "T", "file does conform to FITS standard" );
+		appendValueCard( sHeader, "BITPIX", std::to_string( sizeof( T ) * 8 ), "number of bits per data pixel" );
+		appendValueCard( sHeader, "NAXIS", "2", "number of data axes" );
+		appendValueCard( sHeader, "NAXIS1", std::to_string( uiCols ), "length of data axis 1" );
+		appendValueCard( sHeader, "NAXIS2", std::to_string( uiRows ), "length of data axis 2" );
+		appendValueCard( sHeader, "EXTEND", "T", "FITS dataset may contain extensions" );
+		appendCard( sHeader, FITS_COMMENT_1 );
+		appendCard( sHeader, FITS_COMMENT_2 );
+		appendScalingCards<T>( sHeader );
+
+		std::uint32_t uiReserved = 0;
+
+		if ( pHeader != nullptr )
+		{
+			sHeader += pHeader->getCards();
+
+			uiReserved = pHeader->getReserved();
+		}
+
+		szChecksumOffset = ( bChecksum ? appendChecksumCards( sHeader ) : 0 );
+
+		endHeader( sHeader, uiReserved );
+
+		return sHeader;
+	}
+
+	/** Returns true if two existing directories are on the same file system, so that a file can be renamed from one to
+	 *  the other. On Windows the drive ( root name ) is compared, which misses mounted folders; a failed rename is still
+	 *  handled by the caller. */
+	bool sameFileSystem( const std::filesystem::path& tDir1, const std::filesystem::path& tDir2 )
+	{
+	#ifdef _WINDOWS
+		std::error_code tError1;
+		std::error_code tError2;
+
+		auto tRoot1 = std::filesystem::absolute( tDir1, tError1 ).root_name();
+		auto tRoot2 = std::filesystem::absolute( tDir2, tError2 ).root_name();
+
+		return ( !tError1 && !tError2 && tRoot1 == tRoot2 );
+	#else
+		struct stat tStat1;
+		struct stat tStat2;
+
+		return ( ::stat( tDir1.c_str(), &tStat1 ) == 0 && ::stat( tDir2.c_str(), &tStat2 ) == 0 && tStat1.st_dev == tStat2.st_dev );
+	#endif
+	}
+
+	/** Extends a file to a size, allocating its disk space where the file system supports it, so that later writes
+	 *  into that space cannot run out of room. Returns the error, if any. */
+	std::error_code preallocate( const std::filesystem::path& tFileName, std::uint64_t u64Bytes )
+	{
+	#ifndef _WINDOWS
+		auto iFd = ::open( tFileName.c_str(), O_WRONLY );
+
+		if ( iFd >= 0 )
+		{
+			auto iError = posix_fallocate( iFd, 0, static_cast< off_t >( u64Bytes ) );
+
+			::close( iFd );
+
+			if ( iError != EOPNOTSUPP && iError != EINVAL )
+			{
+				return std::error_code( iError, std::generic_category() );
+			}
+		}
+	#endif
+
+		std::error_code tError;
+
+		std::filesystem::resize_file( tFileName, u64Bytes, tError );
+
+		return tError;
+	}
+}
+
+
 
 namespace arc
 {
@@ -121,1584 +498,4665 @@ namespace arc
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Class constructor                                                                                       |
-		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> CArcFitsFile<T>::CArcFitsFile( void ) : CArcBase(), m_i64Pixel( 0 ), m_iFrame( 0 ), m_pFits( nullptr )
-		{
-		}
-
-
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  Class destructor                                                                                        |
+		// |  CHeaderTemplate Class constructor                                                                       |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> CArcFitsFile<T>::~CArcFitsFile( void )
-		{
-			//try
-			//{
-			//	close();
-			//}
-			//catch ( ... ) {}
-		}
-
-
-		template <typename T> std::string CArcFitsFile<T>::getType( void ) noexcept
+		fits::CHeaderTemplate::CHeaderTemplate( void ) : m_uiReserved( 0 )
 		{
-			return typeid( T ).name();
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  version                                                                                                 |
+		// |  CHeaderTemplate Class define                                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns a textual representation of the library version.                                                |
+		// |  Formats a new keyword card and appends it to the template. The card layout is fixed here: the keyword   |
+		// |  name in columns 1 - 8, "= " in columns 9 - 10 and a fixed width value field from column 11, followed    |
+		// |  by the comment. Numbers and logicals are right justified to column 30, as cfitsio writes them.          |
+		// |  COMMENT and HISTORY cards hold up to 70 characters of text from column 11.                              |
+		// |                                                                                                          |
+		// |  <IN> -> sKey     - The keyword. Ignored for COMMENT / HISTORY; DATE for FITS_DATE_KEY.                  |
+		// |  <IN> -> eType    - The keyword value type.                                                              |
+		// |  <IN> -> sComment - The keyword comment, or the COMMENT / HISTORY text.                                  |
+		// |  <IN> -> uiWidth  - The maximum string value length ( 0 = 18 ).                                          |
+		// |                                                                                                          |
+		// |  Returns the keyword slot.                                                                               |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> const std::string CArcFitsFile<T>::version( void ) noexcept
+		std::uint32_t fits::CHeaderTemplate::define( const std::string& sKey, const fits::e_Type eType, const std::string& sComment, const std::uint32_t uiWidth )
 		{
-			return m_sVersion;
-		}
+			const bool bText = ( eType == fits::e_Type::FITS_COMMENT_KEY || eType == fits::e_Type::FITS_HISTORY_KEY );
 
+			std::string sName = sKey;
 
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  version                                                                                                 |
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns a textual representation of the library version.                                                |
-		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> const std::string CArcFitsFile<T>::cfitsioVersion( void ) noexcept
-		{
-			float fVersion = 0.f;
+			std::uint32_t uiValueWidth = HEADER_NUMBER_WIDTH;
 
-			fits_get_version( &fVersion );
+			switch ( eType )
+			{
+				case fits::e_Type::FITS_STRING_KEY:
+				{
+					auto uiMaxWidth = ( uiWidth == 0 ? HEADER_STRING_WIDTH : uiWidth );
 
-			const std::string sVersion = CArcBase::formatString( "CFITSIO Library.                 [ Version: %f ]", fVersion );
+					if ( uiMaxWidth > ( HEADER_CARD - HEADER_VALUE_COL - 2 ) )
+					{
+						throwArcGen3InvalidArgument( "Invalid string width [ %u ] for keyword %s! Must be %u or less!", uiMaxWidth, sKey.c_str(),
+													 ( HEADER_CARD - HEADER_VALUE_COL - 2 ) );
+					}
 
-			return sVersion;
-		}
+					//
+					// The value is quoted and padded to at least 8 characters
+					//
+					uiValueWidth = std::max( HEADER_NUMBER_WIDTH, std::max( uiMaxWidth, 8u ) + 2 );
+				}
+				break;
 
+				case fits::e_Type::FITS_INT_KEY:
+				case fits::e_Type::FITS_UINT_KEY:
+				case fits::e_Type::FITS_SHORT_KEY:
+				case fits::e_Type::FITS_USHORT_KEY:
+				case fits::e_Type::FITS_FLOAT_KEY:
+				case fits::e_Type::FITS_DOUBLE_KEY:
+				case fits::e_Type::FITS_BYTE_KEY:
+				case fits::e_Type::FITS_LONG_KEY:
+				case fits::e_Type::FITS_ULONG_KEY:
+				case fits::e_Type::FITS_LONGLONG_KEY:
+				case fits::e_Type::FITS_LOGICAL_KEY:
+				{
+				}
+				break;
 
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  create                                                                                                  |
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  Creates a new single image file on disk with the specified image dimensions.                            |
-		// |                                                                                                          |
-		// |  <IN> -> tFileName - The new file name.                                                                  |
-		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
-		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error, std::invalid_argument                                                        |
-		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T>
-		void CArcFitsFile<T>::create( const std::filesystem::path& tFileName, const std::uint32_t uiCols, const std::uint32_t uiRows )
-		{
-			std::int32_t iImageType = ( ( sizeof( T ) == sizeof( std::uint16_t ) ) ? USHORT_IMG : ULONG_IMG );
+				case fits::e_Type::FITS_COMMENT_KEY:
+				case fits::e_Type::FITS_HISTORY_KEY:
+				{
+					sName = ( eType == fits::e_Type::FITS_COMMENT_KEY ? "COMMENT" : "HISTORY" );
 
-			long a_lNAxes[] = { static_cast< long >( uiCols ), static_cast< long >( uiRows ) };
+					uiValueWidth = ( HEADER_CARD - HEADER_VALUE_COL );
+				}
+				break;
 
-			std::int32_t iStatus = 0;
+				case fits::e_Type::FITS_DATE_KEY:
+				{
+					sName = "DATE";
 
-			if ( m_pFits != nullptr )
-			{
-				close();
+					// 'yyyy-mm-ddThh:mm:ss'
+					uiValueWidth = 21;
+				}
+				break;
+
+				default:
+				{
+					throwArcGen3InvalidArgument( "Invalid FITS keyword type. See CArcFitsFile.h for valid type list"s );
+				}
 			}
 
 			//
-			// Verify image dimensions
+			// Verify the keyword. The mandatory keywords are written by create() and writeDirect().
 			//
-			if ( uiRows == 0 )
+			if ( sName.empty() || sName.size() > 8 || sName.find_first_not_of( "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-_" ) != std::string::npos )
 			{
-				throwArcGen3InvalidArgument( "Row dimension must be greater than zero!"s );
+				throwArcGen3InvalidArgument( "Invalid FITS keyword \"%s\"! Must be 1 - 8 characters of A-Z, 0-9, '-' or '_'!", sName.c_str() );
 			}
 
-			if ( uiCols == 0 )
+			if ( sName == "SIMPLE" || sName == "BITPIX" || sName.compare( 0, 5, "NAXIS" ) == 0 || sName == "EXTEND" || sName == "BZERO" ||
+				 sName == "BSCALE" || sName == "XTENSION" || sName == "PCOUNT" || sName == "GCOUNT" || sName == "END" )
 			{
-				throwArcGen3InvalidArgument( "Column dimension must be greater than zero!"s );
+				throwArcGen3InvalidArgument( "Invalid FITS keyword \"%s\"! Mandatory keywords cannot be in a header template!", sName.c_str() );
 			}
 
-			//
-			// Verify filename
-			//
-			if ( tFileName.empty() )
-			{
-				throwArcGen3InvalidArgument( "Invalid file name : %s", tFileName.c_str() );
-			}
+			std::string sCard = sName;
 
-			//
-			// Delete the file if it exists. This is to prevent creation errors.
-			//
-			ArcRemove( tFileName.string() );
+			sCard.resize( 8, ' ' );
 
-			//
-			// Create the file ( force overwrite )
-			//
-			fits_create_file( &m_pFits, ( tFileName.string().insert( 0, 1, '!' ) ).c_str(), &iStatus );
+			sCard += ( bText ? "  " : "= " );
 
-			if ( iStatus )
-			{
-				close();
+			sCard.append( uiValueWidth, ' ' );
 
-				//
-				// Delete the file if it exists. This is to prevent creation errors.
-				//
-				ArcRemove( tFileName.string() );
+			if ( !bText && eType == fits::e_Type::FITS_DATE_KEY && sComment.empty() )
+			{
+				sCard += " / file creation date (YYYY-MM-DDThh:mm:ss UT)";
+			}
 
-				throwFitsError( iStatus );
+			else if ( !bText && !sComment.empty() )
+			{
+				sCard += " / " + sComment;
 			}
 
-			fits_create_img( m_pFits, iImageType, 2, a_lNAxes, &iStatus );
+			sCard.resize( HEADER_CARD, ' ' );
 
-			if ( iStatus )
-			{
-				close();
+			m_vTypes.push_back( eType );
 
-				//
-				// Delete the file if it exists. This is to prevent creation errors.
-				//
-				ArcRemove( tFileName.string() );
+			m_vValueCol.push_back( static_cast< std::uint32_t >( m_sCards.size() ) + HEADER_VALUE_COL );
 
-				throwFitsError( iStatus );
+			m_vValueWidth.push_back( uiValueWidth );
+
+			m_sCards += sCard;
+
+			auto uiSlot = static_cast< std::uint32_t >( m_vTypes.size() - 1 );
+
+			if ( bText )
+			{
+				setString( uiSlot, sComment );
 			}
 
-			m_i64Pixel = 0;
-			m_iFrame = 0;
+			return uiSlot;
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  create3D                                                                                                |
+		// |  CHeaderTemplate Class verifySlot                                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Creates a new data cube file on disk with the specified image dimensions.                               |
+		// |  Verifies that a slot exists and that its type can be bound by the caller.                               |
 		// |                                                                                                          |
-		// |  <IN> -> tFileName - The new file name.                                                                  |
-		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
-		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiSlot  - The slot returned by define().                                                        |
+		// |  <IN> -> fnValid - Returns true for the types that the caller can bind.                                  |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// |  Throws std::invalid_argument                                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T>
-		void CArcFitsFile<T>::create3D( const std::filesystem::path& tFileName, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename F>
+		void fits::CHeaderTemplate::verifySlot( const std::uint32_t uiSlot, F&& fnValid ) const
 		{
-			std::int32_t iImageType = ( ( sizeof( T ) == sizeof( std::uint16_t ) ) ? USHORT_IMG : ULONG_IMG );
-
-			long a_lNAxes[] = { static_cast< long >( uiCols ), static_cast< long >( uiRows ), 1 };		// cols, rows, nof
-
-			std::int32_t iStatus = 0;
-
-			if ( m_pFits != nullptr )
-			{
-				close();
-			}
-
-			//
-			// Verify image dimensions
-			//
-			if ( uiRows == 0 )
-			{
-				throwArcGen3InvalidArgument( "Row dimension must be greater than zero!"s );
-			}
-
-			if ( uiCols == 0 )
+			if ( uiSlot >= m_vTypes.size() )
 			{
-				throwArcGen3InvalidArgument( "Column dimension must be greater than zero!"s );
+				throwArcGen3InvalidArgument( "Invalid header template slot [ %u ]! Template has %u keywords!", uiSlot, getCount() );
 			}
 
-			//
-			// Verify filename
-			//
-			if ( tFileName.empty() )
+			if ( !fnValid( m_vTypes[ uiSlot ] ) )
 			{
-				throwArcGen3InvalidArgument( "Invalid file name : %s", tFileName.c_str() );
+				throwArcGen3InvalidArgument( "Invalid value type for header template slot [ %u ]!", uiSlot );
 			}
+		}
 
-			//
-			// Delete the file if it exists. This is to prevent creation errors.
-			//
-			ArcRemove( tFileName.string() );
 
-			//
-			// Create the file ( force overwrite )
-			//
-			fits_create_file( &m_pFits, ( tFileName.string().insert( 0, 1, '!' ) ).c_str(), &iStatus );
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CHeaderTemplate Class setValue                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Overwrites the value field of a card. Nothing else in the card changes.                                 |
+		// |                                                                                                          |
+		// |  <IN> -> uiSlot     - The slot returned by define().                                                     |
+		// |  <IN> -> sValue     - The formatted value.                                                               |
+		// |  <IN> -> bRightJust - true to right justify the value.                                                   |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		void fits::CHeaderTemplate::setValue( const std::uint32_t uiSlot, const std::string& sValue, const bool bRightJust )
+		{
+			auto uiValueWidth = m_vValueWidth[ uiSlot ];
 
-			if ( iStatus )
+			if ( sValue.size() > uiValueWidth )
 			{
-				close();
-
-				//
-				// Delete the file if it exists. This is to prevent creation errors.
-				//
-				ArcRemove( tFileName.string() );
-
-				throwFitsError( iStatus );
+				throwArcGen3InvalidArgument( "Value %s is too long for header template slot [ %u ]! Maximum length is %u characters!",
+											 sValue.c_str(), uiSlot, uiValueWidth );
 			}
 
-			fits_create_img( m_pFits, iImageType, 3, a_lNAxes, &iStatus );
-
-			if ( iStatus )
-			{
-				close();
+			auto uiPad = static_cast< std::uint32_t >( uiValueWidth - sValue.size() );
 
-				//
-				// Delete the file if it exists. This is to prevent creation errors.
-				//
-				ArcRemove( tFileName.string() );
+			auto pCard = m_sCards.begin() + m_vValueCol[ uiSlot ];
 
-				throwFitsError( iStatus );
-			}
+			std::fill( pCard, pCard + uiValueWidth, ' ' );
 
-			m_i64Pixel = 0;
-			m_iFrame = 0;
+			std::copy( sValue.begin(), sValue.end(), pCard + ( bRightJust ? uiPad : 0 ) );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  open                                                                                                    |
+		// |  CHeaderTemplate Class setString                                                                         |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Opens an existing file. Can be used to open a file containing a single image or data cube ( a file with |
-		// |  multiple image planes ).                                                                                |
+		// |  Binds a string, COMMENT, HISTORY or DATE value. String values are quoted, with embedded quotes doubled, |
+		// |  and padded to at least 8 characters.                                                                    |
 		// |                                                                                                          |
-		// |  <IN> -> tFileName - The file name.                                                                      |
-		// |  <IN> -> eMode - The mode ( read/write ) with which to open the file ( default = e_ReadMode::READMODE ). |
+		// |  <IN> -> uiSlot - The slot returned by define().                                                         |
+		// |  <IN> -> sValue - The value.                                                                             |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// |  Throws std::invalid_argument                                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcFitsFile<T>::open( const std::filesystem::path& tFileName, arc::gen3::fits::e_ReadMode eMode )
+		void fits::CHeaderTemplate::setString( const std::uint32_t uiSlot, const std::string& sValue )
 		{
-			std::int32_t iStatus = 0;
-			std::int32_t iExists = 0;
+			verifySlot( uiSlot, []( fits::e_Type eType )
+			{
+				return ( eType == fits::e_Type::FITS_STRING_KEY || eType == fits::e_Type::FITS_COMMENT_KEY ||
+						 eType == fits::e_Type::FITS_HISTORY_KEY || eType == fits::e_Type::FITS_DATE_KEY );
+			} );
 
-			if ( m_pFits != nullptr )
+			for ( auto c : sValue )
 			{
-				close();
+				if ( c < ' ' || c > '~' )
+				{
+					throwArcGen3InvalidArgument( "Invalid character in value for header template slot [ %u ]! Only printable ASCII is allowed!", uiSlot );
+				}
 			}
 
-			//
-			// Verify filename
-			//
-			if ( tFileName.empty() )
+			if ( m_vTypes[ uiSlot ] == fits::e_Type::FITS_COMMENT_KEY || m_vTypes[ uiSlot ] == fits::e_Type::FITS_HISTORY_KEY )
 			{
-				throwArcGen3InvalidArgument( "Invalid file name : %s", tFileName.c_str() );
+				setValue( uiSlot, sValue, false );
+
+				return;
 			}
 
-			//
-			// Make sure the specified file exists
-			//
-			fits_file_exists( tFileName.string().c_str(), &iExists, &iStatus);
+			std::string sQuoted = "'";
 
-			if ( iStatus )
+			for ( auto c : sValue )
 			{
-				m_pFits = nullptr;
+				sQuoted += c;
 
-				throwFitsError( iStatus );
+				if ( c == '\'' )
+				{
+					sQuoted += c;
+				}
 			}
 
-			//
-			// Open the FITS file
-			//
-			fits_open_file( &m_pFits, tFileName.string().c_str(), static_cast< int >( eMode ), &iStatus);
-
-			if ( iStatus )
+			if ( sQuoted.size() < 9 )
 			{
-				m_pFits = nullptr;
-
-				throwFitsError( iStatus );
+				sQuoted.resize( 9, ' ' );
 			}
 
-			m_i64Pixel = 0;
-			m_iFrame = 0;
+			setValue( uiSlot, sQuoted + "'", false );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  close                                                                                                   |
+		// |  CHeaderTemplate Class setInteger                                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Closes the file.                                                                                        |
+		// |  Binds an integer value.                                                                                 |
+		// |                                                                                                          |
+		// |  <IN> -> uiSlot   - The slot returned by define().                                                       |
+		// |  <IN> -> i64Value - The value.                                                                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T>
-		void CArcFitsFile<T>::close( void ) noexcept
+		void fits::CHeaderTemplate::setInteger( const std::uint32_t uiSlot, const std::int64_t i64Value )
 		{
-			//
-			//  DeleteBuffer requires access to the file, so don't close the file until
-			// after deleteBuffer has been called!!!
-			//
-			if ( m_pFits != nullptr )
+			verifySlot( uiSlot, []( fits::e_Type eType )
 			{
-				std::int32_t iStatus = 0;
+				return ( eType == fits::e_Type::FITS_INT_KEY || eType == fits::e_Type::FITS_UINT_KEY || eType == fits::e_Type::FITS_SHORT_KEY ||
+						 eType == fits::e_Type::FITS_USHORT_KEY || eType == fits::e_Type::FITS_BYTE_KEY || eType == fits::e_Type::FITS_LONG_KEY ||
+						 eType == fits::e_Type::FITS_ULONG_KEY || eType == fits::e_Type::FITS_LONGLONG_KEY );
+			} );
 
-				fits_close_file( m_pFits, &iStatus );
-			}
-
-			m_pFits = nullptr;
-
-			m_i64Pixel = 0;
-			m_iFrame = 0;
+			setValue( uiSlot, std::to_string( i64Value ), true );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getHeader                                                                                               |
+		// |  CHeaderTemplate Class setDouble                                                                         |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns the FITS header as a list of strings.                                                           |
+		// |  Binds a floating point value. Float keywords get 7 significant digits and double keywords 13, the most  |
+		// |  that always fit the 20 column value field. A decimal point is always written, as cfitsio does.          |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <IN> -> uiSlot - The slot returned by define().                                                         |
+		// |  <IN> -> gValue - The value.                                                                             |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<arc::gen3::CArcStringList> CArcFitsFile<T>::getHeader( void )
+		void fits::CHeaderTemplate::setDouble( const std::uint32_t uiSlot, const double gValue )
 		{
-			std::int32_t iNumOfKeys = 0;
-			std::int32_t iStatus = 0;
-
-			verifyFileHandle();
-
-			fits_get_hdrspace( m_pFits, &iNumOfKeys, nullptr, &iStatus );
+			verifySlot( uiSlot, []( fits::e_Type eType )
+			{
+				return ( eType == fits::e_Type::FITS_FLOAT_KEY || eType == fits::e_Type::FITS_DOUBLE_KEY );
+			} );
 
-			if ( iStatus )
+			if ( !std::isfinite( gValue ) )
 			{
-				throwFitsError( iStatus );
+				throwArcGen3InvalidArgument( "Invalid value for header template slot [ %u ]! FITS values must be finite!", uiSlot );
 			}
 
-			std::unique_ptr<arc::gen3::CArcStringList> pList( new arc::gen3::CArcStringList() );
+			char szValue[ 32 ];
 
-			std::string sCard( 100, ' ' );
+			std::snprintf( szValue, sizeof( szValue ), "%.*G", ( m_vTypes[ uiSlot ] == fits::e_Type::FITS_FLOAT_KEY ? 7 : 13 ), gValue );
 
-			for ( auto i = 0; i < iNumOfKeys; i++ )
-			{
-				fits_read_record( m_pFits, ( i + 1 ), const_cast< char* >( sCard.data() ), &iStatus );
+			std::string sValue = szValue;
 
-				if ( iStatus )
-				{
-					throwFitsError( iStatus );
-				}
+			if ( sValue.find( '.' ) == std::string::npos )
+			{
+				auto szExp = sValue.find( 'E' );
 
-				*( pList.get() ) << sCard.c_str();
+				sValue.insert( ( szExp == std::string::npos ? sValue.size() : szExp ), "." );
 			}
 
-			return pList;
+			setValue( uiSlot, sValue, true );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getFileName                                                                                             |
+		// |  CHeaderTemplate Class setLogical                                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns the filename associated with this CArcFitsFile object.                                          |
+		// |  Binds a logical value.                                                                                  |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <IN> -> uiSlot - The slot returned by define().                                                         |
+		// |  <IN> -> bValue - The value.                                                                             |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> const std::string CArcFitsFile<T>::getFileName( void )
+		void fits::CHeaderTemplate::setLogical( const std::uint32_t uiSlot, const bool bValue )
 		{
-			std::int32_t iStatus = 0;
-
-			std::string sFileName( 150, ' ' );
+			verifySlot( uiSlot, []( fits::e_Type eType )
+			{
+				return ( eType == fits::e_Type::FITS_LOGICAL_KEY );
+			} );
 
-			verifyFileHandle();
+			setValue( uiSlot, ( bValue ? "T" : "F" ), true );
+		}
 
-			fits_file_name( m_pFits, const_cast< char* >( sFileName.data() ), &iStatus );
 
-			if ( iStatus )
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CHeaderTemplate Class setDate                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Binds the current system date and time ( UTC ), in 'yyyy-mm-ddThh:mm:ss' format.                        |
+		// |                                                                                                          |
+		// |  <IN> -> uiSlot - The slot returned by define().                                                         |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		void fits::CHeaderTemplate::setDate( const std::uint32_t uiSlot )
+		{
+			verifySlot( uiSlot, []( fits::e_Type eType )
 			{
-				throwFitsError( iStatus );
-			}
+				return ( eType == fits::e_Type::FITS_DATE_KEY );
+			} );
 
-			return sFileName.c_str();
+			auto tNow = std::time( nullptr );
+
+			std::tm tUTC {};
+
+		#ifdef _WINDOWS
+			gmtime_s( &tUTC, &tNow );
+		#else
+			gmtime_r( &tNow, &tUTC );
+		#endif
+
+			char szDate[ 32 ];
+
+			std::strftime( szDate, sizeof( szDate ), "%Y-%m-%dT%H:%M:%S", &tUTC );
+
+			setString( uiSlot, szDate );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  readKeyword                                                                                             |
+		// |  CHeaderTemplate Class reserve                                                                           |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Reads a FITS keyword value from the header.  The keyword must be valid or an exception will be thrown.  |
+		// |  Sets the number of blank keyword cards to reserve for keywords added after the data is written.         |
 		// |                                                                                                          |
-		// |  <IN> -> sKey  - The header keyword. Can be "".  Ex: SIMPLE                                              |
-		// |  <IN> -> eType - The keyword type, as defined in CArcFitsFile.h                                          |
+		// |  <IN> -> uiCards - The number of keyword cards to reserve.                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		void fits::CHeaderTemplate::reserve( const std::uint32_t uiCards ) noexcept
+		{
+			m_uiReserved = uiCards;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CMappedImage Class constructor                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Maps the image data of a FITS file into memory, read only. The mapping starts at the page ( Windows:    |
+		// |  allocation granularity ) boundary below the data and covers every frame.                                |
+		// |                                                                                                          |
+		// |  <IN> -> tFileName - The FITS file name.                                                                 |
+		// |  <IN> -> u64Offset - The byte offset of the image data within the file.                                  |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiFrames  - The number of image frames ( 1 for a single image ).                                |
+		// |  <IN> -> tZero     - The BZERO value, as a pixel value ( modulo 2^bits ).                                |
 		// |                                                                                                          |
 		// |  Throws std::runtime_error, std::invalid_argument                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T>
-		arc::gen3::fits::keywordValue_t CArcFitsFile<T>::readKeyword( const std::string& sKey, arc::gen3::fits::e_Type eType )
+		fits::CMappedImage<T>::CMappedImage( const std::filesystem::path& tFileName, const std::uint64_t u64Offset, const std::uint32_t uiCols,
+											 const std::uint32_t uiRows, const std::uint32_t uiFrames, const T tZero )
+			: m_pMap( nullptr ), m_u64MapBytes( 0 ), m_pData( nullptr ), m_uiCols( uiCols ), m_uiRows( uiRows ), m_uiFrames( uiFrames ), m_tZero( tZero )
 		{
-			std::int32_t iType = static_cast< std::int32_t >( arc::gen3::fits::e_Type::FITS_INVALID_KEY );
+			if ( uiCols == 0 || uiRows == 0 || uiFrames == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid image size [ %u x %u x %u ]! All dimensions must be greater than zero!", uiCols, uiRows, uiFrames );
+			}
 
-			std::int32_t iStatus = 0;
+			auto u64Bytes = ( static_cast< std::uint64_t >( uiCols ) * uiRows * uiFrames * sizeof( T ) );
 
-			verifyFileHandle();
+		#ifdef _WINDOWS
 
-			arc::gen3::fits::keywordValue_t keyValue;
+			SYSTEM_INFO tInfo;
 
-			switch ( eType )
-			{
-				case arc::gen3::fits::e_Type::FITS_STRING_KEY:
-				{
-					constexpr auto iStrMax = 80;
+			GetSystemInfo( &tInfo );
 
-					iType = TSTRING;
+			std::uint64_t u64Granularity = tInfo.dwAllocationGranularity;
 
-					char szValue[ iStrMax ];
+		#else
 
-					arc::gen3::CArcBase::zeroMemory( szValue, static_cast< std::uint64_t >( sizeof( szValue ) ) );
+			auto u64Granularity = static_cast< std::uint64_t >( sysconf( _SC_PAGESIZE ) );
 
-					szValue[ iStrMax - 1 ] = '\0';
+		#endif
 
-					fits_read_key( m_pFits, iType, sKey.c_str(), szValue, NULL, &iStatus );
+			auto u64Start = ( u64Offset - ( u64Offset % u64Granularity ) );
 
-					#ifdef __cpp_lib_variant
-						keyValue = std::string( szValue );
-					#else
-						keyValue = std::make_tuple( 0, 0, 0, 0, 0.0, std::string( szValue ) );
-					#endif
-				}
-				break;
-
-				case arc::gen3::fits::e_Type::FITS_INT_KEY:
-				{
-					iType = TINT;
-
-					std::int32_t iValue = 0;
-
-					fits_read_key( m_pFits, iType, sKey.c_str(), &iValue, NULL, &iStatus );
-
-					#ifdef __cpp_lib_variant
-						keyValue = iValue;
-					#else
-						keyValue = std::make_tuple( 0, iValue, 0, 0, 0.0, std::string() );
-					#endif
-				}
-				break;
-
-				case arc::gen3::fits::e_Type::FITS_UINT_KEY:
-				{
-					iType = TUINT;
-
-					std::uint32_t uiValue = 0;
-
-					fits_read_key( m_pFits, iType, sKey.c_str(), &uiValue, NULL, &iStatus );
-
-					#ifdef __cpp_lib_variant
-						keyValue = uiValue;
-					#else
-						keyValue = std::make_tuple( uiValue, 0, 0, 0, 0.0, std::string() );
-					#endif
-				}
-				break;
-
-				case arc::gen3::fits::e_Type::FITS_SHORT_KEY:
-				{
-					iType = TSHORT;
-
-					std::int16_t wValue = 0;
+			m_u64MapBytes = ( u64Offset + u64Bytes - u64Start );
 
-					fits_read_key( m_pFits, iType, sKey.c_str(), &wValue, NULL, &iStatus );
+		#ifdef _WINDOWS
 
-					#ifdef __cpp_lib_variant
-						keyValue = static_cast< std::int32_t >( wValue );
-					#else
-						keyValue = std::make_tuple( 0, static_cast< std::int32_t >( wValue ), 0, 0, 0.0, std::string() );
-					#endif
-				}
-				break;
+			HANDLE hFile = CreateFileW( tFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
 
-				case arc::gen3::fits::e_Type::FITS_USHORT_KEY:
-				{
-					iType = TUSHORT;
+			if ( hFile == INVALID_HANDLE_VALUE )
+			{
+				throwArcGen3Error( "Failed to open file : %s", tFileName.string().c_str() );
+			}
 
-					std::uint16_t uwValue = 0;
+			LARGE_INTEGER tSize;
 
-					fits_read_key( m_pFits, iType, sKey.c_str(), &uwValue, NULL, &iStatus );
+			if ( !GetFileSizeEx( hFile, &tSize ) || static_cast< std::uint64_t >( tSize.QuadPart ) < ( u64Offset + u64Bytes ) )
+			{
+				CloseHandle( hFile );
 
-					#ifdef __cpp_lib_variant
-						keyValue = static_cast< std::uint32_t >( uwValue );
-					#else
-						keyValue = std::make_tuple( static_cast< std::uint32_t >( uwValue ), 0, 0, 0, 0.0, std::string() );
-					#endif
-				}
-				break;
+				throwArcGen3Error( "File is shorter than its image data : %s", tFileName.string().c_str() );
+			}
 
-				case arc::gen3::fits::e_Type::FITS_FLOAT_KEY:
-				{
-					iType = TFLOAT;
+			HANDLE hMapping = CreateFileMappingW( hFile, nullptr, PAGE_READONLY, 0, 0, nullptr );
 
-					float fValue = 0;
+			if ( hMapping != nullptr )
+			{
+				m_pMap = MapViewOfFile( hMapping, FILE_MAP_READ, static_cast< DWORD >( u64Start >> 32 ), static_cast< DWORD >( u64Start & 0xFFFFFFFF ),
+										static_cast< SIZE_T >( m_u64MapBytes ) );
 
-					fits_read_key( m_pFits, iType, sKey.c_str(), &fValue, NULL, &iStatus );
+				CloseHandle( hMapping );
+			}
 
-					#ifdef __cpp_lib_variant
-						keyValue = static_cast< double >( fValue );
-					#else
-						keyValue = std::make_tuple( 0, 0, 0, 0, static_cast< double >( fValue ), std::string() );
-					#endif
-				}
-				break;
+			CloseHandle( hFile );
 
-				case arc::gen3::fits::e_Type::FITS_DOUBLE_KEY:
-				{
-					iType = TDOUBLE;
+			if ( m_pMap == nullptr )
+			{
+				throwArcGen3Error( "Failed to map file : %s", tFileName.string().c_str() );
+			}
 
-					double gValue = 0;
+		#else
 
-					fits_read_key( m_pFits, iType, sKey.c_str(), &gValue, NULL, &iStatus );
+			auto iFd = ::open( tFileName.c_str(), O_RDONLY );
 
-					#ifdef __cpp_lib_variant
-						keyValue = gValue;
-					#else
-						keyValue = std::make_tuple( 0, 0, 0, 0, gValue, std::string() );
-					#endif
-				}
-				break;
+			if ( iFd < 0 )
+			{
+				throwArcGen3Error( "Failed to open file : %s [ %s ]", tFileName.c_str(), std::strerror( errno ) );
+			}
 
-				case arc::gen3::fits::e_Type::FITS_BYTE_KEY:
-				{
-					iType = TBYTE;
+			struct stat tStat;
 
-					std::int8_t iValue = 0;
+			if ( fstat( iFd, &tStat ) != 0 || static_cast< std::uint64_t >( tStat.st_size ) < ( u64Offset + u64Bytes ) )
+			{
+				::close( iFd );
 
-					fits_read_key( m_pFits, iType, sKey.c_str(), &iValue, NULL, &iStatus );
+				throwArcGen3Error( "File is shorter than its image data : %s", tFileName.c_str() );
+			}
 
-					#ifdef __cpp_lib_variant
-						keyValue = static_cast< std::uint32_t >( iValue );
-					#else
-						keyValue = std::make_tuple( 0, static_cast< std::uint32_t >( iValue ), 0, 0, 0.0, std::string() );
-					#endif
-				}
-				break;
+			auto pMap = ::mmap( nullptr, static_cast< std::size_t >( m_u64MapBytes ), PROT_READ, MAP_SHARED, iFd, static_cast< off_t >( u64Start ) );
 
-				case arc::gen3::fits::e_Type::FITS_LONG_KEY:
-				{
-					iType = TLONG;
+			::close( iFd );
 
-					std::int32_t iValue = 0;
+			if ( pMap == MAP_FAILED )
+			{
+				throwArcGen3Error( "Failed to map file : %s [ %s ]", tFileName.c_str(), std::strerror( errno ) );
+			}
 
-					fits_read_key( m_pFits, iType, sKey.c_str(), &iValue, NULL, &iStatus );
+			m_pMap = pMap;
 
-					#ifdef __cpp_lib_variant
-						keyValue = iValue;
-					#else
-						keyValue = std::make_tuple( 0, static_cast< std::int32_t >( iValue ), 0, 0, 0.0, std::string() );
-					#endif
-				}
-				break;
+		#endif
 
-				case arc::gen3::fits::e_Type::FITS_ULONG_KEY:
-				{
-					iType = TULONG;
+			m_pData = reinterpret_cast< const T* >( static_cast< const std::uint8_t* >( m_pMap ) + ( u64Offset - u64Start ) );
+		}
 
-					std::uint32_t uiValue = 0;
 
-					fits_read_key( m_pFits, iType, sKey.c_str(), &uiValue, NULL, &iStatus );
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CMappedImage Class destructor                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> fits::CMappedImage<T>::~CMappedImage( void )
+		{
+			if ( m_pMap != nullptr )
+			{
+			#ifdef _WINDOWS
+				UnmapViewOfFile( m_pMap );
+			#else
+				::munmap( m_pMap, static_cast< std::size_t >( m_u64MapBytes ) );
+			#endif
+			}
+		}
 
-					#ifdef __cpp_lib_variant
-						keyValue = uiValue;
-					#else
-						keyValue = std::make_tuple( uiValue, 0, 0, 0, 0.0, std::string() );
-					#endif
-				}
-				break;
 
-				case arc::gen3::fits::e_Type::FITS_LONGLONG_KEY:
-				{
-					iType = TLONGLONG;
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CMappedImage Class rawView                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns a view of one frame's pixels exactly as stored in the file: big-endian and offset by BZERO.     |
+		// |                                                                                                          |
+		// |  <IN> -> uiFrame - The frame number, starting at 0.                                                      |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> arc::gen3::CArcImageView<const T> fits::CMappedImage<T>::rawView( const std::uint32_t uiFrame ) const
+		{
+			if ( uiFrame >= m_uiFrames )
+			{
+				throwArcGen3InvalidArgument( "Invalid frame [ %u ]! Image has %u frame( s )!", uiFrame, m_uiFrames );
+			}
 
-					std::int64_t iValue = 0;
+			return arc::gen3::CArcImageView<const T>( m_pData + static_cast< std::size_t >( uiFrame ) * m_uiCols * m_uiRows, m_uiCols, m_uiRows );
+		}
 
-					fits_read_key( m_pFits, iType, sKey.c_str(), &iValue, NULL, &iStatus );
 
-					#ifdef __cpp_lib_variant
-						keyValue = iValue;
-					#else
-						keyValue = std::make_tuple( 0, 0, 0, iValue, 0.0, std::string() );
-					#endif
-				}
-				break;
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CMappedImage Class decode                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Converts a region of one frame to native pixel values in a caller buffer: each pixel is byte swapped    |
+		// |  ( on little-endian hosts ) and BZERO is added, modulo 2^bits. The loop vectorizes. Only the pages       |
+		// |  holding the region are read from disk.                                                                  |
+		// |                                                                                                          |
+		// |  <IN> -> cView   - The destination view. Its size is the size of the region.                             |
+		// |  <IN> -> uiCol   - The region start column.                                                              |
+		// |  <IN> -> uiRow   - The region start row.                                                                 |
+		// |  <IN> -> uiFrame - The frame number, starting at 0.                                                      |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void fits::CMappedImage<T>::decode( const arc::gen3::CArcImageView<T>& cView, const std::uint32_t uiCol, const std::uint32_t uiRow, const std::uint32_t uiFrame ) const
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )."s );
+			}
 
-				case arc::gen3::fits::e_Type::FITS_LOGICAL_KEY:
-				{
-					iType = TLOGICAL;
+			auto cRaw = rawView( uiFrame ).subView( uiCol, uiRow, cView.cols(), cView.rows() );
 
-					std::int32_t iValue = 0;
+			const T tZero = m_tZero;
 
-					fits_read_key( m_pFits, iType, sKey.c_str(), &iValue, NULL, &iStatus );
+			for ( std::uint32_t row = 0; row < cRaw.rows(); row++ )
+			{
+				const T* arcGen3Restrict pSrc = cRaw.row( row );
 
-					#ifdef __cpp_lib_variant
-						keyValue = iValue;
-					#else
-						keyValue = std::make_tuple( 0, iValue, 0, 0, 0.0, std::string() );
-					#endif
-				}
-				break;
+				T* arcGen3Restrict pDst = cView.row( row );
 
-				case arc::gen3::fits::e_Type::FITS_COMMENT_KEY:
-				case arc::gen3::fits::e_Type::FITS_HISTORY_KEY:
-				case arc::gen3::fits::e_Type::FITS_DATE_KEY:
+				for ( std::uint32_t col = 0; col < cRaw.cols(); col++ )
 				{
+					pDst[ col ] = static_cast< T >( bigEndian( pSrc[ col ] ) + tZero );
 				}
-				break;
+			}
+		}
 
-				default:
-				{
-					iType = static_cast< std::int32_t >( arc::gen3::fits::e_Type::FITS_INVALID_KEY );
 
-					throwArcGen3InvalidArgument( "Invalid FITS keyword type. See CArcFitsFile.h for valid type list"s );
-				}
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CMappedImage Class decode                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Converts one frame to native pixel values in a caller buffer.                                           |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf    - The destination buffer; must hold cols() x rows() pixels.                             |
+		// |  <IN> -> uiFrame - The frame number, starting at 0.                                                      |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void fits::CMappedImage<T>::decode( T* pBuf, const std::uint32_t uiFrame ) const
+		{
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid data buffer."s );
 			}
 
-			return keyValue;
+			decode( arc::gen3::CArcImageView<T>( pBuf, m_uiCols, m_uiRows ), 0, 0, uiFrame );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  writeKeyword                                                                                            |
+		// |  CCubeWriter Class constructor                                                                           |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Writes a FITS keyword to the header.  The keyword must be valid or an exception will be thrown.         |
-		// |                                                                                                          |
-		// |  'HIERARCH' keyword NOTE: This text will be prefixed to any keyword by the cfitsio library if the        |
-		// |                           keyword is greater than 8 characters, which is the standard FITS keyword       |
-		// |                           length. See the link below for details:                                        |
-		// |                                                                                                          |
-		// |   http://heasarc.gsfc.nasa.gov/docs/software/fitsio/c/f_user/node28.html                                 |
-		// |                                                                                                          |
-		// |   HIERARCH examples:                                                                                     |
-		// |   -----------------                                                                                      |
-		// |   HIERARCH LongKeyword = 47.5 / Keyword has > 8 characters & mixed case                                  |
-		// |   HIERARCH XTE$TEMP = 98.6 / Keyword contains the '$' character                                          |
-		// |   HIERARCH Earth is a star = F / Keyword contains embedded spaces                                        |
+		// |  Creates a data cube file. The header matches what fits_create_img() writes for a cube, with NAXIS3 set  |
+		// |  to the expected frame count, and the data space for that many frames is allocated on disk up front.     |
 		// |                                                                                                          |
-		// |  <IN> -> sKey     - The header keyword. Can be "".  Ex: SIMPLE                                           |
-		// |  <IN> -> pvalue   - The value associated with the key. Ex: T                                             |
-		// |  <IN> -> eType    - The keyword type, as defined in CArcFitsFile.h                                       |
-		// |  <IN> -> sComment - The comment to attach to the keyword.  Can be "".                                    |
+		// |  <IN> -> tFileName        - The file name. An existing file is replaced.                                 |
+		// |  <IN> -> uiCols           - The frame column size ( in pixels ).                                         |
+		// |  <IN> -> uiRows           - The frame row size ( in pixels ).                                            |
+		// |  <IN> -> uiExpectedFrames - The number of frames to preallocate space for.                               |
+		// |  <IN> -> pHeader          - Optional keywords to add to the header. May be nullptr.                      |
+		// |  <IN> -> bChecksum        - true to add CHECKSUM and DATASUM keywords.                                   |
 		// |                                                                                                          |
 		// |  Throws std::runtime_error, std::invalid_argument                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T>
-		void CArcFitsFile<T>::writeKeyword( const std::string& sKey, void* pValue, arc::gen3::fits::e_Type eType, const std::string& sComment )
+		fits::CCubeWriter<T>::CCubeWriter( const std::filesystem::path& tFileName, const std::uint32_t uiCols, const std::uint32_t uiRows,
+										   const std::uint32_t uiExpectedFrames, const fits::CHeaderTemplate* pHeader, const bool bChecksum )
+			: m_tFileName( tFileName ), m_uiCols( uiCols ), m_uiRows( uiRows ), m_uiFrames( 0 ), m_uiCapacity( uiExpectedFrames ),
+			  m_u64HeaderBytes( 0 ), m_u64Naxis3Offset( 0 ), m_u64ChecksumOffset( 0 ), m_uiDataSum( 0 )
 		{
-			std::int32_t iType = static_cast< std::int32_t >( arc::gen3::fits::e_Type::FITS_INVALID_KEY );
-			std::int32_t iStatus = 0;
-
-			verifyFileHandle();
+			if ( uiCols == 0 || uiRows == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid image size [ %u x %u ]! Both dimensions must be greater than zero!", uiCols, uiRows );
+			}
 
-			//
-			// Verify value pointer
-			//
-			if ( eType != arc::gen3::fits::e_Type::FITS_DATE_KEY && pValue == nullptr )
+			if ( uiExpectedFrames == 0 )
 			{
-				throwArcGen3InvalidArgument( "Invalid FITS key value, cannot be nullptr"s );
+				throwArcGen3InvalidArgument( "Invalid expected frame count! Must be greater than zero!"s );
 			}
 
-			//
-			// Update the fits header with the specified keys
-			//
-			switch ( eType )
+			if ( tFileName.empty() )
 			{
-				case arc::gen3::fits::e_Type::FITS_STRING_KEY:
-				{
-					iType = TSTRING;
-				}
-				break;
+				throwArcGen3InvalidArgument( "Invalid file name : %s", tFileName.string().c_str() );
+			}
 
-				case arc::gen3::fits::e_Type::FITS_INT_KEY:
-				{
-					iType = TINT;
-				}
-				break;
+			std::string sHeader;
 
-				case arc::gen3::fits::e_Type::FITS_UINT_KEY:
-				{
-					iType = TUINT;
-				}
-				break;
+			appendValueCard( sHeader, "SIMPLE", "T", "file does conform to FITS standard" );
+			appendValueCard( sHeader, "BITPIX", std::to_string( sizeof( T ) * 8 ), "number of bits per data pixel" );
+			appendValueCard( sHeader, "NAXIS", "3", "number of data axes" );
+			appendValueCard( sHeader, "NAXIS1", std::to_string( uiCols ), "length of data axis 1" );
+			appendValueCard( sHeader, "NAXIS2", std::to_string( uiRows ), "length of data axis 2" );
 
-				case arc::gen3::fits::e_Type::FITS_SHORT_KEY:
-				{
-					iType = TSHORT;
-				}
-				break;
+			m_u64Naxis3Offset = sHeader.size();
 
-				case arc::gen3::fits::e_Type::FITS_USHORT_KEY:
-				{
-					iType = TUSHORT;
-				}
-				break;
+			appendValueCard( sHeader, "NAXIS3", std::to_string( uiExpectedFrames ), "length of data axis 3" );
+			appendValueCard( sHeader, "EXTEND", "T", "FITS dataset may contain extensions" );
+			appendCard( sHeader, FITS_COMMENT_1 );
+			appendCard( sHeader, FITS_COMMENT_2 );
+			appendScalingCards<T>( sHeader );
 
-				case arc::gen3::fits::e_Type::FITS_FLOAT_KEY:
-				{
-					iType = TFLOAT;
-				}
-				break;
+			std::uint32_t uiReserved = 0;
 
-				case arc::gen3::fits::e_Type::FITS_DOUBLE_KEY:
-				{
-					iType = TDOUBLE;
-				}
-				break;
+			if ( pHeader != nullptr )
+			{
+				sHeader += pHeader->getCards();
 
-				case arc::gen3::fits::e_Type::FITS_BYTE_KEY:
-				{
-					iType = TBYTE;
-				}
-				break;
+				uiReserved = pHeader->getReserved();
+			}
 
-				case arc::gen3::fits::e_Type::FITS_LONG_KEY:
-				{
-					iType = TLONG;
-				}
-				break;
+			if ( bChecksum )
+			{
+				m_u64ChecksumOffset = appendChecksumCards( sHeader );
+			}
 
-				case arc::gen3::fits::e_Type::FITS_ULONG_KEY:
-				{
-					iType = TULONG;
-				}
-				break;
+			endHeader( sHeader, uiReserved );
 
-				case arc::gen3::fits::e_Type::FITS_LONGLONG_KEY:
-				{
-					iType = TLONGLONG;
-				}
-				break;
+			m_u64HeaderBytes = sHeader.size();
 
-				case arc::gen3::fits::e_Type::FITS_LOGICAL_KEY:
-				{
-					iType = TLOGICAL;
-				}
-				break;
+			m_tFile.open( tFileName, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc );
 
-				case arc::gen3::fits::e_Type::FITS_COMMENT_KEY:
-				case arc::gen3::fits::e_Type::FITS_HISTORY_KEY:
-				case arc::gen3::fits::e_Type::FITS_DATE_KEY:
-				{
-				}
-				break;
+			if ( !m_tFile )
+			{
+				throwArcGen3Error( "Failed to create file : %s", tFileName.string().c_str() );
+			}
 
-				default:
-				{
-					iType = static_cast< std::int32_t >( arc::gen3::fits::e_Type::FITS_INVALID_KEY );
+			m_tFile.write( sHeader.data(), static_cast< std::streamsize >( sHeader.size() ) );
 
-					throwArcGen3InvalidArgument( "Invalid FITS keyword type. See CArcFitsFile.h for valid type list"s );
-				}
-			}
+			m_tFile.flush();
 
-			//
-			// write ( append ) a COMMENT keyword to the header. The comment
-			// string will be continued over multiple keywords if it is
-			// longer than 70 characters. 
-			//
-			if ( eType == arc::gen3::fits::e_Type::FITS_COMMENT_KEY )
-			{
-				fits_write_comment( m_pFits, static_cast< char* >( pValue ), &iStatus );
-			}
+			auto tError = preallocate( tFileName, m_u64HeaderBytes + fitsBlocks( static_cast< std::uint64_t >( m_uiCapacity ) * uiCols * uiRows * sizeof( T ) ) );
 
-			//
-			// write ( append ) a HISTORY keyword to the header. The history
-			// string will be continued over multiple keywords if it is
-			// longer than 70 characters. 
-			//
-			else if ( eType == arc::gen3::fits::e_Type::FITS_HISTORY_KEY )
+			if ( !m_tFile || tError )
 			{
-				fits_write_history( m_pFits, static_cast< char* >( pValue ), &iStatus );
-			}
+				m_tFile.close();
 
-			//
-			// write the DATE keyword to the header. The keyword value will contain
-			// the current system date as a character string in 'yyyy-mm-ddThh:mm:ss'
-			// format. If a DATE keyword already exists in the header, then this
-			// routine will simply update the keyword value with the current date.
-			//
-			else if ( eType == arc::gen3::fits::e_Type::FITS_DATE_KEY )
-			{
-				fits_write_date( m_pFits, &iStatus );
+				ArcRemove( tFileName.string() );
+
+				throwArcGen3Error( "Failed to write file : %s [ %s ]", tFileName.string().c_str(), tError.message().c_str() );
 			}
 
-			//
-			// write a keyword of the appropriate data type into the header
-			//
-			else
+			m_vStaging.resize( static_cast< std::size_t >( uiCols ) * uiRows );
+
+			m_sHeader = std::move( sHeader );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CCubeWriter Class destructor                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> fits::CCubeWriter<T>::~CCubeWriter( void )
+		{
+			try
 			{
-				fits_update_key( m_pFits, iType, sKey.c_str(), pValue, ( sComment == "" ? nullptr : sComment.c_str() ), &iStatus );
+				close();
 			}
-
-			if ( iStatus )
+			catch ( ... )
 			{
-				throwFitsError( iStatus );
 			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  updateKeyword                                                                                           |
+		// |  CCubeWriter Class write                                                                                 |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Updates an existing FITS header keyword.  The keyword must be valid or an exception will be thrown.     |
-		// |                                                                                                          |
-		// |  'HIERARCH' keyword NOTE: This text will be prefixed to any keyword by the cfitsio library if the        |
-		// |                           keyword is greater than 8 characters, which is the standard FITS keyword       |
-		// |                           length. See the link below for details:                                        |
-		// |   http://heasarc.gsfc.nasa.gov/docs/software/fitsio/c/f_user/node28.html                                 |
-		// |                                                                                                          |
-		// |   HIERARCH examples:                                                                                     |
-		// |   -----------------                                                                                      |
-		// |   HIERARCH LongKeyword = 47.5 / Keyword has > 8 characters & mixed case                                  |
-		// |   HIERARCH XTE$TEMP = 98.6 / Keyword contains the '$' character                                          |
-		// |   HIERARCH Earth is a star = F / Keyword contains embedded spaces                                        |
+		// |  Converts a frame and writes it at its offset in the file. When the preallocated space is used up, it    |
+		// |  is doubled, so the number of allocations grows with the log of the frame count. With checksums          |
+		// |  enabled, the converted frame is added to the data sum while it is still in the cache.                   |
 		// |                                                                                                          |
-		// |  <IN> -> sKey     - The header keyword. Can be nullptr. Ex: SIMPLE                                       |
-		// |  <IN> -> pKey     - The value associated with the key. Ex: T                                             |
-		// |  <IN> -> iType    - The keyword type, as defined in CArcFitsFile.h                                       |
-		// |  <IN> -> sComment - The comment to attach to the keyword.  Can be nullptr.                               |
+		// |  <IN> -> pBuf - Pointer to the frame.                                                                    |
 		// |                                                                                                          |
 		// |  Throws std::runtime_error, std::invalid_argument                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T>
-		void CArcFitsFile<T>::updateKeyword( const std::string& sKey, void* pKey, arc::gen3::fits::e_Type eType, const std::string& sComment )
+		template <typename T> void fits::CCubeWriter<T>::write( const T* pBuf )
 		{
-			writeKeyword( sKey, pKey, eType, sComment );
+			if ( !m_tFile.is_open() )
+			{
+				throwArcGen3Error( "Invalid data cube file! File is closed!"s );
+			}
+
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid data buffer."s );
+			}
+
+			auto u64FrameBytes = ( static_cast< std::uint64_t >( m_vStaging.size() ) * sizeof( T ) );
+
+			if ( m_uiFrames == m_uiCapacity )
+			{
+				if ( m_uiCapacity > ( UINT32_MAX / 2 ) )
+				{
+					throwArcGen3Error( "Data cube is full [ %u frames ]!", m_uiCapacity );
+				}
+
+				m_tFile.flush();
+
+				auto tError = preallocate( m_tFileName, m_u64HeaderBytes + fitsBlocks( 2ULL * m_uiCapacity * u64FrameBytes ) );
+
+				if ( tError )
+				{
+					throwArcGen3Error( "Failed to extend file : %s [ %s ]", m_tFileName.string().c_str(), tError.message().c_str() );
+				}
+
+				m_uiCapacity *= 2;
+			}
+
+			encodePixels( pBuf, m_vStaging.data(), m_vStaging.size() );
+
+			m_tFile.seekp( static_cast< std::streamoff >( m_u64HeaderBytes + m_uiFrames * u64FrameBytes ) );
+
+			m_tFile.write( reinterpret_cast< const char* >( m_vStaging.data() ), static_cast< std::streamsize >( u64FrameBytes ) );
+
+			if ( !m_tFile )
+			{
+				m_tFile.clear();
+
+				throwArcGen3Error( "Failed to write frame %u to file : %s", ( m_uiFrames + 1 ), m_tFileName.string().c_str() );
+			}
+
+			if ( m_u64ChecksumOffset != 0 )
+			{
+				m_uiDataSum = checksumAdd( m_uiDataSum, reinterpret_cast< const std::uint8_t* >( m_vStaging.data() ), static_cast< std::size_t >( u64FrameBytes ),
+										   m_uiFrames * u64FrameBytes );
+			}
+
+			m_uiFrames++;
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getParameters                                                                                           |
+		// |  CCubeWriter Class close                                                                                 |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns a pointer to an arc::gen3::fits::CParam class that contains all the image parameters, such as   |
-		// |  number of cols, rows, frames, dimensions and bits-per-pixel. May return nullptr.                        |
+		// |  Rewrites the header with the number of frames written in NAXIS3, and the checksums if enabled, and      |
+		// |  trims the file to those frames. The trimmed space past the last frame is zero, so it is already the     |
+		// |  FITS data padding; zeros add nothing to the data sum.                                                   |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Throws std::runtime_error                                                                               |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<arc::gen3::fits::CParam> CArcFitsFile<T>::getParameters( void )
+		template <typename T> void fits::CCubeWriter<T>::close( void )
 		{
-			std::int32_t iStatus = 0;
+			if ( !m_tFile.is_open() )
+			{
+				return;
+			}
 
-			verifyFileHandle();
+			std::string sCard;
 
-			std::unique_ptr<arc::gen3::fits::CParam> pParam( new arc::gen3::fits::CParam() );
+			appendValueCard( sCard, "NAXIS3", std::to_string( m_uiFrames ), "length of data axis 3" );
 
-			if ( pParam == nullptr )
+			m_sHeader.replace( static_cast< std::size_t >( m_u64Naxis3Offset ), sCard.size(), sCard );
+
+			if ( m_u64ChecksumOffset != 0 )
 			{
-				throwArcGen3Error( "Failed to create parameters structure!"s );
+				setChecksumCards( m_sHeader, static_cast< std::size_t >( m_u64ChecksumOffset ), m_uiDataSum );
 			}
 
-			//
-			// Get the image parameters
-			//
-			fits_get_img_param( m_pFits, 3, &pParam->m_iBpp, &pParam->m_iNAxis, pParam->m_lNAxes, &iStatus );
+			m_tFile.seekp( 0 );
 
-			if ( iStatus )
+			m_tFile.write( m_sHeader.data(), static_cast< std::streamsize >( m_sHeader.size() ) );
+
+			m_tFile.close();
+
+			auto bFailed = m_tFile.fail();
+
+			std::error_code tError;
+
+			std::filesystem::resize_file( m_tFileName,
+										  m_u64HeaderBytes + fitsBlocks( static_cast< std::uint64_t >( m_uiFrames ) * m_vStaging.size() * sizeof( T ) ),
+										  tError );
+
+			if ( bFailed || tError )
 			{
-				throwFitsError( iStatus );
+				throwArcGen3Error( "Failed to close file : %s [ %s ]", m_tFileName.string().c_str(), tError.message().c_str() );
 			}
-
-			return pParam;
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getNumberOfFrames                                                                                       |
+		// |  CTileCache Class constructor                                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns the number of frames.  A single image file will return a value of 0.                            |
+		// |  Sizes the tile grid and the cache for an open single image file. Nothing is read until the first        |
+		// |  sub-image read.                                                                                         |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <IN> -> cFile           - An open single image file.                                                    |
+		// |  <IN> -> uiTileSize      - The tile column and row size ( in pixels ).                                   |
+		// |  <IN> -> u64MemoryBudget - The maximum bytes of tile data to keep.                                       |
+		// |  <IN> -> bReadAhead      - true to load the tiles bordering each read on a background thread.            |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::uint32_t CArcFitsFile<T>::getNumberOfFrames( void )
+		template <typename T>
+		fits::CTileCache<T>::CTileCache( CArcFitsFile<T>& cFile, const std::uint32_t uiTileSize, const std::uint64_t u64MemoryBudget, const bool bReadAhead )
+			: m_cFile( cFile ), m_uiCols( 0 ), m_uiRows( 0 ), m_uiTileSize( uiTileSize ), m_uiTileCols( 0 ), m_uiTileRows( 0 ), m_szMaxTiles( 1 ),
+			  m_u64Hits( 0 ), m_u64Misses( 0 ), m_bStop( false )
 		{
-			return static_cast< std::uint32_t >( getParameters()->getFrames() );
+			if ( uiTileSize == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid tile size! Must be greater than zero!"s );
+			}
+
+			auto pParam = cFile.getParameters();
+
+			if ( pParam->getNAxis() != 2 )
+			{
+				throwArcGen3InvalidArgument( "Invalid NAXIS value. A tile cache is only valid for a file containing a single image."s );
+			}
+
+			m_uiCols = pParam->getCols();
+			m_uiRows = pParam->getRows();
+
+			m_uiTileCols = static_cast< std::uint32_t >( ( static_cast< std::uint64_t >( m_uiCols ) + uiTileSize - 1 ) / uiTileSize );
+			m_uiTileRows = static_cast< std::uint32_t >( ( static_cast< std::uint64_t >( m_uiRows ) + uiTileSize - 1 ) / uiTileSize );
+
+			auto u64TileBytes = ( static_cast< std::uint64_t >( uiTileSize ) * uiTileSize * sizeof( T ) );
+
+			m_szMaxTiles = static_cast< std::size_t >( std::max<std::uint64_t>( 1, u64MemoryBudget / u64TileBytes ) );
+
+			if ( bReadAhead )
+			{
+				m_tReadAhead = std::thread( &CTileCache::runReadAhead, this );
+			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getRows                                                                                                 |
+		// |  CTileCache Class destructor                                                                             |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns the number of rows in the image.                                                                |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Stops the read-ahead thread. A tile being read is finished first.                                       |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::uint32_t CArcFitsFile<T>::getRows( void )
+		template <typename T> fits::CTileCache<T>::~CTileCache( void )
 		{
-			return static_cast< std::uint32_t >( getParameters()->getRows() );
+			{
+				std::lock_guard<std::mutex> tLock( m_mutex );
+
+				m_bStop = true;
+			}
+
+			m_cvReadAhead.notify_all();
+
+			if ( m_tReadAhead.joinable() )
+			{
+				m_tReadAhead.join();
+			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getCols																							      |
+		// |  CTileCache Class read                                                                                   |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns the number of columns in the image.                                                             |
+		// |  Reads a sub-image into an image view, one overlapping tile at a time. Each tile is copied row by row    |
+		// |  into its part of the view. With read-ahead enabled, the tiles bordering the sub-image are then queued.  |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <IN> -> cView - The image view that receives the sub-image. Its size is the size of the sub-image.      |
+		// |  <IN> -> uiCol - The sub-image start column.                                                             |
+		// |  <IN> -> uiRow - The sub-image start row.                                                                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::uint32_t CArcFitsFile<T>::getCols( void )
+		template <typename T>
+		void fits::CTileCache<T>::read( const arc::gen3::CArcImageView<T>& cView, const std::uint32_t uiCol, const std::uint32_t uiRow )
 		{
-			return static_cast< std::uint32_t >( getParameters()->getCols() );
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )."s );
+			}
+
+			if ( uiCol >= m_uiCols || uiRow >= m_uiRows || cView.cols() > ( m_uiCols - uiCol ) || cView.rows() > ( m_uiRows - uiRow ) )
+			{
+				throwArcGen3InvalidArgument( "Sub-image [ %u x %u ] at [ %u, %u ] is outside the image [ %u x %u ]!",
+											 cView.cols(), cView.rows(), uiCol, uiRow, m_uiCols, m_uiRows );
+			}
+
+			auto uiLastCol = ( uiCol + cView.cols() );
+			auto uiLastRow = ( uiRow + cView.rows() );
+
+			auto uiFirstTileCol = ( uiCol / m_uiTileSize );
+			auto uiLastTileCol = ( ( uiLastCol - 1 ) / m_uiTileSize );
+			auto uiFirstTileRow = ( uiRow / m_uiTileSize );
+			auto uiLastTileRow = ( ( uiLastRow - 1 ) / m_uiTileSize );
+
+			for ( auto uiTileRow = uiFirstTileRow; uiTileRow <= uiLastTileRow; uiTileRow++ )
+			{
+				for ( auto uiTileCol = uiFirstTileCol; uiTileCol <= uiLastTileCol; uiTileCol++ )
+				{
+					auto pTile = getTile( uiTileCol, uiTileRow );
+
+					auto uiTileX = ( uiTileCol * m_uiTileSize );
+					auto uiTileY = ( uiTileRow * m_uiTileSize );
+					auto uiTileWidth = std::min( m_uiTileSize, m_uiCols - uiTileX );
+
+					//
+					// The part of the tile inside the sub-image
+					//
+					auto uiStartCol = std::max( uiCol, uiTileX );
+					auto uiEndCol = std::min( uiLastCol, uiTileX + uiTileWidth );
+					auto uiStartRow = std::max( uiRow, uiTileY );
+					auto uiEndRow = std::min( uiLastRow, uiTileY + std::min( m_uiTileSize, m_uiRows - uiTileY ) );
+
+					for ( auto row = uiStartRow; row < uiEndRow; row++ )
+					{
+						std::copy_n( pTile->data() + static_cast< std::size_t >( row - uiTileY ) * uiTileWidth + ( uiStartCol - uiTileX ),
+									 ( uiEndCol - uiStartCol ),
+									 cView.row( row - uiRow ) + ( uiStartCol - uiCol ) );
+					}
+				}
+			}
+
+			if ( m_tReadAhead.joinable() )
+			{
+				queueReadAhead( uiFirstTileCol, uiLastTileCol, uiFirstTileRow, uiLastTileRow );
+			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getNAxis                                                                                                |
+		// |  CTileCache Class read                                                                                   |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns the number of dimensions in the image.                                                          |
+		// |  Reads a sub-image into a caller buffer. The points match CArcFitsFile::readSubImage().                  |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <IN> -> pBuf            - The destination buffer; must hold the sub-image pixels.                       |
+		// |  <IN> -> lowerLeftPoint  - The lower left point { col, row } of the sub-image.                           |
+		// |  <IN> -> upperRightPoint - The upper right point { col, row } of the sub-image.                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::uint32_t CArcFitsFile<T>::getNAxis( void )
+		template <typename T>
+		void fits::CTileCache<T>::read( T* pBuf, const fits::Point& lowerLeftPoint, const fits::Point& upperRightPoint )
 		{
-			return static_cast< std::uint32_t >( getParameters()->getNAxis() );
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid data buffer."s );
+			}
+
+			if ( lowerLeftPoint.first < 0 || lowerLeftPoint.first > upperRightPoint.first || upperRightPoint.first >= static_cast< long >( m_uiCols ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid sub-image COLUMN parameters!"s );
+			}
+
+			if ( lowerLeftPoint.second < 0 || lowerLeftPoint.second > upperRightPoint.second || upperRightPoint.second >= static_cast< long >( m_uiRows ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid sub-image ROW parameters!"s );
+			}
+
+			read( arc::gen3::CArcImageView<T>( pBuf,
+											   static_cast< std::uint32_t >( upperRightPoint.first - lowerLeftPoint.first + 1 ),
+											   static_cast< std::uint32_t >( upperRightPoint.second - lowerLeftPoint.second + 1 ) ),
+				  static_cast< std::uint32_t >( lowerLeftPoint.first ),
+				  static_cast< std::uint32_t >( lowerLeftPoint.second ) );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getBitsPerPixel                                                                                         |
+		// |  CTileCache Class clear                                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns the image bits-per-pixel value.                                                                 |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Removes all tiles from the cache and cancels any pending read-ahead. A tile still being copied by a     |
+		// |  read stays alive until the copy is done.                                                                |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::uint32_t CArcFitsFile<T>::getBitsPerPixel( void )
+		template <typename T> void fits::CTileCache<T>::clear( void )
 		{
-			return static_cast< std::uint32_t >( getParameters()->getBpp() );
+			std::lock_guard<std::mutex> tLock( m_mutex );
+
+			m_dReadAhead.clear();
+			m_mTiles.clear();
+			m_lTiles.clear();
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  generateTestData                                                                                        |
+		// |  CTileCache Class getTileCount                                                                           |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Generates a ramp test pattern image within the file. The size of the image is determined by the image   |
-		// |  dimensions supplied during the create() method call.This method is only valid for single image files.   |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		template <typename T> std::uint32_t fits::CTileCache<T>::getTileCount( void ) const
+		{
+			std::lock_guard<std::mutex> tLock( m_mutex );
+
+			return static_cast< std::uint32_t >( m_lTiles.size() );
+		}
+
+
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcFitsFile<T>::generateTestData( void )
+		// |  CTileCache Class getHits                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint64_t fits::CTileCache<T>::getHits( void ) const
 		{
-			std::size_t  iNElements = 0;
-			std::int64_t i64FPixel  = 1;
-			std::int32_t iStatus    = 0;
+			std::lock_guard<std::mutex> tLock( m_mutex );
 
-			verifyFileHandle();
+			return m_u64Hits;
+		}
 
-			auto pParam = getParameters();
 
-			if ( pParam->getNAxis() > 2 )
-			{
-				throwArcGen3Error( "This method only supports single 2-D image files."s );
-			}
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CTileCache Class getMisses                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint64_t fits::CTileCache<T>::getMisses( void ) const
+		{
+			std::lock_guard<std::mutex> tLock( m_mutex );
 
-			//
-			// Set number of pixels to write
-			//
-			iNElements = static_cast< std::size_t >( pParam->getCols() ) * static_cast< std::size_t >( pParam->getRows() );
+			return m_u64Misses;
+		}
 
-			std::unique_ptr<T[]> pBuf( new T[ iNElements ] );
 
-			T uiValue = 0;
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CTileCache Class getTile                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns a tile. A cached tile is moved to the front of the least recently used list; any other tile is  |
+		// |  read from the file.                                                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> uiTileCol - The tile column number.                                                             |
+		// |  <IN> -> uiTileRow - The tile row number.                                                                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		typename fits::CTileCache<T>::tile_t fits::CTileCache<T>::getTile( const std::uint32_t uiTileCol, const std::uint32_t uiTileRow )
+		{
+			auto u64Key = ( static_cast< std::uint64_t >( uiTileRow ) * m_uiTileCols + uiTileCol );
 
-			for ( std::size_t i = 0; i < iNElements; i++ )
 			{
-				pBuf.get()[ i ] = uiValue;
+				std::lock_guard<std::mutex> tLock( m_mutex );
 
-				uiValue++;
+				auto it = m_mTiles.find( u64Key );
 
-				if ( uiValue >= maxTVal() )
+				if ( it != m_mTiles.end() )
 				{
-					uiValue = 0;
-				}
-			}
+					m_lTiles.splice( m_lTiles.begin(), m_lTiles, it->second );
 
-			fits_write_img( m_pFits,
-							( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
-							i64FPixel,
-							static_cast<LONGLONG>( iNElements ),
-							pBuf.get(),
-							&iStatus );
+					m_u64Hits++;
 
-			if ( iStatus )
-			{
-				throwFitsError( iStatus );
+					return it->second->second;
+				}
+
+				m_u64Misses++;
 			}
+
+			return loadTile( u64Key );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  reOpen                                                                                                  |
+		// |  CTileCache Class loadTile                                                                               |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Effectively closes and re-opens the underlying disk file.                                               |
+		// |  Reads a tile from the file and caches it. File reads are serialized, so the cache is checked again once |
+		// |  the file is free, in case the read-ahead thread has just read the same tile. m_fileMutex is always      |
+		// |  taken before m_mutex.                                                                                   |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <IN> -> u64Key - The tile key.                                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcFitsFile<T>::reOpen( void )
+		template <typename T>
+		typename fits::CTileCache<T>::tile_t fits::CTileCache<T>::loadTile( const std::uint64_t u64Key )
 		{
-			std::int32_t	iStatus = 0;
-			std::int32_t	iIOMode = 0;
+			std::lock_guard<std::mutex> tFileLock( m_fileMutex );
 
-			std::string sFilename = getFileName();
+			{
+				std::lock_guard<std::mutex> tLock( m_mutex );
 
-			fits_file_mode( m_pFits, &iIOMode, &iStatus );
+				auto it = m_mTiles.find( u64Key );
 
-			if ( iStatus )
-			{
-				throwFitsError( iStatus );
+				if ( it != m_mTiles.end() )
+				{
+					return it->second->second;
+				}
 			}
 
-			close();
+			auto uiTileX = static_cast< std::uint32_t >( u64Key % m_uiTileCols ) * m_uiTileSize;
+			auto uiTileY = static_cast< std::uint32_t >( u64Key / m_uiTileCols ) * m_uiTileSize;
 
-			fits_open_file( &m_pFits, sFilename.c_str(), iIOMode, &iStatus );
+			auto uiTileWidth = std::min( m_uiTileSize, m_uiCols - uiTileX );
+			auto uiTileHeight = std::min( m_uiTileSize, m_uiRows - uiTileY );
 
-			if ( iStatus )
-			{
-				close();
+			auto pPixels = std::make_shared<std::vector<T>>( static_cast< std::size_t >( uiTileWidth ) * uiTileHeight );
 
-				throwFitsError( iStatus );
-			}
+			m_cFile.readSubImage( arc::gen3::CArcImageView<T>( pPixels->data(), uiTileWidth, uiTileHeight ), uiTileX, uiTileY );
+
+			std::lock_guard<std::mutex> tLock( m_mutex );
+
+			return insertTile( u64Key, std::move( pPixels ) );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  flush                                                                                                   |
+		// |  CTileCache Class insertTile                                                                             |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Causes all internal data buffers to write data to the disk file.                                        |
+		// |  Adds a tile to the front of the least recently used list and evicts tiles from the back until the       |
+		// |  cache is within its budget. The caller must hold m_mutex.                                               |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <IN> -> u64Key - The tile key.                                                                          |
+		// |  <IN> -> pTile  - The tile pixels.                                                                       |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcFitsFile<T>::flush( void )
+		template <typename T>
+		typename fits::CTileCache<T>::tile_t fits::CTileCache<T>::insertTile( const std::uint64_t u64Key, tile_t pTile )
 		{
-			std::int32_t iStatus = 0;
+			auto it = m_mTiles.find( u64Key );
 
-			verifyFileHandle();
+			if ( it != m_mTiles.end() )
+			{
+				return it->second->second;
+			}
 
-			fits_flush_file( m_pFits, &iStatus );
+			m_lTiles.emplace_front( u64Key, std::move( pTile ) );
 
-			if ( iStatus )
+			m_mTiles.emplace( u64Key, m_lTiles.begin() );
+
+			while ( m_lTiles.size() > m_szMaxTiles )
 			{
-				throwFitsError( iStatus );
+				m_mTiles.erase( m_lTiles.back().first );
+
+				m_lTiles.pop_back();
 			}
+
+			return m_lTiles.front().second;
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  compare ( Single Images )                                                                               |
+		// |  CTileCache Class queueReadAhead                                                                         |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Compares this file image data to another. This method does not check headers, except for size values.   |
+		// |  Queues the uncached tiles in the ring around a tile range, replacing any earlier queue, since the       |
+		// |  latest read is the best guess of what comes next. No more tiles are queued than the budget has room     |
+		// |  for beside the range itself, so read-ahead never evicts the tiles just read.                            |
 		// |                                                                                                          |
-		// |  <IN> - > cFitsFile - Reference to FITS file to compare.	                                              |
+		// |  <IN> -> uiFirstCol - The first tile column of the range.                                                |
+		// |  <IN> -> uiLastCol  - The last tile column of the range.                                                 |
+		// |  <IN> -> uiFirstRow - The first tile row of the range.                                                   |
+		// |  <IN> -> uiLastRow  - The last tile row of the range.                                                    |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcFitsFile<T>::compare( CArcFitsFile<T>& cFitsFile )
+		template <typename T>
+		void fits::CTileCache<T>::queueReadAhead( const std::uint32_t uiFirstCol, const std::uint32_t uiLastCol, const std::uint32_t uiFirstRow, const std::uint32_t uiLastRow )
 		{
-			auto pParam = cFitsFile.getParameters();
+			auto szRange = ( static_cast< std::size_t >( uiLastCol - uiFirstCol + 1 ) * ( uiLastRow - uiFirstRow + 1 ) );
 
-			auto pThisParams = getParameters();
+			auto szRoom = ( m_szMaxTiles > szRange ? ( m_szMaxTiles - szRange ) : 0 );
 
-			//
-			//  Verify file dimensions
-			//
-			if ( pThisParams->getNAxis() != pParam->getNAxis() )
 			{
-				throwArcGen3Error( "Comparison file dimensions DO NOT match! This: %u Passed: %u.", pThisParams->getNAxis(), pParam->getNAxis() );
-			}
+				std::lock_guard<std::mutex> tLock( m_mutex );
 
-			//
-			//  Verify image dimensions
-			//
-			if ( ( pThisParams->getCols() != pParam->getCols() ) || ( pThisParams->getRows() != pParam->getRows() ) )
-			{
-				throwArcGen3Error( "Image dimensions of comparison files DO NOT match! This: %ux%u Passed: %ux%u.",
-									pThisParams->getCols(),
-									pThisParams->getRows(),
-									pParam->getCols(),
-									pParam->getRows() );
-			}
+				m_dReadAhead.clear();
 
-			if ( pThisParams->getBpp() != pParam->getBpp() )
-			{
-				throwArcGen3Error( "Image bits-per-pixel of comparison files DO NOT match! This: %u Passed: %u.",
-									pThisParams->getBpp(),
-									pParam->getBpp() );
-			}
+				auto uiStartCol = ( uiFirstCol > 0 ? ( uiFirstCol - 1 ) : uiFirstCol );
+				auto uiEndCol = std::min( uiLastCol + 1, m_uiTileCols - 1 );
+				auto uiStartRow = ( uiFirstRow > 0 ? ( uiFirstRow - 1 ) : uiFirstRow );
+				auto uiEndRow = std::min( uiLastRow + 1, m_uiTileRows - 1 );
 
-			//
-			//  Read input file image buffer
-			//
-			auto pBuf = cFitsFile.read();
+				for ( auto uiTileRow = uiStartRow; uiTileRow <= uiEndRow && m_dReadAhead.size() < szRoom; uiTileRow++ )
+				{
+					for ( auto uiTileCol = uiStartCol; uiTileCol <= uiEndCol && m_dReadAhead.size() < szRoom; uiTileCol++ )
+					{
+						if ( uiTileCol >= uiFirstCol && uiTileCol <= uiLastCol && uiTileRow >= uiFirstRow && uiTileRow <= uiLastRow )
+						{
+							continue;
+						}
 
-			if ( pBuf.get() == nullptr )
-			{
-				throwArcGen3Error( "Failed to read passed FITS file image data!"s );
-			}
+						auto u64Key = ( static_cast< std::uint64_t >( uiTileRow ) * m_uiTileCols + uiTileCol );
 
-			//
-			//  Read this file image buffer
-			//
-			auto pThisBuf = read();
+						if ( m_mTiles.find( u64Key ) == m_mTiles.end() )
+						{
+							m_dReadAhead.push_back( u64Key );
+						}
+					}
+				}
 
-			if ( pThisBuf.get() == nullptr )
-			{
-				throwArcGen3Error( "Failed to read this FITS file image data!"s );
+				if ( m_dReadAhead.empty() )
+				{
+					return;
+				}
 			}
 
-			//
-			//  compare image buffers
-			//
-			for ( std::uint32_t r = 0; r < pThisParams->getRows(); r++ )
+			m_cvReadAhead.notify_one();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CTileCache Class runReadAhead                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Read-ahead thread. Loads queued tiles one at a time until stopped. Read-ahead is only a hint, so a      |
+		// |  failed read is dropped; the same error is thrown by the sub-image read that needs the tile.             |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void fits::CTileCache<T>::runReadAhead( void )
+		{
+			while ( true )
 			{
-				for ( std::uint32_t c = 0; c < pThisParams->getCols(); c++ )
+				std::uint64_t u64Key = 0;
+
 				{
-					auto uIndex = c + r * pThisParams->getCols();
+					std::unique_lock<std::mutex> tLock( m_mutex );
 
-					if ( pThisBuf.get()[ uIndex ] != pBuf.get()[ uIndex ] )
+					m_cvReadAhead.wait( tLock, [ this ] { return ( m_bStop || !m_dReadAhead.empty() ); } );
+
+					if ( m_bStop )
 					{
-						throwArcGen3Error( "Images do not match at col: %u, row: %u, this: %u, passed: %u",
-											c,
-											r,
-											pThisBuf.get()[ uIndex ],
-											pBuf.get()[ uIndex ] );
+						return;
 					}
+
+					u64Key = m_dReadAhead.front();
+
+					m_dReadAhead.pop_front();
+				}
+
+				try
+				{
+					loadTile( u64Key );
+				}
+				catch ( ... )
+				{
 				}
 			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  reSize ( Single Image )                                                                                 |
+		// |  CFilePool Class constructor                                                                             |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Resizes a single image file by modifying the NAXES keyword and increasing the image data portion of     |
-		// |  the file.                                                                                               |
+		// |  Builds the header skeleton, sizes the pool files and starts the creator thread.                         |
 		// |                                                                                                          |
-		// |  <IN> -> uiCols - The number of image columns the new file will have.                                    |
-		// |  <IN> -> uiRows - The number of image rows the new file will have.                                       |
+		// |  <IN> -> tDirectory - The directory the output files will be written to.                                 |
+		// |  <IN> -> uiCols     - The expected image column size ( in pixels ).                                      |
+		// |  <IN> -> uiRows     - The expected image row size ( in pixels ).                                         |
+		// |  <IN> -> uiCount    - The number of files to keep ready.                                                 |
+		// |  <IN> -> pHeader    - The header template write() will be called with. May be nullptr.                   |
+		// |  <IN> -> bChecksum  - true if write() will add CHECKSUM and DATASUM keywords.                            |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// |  Throws std::invalid_argument                                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcFitsFile<T>::reSize( const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		fits::CFilePool<T>::CFilePool( const std::filesystem::path& tDirectory, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiCount,
+									   const fits::CHeaderTemplate* pHeader, const bool bChecksum )
+			: m_tDirectory( tDirectory ), m_u64FileBytes( 0 ), m_uiCount( uiCount ), m_bChecksum( bChecksum ), m_u64Misses( 0 ), m_bFailed( false ),
+			  m_bStop( false )
 		{
-			std::int32_t  iStatus = 0;
+			if ( uiCols == 0 || uiRows == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid image size [ %u x %u ]! Both dimensions must be greater than zero!", uiCols, uiRows );
+			}
 
-			verifyFileHandle();
+			if ( uiCount == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid pool size! Must be greater than zero!"s );
+			}
 
-			auto pParam = getParameters();
+			std::error_code tError;
 
-			//
-			// Verify NAXIS parameter
-			//
-			if ( pParam->getNAxis() != 2 )
+			if ( !std::filesystem::is_directory( tDirectory, tError ) )
 			{
-				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+				throwArcGen3InvalidArgument( "Invalid pool directory : %s", tDirectory.string().c_str() );
 			}
 
-			*pParam->m_plCols = uiCols;
-			*pParam->m_plRows = uiRows;
+			std::size_t szChecksumOffset = 0;
 
-			fits_resize_img( m_pFits, pParam->m_iBpp, pParam->m_iNAxis, pParam->m_lNAxes, &iStatus );
+			m_sHeader = imageHeader<T>( uiCols, uiRows, pHeader, bChecksum, szChecksumOffset );
 
-			if ( iStatus )
+			m_u64FileBytes = ( m_sHeader.size() + fitsBlocks( static_cast< std::uint64_t >( uiCols ) * uiRows * sizeof( T ) ) );
+
+			m_tCreator = std::thread( &CFilePool::run, this );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CFilePool Class destructor                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Stops the creator thread, letting it finish the file it is creating, and removes the unused files.      |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> fits::CFilePool<T>::~CFilePool( void )
+		{
 			{
-				throwFitsError( iStatus );
+				std::lock_guard<std::mutex> tLock( m_mutex );
+
+				m_bStop = true;
+			}
+
+			m_cvRefill.notify_all();
+
+			m_tCreator.join();
+
+			for ( const auto& tFile : m_dReady )
+			{
+				std::error_code tError;
+
+				std::filesystem::remove( tFile, tError );
 			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  write ( Single Image )                                                                                  |
+		// |  CFilePool Class write                                                                                   |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Writes image data to a single image file.                                                               |
+		// |  Writes a single image file through a ready pool file: the file is overwritten in place by writeDirect() |
+		// |  and then renamed to the final name, which replaces any existing file atomically. The creator thread is  |
+		// |  woken to replace the file taken. With no file ready, or a final name on another file system, the image  |
+		// |  is written straight to the final name. A failed rename also falls back to a direct write; the pool file |
+		// |  is only removed once the image is safely in the final file, as it may hold the only copy.               |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf - Pointer to the image data.                                                               |
+		// |  <IN> -> tFileName - The file name. An existing file is replaced.                                        |
+		// |  <IN> -> pBuf      - Pointer to the image data.                                                          |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> pHeader   - Optional keywords to add to the header. May be nullptr.                             |
 		// |                                                                                                          |
 		// |  Throws std::runtime_error, std::invalid_argument                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcFitsFile<T>::write( T* pBuf )
+		template <typename T>
+		void fits::CFilePool<T>::write( const std::filesystem::path& tFileName, const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows,
+										const fits::CHeaderTemplate* pHeader )
 		{
-			std::int64_t i64NElements = 0;
-			std::int64_t i64FPixel = 1;
-			std::int32_t iStatus = 0;
-
-			verifyFileHandle();
-
 			//
-			// Verify buffer pointer
+			// Verify the arguments before a pool file is used up
 			//
 			if ( pBuf == nullptr )
 			{
 				throwArcGen3InvalidArgument( "Invalid data buffer."s );
 			}
 
-			//
-			// Verify parameters
-			//
-			auto pParam = getParameters();
-
-			if ( pParam->getNAxis() != 2 )
+			if ( uiCols == 0 || uiRows == 0 )
 			{
-				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+				throwArcGen3InvalidArgument( "Invalid image size [ %u x %u ]! Both dimensions must be greater than zero!", uiCols, uiRows );
 			}
 
-			//
-			// Set number of pixels to write
-			//
-			i64NElements = ( static_cast<std::int64_t>( pParam->getCols() ) * static_cast< std::int64_t >( pParam->getRows() ) );
-
-			//
-			// Write image data
-			//
-			fits_write_img( m_pFits,
-							( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
-							i64FPixel,
-							i64NElements,
-							pBuf,
-							&iStatus );
-
-			if ( iStatus )
+			if ( tFileName.empty() )
 			{
-				throwFitsError( iStatus );
+				throwArcGen3InvalidArgument( "Invalid file name : %s", tFileName.string().c_str() );
 			}
 
 			//
-			// Force data flush for more real-time performance
+			// A pool file can only be renamed within its own file system; route other targets around the pool
 			//
-			fits_flush_file( m_pFits, &iStatus );
-
-			if ( iStatus )
+			if ( !sameFileSystem( m_tDirectory, ( tFileName.has_parent_path() ? tFileName.parent_path() : std::filesystem::path( "." ) ) ) )
 			{
-				throwFitsError( iStatus );
-			}
-		}
+				CArcFitsFile<T>::writeDirect( tFileName, pBuf, uiCols, uiRows, pHeader, false, m_bChecksum );
 
+				return;
+			}
 
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  write ( Single Image )                                                                                  |
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  Writes the specified number of bytes to a single image file. The start position of the data within the  |
-		// |  file image can be specified.                                                                            |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf		- Pointer to the data to write.                                                       |
-		// |  <IN> -> i64Bytes  - The number of bytes to write.                                                       |
-		// |  <IN> -> i64Pixel  - The start pixel within the file image. This parameter is optional. If -1, then the  |
-		// |                      next write position will be at zero.                                                |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error, std::invalid_argument                                                        |
-		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcFitsFile<T>::write( T* pBuf, const std::int64_t i64Bytes, const std::int64_t i64Pixel )
-		{
-			std::int64_t i64NElements = 0;
-			std::int32_t iStatus = 0;
-
-			bool bMultiWrite = false;
+			std::filesystem::path tPoolFile;
 
-			verifyFileHandle();
+			{
+				std::lock_guard<std::mutex> tLock( m_mutex );
 
-			auto pParam = getParameters();
+				if ( m_dReady.empty() )
+				{
+					m_u64Misses++;
+				}
+				else
+				{
+					tPoolFile = m_dReady.front();
 
-			//
-			// Verify parameters
-			//
-			if ( pParam->getNAxis() != 2 )
-			{
-				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
-			}
+					m_dReady.pop_front();
+				}
 
-			if ( pBuf == nullptr )
-			{
-				throwArcGen3InvalidArgument( "Invalid data buffer."s );
+				m_bFailed = false;
 			}
 
-			if ( i64Pixel >= static_cast< std::int64_t >( pParam->getCols() ) * static_cast< std::int64_t >( pParam->getRows() ) )
-			{
-				throwArcGen3InvalidArgument( "Invalid start position, pixel position outside image size."s );
-			}
+			m_cvRefill.notify_one();
 
-			//
-			// Set the start pixel ( position ) within the file.
-			//
-			if ( i64Pixel < 0 && m_i64Pixel == 0 )
+			if ( tPoolFile.empty() )
 			{
-				m_i64Pixel = 1;
+				CArcFitsFile<T>::writeDirect( tFileName, pBuf, uiCols, uiRows, pHeader, false, m_bChecksum );
 
-				bMultiWrite = true;
+				return;
 			}
 
-			else if ( i64Pixel == 0 && m_i64Pixel != 0 )
-			{
-				m_i64Pixel = 1;
-
-				bMultiWrite = true;
-			}
+			std::error_code tError;
 
-			else if ( i64Pixel < 0 && m_i64Pixel != 0 )
+			try
 			{
-				bMultiWrite = true;
+				CArcFitsFile<T>::writeDirect( tPoolFile, pBuf, uiCols, uiRows, pHeader, false, m_bChecksum );
 			}
-
-			else
+			catch ( ... )
 			{
-				m_i64Pixel = i64Pixel + 1;
+				std::filesystem::remove( tPoolFile, tError );
 
-				bMultiWrite = false;
+				throw;
 			}
 
-			//
-			// Verify the start position
-			//
-			if ( m_i64Pixel >= static_cast< std::int64_t >( pParam->getCols() ) * static_cast< std::int64_t >( pParam->getRows() ) )
+			std::filesystem::rename( tPoolFile, tFileName, tError );
+
+			if ( tError )
 			{
-				throwArcGen3Error( "Invalid start position, pixel position outside image size."s );
-			}
+				//
+				// The pool file holds the written image; keep it until the image is in the final file
+				//
+				try
+				{
+					CArcFitsFile<T>::writeDirect( tFileName, pBuf, uiCols, uiRows, pHeader, false, m_bChecksum );
+				}
+				catch ( const std::exception& e )
+				{
+					throwArcGen3Error( "Failed to rename file : %s to %s [ %s ] or to write it directly [ %s ]! The image is kept in %s",
+									   tPoolFile.string().c_str(), tFileName.string().c_str(), tError.message().c_str(), e.what(), tPoolFile.string().c_str() );
+				}
 
-			//
-			// Number of pixels to write
-			//
-			i64NElements = i64Bytes / static_cast<std::int64_t>( sizeof( T ) );
+				std::filesystem::remove( tPoolFile, tError );
+			}
+		}
 
-			fits_write_img( m_pFits,
-							( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
-							static_cast< LONGLONG >( m_i64Pixel ),
-							static_cast< LONGLONG >( i64NElements ),
-							pBuf,
-							&iStatus );
 
-			if ( iStatus )
-			{
-				throwFitsError( iStatus );
-			}
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CFilePool Class getReadyCount                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint32_t fits::CFilePool<T>::getReadyCount( void ) const
+		{
+			std::lock_guard<std::mutex> tLock( m_mutex );
 
-			if ( bMultiWrite )
-			{
-				m_i64Pixel += i64NElements;
-			}
+			return static_cast< std::uint32_t >( m_dReady.size() );
+		}
 
-			//
-			// Force data flush for more real-time performance
-			//
-			fits_flush_file( m_pFits, &iStatus );
 
-			if ( iStatus )
-			{
-				throwFitsError( iStatus );
-			}
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  CFilePool Class getMissCount                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint64_t fits::CFilePool<T>::getMissCount( void ) const
+		{
+			std::lock_guard<std::mutex> tLock( m_mutex );
 
+			return m_u64Misses;
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  writeSubImage ( Single Image )                                                                          |
+		// |  CFilePool Class run                                                                                     |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Writes a sub-image of the specified buffer to a single image file.                                      |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf	          - The pixel data.                                                               |
-		// |  <IN> -> lowerLeftPoint  - The lower left point { col, row } of the sub-image.                           |
-		// |  <IN> -> upperRightPoint - The upper right point { col, row } of the sub-image.                          |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// |  Creator thread. Creates hidden pool files, each named by process id and a serial number so that pools   |
+		// |  sharing a directory never collide, until the pool is full. Each file gets the header skeleton and is    |
+		// |  preallocated to the expected size. A failed file is removed, and no more are tried until the next       |
+		// |  write(), so a full disk does not spin this thread.                                                      |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T>
-		void CArcFitsFile<T>::writeSubImage( T* pBuf, const arc::gen3::fits::Point& lowerLeftPoint, const arc::gen3::fits::Point& upperRightPoint )
+		template <typename T> void fits::CFilePool<T>::run( void )
 		{
-			std::int32_t iStatus = 0;
-
-			verifyFileHandle();
+			static std::atomic<std::uint64_t> u64Serial( 0 );
 
-			auto pParam = getParameters();
+		#ifdef _WINDOWS
+			auto uiProcess = static_cast< std::uint64_t >( GetCurrentProcessId() );
+		#else
+			auto uiProcess = static_cast< std::uint64_t >( getpid() );
+		#endif
 
-			//
-			// Verify parameters
-			//
-			if ( pParam->getNAxis() != 2 )
+			while ( true )
 			{
-				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
-			}
+				{
+					std::unique_lock<std::mutex> tLock( m_mutex );
 
-			if ( lowerLeftPoint.second > upperRightPoint.second )
-			{
-				throwArcGen3InvalidArgument( "Invalid LOWER LEFT ROW parameter!"s );
-			}
+					m_cvRefill.wait( tLock, [ this ] { return ( m_bStop || ( !m_bFailed && m_dReady.size() < m_uiCount ) ); } );
 
-			if ( lowerLeftPoint.first > upperRightPoint.first )
-			{
-				throwArcGen3InvalidArgument( "Invalid LOWER LEFT COLUMN parameter!"s );
-			}
+					if ( m_bStop )
+					{
+						return;
+					}
+				}
 
-			if ( lowerLeftPoint.second < 0 || lowerLeftPoint.second >= static_cast< long >( pParam->getRows() ) )
-			{
-				throwArcGen3InvalidArgument( "Invalid LOWER LEFT ROW parameter!"s );
-			}
+				auto tFile = ( m_tDirectory / ( ".arcpool-"s + std::to_string( uiProcess ) + "-" + std::to_string( u64Serial++ ) + ".fits" ) );
 
-			if ( upperRightPoint.second < 0 || upperRightPoint.second >= static_cast< long >( pParam->getRows() ) )
-			{
-				throwArcGen3InvalidArgument( "Invalid UPPER RIGHT ROW parameter!"s );
-			}
+				bool bCreated = false;
 
-			if ( lowerLeftPoint.first < 0 || lowerLeftPoint.first >= static_cast< long >( pParam->getCols() ) )
-			{
-				throwArcGen3InvalidArgument( "Invalid LOWER LEFT COLUMN parameter!"s );
-			}
+				{
+					std::ofstream tStream( tFile, std::ios::binary | std::ios::trunc );
 
-			if ( upperRightPoint.first < 0 || upperRightPoint.first >= static_cast< long >( pParam->getCols() ) )
-			{
-				throwArcGen3InvalidArgument( "Invalid UPPER RIGHT COLUMN parameter!"s );
-			}
+					tStream.write( m_sHeader.data(), static_cast< std::streamsize >( m_sHeader.size() ) );
 
-			if ( pBuf == nullptr )
-			{
-				throwArcGen3InvalidArgument( "Invalid data buffer."s );
-			}
+					tStream.close();
 
-			//
-			// Set the subset start pixels
-			//
-			long lFirstPixel[] = { lowerLeftPoint.first + 1, lowerLeftPoint.second + 1 };
-			long lLastPixel[] = { upperRightPoint.first + 1, upperRightPoint.second + 1 };
+					bCreated = ( !tStream.fail() && !preallocate( tFile, m_u64FileBytes ) );
+				}
 
-			fits_write_subset( m_pFits,
-							   ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
-							   lFirstPixel,
-							   lLastPixel,
-							   pBuf,
-							   &iStatus );
+				if ( !bCreated )
+				{
+					std::error_code tError;
 
-			if ( iStatus )
-			{
-				throwFitsError( iStatus );
-			}
+					std::filesystem::remove( tFile, tError );
+				}
 
-			//
-			// Force data flush for more real-time performance
-			//
-			fits_flush_file( m_pFits, &iStatus );
+				std::lock_guard<std::mutex> tLock( m_mutex );
 
-			if ( iStatus )
-			{
-				throwFitsError( iStatus );
+				if ( bCreated )
+				{
+					m_dReady.push_back( tFile );
+				}
+				else
+				{
+					m_bFailed = true;
+				}
 			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  readSubImage ( Single Image )                                                                           |
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  Reads a sub-image from a single image file.                                                             |
-		// |                                                                                                          |
-		// |  <IN> -> lowerLeftPoint  - The lower left point { col, row } of the sub-image.                           |
-		// |  <IN> -> upperRightPoint - The upper right point { col, row } of the sub-image.                          |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// |  Class constructor                                                                                       |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>>
-		CArcFitsFile<T>::readSubImage( arc::gen3::fits::Point lowerLeftPoint, arc::gen3::fits::Point upperRightPoint )
+		template <typename T> CArcFitsFile<T>::CArcFitsFile( void ) : CArcBase(), m_i64Pixel( 0 ), m_iFrame( 0 ), m_pFits( nullptr ),
+			m_cParam(), m_bParamValid( false ), m_eFlush( arc::gen3::fits::e_Flush::EVERY_WRITE ), m_u64FlushValue( 0 ), m_u64UnflushedWrites( 0 ), m_u64UnflushedBytes( 0 ),
+			m_eCompress( arc::gen3::fits::e_Compress::NONE ), m_uiTileRows( 0 ), m_u64CompressBudget( 0 ), m_uiRiceTileRows( 0 )
 		{
-			std::int32_t iStatus = 0;
-			std::int32_t iAnyNul = 0;
+		}
 
-			verifyFileHandle();
 
-			auto pParam = getParameters();
-			
-			//
-			// Verify parameters
-			//
-			if ( pParam->getNAxis() != 2 )
-			{
-				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
-			}
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Class destructor                                                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> CArcFitsFile<T>::~CArcFitsFile( void )
+		{
+			//try
+			//{
+			//	close();
+			//}
+			//catch ( ... ) {}
+		}
 
-			if ( lowerLeftPoint.second > upperRightPoint.second )
+
+		template <typename T> std::string CArcFitsFile<T>::getType( void ) noexcept
+		{
+			return typeid( T ).name();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  version                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns a textual representation of the library version.                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> const std::string CArcFitsFile<T>::version( void ) noexcept
+		{
+			return m_sVersion;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  version                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns a textual representation of the library version.                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> const std::string CArcFitsFile<T>::cfitsioVersion( void ) noexcept
+		{
+			float fVersion = 0.f;
+
+			fits_get_version( &fVersion );
+
+			const std::string sVersion = CArcBase::formatString( "CFITSIO Library.                 [ Version: %f ]", fVersion );
+
+			return sVersion;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  create                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Creates a new single image file on disk with the specified image dimensions.                            |
+		// |                                                                                                          |
+		// |  <IN> -> tFileName - The new file name.                                                                  |
+		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFitsFile<T>::create( const std::filesystem::path& tFileName, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			std::int32_t iImageType = ( ( sizeof( T ) == sizeof( std::uint16_t ) ) ? USHORT_IMG : ULONG_IMG );
+
+			long a_lNAxes[] = { static_cast< long >( uiCols ), static_cast< long >( uiRows ) };
+
+			std::int32_t iStatus = 0;
+
+			if ( m_pFits != nullptr )
 			{
-				throwArcGen3InvalidArgument( "Invalid LOWER LEFT ROW parameter!"s );
+				close();
 			}
 
-			if ( lowerLeftPoint.first > upperRightPoint.first )
+			//
+			// Verify image dimensions
+			//
+			if ( uiRows == 0 )
 			{
-				throwArcGen3InvalidArgument( "Invalid LOWER LEFT COLUMN parameter!"s );
+				throwArcGen3InvalidArgument( "Row dimension must be greater than zero!"s );
 			}
 
-			if ( lowerLeftPoint.second < 0 || lowerLeftPoint.second >= static_cast< long >( pParam->getRows() ) )
+			if ( uiCols == 0 )
 			{
-				throwArcGen3InvalidArgument( "Invalid LOWER LEFT ROW parameter!"s );
+				throwArcGen3InvalidArgument( "Column dimension must be greater than zero!"s );
 			}
 
-			if ( upperRightPoint.second < 0 || upperRightPoint.second >= static_cast< long >( pParam->getRows() ) )
+			//
+			// Verify filename
+			//
+			if ( tFileName.empty() )
 			{
-				throwArcGen3InvalidArgument( "Invalid UPPER RIGHT ROW parameter!"s );
+				throwArcGen3InvalidArgument( "Invalid file name : %s", tFileName.c_str() );
 			}
 
-			if ( lowerLeftPoint.first < 0 || lowerLeftPoint.first >= static_cast< long >( pParam->getCols() ) )
+			//
+			// Delete the file if it exists. This is to prevent creation errors.
+			//
+			ArcRemove( tFileName.string() );
+
+			//
+			// Create the file ( force overwrite )
+			//
+			fits_create_file( &m_pFits, ( tFileName.string().insert( 0, 1, '!' ) ).c_str(), &iStatus );
+
+			if ( iStatus )
 			{
-				throwArcGen3InvalidArgument( "Invalid LOWER LEFT COLUMN parameter!"s );
+				close();
+
+				//
+				// Delete the file if it exists. This is to prevent creation errors.
+				//
+				ArcRemove( tFileName.string() );
+
+				throwFitsError( iStatus );
+			}
+
+			//
+			// Set up tile compression, if enabled
+			//
+			if ( m_eCompress != arc::gen3::fits::e_Compress::NONE )
+			{
+				iStatus = setTileCompression( uiCols, uiRows, 2 );
+
+				if ( iStatus )
+				{
+					close();
+
+					ArcRemove( tFileName.string() );
+
+					throwFitsError( iStatus );
+				}
+			}
+
+			fits_create_img( m_pFits, iImageType, 2, a_lNAxes, &iStatus );
+
+			if ( iStatus )
+			{
+				close();
+
+				//
+				// Delete the file if it exists. This is to prevent creation errors.
+				//
+				ArcRemove( tFileName.string() );
+
+				throwFitsError( iStatus );
+			}
+
+			m_i64Pixel = 0;
+			m_iFrame = 0;
+
+			resetState();
+
+			if ( m_eCompress == arc::gen3::fits::e_Compress::RICE )
+			{
+				m_uiRiceTileRows = std::min( ( m_uiTileRows > 0 ? m_uiTileRows : 1 ), uiRows );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  create3D                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Creates a new data cube file on disk with the specified image dimensions.                               |
+		// |                                                                                                          |
+		// |  <IN> -> tFileName - The new file name.                                                                  |
+		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFitsFile<T>::create3D( const std::filesystem::path& tFileName, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			std::int32_t iImageType = ( ( sizeof( T ) == sizeof( std::uint16_t ) ) ? USHORT_IMG : ULONG_IMG );
+
+			long a_lNAxes[] = { static_cast< long >( uiCols ), static_cast< long >( uiRows ), 1 };		// cols, rows, nof
+
+			std::int32_t iStatus = 0;
+
+			if ( m_pFits != nullptr )
+			{
+				close();
+			}
+
+			//
+			// Verify image dimensions
+			//
+			if ( uiRows == 0 )
+			{
+				throwArcGen3InvalidArgument( "Row dimension must be greater than zero!"s );
+			}
+
+			if ( uiCols == 0 )
+			{
+				throwArcGen3InvalidArgument( "Column dimension must be greater than zero!"s );
+			}
+
+			//
+			// Verify filename
+			//
+			if ( tFileName.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid file name : %s", tFileName.c_str() );
+			}
+
+			//
+			// Delete the file if it exists. This is to prevent creation errors.
+			//
+			ArcRemove( tFileName.string() );
+
+			//
+			// Create the file ( force overwrite )
+			//
+			fits_create_file( &m_pFits, ( tFileName.string().insert( 0, 1, '!' ) ).c_str(), &iStatus );
+
+			if ( iStatus )
+			{
+				close();
+
+				//
+				// Delete the file if it exists. This is to prevent creation errors.
+				//
+				ArcRemove( tFileName.string() );
+
+				throwFitsError( iStatus );
+			}
+
+			//
+			// Set up tile compression, if enabled
+			//
+			if ( m_eCompress != arc::gen3::fits::e_Compress::NONE )
+			{
+				iStatus = setTileCompression( uiCols, uiRows, 3 );
+
+				if ( iStatus )
+				{
+					close();
+
+					ArcRemove( tFileName.string() );
+
+					throwFitsError( iStatus );
+				}
+			}
+
+			fits_create_img( m_pFits, iImageType, 3, a_lNAxes, &iStatus );
+
+			if ( iStatus )
+			{
+				close();
+
+				//
+				// Delete the file if it exists. This is to prevent creation errors.
+				//
+				ArcRemove( tFileName.string() );
+
+				throwFitsError( iStatus );
+			}
+
+			m_i64Pixel = 0;
+			m_iFrame = 0;
+
+			resetState();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  open                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Opens an existing file. Can be used to open a file containing a single image or data cube ( a file with |
+		// |  multiple image planes ).                                                                                |
+		// |                                                                                                          |
+		// |  <IN> -> tFileName - The file name.                                                                      |
+		// |  <IN> -> eMode - The mode ( read/write ) with which to open the file ( default = e_ReadMode::READMODE ). |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcFitsFile<T>::open( const std::filesystem::path& tFileName, arc::gen3::fits::e_ReadMode eMode )
+		{
+			std::int32_t iStatus = 0;
+			std::int32_t iExists = 0;
+
+			if ( m_pFits != nullptr )
+			{
+				close();
 			}
 
-			if ( upperRightPoint.first < 0 || upperRightPoint.first >= static_cast< long >( pParam->getCols() ) )
-			{
-				throwArcGen3InvalidArgument( "Invalid UPPER RIGHT COLUMN parameter!"s );
-			}
+			//
+			// Verify filename
+			//
+			if ( tFileName.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid file name : %s", tFileName.c_str() );
+			}
+
+			//
+			// Make sure the specified file exists
+			//
+			fits_file_exists( tFileName.string().c_str(), &iExists, &iStatus);
+
+			if ( iStatus )
+			{
+				m_pFits = nullptr;
+
+				throwFitsError( iStatus );
+			}
+
+			//
+			// Open the FITS file
+			//
+			fits_open_file( &m_pFits, tFileName.string().c_str(), static_cast< int >( eMode ), &iStatus);
+
+			if ( iStatus )
+			{
+				m_pFits = nullptr;
+
+				throwFitsError( iStatus );
+			}
+
+			m_i64Pixel = 0;
+			m_iFrame = 0;
+
+			resetState();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  close                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Closes the file.                                                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFitsFile<T>::close( void ) noexcept
+		{
+			//
+			//  DeleteBuffer requires access to the file, so don't close the file until
+			// after deleteBuffer has been called!!!
+			//
+			if ( m_pFits != nullptr )
+			{
+				std::int32_t iStatus = 0;
+
+				fits_close_file( m_pFits, &iStatus );
+			}
+
+			m_pFits = nullptr;
+
+			m_i64Pixel = 0;
+			m_iFrame = 0;
+
+			resetState();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getHeader                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the FITS header as a list of strings.                                                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::CArcStringList> CArcFitsFile<T>::getHeader( void )
+		{
+			std::int32_t iNumOfKeys = 0;
+			std::int32_t iStatus = 0;
+
+			verifyFileHandle();
+
+			fits_get_hdrspace( m_pFits, &iNumOfKeys, nullptr, &iStatus );
+
+			if ( iStatus )
+			{
+				throwFitsError( iStatus );
+			}
+
+			std::unique_ptr<arc::gen3::CArcStringList> pList( new arc::gen3::CArcStringList() );
+
+			std::string sCard( 100, ' ' );
+
+			for ( auto i = 0; i < iNumOfKeys; i++ )
+			{
+				fits_read_record( m_pFits, ( i + 1 ), const_cast< char* >( sCard.data() ), &iStatus );
+
+				if ( iStatus )
+				{
+					throwFitsError( iStatus );
+				}
+
+				*( pList.get() ) << sCard.c_str();
+			}
+
+			return pList;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getFileName                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the filename associated with this CArcFitsFile object.                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> const std::string CArcFitsFile<T>::getFileName( void )
+		{
+			std::int32_t iStatus = 0;
+
+			std::string sFileName( 150, ' ' );
+
+			verifyFileHandle();
+
+			fits_file_name( m_pFits, const_cast< char* >( sFileName.data() ), &iStatus );
+
+			if ( iStatus )
+			{
+				throwFitsError( iStatus );
+			}
+
+			return sFileName.c_str();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  readKeyword                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Reads a FITS keyword value from the header.  The keyword must be valid or an exception will be thrown.  |
+		// |                                                                                                          |
+		// |  <IN> -> sKey  - The header keyword. Can be "".  Ex: SIMPLE                                              |
+		// |  <IN> -> eType - The keyword type, as defined in CArcFitsFile.h                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		arc::gen3::fits::keywordValue_t CArcFitsFile<T>::readKeyword( const std::string& sKey, arc::gen3::fits::e_Type eType )
+		{
+			std::int32_t iType = static_cast< std::int32_t >( arc::gen3::fits::e_Type::FITS_INVALID_KEY );
+
+			std::int32_t iStatus = 0;
+
+			verifyFileHandle();
+
+			arc::gen3::fits::keywordValue_t keyValue;
+
+			switch ( eType )
+			{
+				case arc::gen3::fits::e_Type::FITS_STRING_KEY:
+				{
+					constexpr auto iStrMax = 80;
+
+					iType = TSTRING;
+
+					char szValue[ iStrMax ];
+
+					arc::gen3::CArcBase::zeroMemory( szValue, static_cast< std::uint64_t >( sizeof( szValue ) ) );
+
+					szValue[ iStrMax - 1 ] = '\0';
+
+					fits_read_key( m_pFits, iType, sKey.c_str(), szValue, NULL, &iStatus );
+
+					#ifdef __cpp_lib_variant
+						keyValue = std::string( szValue );
+					#else
+						keyValue = std::make_tuple( 0, 0, 0, 0, 0.0, std::string( szValue ) );
+					#endif
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_INT_KEY:
+				{
+					iType = TINT;
+
+					std::int32_t iValue = 0;
+
+					fits_read_key( m_pFits, iType, sKey.c_str(), &iValue, NULL, &iStatus );
+
+					#ifdef __cpp_lib_variant
+						keyValue = iValue;
+					#else
+						keyValue = std::make_tuple( 0, iValue, 0, 0, 0.0, std::string() );
+					#endif
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_UINT_KEY:
+				{
+					iType = TUINT;
+
+					std::uint32_t uiValue = 0;
+
+					fits_read_key( m_pFits, iType, sKey.c_str(), &uiValue, NULL, &iStatus );
+
+					#ifdef __cpp_lib_variant
+						keyValue = uiValue;
+					#else
+						keyValue = std::make_tuple( uiValue, 0, 0, 0, 0.0, std::string() );
+					#endif
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_SHORT_KEY:
+				{
+					iType = TSHORT;
+
+					std::int16_t wValue = 0;
+
+					fits_read_key( m_pFits, iType, sKey.c_str(), &wValue, NULL, &iStatus );
+
+					#ifdef __cpp_lib_variant
+						keyValue = static_cast< std::int32_t >( wValue );
+					#else
+						keyValue = std::make_tuple( 0, static_cast< std::int32_t >( wValue ), 0, 0, 0.0, std::string() );
+					#endif
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_USHORT_KEY:
+				{
+					iType = TUSHORT;
+
+					std::uint16_t uwValue = 0;
+
+					fits_read_key( m_pFits, iType, sKey.c_str(), &uwValue, NULL, &iStatus );
+
+					#ifdef __cpp_lib_variant
+						keyValue = static_cast< std::uint32_t >( uwValue );
+					#else
+						keyValue = std::make_tuple( static_cast< std::uint32_t >( uwValue ), 0, 0, 0, 0.0, std::string() );
+					#endif
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_FLOAT_KEY:
+				{
+					iType = TFLOAT;
+
+					float fValue = 0;
+
+					fits_read_key( m_pFits, iType, sKey.c_str(), &fValue, NULL, &iStatus );
+
+					#ifdef __cpp_lib_variant
+						keyValue = static_cast< double >( fValue );
+					#else
+						keyValue = std::make_tuple( 0, 0, 0, 0, static_cast< double >( fValue ), std::string() );
+					#endif
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_DOUBLE_KEY:
+				{
+					iType = TDOUBLE;
+
+					double gValue = 0;
+
+					fits_read_key( m_pFits, iType, sKey.c_str(), &gValue, NULL, &iStatus );
+
+					#ifdef __cpp_lib_variant
+						keyValue = gValue;
+					#else
+						keyValue = std::make_tuple( 0, 0, 0, 0, gValue, std::string() );
+					#endif
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_BYTE_KEY:
+				{
+					iType = TBYTE;
+
+					std::int8_t iValue = 0;
+
+					fits_read_key( m_pFits, iType, sKey.c_str(), &iValue, NULL, &iStatus );
+
+					#ifdef __cpp_lib_variant
+						keyValue = static_cast< std::uint32_t >( iValue );
+					#else
+						keyValue = std::make_tuple( 0, static_cast< std::uint32_t >( iValue ), 0, 0, 0.0, std::string() );
+					#endif
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_LONG_KEY:
+				{
+					iType = TLONG;
+
+					std::int32_t iValue = 0;
+
+					fits_read_key( m_pFits, iType, sKey.c_str(), &iValue, NULL, &iStatus );
+
+					#ifdef __cpp_lib_variant
+						keyValue = iValue;
+					#else
+						keyValue = std::make_tuple( 0, static_cast< std::int32_t >( iValue ), 0, 0, 0.0, std::string() );
+					#endif
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_ULONG_KEY:
+				{
+					iType = TULONG;
+
+					std::uint32_t uiValue = 0;
+
+					fits_read_key( m_pFits, iType, sKey.c_str(), &uiValue, NULL, &iStatus );
+
+					#ifdef __cpp_lib_variant
+						keyValue = uiValue;
+					#else
+						keyValue = std::make_tuple( uiValue, 0, 0, 0, 0.0, std::string() );
+					#endif
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_LONGLONG_KEY:
+				{
+					iType = TLONGLONG;
+
+					std::int64_t iValue = 0;
+
+					fits_read_key( m_pFits, iType, sKey.c_str(), &iValue, NULL, &iStatus );
+
+					#ifdef __cpp_lib_variant
+						keyValue = iValue;
+					#else
+						keyValue = std::make_tuple( 0, 0, 0, iValue, 0.0, std::string() );
+					#endif
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_LOGICAL_KEY:
+				{
+					iType = TLOGICAL;
+
+					std::int32_t iValue = 0;
+
+					fits_read_key( m_pFits, iType, sKey.c_str(), &iValue, NULL, &iStatus );
+
+					#ifdef __cpp_lib_variant
+						keyValue = iValue;
+					#else
+						keyValue = std::make_tuple( 0, iValue, 0, 0, 0.0, std::string() );
+					#endif
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_COMMENT_KEY:
+				case arc::gen3::fits::e_Type::FITS_HISTORY_KEY:
+				case arc::gen3::fits::e_Type::FITS_DATE_KEY:
+				{
+				}
+				break;
+
+				default:
+				{
+					iType = static_cast< std::int32_t >( arc::gen3::fits::e_Type::FITS_INVALID_KEY );
+
+					throwArcGen3InvalidArgument( "Invalid FITS keyword type. See CArcFitsFile.h for valid type list"s );
+				}
+			}
+
+			return keyValue;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  writeKeyword                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Writes a FITS keyword to the header.  The keyword must be valid or an exception will be thrown.         |
+		// |                                                                                                          |
+		// |  'HIERARCH' keyword NOTE: This text will be prefixed to any keyword by the cfitsio library if the        |
+		// |                           keyword is greater than 8 characters, which is the standard FITS keyword       |
+		// |                           length. See the link below for details:                                        |
+		// |                                                                                                          |
+		// |   http://heasarc.gsfc.nasa.gov/docs/software/fitsio/c/f_user/node28.html                                 |
+		// |                                                                                                          |
+		// |   HIERARCH examples:                                                                                     |
+		// |   -----------------                                                                                      |
+		// |   HIERARCH LongKeyword = 47.5 / Keyword has > 8 characters & mixed case                                  |
+		// |   HIERARCH XTE$TEMP = 98.6 / Keyword contains the '$' character                                          |
+		// |   HIERARCH Earth is a star = F / Keyword contains embedded spaces                                        |
+		// |                                                                                                          |
+		// |  <IN> -> sKey     - The header keyword. Can be "".  Ex: SIMPLE                                           |
+		// |  <IN> -> pvalue   - The value associated with the key. Ex: T                                             |
+		// |  <IN> -> eType    - The keyword type, as defined in CArcFitsFile.h                                       |
+		// |  <IN> -> sComment - The comment to attach to the keyword.  Can be "".                                    |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFitsFile<T>::writeKeyword( const std::string& sKey, void* pValue, arc::gen3::fits::e_Type eType, const std::string& sComment )
+		{
+			std::int32_t iType = static_cast< std::int32_t >( arc::gen3::fits::e_Type::FITS_INVALID_KEY );
+			std::int32_t iStatus = 0;
+
+			verifyFileHandle();
+
+			//
+			// Verify value pointer
+			//
+			if ( eType != arc::gen3::fits::e_Type::FITS_DATE_KEY && pValue == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid FITS key value, cannot be nullptr"s );
+			}
+
+			//
+			// Update the fits header with the specified keys
+			//
+			switch ( eType )
+			{
+				case arc::gen3::fits::e_Type::FITS_STRING_KEY:
+				{
+					iType = TSTRING;
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_INT_KEY:
+				{
+					iType = TINT;
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_UINT_KEY:
+				{
+					iType = TUINT;
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_SHORT_KEY:
+				{
+					iType = TSHORT;
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_USHORT_KEY:
+				{
+					iType = TUSHORT;
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_FLOAT_KEY:
+				{
+					iType = TFLOAT;
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_DOUBLE_KEY:
+				{
+					iType = TDOUBLE;
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_BYTE_KEY:
+				{
+					iType = TBYTE;
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_LONG_KEY:
+				{
+					iType = TLONG;
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_ULONG_KEY:
+				{
+					iType = TULONG;
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_LONGLONG_KEY:
+				{
+					iType = TLONGLONG;
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_LOGICAL_KEY:
+				{
+					iType = TLOGICAL;
+				}
+				break;
+
+				case arc::gen3::fits::e_Type::FITS_COMMENT_KEY:
+				case arc::gen3::fits::e_Type::FITS_HISTORY_KEY:
+				case arc::gen3::fits::e_Type::FITS_DATE_KEY:
+				{
+				}
+				break;
+
+				default:
+				{
+					iType = static_cast< std::int32_t >( arc::gen3::fits::e_Type::FITS_INVALID_KEY );
+
+					throwArcGen3InvalidArgument( "Invalid FITS keyword type. See CArcFitsFile.h for valid type list"s );
+				}
+			}
+
+			//
+			// write ( append ) a COMMENT keyword to the header. The comment
+			// string will be continued over multiple keywords if it is
+			// longer than 70 characters. 
+			//
+			if ( eType == arc::gen3::fits::e_Type::FITS_COMMENT_KEY )
+			{
+				fits_write_comment( m_pFits, static_cast< char* >( pValue ), &iStatus );
+			}
+
+			//
+			// write ( append ) a HISTORY keyword to the header. The history
+			// string will be continued over multiple keywords if it is
+			// longer than 70 characters. 
+			//
+			else if ( eType == arc::gen3::fits::e_Type::FITS_HISTORY_KEY )
+			{
+				fits_write_history( m_pFits, static_cast< char* >( pValue ), &iStatus );
+			}
+
+			//
+			// write the DATE keyword to the header. The keyword value will contain
+			// the current system date as a character string in 'yyyy-mm-ddThh:mm:ss'
+			// format. If a DATE keyword already exists in the header, then this
+			// routine will simply update the keyword value with the current date.
+			//
+			else if ( eType == arc::gen3::fits::e_Type::FITS_DATE_KEY )
+			{
+				fits_write_date( m_pFits, &iStatus );
+			}
+
+			//
+			// write a keyword of the appropriate data type into the header
+			//
+			else
+			{
+				fits_update_key( m_pFits, iType, sKey.c_str(), pValue, ( sComment == "" ? nullptr : sComment.c_str() ), &iStatus );
+
+				// The keyword may be an image dimension ( NAXISn )
+				m_bParamValid = false;
+			}
+
+			if ( iStatus )
+			{
+				throwFitsError( iStatus );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  updateKeyword                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Updates an existing FITS header keyword.  The keyword must be valid or an exception will be thrown.     |
+		// |                                                                                                          |
+		// |  'HIERARCH' keyword NOTE: This text will be prefixed to any keyword by the cfitsio library if the        |
+		// |                           keyword is greater than 8 characters, which is the standard FITS keyword       |
+		// |                           length. See the link below for details:                                        |
+		// |   http://heasarc.gsfc.nasa.gov/docs/software/fitsio/c/f_user/node28.html                                 |
+		// |                                                                                                          |
+		// |   HIERARCH examples:                                                                                     |
+		// |   -----------------                                                                                      |
+		// |   HIERARCH LongKeyword = 47.5 / Keyword has > 8 characters & mixed case                                  |
+		// |   HIERARCH XTE$TEMP = 98.6 / Keyword contains the '$' character                                          |
+		// |   HIERARCH Earth is a star = F / Keyword contains embedded spaces                                        |
+		// |                                                                                                          |
+		// |  <IN> -> sKey     - The header keyword. Can be nullptr. Ex: SIMPLE                                       |
+		// |  <IN> -> pKey     - The value associated with the key. Ex: T                                             |
+		// |  <IN> -> iType    - The keyword type, as defined in CArcFitsFile.h                                       |
+		// |  <IN> -> sComment - The comment to attach to the keyword.  Can be nullptr.                               |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFitsFile<T>::updateKeyword( const std::string& sKey, void* pKey, arc::gen3::fits::e_Type eType, const std::string& sComment )
+		{
+			writeKeyword( sKey, pKey, eType, sComment );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  writeHeader                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Appends the cards of a header template to the header. Each card is already formatted, so it is copied   |
+		// |  into the header as is, with none of the type conversion or keyword search that writeKeyword() does.     |
+		// |  The reserved space is set aside first; cfitsio only allows this before the image data is written.       |
+		// |                                                                                                          |
+		// |  <IN> -> cHeader - The header template.                                                                  |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFitsFile<T>::writeHeader( const arc::gen3::fits::CHeaderTemplate& cHeader )
+		{
+			std::int32_t iStatus = 0;
+
+			verifyFileHandle();
+
+			auto uiCount = cHeader.getCount();
+
+			fits_set_hdrsize( m_pFits, static_cast< int >( uiCount + cHeader.getReserved() ), &iStatus );
+
+			const auto& sCards = cHeader.getCards();
+
+			char szCard[ HEADER_CARD + 1 ];
+
+			szCard[ HEADER_CARD ] = '\0';
+
+			for ( std::uint32_t i = 0; i < uiCount && iStatus == 0; i++ )
+			{
+				sCards.copy( szCard, HEADER_CARD, static_cast< std::size_t >( i ) * HEADER_CARD );
+
+				fits_write_record( m_pFits, szCard, &iStatus );
+			}
+
+			if ( iStatus )
+			{
+				throwFitsError( iStatus );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getParameters                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns a pointer to an arc::gen3::fits::CParam class that contains all the image parameters, such as   |
+		// |  number of cols, rows, frames, dimensions and bits-per-pixel. May return nullptr.                        |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::fits::CParam> CArcFitsFile<T>::getParameters( void )
+		{
+			std::int32_t iStatus = 0;
+
+			verifyFileHandle();
+
+			std::unique_ptr<arc::gen3::fits::CParam> pParam( new arc::gen3::fits::CParam() );
+
+			if ( pParam == nullptr )
+			{
+				throwArcGen3Error( "Failed to create parameters structure!"s );
+			}
+
+			//
+			// Get the image parameters
+			//
+			fits_get_img_param( m_pFits, 3, &pParam->m_iBpp, &pParam->m_iNAxis, pParam->m_lNAxes, &iStatus );
+
+			if ( iStatus )
+			{
+				throwFitsError( iStatus );
+			}
+
+			return pParam;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getNumberOfFrames                                                                                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of frames.  A single image file will return a value of 0.                            |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint32_t CArcFitsFile<T>::getNumberOfFrames( void )
+		{
+			return static_cast< std::uint32_t >( getParameters()->getFrames() );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getRows                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of rows in the image.                                                                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint32_t CArcFitsFile<T>::getRows( void )
+		{
+			return static_cast< std::uint32_t >( getParameters()->getRows() );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getCols																							      |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of columns in the image.                                                             |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint32_t CArcFitsFile<T>::getCols( void )
+		{
+			return static_cast< std::uint32_t >( getParameters()->getCols() );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getNAxis                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of dimensions in the image.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint32_t CArcFitsFile<T>::getNAxis( void )
+		{
+			return static_cast< std::uint32_t >( getParameters()->getNAxis() );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getBitsPerPixel                                                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the image bits-per-pixel value.                                                                 |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint32_t CArcFitsFile<T>::getBitsPerPixel( void )
+		{
+			return static_cast< std::uint32_t >( getParameters()->getBpp() );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  generateTestData                                                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Generates a ramp test pattern image within the file. The size of the image is determined by the image   |
+		// |  dimensions supplied during the create() method call.This method is only valid for single image files.   |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcFitsFile<T>::generateTestData( void )
+		{
+			std::size_t  iNElements = 0;
+			std::int64_t i64FPixel  = 1;
+			std::int32_t iStatus    = 0;
+
+			verifyFileHandle();
+
+			auto pParam = getParameters();
+
+			if ( pParam->getNAxis() > 2 )
+			{
+				throwArcGen3Error( "This method only supports single 2-D image files."s );
+			}
+
+			//
+			// Set number of pixels to write
+			//
+			iNElements = static_cast< std::size_t >( pParam->getCols() ) * static_cast< std::size_t >( pParam->getRows() );
+
+			std::unique_ptr<T[]> pBuf( new T[ iNElements ] );
+
+			T uiValue = 0;
+
+			for ( std::size_t i = 0; i < iNElements; i++ )
+			{
+				pBuf.get()[ i ] = uiValue;
+
+				uiValue++;
+
+				if ( uiValue >= maxTVal() )
+				{
+					uiValue = 0;
+				}
+			}
+
+			fits_write_img( m_pFits,
+							( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+							i64FPixel,
+							static_cast<LONGLONG>( iNElements ),
+							pBuf.get(),
+							&iStatus );
+
+			if ( iStatus )
+			{
+				throwFitsError( iStatus );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  reOpen                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Effectively closes and re-opens the underlying disk file.                                               |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcFitsFile<T>::reOpen( void )
+		{
+			std::int32_t	iStatus = 0;
+			std::int32_t	iIOMode = 0;
+
+			std::string sFilename = getFileName();
+
+			fits_file_mode( m_pFits, &iIOMode, &iStatus );
+
+			if ( iStatus )
+			{
+				throwFitsError( iStatus );
+			}
+
+			close();
+
+			fits_open_file( &m_pFits, sFilename.c_str(), iIOMode, &iStatus );
+
+			if ( iStatus )
+			{
+				close();
+
+				throwFitsError( iStatus );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  flush                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Causes all internal data buffers to write data to the disk file.                                        |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcFitsFile<T>::flush( void )
+		{
+			std::int32_t iStatus = 0;
+
+			verifyFileHandle();
+
+			fits_flush_file( m_pFits, &iStatus );
+
+			if ( iStatus )
+			{
+				throwFitsError( iStatus );
+			}
+
+			m_u64UnflushedWrites = 0;
+			m_u64UnflushedBytes = 0;
+			m_tLastFlush = std::chrono::steady_clock::now();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setFlushPolicy                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets when the write methods ( write, writeSubImage, write3D and reWrite3D ) flush the file to disk.     |
+		// |  Flushing after every write costs a disk round trip per data cube frame, so continuous readouts that     |
+		// |  write many frames may prefer to flush every few frames, every few megabytes, on a timer or on close.    |
+		// |  The policy stays in effect across create(), open() and close().                                         |
+		// |                                                                                                          |
+		// |  <IN> -> eFlush   - The flush policy.                                                                    |
+		// |  <IN> -> u64Value - The number of writes ( FRAMES ), bytes ( BYTES ) or milliseconds ( INTERVAL )        |
+		// |                     between flushes. Ignored by EVERY_WRITE and ON_CLOSE.                                |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcFitsFile<T>::setFlushPolicy( arc::gen3::fits::e_Flush eFlush, const std::uint64_t u64Value )
+		{
+			switch ( eFlush )
+			{
+				case arc::gen3::fits::e_Flush::EVERY_WRITE:
+				case arc::gen3::fits::e_Flush::ON_CLOSE:
+					break;
+
+				case arc::gen3::fits::e_Flush::FRAMES:
+				case arc::gen3::fits::e_Flush::BYTES:
+				case arc::gen3::fits::e_Flush::INTERVAL:
+				{
+					if ( u64Value == 0 )
+					{
+						throwArcGen3InvalidArgument( "Invalid flush interval [ 0 ]! Must be greater than zero!"s );
+					}
+				}
+				break;
+
+				default:
+				{
+					throwArcGen3InvalidArgument( "Invalid flush policy [ %d ]!", static_cast< std::int32_t >( eFlush ) );
+				}
+			}
+
+			m_eFlush = eFlush;
+
+			m_u64FlushValue = u64Value;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setCompression                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the tile compression used by later calls to create() and create3D(). The image is stored as a      |
+		// |  tile compressed binary table that cfitsio ( and fpack/funpack ) read as a normal image. Each tile       |
+		// |  holds whole image rows. All of the algorithms are lossless for integer images.                          |
+		// |                                                                                                          |
+		// |  For RICE, write() compresses the tiles of a single image on one thread per core and writes them in      |
+		// |  order, one batch at a time, so no more than u64MemoryBudget bytes of compressed tiles are held at       |
+		// |  once. Other writes, and the GZIP and HCOMPRESS algorithms, are compressed by cfitsio.                   |
+		// |                                                                                                          |
+		// |  <IN> -> eCompress       - The compression algorithm.                                                    |
+		// |  <IN> -> uiTileRows      - Image rows per tile. 0 selects one row ( 16 for HCOMPRESS ).                  |
+		// |  <IN> -> u64MemoryBudget - Maximum bytes of compressed tile buffers. 0 selects 64 MB.                    |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFitsFile<T>::setCompression( arc::gen3::fits::e_Compress eCompress, const std::uint32_t uiTileRows, const std::uint64_t u64MemoryBudget )
+		{
+			switch ( eCompress )
+			{
+				case arc::gen3::fits::e_Compress::NONE:
+				case arc::gen3::fits::e_Compress::RICE:
+				case arc::gen3::fits::e_Compress::GZIP:
+					break;
+
+				case arc::gen3::fits::e_Compress::HCOMPRESS:
+				{
+					if ( uiTileRows > 0 && uiTileRows < 4 )
+					{
+						throwArcGen3InvalidArgument( "Invalid tile rows [ %u ]! HCOMPRESS needs at least 4!", uiTileRows );
+					}
+				}
+				break;
+
+				default:
+				{
+					throwArcGen3InvalidArgument( "Invalid compression [ %d ]!", static_cast< std::int32_t >( eCompress ) );
+				}
+			}
+
+			m_eCompress = eCompress;
+
+			m_uiTileRows = uiTileRows;
+
+			m_u64CompressBudget = ( ( u64MemoryBudget > 0 ) ? u64MemoryBudget : COMPRESS_BUDGET );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  compare ( Single Images )                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Compares this file image data to another. This method does not check headers, except for size values.   |
+		// |                                                                                                          |
+		// |  <IN> - > cFitsFile - Reference to FITS file to compare.	                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcFitsFile<T>::compare( CArcFitsFile<T>& cFitsFile )
+		{
+			auto pParam = cFitsFile.getParameters();
+
+			auto pThisParams = getParameters();
+
+			//
+			//  Verify file dimensions
+			//
+			if ( pThisParams->getNAxis() != pParam->getNAxis() )
+			{
+				throwArcGen3Error( "Comparison file dimensions DO NOT match! This: %u Passed: %u.", pThisParams->getNAxis(), pParam->getNAxis() );
+			}
+
+			//
+			//  Verify image dimensions
+			//
+			if ( ( pThisParams->getCols() != pParam->getCols() ) || ( pThisParams->getRows() != pParam->getRows() ) )
+			{
+				throwArcGen3Error( "Image dimensions of comparison files DO NOT match! This: %ux%u Passed: %ux%u.",
+									pThisParams->getCols(),
+									pThisParams->getRows(),
+									pParam->getCols(),
+									pParam->getRows() );
+			}
+
+			if ( pThisParams->getBpp() != pParam->getBpp() )
+			{
+				throwArcGen3Error( "Image bits-per-pixel of comparison files DO NOT match! This: %u Passed: %u.",
+									pThisParams->getBpp(),
+									pParam->getBpp() );
+			}
+
+			//
+			//  Read input file image buffer
+			//
+			auto pBuf = cFitsFile.read();
+
+			if ( pBuf.get() == nullptr )
+			{
+				throwArcGen3Error( "Failed to read passed FITS file image data!"s );
+			}
+
+			//
+			//  Read this file image buffer
+			//
+			auto pThisBuf = read();
+
+			if ( pThisBuf.get() == nullptr )
+			{
+				throwArcGen3Error( "Failed to read this FITS file image data!"s );
+			}
+
+			//
+			//  compare image buffers
+			//
+			for ( std::uint32_t r = 0; r < pThisParams->getRows(); r++ )
+			{
+				for ( std::uint32_t c = 0; c < pThisParams->getCols(); c++ )
+				{
+					auto uIndex = c + r * pThisParams->getCols();
+
+					if ( pThisBuf.get()[ uIndex ] != pBuf.get()[ uIndex ] )
+					{
+						throwArcGen3Error( "Images do not match at col: %u, row: %u, this: %u, passed: %u",
+											c,
+											r,
+											pThisBuf.get()[ uIndex ],
+											pBuf.get()[ uIndex ] );
+					}
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  compareData                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Compares this file image data to another through memory mappings of both. The pixels are split into     |
+		// |  chunks, which worker threads take in turn. A chunk is first byte compared ( a vectorized memcmp ); when |
+		// |  the BZERO values match, equal bytes mean equal pixels and the chunk is done. Otherwise the chunk is     |
+		// |  decoded and compared pixel by pixel, in a loop that vectorizes.                                         |
+		// |                                                                                                          |
+		// |  For FIRST_DIFF, the lowest differing pixel index found so far is shared between the threads, and chunks |
+		// |  past it are skipped, so a mismatch early in a night's data stops the compare without reading the rest.  |
+		// |                                                                                                          |
+		// |  <IN> -> cFitsFile - Reference to FITS file to compare.                                                  |
+		// |  <IN> -> eMode     - Whether to stop at the first difference or gather difference statistics.            |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		arc::gen3::fits::CompareResult CArcFitsFile<T>::compareData( CArcFitsFile<T>& cFitsFile, const arc::gen3::fits::e_Compare eMode )
+		{
+			auto pThis = mapImage();
+
+			auto pPassed = cFitsFile.mapImage();
+
+			if ( pThis->cols() != pPassed->cols() || pThis->rows() != pPassed->rows() || pThis->frames() != pPassed->frames() )
+			{
+				throwArcGen3Error( "Image dimensions of comparison files DO NOT match! This: %ux%ux%u Passed: %ux%ux%u.",
+									pThis->cols(), pThis->rows(), pThis->frames(), pPassed->cols(), pPassed->rows(), pPassed->frames() );
+			}
+
+			//
+			// Frames follow each other in the file, so both images are one run of pixels
+			//
+			const T* pThisData = pThis->rawView( 0 ).data();
+			const T* pPassedData = pPassed->rawView( 0 ).data();
+
+			const T tThisZero = pThis->zero();
+			const T tPassedZero = pPassed->zero();
+
+			const bool bSameZero = ( tThisZero == tPassedZero );
+			const bool bFirstOnly = ( eMode == arc::gen3::fits::e_Compare::FIRST_DIFF );
+
+			auto u64FramePixels = ( static_cast< std::uint64_t >( pThis->cols() ) * pThis->rows() );
+			auto u64Pixels = ( u64FramePixels * pThis->frames() );
+
+			auto u64Chunks = ( ( u64Pixels + COMPARE_CHUNK - 1 ) / COMPARE_CHUNK );
+
+			auto uiThreads = static_cast< std::uint32_t >( std::min<std::uint64_t>( std::max( std::thread::hardware_concurrency(), 1U ), u64Chunks ) );
+
+			//
+			// Per thread difference statistics, merged once all chunks are done
+			//
+			struct Partial
+			{
+				std::uint64_t u64Count = 0;
+				double gSum = 0.0;
+				std::int64_t i64Min = INT64_MAX;
+				std::int64_t i64Max = INT64_MIN;
+			};
+
+			std::vector<Partial> vPartial( uiThreads );
+
+			std::atomic<std::uint64_t> u64Next( 0 );
+			std::atomic<std::uint64_t> u64FirstDiff( UINT64_MAX );
+
+			auto fnWorker = [ & ]( std::uint32_t uiThread )
+			{
+				Partial& tPartial = vPartial[ uiThread ];
+
+				for ( auto u64Chunk = u64Next++; u64Chunk < u64Chunks; u64Chunk = u64Next++ )
+				{
+					auto u64Start = ( u64Chunk * COMPARE_CHUNK );
+
+					if ( bFirstOnly && u64Start > u64FirstDiff.load( std::memory_order_relaxed ) )
+					{
+						break;
+					}
+
+					auto szCount = static_cast< std::size_t >( std::min( COMPARE_CHUNK, u64Pixels - u64Start ) );
+
+					const T* arcGen3Restrict pA = ( pThisData + u64Start );
+					const T* arcGen3Restrict pB = ( pPassedData + u64Start );
+
+					if ( bSameZero && std::memcmp( pA, pB, szCount * sizeof( T ) ) == 0 )
+					{
+						continue;
+					}
+
+					std::uint64_t u64Count = 0;
+					std::int64_t i64Sum = 0;
+					std::int64_t i64Min = INT64_MAX;
+					std::int64_t i64Max = INT64_MIN;
+
+					if ( !bFirstOnly )
+					{
+						for ( std::size_t i = 0; i < szCount; i++ )
+						{
+							auto i64Diff = ( static_cast< std::int64_t >( static_cast< T >( bigEndian( pA[ i ] ) + tThisZero ) ) -
+											 static_cast< std::int64_t >( static_cast< T >( bigEndian( pB[ i ] ) + tPassedZero ) ) );
+
+							u64Count += ( i64Diff != 0 );
+							i64Sum += i64Diff;
+							i64Min = std::min( i64Min, i64Diff );
+							i64Max = std::max( i64Max, i64Diff );
+						}
+
+						tPartial.u64Count += u64Count;
+						tPartial.gSum += static_cast< double >( i64Sum );
+						tPartial.i64Min = std::min( tPartial.i64Min, i64Min );
+						tPartial.i64Max = std::max( tPartial.i64Max, i64Max );
+
+						if ( u64Count == 0 )
+						{
+							continue;
+						}
+					}
+
+					//
+					// Record the first difference in this chunk, if it is the lowest so far
+					//
+					for ( std::size_t i = 0; i < szCount; i++ )
+					{
+						if ( static_cast< T >( bigEndian( pA[ i ] ) + tThisZero ) != static_cast< T >( bigEndian( pB[ i ] ) + tPassedZero ) )
+						{
+							auto u64Index = ( u64Start + i );
+
+							auto u64Lowest = u64FirstDiff.load( std::memory_order_relaxed );
+
+							while ( u64Index < u64Lowest && !u64FirstDiff.compare_exchange_weak( u64Lowest, u64Index, std::memory_order_relaxed ) )
+							{
+							}
+
+							break;
+						}
+					}
+				}
+			};
+
+			std::vector<std::thread> vThreads;
+
+			for ( std::uint32_t i = 1; i < uiThreads; i++ )
+			{
+				vThreads.emplace_back( fnWorker, i );
+			}
+
+			fnWorker( 0 );
+
+			for ( auto& tThread : vThreads )
+			{
+				tThread.join();
+			}
+
+			arc::gen3::fits::CompareResult cResult;
+
+			cResult.m_u64Pixels = u64Pixels;
+
+			auto u64First = u64FirstDiff.load();
+
+			if ( u64First != UINT64_MAX )
+			{
+				auto u64InFrame = ( u64First % u64FramePixels );
+
+				cResult.m_firstDiff = { static_cast< long >( u64InFrame % pThis->cols() ), static_cast< long >( u64InFrame / pThis->cols() ) };
+				cResult.m_uiFirstDiffFrame = static_cast< std::uint32_t >( u64First / u64FramePixels );
+				cResult.m_uiThisValue = static_cast< T >( bigEndian( pThisData[ u64First ] ) + tThisZero );
+				cResult.m_uiPassedValue = static_cast< T >( bigEndian( pPassedData[ u64First ] ) + tPassedZero );
+			}
+
+			if ( bFirstOnly )
+			{
+				cResult.m_u64DiffCount = ( ( u64First != UINT64_MAX ) ? 1 : 0 );
+
+				if ( u64First != UINT64_MAX )
+				{
+					cResult.m_u64Pixels = ( u64First + 1 );
+				}
+
+				return cResult;
+			}
+
+			double gSum = 0.0;
+
+			cResult.m_i64MinDiff = INT64_MAX;
+			cResult.m_i64MaxDiff = INT64_MIN;
+
+			for ( const auto& tPartial : vPartial )
+			{
+				cResult.m_u64DiffCount += tPartial.u64Count;
+				gSum += tPartial.gSum;
+				cResult.m_i64MinDiff = std::min( cResult.m_i64MinDiff, tPartial.i64Min );
+				cResult.m_i64MaxDiff = std::max( cResult.m_i64MaxDiff, tPartial.i64Max );
+			}
+
+			//
+			// Matching pixels, including whole chunks skipped by the byte compare, are zero differences
+			//
+			if ( cResult.m_u64DiffCount < u64Pixels )
+			{
+				cResult.m_i64MinDiff = std::min<std::int64_t>( cResult.m_i64MinDiff, 0 );
+				cResult.m_i64MaxDiff = std::max<std::int64_t>( cResult.m_i64MaxDiff, 0 );
+			}
+
+			cResult.m_gMeanDiff = ( gSum / static_cast< double >( u64Pixels ) );
+
+			return cResult;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  reSize ( Single Image )                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Resizes a single image file by modifying the NAXES keyword and increasing the image data portion of     |
+		// |  the file.                                                                                               |
+		// |                                                                                                          |
+		// |  <IN> -> uiCols - The number of image columns the new file will have.                                    |
+		// |  <IN> -> uiRows - The number of image rows the new file will have.                                       |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcFitsFile<T>::reSize( const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			std::int32_t  iStatus = 0;
+
+			verifyFileHandle();
+
+			auto pParam = getParameters();
+
+			//
+			// Verify NAXIS parameter
+			//
+			if ( pParam->getNAxis() != 2 )
+			{
+				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+			}
+
+			*pParam->m_plCols = uiCols;
+			*pParam->m_plRows = uiRows;
+
+			fits_resize_img( m_pFits, pParam->m_iBpp, pParam->m_iNAxis, pParam->m_lNAxes, &iStatus );
+
+			m_bParamValid = false;
+
+			if ( iStatus )
+			{
+				throwFitsError( iStatus );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  write ( Single Image )                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Writes image data to a single image file.                                                               |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf - Pointer to the image data.                                                               |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcFitsFile<T>::write( T* pBuf )
+		{
+			std::int64_t i64NElements = 0;
+			std::int64_t i64FPixel = 1;
+			std::int32_t iStatus = 0;
+
+			verifyFileHandle();
+
+			//
+			// Verify buffer pointer
+			//
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid data buffer."s );
+			}
+
+			//
+			// Verify parameters
+			//
+			auto pParam = cachedParameters();
+
+			if ( pParam->getNAxis() != 2 )
+			{
+				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+			}
+
+			//
+			// Set number of pixels to write
+			//
+			i64NElements = ( static_cast<std::int64_t>( pParam->getCols() ) * static_cast< std::int64_t >( pParam->getRows() ) );
+
+			//
+			// Write image data. Rice compressed files are compressed here, in parallel.
+			//
+			if ( m_uiRiceTileRows > 0 )
+			{
+				writeRiceTiles( pBuf, pParam->getCols(), pParam->getRows() );
+			}
+
+			else
+			{
+				fits_write_img( m_pFits,
+								( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+								i64FPixel,
+								i64NElements,
+								pBuf,
+								&iStatus );
+
+				if ( iStatus )
+				{
+					throwFitsError( iStatus );
+				}
+			}
+
+			//
+			// Flush as set by the flush policy
+			//
+			flushIfDue( static_cast< std::uint64_t >( i64NElements ) * sizeof( T ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  write ( Single Image )                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Writes the specified number of bytes to a single image file. The start position of the data within the  |
+		// |  file image can be specified.                                                                            |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf		- Pointer to the data to write.                                                       |
+		// |  <IN> -> i64Bytes  - The number of bytes to write.                                                       |
+		// |  <IN> -> i64Pixel  - The start pixel within the file image. This parameter is optional. If -1, then the  |
+		// |                      next write position will be at zero.                                                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcFitsFile<T>::write( T* pBuf, const std::int64_t i64Bytes, const std::int64_t i64Pixel )
+		{
+			std::int64_t i64NElements = 0;
+			std::int32_t iStatus = 0;
+
+			bool bMultiWrite = false;
+
+			verifyFileHandle();
+
+			auto pParam = cachedParameters();
+
+			//
+			// Verify parameters
+			//
+			if ( pParam->getNAxis() != 2 )
+			{
+				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+			}
+
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid data buffer."s );
+			}
+
+			if ( i64Pixel >= static_cast< std::int64_t >( pParam->getCols() ) * static_cast< std::int64_t >( pParam->getRows() ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid start position, pixel position outside image size."s );
+			}
+
+			//
+			// Set the start pixel ( position ) within the file.
+			//
+			if ( i64Pixel < 0 && m_i64Pixel == 0 )
+			{
+				m_i64Pixel = 1;
+
+				bMultiWrite = true;
+			}
+
+			else if ( i64Pixel == 0 && m_i64Pixel != 0 )
+			{
+				m_i64Pixel = 1;
+
+				bMultiWrite = true;
+			}
+
+			else if ( i64Pixel < 0 && m_i64Pixel != 0 )
+			{
+				bMultiWrite = true;
+			}
+
+			else
+			{
+				m_i64Pixel = i64Pixel + 1;
+
+				bMultiWrite = false;
+			}
+
+			//
+			// Verify the start position
+			//
+			if ( m_i64Pixel >= static_cast< std::int64_t >( pParam->getCols() ) * static_cast< std::int64_t >( pParam->getRows() ) )
+			{
+				throwArcGen3Error( "Invalid start position, pixel position outside image size."s );
+			}
+
+			//
+			// Number of pixels to write
+			//
+			i64NElements = i64Bytes / static_cast<std::int64_t>( sizeof( T ) );
+
+			fits_write_img( m_pFits,
+							( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+							static_cast< LONGLONG >( m_i64Pixel ),
+							static_cast< LONGLONG >( i64NElements ),
+							pBuf,
+							&iStatus );
+
+			if ( iStatus )
+			{
+				throwFitsError( iStatus );
+			}
+
+			if ( bMultiWrite )
+			{
+				m_i64Pixel += i64NElements;
+			}
+
+			//
+			// Flush as set by the flush policy
+			//
+			flushIfDue( static_cast< std::uint64_t >( i64NElements ) * sizeof( T ) );
+
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  write ( Single Image )                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Writes an image view to a single image file. The view dimensions must match the file image. A           |
+		// |  contiguous view is written with a single call. A strided view is written one row at a time straight     |
+		// |  from the parent buffer, and the file is flushed once at the end.                                        |
+		// |                                                                                                          |
+		// |  <IN> -> cView - The image view to write.                                                                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcFitsFile<T>::write( const arc::gen3::CArcImageView<const T>& cView )
+		{
+			verifyFileHandle();
+
+			//
+			// Verify parameters
+			//
+			auto pParam = cachedParameters();
+
+			if ( pParam->getNAxis() != 2 )
+			{
+				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+			}
+
+			verifyView( cView, pParam );
+
+			//
+			// Write image data, either as a single block or a row at a time
+			//
+			writeView( cView, 1 );
+
+			//
+			// Flush as set by the flush policy
+			//
+			flushIfDue( static_cast< std::uint64_t >( cView.size() ) * sizeof( T ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  writeDirect ( Single Image )                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Writes a single image file without going through cfitsio, which converts and byte swaps each pixel      |
+		// |  through its own small buffers. The output is byte for byte what create() followed by write() produce:   |
+		// |  the cfitsio primary header ( padded with spaces ) and big-endian pixels offset by BZERO ( padded with   |
+		// |  zeros ) to a multiple of 2880 bytes.                                                                    |
+		// |                                                                                                          |
+		// |  The header and pixels are assembled in a 4 MB staging buffer aligned to 4 KB; the pixel conversion is   |
+		// |  one vectorized pass. Full chunks are written at aligned offsets, so O_DIRECT can be used; it is turned  |
+		// |  off for the final partial chunk. The file is preallocated first, so a full disk fails up front.         |
+		// |                                                                                                          |
+		// |  With checksums enabled, each converted chunk is added to the data sum before it is written. Once the    |
+		// |  data is done, the CHECKSUM and DATASUM cards are filled in and the header is written again.             |
+		// |                                                                                                          |
+		// |  <IN> -> tFileName - The file name. An existing file is replaced.                                        |
+		// |  <IN> -> pBuf      - Pointer to the image data.                                                          |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> pHeader   - Optional keywords to add after the mandatory ones. May be nullptr.                  |
+		// |  <IN> -> bDirectIO - true to bypass the page cache ( O_DIRECT ), where the file system supports it.      |
+		// |  <IN> -> bChecksum - true to add CHECKSUM and DATASUM keywords.                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFitsFile<T>::writeDirect( const std::filesystem::path& tFileName, const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows,
+										   const arc::gen3::fits::CHeaderTemplate* pHeader, [[maybe_unused]] const bool bDirectIO, const bool bChecksum )
+		{
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid data buffer."s );
+			}
+
+			if ( uiCols == 0 || uiRows == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid image size [ %u x %u ]! Both dimensions must be greater than zero!", uiCols, uiRows );
+			}
+
+			if ( tFileName.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid file name : %s", tFileName.string().c_str() );
+			}
+
+			//
+			// Build the primary header exactly as fits_create_img() writes it, then add the template
+			//
+			std::size_t szChecksumOffset = 0;
+
+			auto sHeader = imageHeader<T>( uiCols, uiRows, pHeader, bChecksum, szChecksumOffset );
+
+			std::uint64_t u64HeaderBytes = sHeader.size();
+
+			if ( u64HeaderBytes > DIRECT_CHUNK )
+			{
+				throwArcGen3InvalidArgument( "Invalid header size [ %u bytes ]! Must be %u bytes or less!", static_cast< std::uint32_t >( u64HeaderBytes ),
+											 static_cast< std::uint32_t >( DIRECT_CHUNK ) );
+			}
+
+			auto u64Pixels = ( static_cast< std::uint64_t >( uiCols ) * uiRows );
+
+			auto u64DataBytes = ( u64Pixels * sizeof( T ) );
+
+			auto u64FileBytes = ( u64HeaderBytes + fitsBlocks( u64DataBytes ) );
+
+			//
+			// Open and preallocate the file
+			//
+		#ifdef _WINDOWS
+
+			std::ofstream tFile( tFileName, std::ios::binary | std::ios::trunc );
+
+			if ( !tFile )
+			{
+				throwArcGen3Error( "Failed to create file : %s", tFileName.string().c_str() );
+			}
+
+			auto fnWrite = [ & ]( const std::uint8_t* pData, std::size_t szBytes, [[maybe_unused]] bool bLast )
+			{
+				if ( !tFile.write( reinterpret_cast< const char* >( pData ), static_cast< std::streamsize >( szBytes ) ) )
+				{
+					tFile.close();
+
+					ArcRemove( tFileName.string() );
+
+					throwArcGen3Error( "Failed to write file : %s", tFileName.string().c_str() );
+				}
+			};
+
+		#else
+
+			//
+			// An existing file is overwritten in place and trimmed at the end rather than truncated first, so the
+			// disk space of a pre-created file ( see CFilePool ) is reused
+			//
+			std::int32_t iFlags = ( O_WRONLY | O_CREAT );
+
+			std::int32_t iFd = -1;
+
+			if ( bDirectIO )
+			{
+				iFd = ::open( tFileName.c_str(), ( iFlags | O_DIRECT ), 0666 );
+			}
+
+			//
+			// Not all file systems support O_DIRECT ( e.g. tmpfs )
+			//
+			if ( iFd < 0 )
+			{
+				iFd = ::open( tFileName.c_str(), iFlags, 0666 );
+			}
+
+			if ( iFd < 0 )
+			{
+				throwArcGen3Error( "Failed to create file : %s [ %s ]", tFileName.c_str(), std::strerror( errno ) );
+			}
+
+			auto fnFail = [ & ]( std::int32_t iError )
+			{
+				::close( iFd );
+
+				ArcRemove( tFileName.string() );
+
+				throwArcGen3Error( "Failed to write file : %s [ %s ]", tFileName.c_str(), std::strerror( iError ) );
+			};
+
+			auto iError = posix_fallocate( iFd, 0, static_cast< off_t >( u64FileBytes ) );
+
+			if ( iError != 0 && iError != EOPNOTSUPP && iError != EINVAL )
+			{
+				fnFail( iError );
+			}
+
+			auto fnWrite = [ & ]( const std::uint8_t* pData, std::size_t szBytes, bool bLast )
+			{
+				//
+				// O_DIRECT needs whole blocks; the final chunk may end part way through one
+				//
+				if ( bLast && ( szBytes % DIRECT_ALIGN ) != 0 )
+				{
+					fcntl( iFd, F_SETFL, ( fcntl( iFd, F_GETFL ) & ~O_DIRECT ) );
+				}
+
+				while ( szBytes > 0 )
+				{
+					auto szWritten = ::write( iFd, pData, szBytes );
+
+					if ( szWritten < 0 && errno == EINTR )
+					{
+						continue;
+					}
+
+					if ( szWritten <= 0 )
+					{
+						fnFail( ( szWritten < 0 ) ? errno : EIO );
+					}
+
+					pData += szWritten;
+
+					szBytes -= static_cast< std::size_t >( szWritten );
+				}
+			};
+
+		#endif
+
+			//
+			// Stream the header, pixels and padding through the aligned staging buffer
+			//
+			std::vector<std::uint8_t> vStaging( DIRECT_CHUNK + DIRECT_ALIGN );
+
+			void* pAligned = vStaging.data();
+
+			std::size_t szSpace = vStaging.size();
+
+			auto pStaging = static_cast< std::uint8_t* >( std::align( DIRECT_ALIGN, DIRECT_CHUNK, pAligned, szSpace ) );
+
+			std::memcpy( pStaging, sHeader.data(), sHeader.size() );
+
+			std::size_t szFill = sHeader.size();
+
+			std::uint64_t u64Pixel = 0;
+
+			std::uint64_t u64Remaining = ( u64FileBytes - u64HeaderBytes );
+
+			std::uint32_t uiDataSum = 0;
+
+			while ( u64Remaining > 0 )
+			{
+				auto szChunk = static_cast< std::size_t >( std::min<std::uint64_t>( DIRECT_CHUNK - szFill, u64Remaining ) );
+
+				auto szPixels = static_cast< std::size_t >( std::min<std::uint64_t>( szChunk / sizeof( T ), u64Pixels - u64Pixel ) );
+
+				encodePixels( pBuf + u64Pixel, reinterpret_cast< T* >( pStaging + szFill ), szPixels );
+
+				if ( bChecksum )
+				{
+					uiDataSum = checksumAdd( uiDataSum, pStaging + szFill, szPixels * sizeof( T ), u64Pixel * sizeof( T ) );
+				}
+
+				//
+				// Zero padding after the last pixel
+				//
+				std::memset( pStaging + szFill + szPixels * sizeof( T ), 0, szChunk - szPixels * sizeof( T ) );
+
+				u64Pixel += szPixels;
+
+				u64Remaining -= szChunk;
+
+				szFill += szChunk;
+
+				if ( szFill == DIRECT_CHUNK || u64Remaining == 0 )
+				{
+					fnWrite( pStaging, szFill, ( u64Remaining == 0 ) );
+
+					szFill = 0;
+				}
+			}
+
+			//
+			// Rewrite the header with the checksums, now that the data sum is known
+			//
+			if ( bChecksum )
+			{
+				setChecksumCards( sHeader, szChecksumOffset, uiDataSum );
+
+			#ifdef _WINDOWS
+				tFile.seekp( 0 );
+			#else
+				fcntl( iFd, F_SETFL, ( fcntl( iFd, F_GETFL ) & ~O_DIRECT ) );
+
+				if ( ::lseek( iFd, 0, SEEK_SET ) != 0 )
+				{
+					fnFail( errno );
+				}
+			#endif
+
+				fnWrite( reinterpret_cast< const std::uint8_t* >( sHeader.data() ), sHeader.size(), true );
+			}
+
+		#ifdef _WINDOWS
+
+			tFile.close();
+
+			if ( !tFile )
+			{
+				ArcRemove( tFileName.string() );
+
+				throwArcGen3Error( "Failed to close file : %s", tFileName.string().c_str() );
+			}
+
+		#else
+
+			if ( ::ftruncate( iFd, static_cast< off_t >( u64FileBytes ) ) != 0 )
+			{
+				fnFail( errno );
+			}
+
+			if ( ::close( iFd ) != 0 )
+			{
+				ArcRemove( tFileName.string() );
+
+				throwArcGen3Error( "Failed to close file : %s [ %s ]", tFileName.c_str(), std::strerror( errno ) );
+			}
+
+		#endif
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  writeMEF                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Writes a deinterlaced frame as a multi-extension FITS file, one image extension per readout amplifier.  |
+		// |  The primary header has no data ( NAXIS = 0 ) and holds NEXTEND and any template keywords. Each          |
+		// |  extension header matches what fits_create_img() writes, plus EXTNAME, DATASEC and BIASSEC.              |
+		// |                                                                                                          |
+		// |  Every header and data size is known up front, so the file is created at its full size ( the data        |
+		// |  padding is the zero fill ) and each extension is then converted and written by its own thread at its    |
+		// |  own offset, straight from the frame buffer.                                                             |
+		// |                                                                                                          |
+		// |  With checksums enabled, the primary header is summed up front ( it has no data ), and each thread adds  |
+		// |  its converted rows to its extension's data sum and then writes its header again with the checksums.     |
+		// |                                                                                                          |
+		// |  <IN> -> tFileName - The file name. An existing file is replaced.                                        |
+		// |  <IN> -> pBuf      - Pointer to the deinterlaced frame.                                                  |
+		// |  <IN> -> uiCols    - The frame column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The frame row size ( in pixels ).                                                   |
+		// |  <IN> -> vAmps     - The amplifier regions, in extension order.                                          |
+		// |  <IN> -> pHeader   - Optional keywords to add to the primary header. May be nullptr.                     |
+		// |  <IN> -> bChecksum - true to add CHECKSUM and DATASUM keywords to every HDU.                             |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFitsFile<T>::writeMEF( const std::filesystem::path& tFileName, const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows,
+										const std::vector<arc::gen3::fits::AmpSection>& vAmps, const arc::gen3::fits::CHeaderTemplate* pHeader,
+										const bool bChecksum )
+		{
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid data buffer."s );
+			}
+
+			if ( uiCols == 0 || uiRows == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid image size [ %u x %u ]! Both dimensions must be greater than zero!", uiCols, uiRows );
+			}
+
+			if ( tFileName.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid file name : %s", tFileName.string().c_str() );
+			}
+
+			if ( vAmps.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid amplifier list! At least one amplifier region is required!"s );
+			}
+
+			//
+			// Verify that each section lies within its bounds
+			//
+			auto fnInside = []( const arc::gen3::fits::Point& lowerLeft, const arc::gen3::fits::Point& upperRight, long lCols, long lRows )
+			{
+				return ( lowerLeft.first >= 0 && lowerLeft.second >= 0 && lowerLeft.first <= upperRight.first &&
+						 lowerLeft.second <= upperRight.second && upperRight.first < lCols && upperRight.second < lRows );
+			};
+
+			auto fnSection = []( const arc::gen3::fits::Point& lowerLeft, const arc::gen3::fits::Point& upperRight )
+			{
+				return ( "["s + std::to_string( lowerLeft.first + 1 ) + ":" + std::to_string( upperRight.first + 1 ) + "," +
+						 std::to_string( lowerLeft.second + 1 ) + ":" + std::to_string( upperRight.second + 1 ) + "]" );
+			};
+
+			for ( const auto& tAmp : vAmps )
+			{
+				if ( !fnInside( tAmp.m_lowerLeft, tAmp.m_upperRight, static_cast< long >( uiCols ), static_cast< long >( uiRows ) ) )
+				{
+					throwArcGen3InvalidArgument( "Invalid region for amplifier %s! Must be within the %u x %u frame!", tAmp.m_sName.c_str(), uiCols, uiRows );
+				}
+
+				auto lCols = ( tAmp.m_upperRight.first - tAmp.m_lowerLeft.first + 1 );
+
+				auto lRows = ( tAmp.m_upperRight.second - tAmp.m_lowerLeft.second + 1 );
+
+				if ( !fnInside( tAmp.m_dataLowerLeft, tAmp.m_dataUpperRight, lCols, lRows ) ||
+					 ( tAmp.m_bBias && !fnInside( tAmp.m_biasLowerLeft, tAmp.m_biasUpperRight, lCols, lRows ) ) )
+				{
+					throwArcGen3InvalidArgument( "Invalid data or bias section for amplifier %s! Must be within its region!", tAmp.m_sName.c_str() );
+				}
+
+				if ( tAmp.m_sName.empty() || tAmp.m_sName.size() > HEADER_STRING_WIDTH ||
+					 std::any_of( tAmp.m_sName.begin(), tAmp.m_sName.end(), []( char c ) { return ( c < ' ' || c > '~' || c == '\'' ); } ) )
+				{
+					throwArcGen3InvalidArgument( "Invalid amplifier name \"%s\"! Must be 1 - %u printable characters, without quotes!",
+												 tAmp.m_sName.c_str(), HEADER_STRING_WIDTH );
+				}
+			}
+
+			//
+			// Build the primary header and the extension headers, and lay out the file
+			//
+			std::string sHeader;
+
+			appendValueCard( sHeader, "SIMPLE", "T", "file does conform to FITS standard" );
+			appendValueCard( sHeader, "BITPIX", std::to_string( sizeof( T ) * 8 ), "number of bits per data pixel" );
+			appendValueCard( sHeader, "NAXIS", "0", "number of data axes" );
+			appendValueCard( sHeader, "EXTEND", "T", "FITS dataset may contain extensions" );
+			appendCard( sHeader, FITS_COMMENT_1 );
+			appendCard( sHeader, FITS_COMMENT_2 );
+			appendValueCard( sHeader, "NEXTEND", std::to_string( vAmps.size() ), "number of extensions" );
+
+			std::uint32_t uiReserved = 0;
+
+			if ( pHeader != nullptr )
+			{
+				sHeader += pHeader->getCards();
+
+				uiReserved = pHeader->getReserved();
+			}
+
+			std::size_t szChecksumOffset = 0;
+
+			if ( bChecksum )
+			{
+				szChecksumOffset = appendChecksumCards( sHeader );
+			}
+
+			endHeader( sHeader, uiReserved );
+
+			if ( bChecksum )
+			{
+				setChecksumCards( sHeader, szChecksumOffset, 0 );
+			}
+
+			std::vector<std::string> vHeaders;
+
+			std::vector<std::uint64_t> vOffsets;
+
+			std::vector<std::size_t> vChecksumOffsets;
+
+			std::uint64_t u64FileBytes = sHeader.size();
+
+			for ( const auto& tAmp : vAmps )
+			{
+				auto lCols = ( tAmp.m_upperRight.first - tAmp.m_lowerLeft.first + 1 );
+
+				auto lRows = ( tAmp.m_upperRight.second - tAmp.m_lowerLeft.second + 1 );
+
+				std::string sExtHeader;
+
+				appendStringCard( sExtHeader, "XTENSION", "IMAGE", "IMAGE extension" );
+				appendValueCard( sExtHeader, "BITPIX", std::to_string( sizeof( T ) * 8 ), "number of bits per data pixel" );
+				appendValueCard( sExtHeader, "NAXIS", "2", "number of data axes" );
+				appendValueCard( sExtHeader, "NAXIS1", std::to_string( lCols ), "length of data axis 1" );
+				appendValueCard( sExtHeader, "NAXIS2", std::to_string( lRows ), "length of data axis 2" );
+				appendValueCard( sExtHeader, "PCOUNT", "0", "required keyword; must = 0" );
+				appendValueCard( sExtHeader, "GCOUNT", "1", "required keyword; must = 1" );
+				appendScalingCards<T>( sExtHeader );
+				appendStringCard( sExtHeader, "EXTNAME", tAmp.m_sName, "extension name" );
+				appendStringCard( sExtHeader, "DATASEC", fnSection( tAmp.m_dataLowerLeft, tAmp.m_dataUpperRight ), "image data section" );
+
+				if ( tAmp.m_bBias )
+				{
+					appendStringCard( sExtHeader, "BIASSEC", fnSection( tAmp.m_biasLowerLeft, tAmp.m_biasUpperRight ), "overscan section" );
+				}
+
+				vChecksumOffsets.push_back( bChecksum ? appendChecksumCards( sExtHeader ) : 0 );
+
+				endHeader( sExtHeader, 0 );
+
+				vOffsets.push_back( u64FileBytes );
+
+				u64FileBytes += ( sExtHeader.size() + fitsBlocks( static_cast< std::uint64_t >( lCols ) * lRows * sizeof( T ) ) );
+
+				vHeaders.push_back( std::move( sExtHeader ) );
+			}
+
+			//
+			// Create the file at its full size. The zero fill is the data padding.
+			//
+			{
+				std::ofstream tFile( tFileName, std::ios::binary | std::ios::trunc );
+
+				if ( !tFile )
+				{
+					throwArcGen3Error( "Failed to create file : %s", tFileName.string().c_str() );
+				}
+
+				tFile.write( sHeader.data(), static_cast< std::streamsize >( sHeader.size() ) );
+
+				tFile.close();
+
+				auto tError = preallocate( tFileName, u64FileBytes );
+
+				if ( !tFile || tError )
+				{
+					ArcRemove( tFileName.string() );
+
+					throwArcGen3Error( "Failed to write file : %s [ %s ]", tFileName.string().c_str(), tError.message().c_str() );
+				}
+			}
+
+			//
+			// Write the extensions in parallel, each from its region of the frame
+			//
+			auto fnWriteExtension = [ & ]( std::size_t szAmp )
+			{
+				const auto& tAmp = vAmps[ szAmp ];
+
+				auto szCols = static_cast< std::size_t >( tAmp.m_upperRight.first - tAmp.m_lowerLeft.first + 1 );
+
+				auto szRows = static_cast< std::size_t >( tAmp.m_upperRight.second - tAmp.m_lowerLeft.second + 1 );
+
+				std::fstream tFile( tFileName, std::ios::binary | std::ios::in | std::ios::out );
+
+				if ( !tFile )
+				{
+					throwArcGen3Error( "Failed to open file : %s", tFileName.string().c_str() );
+				}
+
+				tFile.seekp( static_cast< std::streamoff >( vOffsets[ szAmp ] ) );
+
+				tFile.write( vHeaders[ szAmp ].data(), static_cast< std::streamsize >( vHeaders[ szAmp ].size() ) );
+
+				auto szChunkRows = std::max<std::size_t>( 1, DIRECT_CHUNK / ( szCols * sizeof( T ) ) );
+
+				std::vector<T> vStaging( std::min( szChunkRows, szRows ) * szCols );
+
+				std::uint32_t uiDataSum = 0;
+
+				for ( std::size_t szRow = 0; szRow < szRows && tFile; szRow += szChunkRows )
+				{
+					auto szChunk = std::min( szChunkRows, szRows - szRow );
+
+					for ( std::size_t r = 0; r < szChunk; r++ )
+					{
+						auto pSrc = ( pBuf + ( static_cast< std::size_t >( tAmp.m_lowerLeft.second ) + szRow + r ) * uiCols + tAmp.m_lowerLeft.first );
+
+						encodePixels( pSrc, vStaging.data() + r * szCols, szCols );
+					}
+
+					if ( bChecksum )
+					{
+						uiDataSum = checksumAdd( uiDataSum, reinterpret_cast< const std::uint8_t* >( vStaging.data() ), szChunk * szCols * sizeof( T ),
+												 szRow * szCols * sizeof( T ) );
+					}
+
+					tFile.write( reinterpret_cast< const char* >( vStaging.data() ), static_cast< std::streamsize >( szChunk * szCols * sizeof( T ) ) );
+				}
+
+				if ( bChecksum && tFile )
+				{
+					setChecksumCards( vHeaders[ szAmp ], vChecksumOffsets[ szAmp ], uiDataSum );
+
+					tFile.seekp( static_cast< std::streamoff >( vOffsets[ szAmp ] ) );
+
+					tFile.write( vHeaders[ szAmp ].data(), static_cast< std::streamsize >( vHeaders[ szAmp ].size() ) );
+				}
+
+				tFile.close();
+
+				if ( !tFile )
+				{
+					throwArcGen3Error( "Failed to write extension %s to file : %s", tAmp.m_sName.c_str(), tFileName.string().c_str() );
+				}
+			};
+
+			std::vector<std::exception_ptr> vErrors( vAmps.size() );
+
+			std::vector<std::thread> vThreads;
+
+			try
+			{
+				for ( std::size_t i = 1; i < vAmps.size(); i++ )
+				{
+					vThreads.emplace_back( [ &, i ]()
+					{
+						try
+						{
+							fnWriteExtension( i );
+						}
+						catch ( ... )
+						{
+							vErrors[ i ] = std::current_exception();
+						}
+					} );
+				}
+
+				//
+				// The calling thread writes the first extension
+				//
+				fnWriteExtension( 0 );
+			}
+			catch ( ... )
+			{
+				vErrors[ 0 ] = std::current_exception();
+			}
+
+			for ( auto& tThread : vThreads )
+			{
+				tThread.join();
+			}
+
+			for ( const auto& pError : vErrors )
+			{
+				if ( pError )
+				{
+					ArcRemove( tFileName.string() );
+
+					std::rethrow_exception( pError );
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  writeSubImage ( Single Image )                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Writes a sub-image of the specified buffer to a single image file.                                      |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	          - The pixel data.                                                               |
+		// |  <IN> -> lowerLeftPoint  - The lower left point { col, row } of the sub-image.                           |
+		// |  <IN> -> upperRightPoint - The upper right point { col, row } of the sub-image.                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFitsFile<T>::writeSubImage( T* pBuf, const arc::gen3::fits::Point& lowerLeftPoint, const arc::gen3::fits::Point& upperRightPoint )
+		{
+			std::int32_t iStatus = 0;
+
+			verifyFileHandle();
+
+			auto pParam = cachedParameters();
+
+			//
+			// Verify parameters
+			//
+			if ( pParam->getNAxis() != 2 )
+			{
+				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+			}
+
+			if ( lowerLeftPoint.second > upperRightPoint.second )
+			{
+				throwArcGen3InvalidArgument( "Invalid LOWER LEFT ROW parameter!"s );
+			}
+
+			if ( lowerLeftPoint.first > upperRightPoint.first )
+			{
+				throwArcGen3InvalidArgument( "Invalid LOWER LEFT COLUMN parameter!"s );
+			}
+
+			if ( lowerLeftPoint.second < 0 || lowerLeftPoint.second >= static_cast< long >( pParam->getRows() ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid LOWER LEFT ROW parameter!"s );
+			}
+
+			if ( upperRightPoint.second < 0 || upperRightPoint.second >= static_cast< long >( pParam->getRows() ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid UPPER RIGHT ROW parameter!"s );
+			}
+
+			if ( lowerLeftPoint.first < 0 || lowerLeftPoint.first >= static_cast< long >( pParam->getCols() ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid LOWER LEFT COLUMN parameter!"s );
+			}
+
+			if ( upperRightPoint.first < 0 || upperRightPoint.first >= static_cast< long >( pParam->getCols() ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid UPPER RIGHT COLUMN parameter!"s );
+			}
+
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid data buffer."s );
+			}
+
+			//
+			// Set the subset start pixels
+			//
+			long lFirstPixel[] = { lowerLeftPoint.first + 1, lowerLeftPoint.second + 1 };
+			long lLastPixel[] = { upperRightPoint.first + 1, upperRightPoint.second + 1 };
+
+			fits_write_subset( m_pFits,
+							   ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+							   lFirstPixel,
+							   lLastPixel,
+							   pBuf,
+							   &iStatus );
+
+			if ( iStatus )
+			{
+				throwFitsError( iStatus );
+			}
+
+			//
+			// Flush as set by the flush policy
+			//
+			flushIfDue( static_cast< std::uint64_t >( lLastPixel[ 0 ] - lFirstPixel[ 0 ] + 1 ) * static_cast< std::uint64_t >( lLastPixel[ 1 ] - lFirstPixel[ 1 ] + 1 ) * sizeof( T ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  writeSubImage ( Single Image )                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Writes an image view as a sub-image of a single image file. A strided view is written one row at a      |
+		// |  time straight from the parent buffer, and the file is flushed once at the end.                          |
+		// |                                                                                                          |
+		// |  <IN> -> cView - The image view to write. Its size is the size of the sub-image.                         |
+		// |  <IN> -> uiCol - The sub-image start column.                                                             |
+		// |  <IN> -> uiRow - The sub-image start row.                                                                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFitsFile<T>::writeSubImage( const arc::gen3::CArcImageView<const T>& cView, const std::uint32_t uiCol, const std::uint32_t uiRow )
+		{
+			std::int32_t iStatus = 0;
+
+			verifyFileHandle();
+
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )."s );
+			}
+
+			auto pParam = cachedParameters();
+
+			if ( pParam->getNAxis() != 2 )
+			{
+				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+			}
+
+			auto uiCols = static_cast< std::uint32_t >( pParam->getCols() );
+			auto uiRows = static_cast< std::uint32_t >( pParam->getRows() );
+
+			if ( uiCol >= uiCols || uiRow >= uiRows || cView.cols() > ( uiCols - uiCol ) || cView.rows() > ( uiRows - uiRow ) )
+			{
+				throwArcGen3InvalidArgument( "Sub-image [ %u x %u ] at [ %u, %u ] is outside the image [ %u x %u ]!",
+											 cView.cols(), cView.rows(), uiCol, uiRow, uiCols, uiRows );
+			}
+
+			//
+			// Write the sub-image, either as a single block or a row at a time
+			//
+			std::uint32_t uiBlocks = ( cView.isContiguous() ? 1 : cView.rows() );
+
+			long lBlockRows = static_cast< long >( cView.isContiguous() ? cView.rows() : 1 );
+
+			for ( std::uint32_t uiBlock = 0; uiBlock < uiBlocks; uiBlock++ )
+			{
+				long lFirstPixel[] = { static_cast< long >( uiCol ) + 1, static_cast< long >( uiRow + uiBlock ) + 1 };
+				long lLastPixel[] = { static_cast< long >( uiCol + cView.cols() ), static_cast< long >( uiRow + uiBlock ) + lBlockRows };
+
+				fits_write_subset( m_pFits,
+								   ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+								   lFirstPixel,
+								   lLastPixel,
+								   const_cast< T* >( cView.row( uiBlock ) ),
+								   &iStatus );
+
+				if ( iStatus )
+				{
+					throwFitsError( iStatus );
+				}
+			}
+
+			//
+			// Flush as set by the flush policy
+			//
+			flushIfDue( static_cast< std::uint64_t >( cView.size() ) * sizeof( T ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  readSubImage ( Single Image )                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Reads a sub-image from a single image file.                                                             |
+		// |                                                                                                          |
+		// |  <IN> -> lowerLeftPoint  - The lower left point { col, row } of the sub-image.                           |
+		// |  <IN> -> upperRightPoint - The upper right point { col, row } of the sub-image.                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>>
+		CArcFitsFile<T>::readSubImage( arc::gen3::fits::Point lowerLeftPoint, arc::gen3::fits::Point upperRightPoint )
+		{
+			std::int32_t iStatus = 0;
+			std::int32_t iAnyNul = 0;
+
+			verifyFileHandle();
+
+			auto pParam = getParameters();
+			
+			//
+			// Verify parameters
+			//
+			if ( pParam->getNAxis() != 2 )
+			{
+				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+			}
+
+			if ( lowerLeftPoint.second > upperRightPoint.second )
+			{
+				throwArcGen3InvalidArgument( "Invalid LOWER LEFT ROW parameter!"s );
+			}
+
+			if ( lowerLeftPoint.first > upperRightPoint.first )
+			{
+				throwArcGen3InvalidArgument( "Invalid LOWER LEFT COLUMN parameter!"s );
+			}
+
+			if ( lowerLeftPoint.second < 0 || lowerLeftPoint.second >= static_cast< long >( pParam->getRows() ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid LOWER LEFT ROW parameter!"s );
+			}
+
+			if ( upperRightPoint.second < 0 || upperRightPoint.second >= static_cast< long >( pParam->getRows() ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid UPPER RIGHT ROW parameter!"s );
+			}
+
+			if ( lowerLeftPoint.first < 0 || lowerLeftPoint.first >= static_cast< long >( pParam->getCols() ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid LOWER LEFT COLUMN parameter!"s );
+			}
+
+			if ( upperRightPoint.first < 0 || upperRightPoint.first >= static_cast< long >( pParam->getCols() ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid UPPER RIGHT COLUMN parameter!"s );
+			}
+
+			if ( upperRightPoint.first == static_cast< long >( pParam->getCols() ) )
+			{
+				upperRightPoint.first = ( static_cast< long >( pParam->getCols() ) - 1 );
+			}
+
+			if ( upperRightPoint.second == static_cast< long >( pParam->getRows() ) )
+			{
+				upperRightPoint.second = ( static_cast< long >( pParam->getRows() ) - 1 );
+			}
+
+			//
+			// Set the subset start pixels
+			//
+			long lFirstPixel[] = { lowerLeftPoint.first + 1, lowerLeftPoint.second + 1 };
+			long lLastPixel[] = { upperRightPoint.first + 1, upperRightPoint.second + 1 };
+
+			//
+			// The read routine also has an inc parameter which can be used to
+			// read only every inc-th pixel along each dimension of the image.
+			// Normally inc[0] = inc[1] = 1 to read every pixel in a 2D image.
+			// To read every other pixel in the entire 2D image, set 
+			//
+			long lInc[] = { 1, 1 };
+
+			//
+			// Set the data length ( in pixels )
+			//
+			std::uint32_t uiDataLength = static_cast< std::uint32_t >( ( lLastPixel[ 0 ] - lFirstPixel[ 0 ] + 1 ) * ( lLastPixel[ 1 ] - lFirstPixel[ 1 ] + 1 ) );
+
+			std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>> pSubBuf( new T[ uiDataLength ], arc::gen3::fits::ArrayDeleter<T>() );
+
+			if ( pSubBuf.get() == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate buffer for image pixel data."s );
+			}
+
+			fits_read_subset( m_pFits,
+							 ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+							 lFirstPixel,
+							 lLastPixel,
+							 lInc,
+							 0,
+							 pSubBuf.get(),
+							 &iAnyNul,
+							 &iStatus );
+
+			if ( iStatus )
+			{
+				throwFitsError( iStatus );
+			}
+
+			return pSubBuf;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  readSubImage ( Single Image )                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Reads a sub-image from a single image file into an image view. Nothing is allocated. A strided view is  |
+		// |  filled one row at a time.                                                                               |
+		// |                                                                                                          |
+		// |  <IN> -> cView - The image view that receives the sub-image. Its size is the size of the sub-image.      |
+		// |  <IN> -> uiCol - The sub-image start column.                                                             |
+		// |  <IN> -> uiRow - The sub-image start row.                                                                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFitsFile<T>::readSubImage( const arc::gen3::CArcImageView<T>& cView, const std::uint32_t uiCol, const std::uint32_t uiRow )
+		{
+			std::int32_t iStatus = 0;
+			std::int32_t iAnyNul = 0;
+
+			verifyFileHandle();
+
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )."s );
+			}
+
+			auto pParam = cachedParameters();
+
+			if ( pParam->getNAxis() != 2 )
+			{
+				throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+			}
+
+			auto uiCols = static_cast< std::uint32_t >( pParam->getCols() );
+			auto uiRows = static_cast< std::uint32_t >( pParam->getRows() );
+
+			if ( uiCol >= uiCols || uiRow >= uiRows || cView.cols() > ( uiCols - uiCol ) || cView.rows() > ( uiRows - uiRow ) )
+			{
+				throwArcGen3InvalidArgument( "Sub-image [ %u x %u ] at [ %u, %u ] is outside the image [ %u x %u ]!",
+											 cView.cols(), cView.rows(), uiCol, uiRow, uiCols, uiRows );
+			}
+
+			long lInc[] = { 1, 1 };
+
+			//
+			// Read the sub-image, either as a single block or a row at a time
+			//
+			std::uint32_t uiBlocks = ( cView.isContiguous() ? 1 : cView.rows() );
+
+			long lBlockRows = static_cast< long >( cView.isContiguous() ? cView.rows() : 1 );
+
+			for ( std::uint32_t uiBlock = 0; uiBlock < uiBlocks; uiBlock++ )
+			{
+				long lFirstPixel[] = { static_cast< long >( uiCol ) + 1, static_cast< long >( uiRow + uiBlock ) + 1 };
+				long lLastPixel[] = { static_cast< long >( uiCol + cView.cols() ), static_cast< long >( uiRow + uiBlock ) + lBlockRows };
+
+				fits_read_subset( m_pFits,
+								 ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+								 lFirstPixel,
+								 lLastPixel,
+								 lInc,
+								 0,
+								 cView.row( uiBlock ),
+								 &iAnyNul,
+								 &iStatus );
+
+				if ( iStatus )
+				{
+					throwFitsError( iStatus );
+				}
+			}
+		}
+
+
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Read ( Single Image )                                                                                   |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Read the image from a single image file. Returns a pointer to the image data.                           |
+			// |                                                                                                          |
+			// |  Throws std::runtime_error, std::invalid_argument                                                        |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>> CArcFitsFile<T>::read( void )
+			{
+				std::int32_t iStatus = 0;
+
+				verifyFileHandle();
+
+				auto pParam = getParameters();
+
+				//
+				// Verify NAXIS parameter
+				//
+				if ( pParam->getNAxis() != 2 )
+				{
+					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+				}
+
+				//
+				// Set the data length ( in pixels )
+				//
+				std::uint32_t uiDataLength = ( pParam->getCols() * pParam->getRows() );
+
+				std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>> pImgBuf( new T[ uiDataLength ], arc::gen3::fits::ArrayDeleter<T>() );
+
+				if ( pImgBuf.get() == nullptr )
+				{
+					throwArcGen3Error( "Failed to allocate buffer for image pixel data."s );
+				}
+
+				//
+				// Read the image data
+				//
+				fits_read_img( m_pFits,
+							  ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+							  1,
+							  static_cast< long >( uiDataLength ),
+							  nullptr,
+							  pImgBuf.get(),
+							  nullptr,
+							  &iStatus );
+
+				if ( iStatus )
+				{
+					throwFitsError( iStatus );
+				}
+
+				return pImgBuf;
+			}
+
+
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Read ( Single Image )                                                                                   |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Read the image from a single image file into the user supplied buffer.                                  |
+			// |                                                                                                          |
+			// |  <IN> -> pBuf   - A pointer to the user supplied image buffer.                                           |
+			// |  <IN> -> uiCols - The column length of the user image buffer ( in pixels ).                              |
+			// |  <IN> -> uiRows - The row length of the user image buffer ( in pixels ).                                 |
+			// |                                                                                                          |
+			// |  Throws std::runtime_error, std::invalid_argument, std::length_error                                     |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> void CArcFitsFile<T>::read( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+			{
+				std::int32_t iStatus = 0;
+
+				verifyFileHandle();
+
+				auto pParam = getParameters();
+
+				//
+				// Verify NAXIS parameter
+				//
+				if ( pParam->getNAxis() != 2 )
+				{
+					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+				}
+
+				//
+				// Set the data length ( in pixels )
+				//
+				std::uint32_t uiDataLength = ( pParam->getCols() * pParam->getRows() );
+
+				//
+				// Verify the buffer dimensions
+				//
+				if ( uiDataLength > ( uiCols * uiRows ) )
+				{
+					throwArcGen3LengthError( "Error, user supplied buffer is too small. Expected: %d bytes, Supplied: %d bytes.", uiDataLength, ( uiCols * uiRows ) );
+				}
+
+				if ( pBuf == nullptr )
+				{
+					throwArcGen3InvalidArgument( "Invalid image buffer parameter ( nullptr )."s );
+				}
+
+				//
+				// Read the image data
+				//
+				fits_read_img( m_pFits,
+							   ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+							   1,
+							   static_cast< long >( uiDataLength ),
+							   nullptr,
+							   pBuf,
+							   nullptr,
+							   &iStatus );
+
+				if ( iStatus )
+				{
+					throwFitsError( iStatus );
+				}
+			}
+
+
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Read ( Single Image )                                                                                   |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Read the image from a single image file into an image view. The view dimensions must match the file     |
+			// |  image. A strided view is filled one row at a time.                                                      |
+			// |                                                                                                          |
+			// |  <IN> -> cView - The image view that receives the image.                                                 |
+			// |                                                                                                          |
+			// |  Throws std::runtime_error, std::invalid_argument                                                        |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> void CArcFitsFile<T>::read( const arc::gen3::CArcImageView<T>& cView )
+			{
+				verifyFileHandle();
+
+				auto pParam = getParameters();
+
+				//
+				// Verify NAXIS parameter
+				//
+				if ( pParam->getNAxis() != 2 )
+				{
+					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+				}
+
+				verifyView( cView, pParam.get() );
+
+				//
+				// Read the image data, either as a single block or a row at a time
+				//
+				readView( cView, 1 );
+			}
+
+
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  write3D ( Data Cube )                                                                                   |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Writes an image to the end of a data cube file.                                                         |
+			// |                                                                                                          |
+			// |  <IN> -> pBuf - A pointer to the image data.                                                             |
+			// |                                                                                                          |
+			// |  Throws std::runtime_error, std::invalid_argument                                                        |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> void CArcFitsFile<T>::write3D( T* pBuf )
+			{
+				std::int64_t i64NElements = 0;
+				std::int32_t iStatus = 0;
+
+				verifyFileHandle();
+
+				auto pParam = cachedParameters();
+
+				*pParam->m_plFrames = ++m_iFrame;
+
+				//
+				// Verify parameters
+				//
+				if ( pParam->getNAxis() != 3 )
+				{
+					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a FITS data cube."s );
+				}
+
+				if ( pBuf == nullptr )
+				{
+					throwArcGen3InvalidArgument( "Invalid data buffer ( write3D )."s );
+				}
+
+				//
+				// Set number of pixels to write
+				//
+				i64NElements = static_cast< std::int64_t >( pParam->getCols() ) * static_cast< std::int64_t >( pParam->getRows() );
+
+				if ( m_i64Pixel == 0 )
+				{
+					m_i64Pixel = 1;
+				}
+
+				fits_write_img( m_pFits,
+								( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+								m_i64Pixel,
+								i64NElements,
+								pBuf,
+								&iStatus );
+
+				if ( iStatus )
+				{
+					throwFitsError( iStatus );
+				}
+
+				//
+				// Update the start pixel
+				//
+				m_i64Pixel += i64NElements;
+
+				//
+				// Increment the image number and update the key
+				//
+				fits_update_key( m_pFits, TINT, "NAXIS3", &m_iFrame, nullptr, &iStatus );
+
+				if ( iStatus )
+				{
+					throwFitsError( iStatus );
+				}
+
+				//
+				// Flush as set by the flush policy
+				//
+				flushIfDue( static_cast< std::uint64_t >( i64NElements ) * sizeof( T ) );
+			}
+
+
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  write3D ( Data Cube )                                                                                   |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Writes an image view to the end of a data cube file. The view dimensions must match the data cube       |
+			// |  image. A strided view is written one row at a time straight from the parent buffer.                     |
+			// |                                                                                                          |
+			// |  <IN> -> cView - The image view to write.                                                                |
+			// |                                                                                                          |
+			// |  Throws std::runtime_error, std::invalid_argument                                                        |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> void CArcFitsFile<T>::write3D( const arc::gen3::CArcImageView<const T>& cView )
+			{
+				std::int32_t iStatus = 0;
+
+				verifyFileHandle();
+
+				auto pParam = cachedParameters();
+
+				//
+				// Verify parameters
+				//
+				if ( pParam->getNAxis() != 3 )
+				{
+					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a FITS data cube."s );
+				}
+
+				verifyView( cView, pParam );
+
+				if ( m_i64Pixel == 0 )
+				{
+					m_i64Pixel = 1;
+				}
+
+				writeView( cView, m_i64Pixel );
+
+				//
+				// Update the start pixel
+				//
+				m_i64Pixel += static_cast< std::int64_t >( cView.size() );
+
+				//
+				// Increment the image number and update the key
+				//
+				*pParam->m_plFrames = ++m_iFrame;
+
+				fits_update_key( m_pFits, TINT, "NAXIS3", &m_iFrame, nullptr, &iStatus );
+
+				if ( iStatus )
+				{
+					throwFitsError( iStatus );
+				}
+
+				//
+				// Flush as set by the flush policy
+				//
+				flushIfDue( static_cast< std::uint64_t >( cView.size() ) * sizeof( T ) );
+			}
+
+
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  reWrite3D ( Data Cube )                                                                                 |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Re-writes an existing image in a FITS data cube. The image data MUST match in size to the exising       |
+			// |  images within the data cube. The image size is NOT checked for by this method.                          |
+			// |                                                                                                          |
+			// |  <IN> -> pBuf			- A pointer to the image data.                                                    |
+			// |  <IN> -> uiImageNumber	- The number of the data cube image to replace.                                   |
+			// |                                                                                                          |
+			// |  Throws std::runtime_error, std::invalid_argument                                                        |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> void CArcFitsFile<T>::reWrite3D( T* pBuf, const std::uint32_t uiImageNumber )
+			{
+				std::int64_t i64NElements = 0;
+				std::int64_t i64Pixel = 0;
+				std::int32_t iStatus = 0;
+
+				verifyFileHandle();
+
+				auto pParam = cachedParameters();
+
+				//
+				// Verify parameters
+				//
+				if ( pParam->getNAxis() != 3 )
+				{
+					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a FITS data cube."s );
+				}
+
+				if ( pBuf == nullptr )
+				{
+					throwArcGen3InvalidArgument( "Invalid data buffer."s );
+				}
+
+				//
+				// Set number of pixels to write; also set the start position
+				//
+				i64NElements = static_cast< std::int64_t >( pParam->getCols() ) * static_cast< std::int64_t >( pParam->getRows() );
+
+				i64Pixel = i64NElements * uiImageNumber + 1;
+
+				fits_write_img( m_pFits,
+								( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+								i64Pixel,
+								i64NElements,
+								pBuf,
+								&iStatus );
 
-			if ( upperRightPoint.first == static_cast< long >( pParam->getCols() ) )
-			{
-				upperRightPoint.first = ( static_cast< long >( pParam->getCols() ) - 1 );
-			}
+				if ( iStatus )
+				{
+					throwFitsError( iStatus );
+				}
 
-			if ( upperRightPoint.second == static_cast< long >( pParam->getRows() ) )
-			{
-				upperRightPoint.second = ( static_cast< long >( pParam->getRows() ) - 1 );
+				//
+				// Flush as set by the flush policy
+				//
+				flushIfDue( static_cast< std::uint64_t >( i64NElements ) * sizeof( T ) );
 			}
 
-			//
-			// Set the subset start pixels
-			//
-			long lFirstPixel[] = { lowerLeftPoint.first + 1, lowerLeftPoint.second + 1 };
-			long lLastPixel[] = { upperRightPoint.first + 1, upperRightPoint.second + 1 };
 
-			//
-			// The read routine also has an inc parameter which can be used to
-			// read only every inc-th pixel along each dimension of the image.
-			// Normally inc[0] = inc[1] = 1 to read every pixel in a 2D image.
-			// To read every other pixel in the entire 2D image, set 
-			//
-			long lInc[] = { 1, 1 };
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  reWrite3D ( Data Cube )                                                                                 |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Re-writes an existing image in a FITS data cube from an image view. Unlike the pointer version, the     |
+			// |  view size is checked against the data cube image.                                                       |
+			// |                                                                                                          |
+			// |  <IN> -> cView			- The image view to write.                                                        |
+			// |  <IN> -> uiImageNumber	- The number of the data cube image to replace.                                   |
+			// |                                                                                                          |
+			// |  Throws std::runtime_error, std::invalid_argument                                                        |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> void CArcFitsFile<T>::reWrite3D( const arc::gen3::CArcImageView<const T>& cView, const std::uint32_t uiImageNumber )
+			{
+				verifyFileHandle();
 
-			//
-			// Set the data length ( in pixels )
-			//
-			std::uint32_t uiDataLength = ( pParam->getCols() * pParam->getRows() );
+				auto pParam = cachedParameters();
 
-			std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>> pSubBuf( new T[ uiDataLength ], arc::gen3::fits::ArrayDeleter<T>() );
+				//
+				// Verify parameters
+				//
+				if ( pParam->getNAxis() != 3 )
+				{
+					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a FITS data cube."s );
+				}
 
-			if ( pSubBuf.get() == nullptr )
-			{
-				throwArcGen3Error( "Failed to allocate buffer for image pixel data."s );
-			}
+				verifyView( cView, pParam );
 
-			fits_read_subset( m_pFits,
-							 ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
-							 lFirstPixel,
-							 lLastPixel,
-							 lInc,
-							 0,
-							 pSubBuf.get(),
-							 &iAnyNul,
-							 &iStatus );
+				writeView( cView, static_cast< std::int64_t >( cView.size() * uiImageNumber + 1 ) );
 
-			if ( iStatus )
-			{
-				throwFitsError( iStatus );
+				//
+				// Flush as set by the flush policy
+				//
+				flushIfDue( static_cast< std::uint64_t >( cView.size() ) * sizeof( T ) );
 			}
 
-			return pSubBuf;
-		}
-
 
 			// +----------------------------------------------------------------------------------------------------------+
-			// |  Read ( Single Image )                                                                                   |
+			// |  read3D ( Data Cube )                                                                                    |
 			// +----------------------------------------------------------------------------------------------------------+
-			// |  Read the image from a single image file. Returns a pointer to the image data.                           |
+			// |  Reads an image from a data cube file.                                                                   |
+			// |                                                                                                          |
+			// |  <IN>  -> uiImageNumber - The image number to read.                                                      |
 			// |                                                                                                          |
 			// |  Throws std::runtime_error, std::invalid_argument                                                        |
 			// +----------------------------------------------------------------------------------------------------------+
-			template <typename T> std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>> CArcFitsFile<T>::read( void )
+			template <typename T>
+			std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>> CArcFitsFile<T>::read3D( const std::uint32_t uiImageNumber )
 			{
+				std::size_t  iNElements = 0;
+				std::int64_t i64Pixel = 0;
 				std::int32_t iStatus = 0;
 
 				verifyFileHandle();
 
 				auto pParam = getParameters();
 
+				if ( pParam->getNAxis() != 3 )
+				{
+					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a FITS data cube."s );
+				}
+
 				//
-				// Verify NAXIS parameter
+				// Verify parameters
 				//
-				if ( pParam->getNAxis() != 2 )
+				if ( ( uiImageNumber + 1 ) > pParam->getFrames() )
 				{
-					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+					throwArcGen3InvalidArgument( "Invalid image number. File contains %u images.", pParam->getFrames() );
 				}
 
 				//
-				// Set the data length ( in pixels )
+				// Set number of pixels to read
 				//
-				std::uint32_t uiDataLength = ( pParam->getCols() * pParam->getRows() );
+				iNElements = static_cast< std::size_t >( pParam->getCols() ) * static_cast< std::size_t >( pParam->getRows() );
 
-				std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>> pImgBuf( new T[ uiDataLength ], arc::gen3::fits::ArrayDeleter<T>() );
+				i64Pixel = static_cast<std::int64_t>( iNElements * uiImageNumber + 1U );
+
+				std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>> pImgBuf( new T[ iNElements ], arc::gen3::fits::ArrayDeleter<T>() );
 
 				if ( pImgBuf.get() == nullptr )
 				{
@@ -1709,13 +5167,13 @@ namespace arc
 				// Read the image data
 				//
 				fits_read_img( m_pFits,
-							  ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
-							  1,
-							  static_cast< long >( uiDataLength ),
-							  nullptr,
-							  pImgBuf.get(),
-							  nullptr,
-							  &iStatus );
+							   ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+							   i64Pixel,
+							   static_cast<LONGLONG>( iNElements ),
+							   nullptr,
+							   pImgBuf.get(),
+							   nullptr,
+							   &iStatus );
 
 				if ( iStatus )
 				{
@@ -1727,323 +5185,542 @@ namespace arc
 
 
 			// +----------------------------------------------------------------------------------------------------------+
-			// |  Read ( Single Image )                                                                                   |
+			// |  read3D ( Data Cube )                                                                                    |
 			// +----------------------------------------------------------------------------------------------------------+
-			// |  Read the image from a single image file into the user supplied buffer.                                  |
+			// |  Reads an image from a data cube file into an image view. Nothing is allocated. The view dimensions      |
+			// |  must match the data cube image. A strided view is filled one row at a time.                             |
 			// |                                                                                                          |
-			// |  <IN> -> pBuf   - A pointer to the user supplied image buffer.                                           |
-			// |  <IN> -> uiCols - The column length of the user image buffer ( in pixels ).                              |
-			// |  <IN> -> uiRows - The row length of the user image buffer ( in pixels ).                                 |
+			// |  <IN> -> cView			- The image view that receives the image.                                         |
+			// |  <IN> -> uiImageNumber	- The image number to read.                                                       |
 			// |                                                                                                          |
-			// |  Throws std::runtime_error, std::invalid_argument, std::length_error                                     |
+			// |  Throws std::runtime_error, std::invalid_argument                                                        |
 			// +----------------------------------------------------------------------------------------------------------+
-			template <typename T> void CArcFitsFile<T>::read( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+			template <typename T> void CArcFitsFile<T>::read3D( const arc::gen3::CArcImageView<T>& cView, const std::uint32_t uiImageNumber )
 			{
-				std::int32_t iStatus = 0;
-
 				verifyFileHandle();
 
 				auto pParam = getParameters();
 
-				//
-				// Verify NAXIS parameter
-				//
-				if ( pParam->getNAxis() != 2 )
+				if ( pParam->getNAxis() != 3 )
 				{
-					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a file containing a single image."s );
+					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a FITS data cube."s );
 				}
 
 				//
-				// Set the data length ( in pixels )
+				// Verify parameters
 				//
-				std::uint32_t uiDataLength = ( pParam->getCols() * pParam->getRows() );
+				if ( ( uiImageNumber + 1 ) > pParam->getFrames() )
+				{
+					throwArcGen3InvalidArgument( "Invalid image number. File contains %u images.", pParam->getFrames() );
+				}
+
+				verifyView( cView, pParam.get() );
+
+				readView( cView, static_cast< std::int64_t >( cView.size() * uiImageNumber + 1 ) );
+			}
+
+
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  mapImage                                                                                                |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Memory maps the image data of the open file, read only. Unlike read(), read3D() and readSubImage(),     |
+			// |  nothing is allocated, read or converted here; see arc::gen3::fits::CMappedImage. Valid for              |
+			// |  uncompressed disk files with BITPIX matching this class ( 16 or 32 ), BSCALE = 1 and an integer BZERO.  |
+			// |  Any buffered writes are flushed first so the mapping sees them.                                         |
+			// |                                                                                                          |
+			// |  Throws std::runtime_error, std::invalid_argument                                                        |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> std::unique_ptr<arc::gen3::fits::CMappedImage<T>> CArcFitsFile<T>::mapImage( void )
+			{
+				std::int32_t iStatus = 0;
+				std::int32_t iBitpix = 0;
+
+				double gZero = 0.0;
+				double gScale = 1.0;
+
+				LONGLONG llHeadStart = 0;
+				LONGLONG llDataStart = 0;
+				LONGLONG llDataEnd = 0;
+
+				verifyFileHandle();
+
+				if ( fits_is_compressed_image( m_pFits, &iStatus ) )
+				{
+					throwArcGen3InvalidArgument( "Tile compressed images cannot be memory mapped!"s );
+				}
+
+				fits_get_img_type( m_pFits, &iBitpix, &iStatus );
+
+				if ( iStatus )
+				{
+					throwFitsError( iStatus );
+				}
+
+				if ( iBitpix != static_cast< std::int32_t >( sizeof( T ) * 8 ) )
+				{
+					throwArcGen3InvalidArgument( "Invalid BITPIX [ %d ]! Must be %d to map this image!", iBitpix, static_cast< std::int32_t >( sizeof( T ) * 8 ) );
+				}
+
+				auto pParam = getParameters();
+
+				if ( pParam->getNAxis() != 2 && pParam->getNAxis() != 3 )
+				{
+					throwArcGen3InvalidArgument( "Invalid NAXIS value [ %u ]! Must be 2 or 3!", pParam->getNAxis() );
+				}
 
 				//
-				// Verify the buffer dimensions
+				// Read the scaling keywords; either may be missing
 				//
-				if ( uiDataLength > ( uiCols * uiRows ) )
+				fits_read_key( m_pFits, TDOUBLE, "BZERO", &gZero, nullptr, &iStatus );
+
+				if ( iStatus == KEY_NO_EXIST )
 				{
-					throwArcGen3LengthError( "Error, user supplied buffer is too small. Expected: %d bytes, Supplied: %d bytes.", uiDataLength, ( uiCols * uiRows ) );
+					iStatus = 0;
 				}
 
-				if ( pBuf == nullptr )
+				fits_read_key( m_pFits, TDOUBLE, "BSCALE", &gScale, nullptr, &iStatus );
+
+				if ( iStatus == KEY_NO_EXIST )
 				{
-					throwArcGen3InvalidArgument( "Invalid image buffer parameter ( nullptr )."s );
+					iStatus = 0;
+				}
+
+				if ( iStatus )
+				{
+					throwFitsError( iStatus );
+				}
+
+				if ( gScale != 1.0 || gZero != std::floor( gZero ) )
+				{
+					throwArcGen3InvalidArgument( "Invalid scaling [ BSCALE: %f, BZERO: %f ]! BSCALE must be 1 and BZERO an integer!", gScale, gZero );
 				}
 
 				//
-				// Read the image data
+				// Make sure buffered writes are in the file, then find the data
 				//
-				fits_read_img( m_pFits,
-							   ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
-							   1,
-							   static_cast< long >( uiDataLength ),
-							   nullptr,
-							   pBuf,
-							   nullptr,
-							   &iStatus );
+				fits_flush_file( m_pFits, &iStatus );
+
+				fits_get_hduaddrll( m_pFits, &llHeadStart, &llDataStart, &llDataEnd, &iStatus );
 
 				if ( iStatus )
 				{
-					throwFitsError( iStatus );
+					throwFitsError( iStatus );
+				}
+
+				auto uiFrames = ( ( pParam->getNAxis() == 3 ) ? pParam->getFrames() : 1 );
+
+				return std::make_unique<arc::gen3::fits::CMappedImage<T>>( getFileName(),
+																		   static_cast< std::uint64_t >( llDataStart ),
+																		   pParam->getCols(),
+																		   pParam->getRows(),
+																		   uiFrames,
+																		   static_cast< T >( static_cast< std::int64_t >( gZero ) ) );
+			}
+
+
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  getBaseFile                                                                                             |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Returns the underlying cfitsio file pointer. May return nullptr.                                        |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> fitsfile* CArcFitsFile<T>::getBaseFile( void )
+			{
+				return m_pFits;
+			}
+
+
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  maxTVal                                                                                                 |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Determines the maximum value for a specific data type. Example, for std::uint16_t: 2^16 = 65536.        |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> std::uint32_t CArcFitsFile<T>::maxTVal( void )
+			{
+				auto gExponent = ( ( sizeof( T ) == sizeof( arc::gen3::fits::BPP_32 ) ) ? 20 : ( sizeof( T ) * 8 ) );
+
+				return static_cast< std::uint32_t >( std::pow( 2.0, gExponent ) );
+			}
+
+
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  verifyFileHandle                                                                                        |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Ensures that the internal fits handle is valid.                                                         |
+			// |                                                                                                          |
+			// |  Throws std::runtime_error if the fits handle is not valid                                               |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> constexpr void CArcFitsFile<T>::verifyFileHandle( void )
+			{
+				if ( m_pFits == nullptr )
+				{
+					throwArcGen3Error( "Invalid FITS handle, no file open"s );
+				}
+
+				return;
+			}
+
+
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  cachedParameters                                                                                        |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Returns the image parameters. They are read from the file on first use after the file is created,      |
+			// |  opened, resized or has a keyword written, and reused after that, which saves the write methods a       |
+			// |  header query per call.                                                                                  |
+			// |                                                                                                          |
+			// |  Throws std::runtime_error on error.                                                                     |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> arc::gen3::fits::CParam* CArcFitsFile<T>::cachedParameters( void )
+			{
+				if ( !m_bParamValid )
+				{
+					std::int32_t iStatus = 0;
+
+					verifyFileHandle();
+
+					m_cParam.m_lNAxes[ 0 ] = m_cParam.m_lNAxes[ 1 ] = m_cParam.m_lNAxes[ 2 ] = 0;
+
+					fits_get_img_param( m_pFits, 3, &m_cParam.m_iBpp, &m_cParam.m_iNAxis, m_cParam.m_lNAxes, &iStatus );
+
+					if ( iStatus )
+					{
+						throwFitsError( iStatus );
+					}
+
+					m_bParamValid = true;
 				}
+
+				return &m_cParam;
 			}
 
 
 			// +----------------------------------------------------------------------------------------------------------+
-			// |  write3D ( Data Cube )                                                                                   |
+			// |  flushIfDue                                                                                              |
 			// +----------------------------------------------------------------------------------------------------------+
-			// |  Writes an image to the end of a data cube file.                                                         |
+			// |  Records a completed write and flushes the file if the flush policy calls for it.                        |
 			// |                                                                                                          |
-			// |  <IN> -> pBuf - A pointer to the image data.                                                             |
+			// |  <IN> -> u64Bytes - The number of bytes just written.                                                    |
 			// |                                                                                                          |
-			// |  Throws std::runtime_error, std::invalid_argument                                                        |
+			// |  Throws std::runtime_error on error.                                                                     |
 			// +----------------------------------------------------------------------------------------------------------+
-			template <typename T> void CArcFitsFile<T>::write3D( T* pBuf )
+			template <typename T> void CArcFitsFile<T>::flushIfDue( const std::uint64_t u64Bytes )
 			{
-				std::int64_t i64NElements = 0;
-				std::int32_t iStatus = 0;
-
-				verifyFileHandle();
+				bool bFlush = false;
 
-				auto pParam = getParameters();
+				m_u64UnflushedWrites++;
 
-				*pParam->m_plFrames = ++m_iFrame;
+				m_u64UnflushedBytes += u64Bytes;
 
-				//
-				// Verify parameters
-				//
-				if ( pParam->getNAxis() != 3 )
+				switch ( m_eFlush )
 				{
-					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a FITS data cube."s );
+					case arc::gen3::fits::e_Flush::FRAMES:
+					{
+						bFlush = ( m_u64UnflushedWrites >= m_u64FlushValue );
+					}
+					break;
+
+					case arc::gen3::fits::e_Flush::BYTES:
+					{
+						bFlush = ( m_u64UnflushedBytes >= m_u64FlushValue );
+					}
+					break;
+
+					case arc::gen3::fits::e_Flush::ON_CLOSE:
+					{
+						bFlush = false;
+					}
+					break;
+
+					case arc::gen3::fits::e_Flush::INTERVAL:
+					{
+						bFlush = ( ( std::chrono::steady_clock::now() - m_tLastFlush ) >= std::chrono::milliseconds( m_u64FlushValue ) );
+					}
+					break;
+
+					default:
+					{
+						bFlush = true;
+					}
 				}
 
-				if ( pBuf == nullptr )
+				if ( bFlush )
 				{
-					throwArcGen3InvalidArgument( "Invalid data buffer ( write3D )."s );
+					flush();
 				}
+			}
 
-				//
-				// Set number of pixels to write
-				//
-				i64NElements = static_cast< std::int64_t >( pParam->getCols() ) * static_cast< std::int64_t >( pParam->getRows() );
 
-				if ( m_i64Pixel == 0 )
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  verifyView                                                                                              |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Verifies that an image view is not empty and matches the file image dimensions.                         |
+			// |                                                                                                          |
+			// |  <IN> -> cView  - The image view to check.                                                               |
+			// |  <IN> -> pParam - The file image parameters.                                                             |
+			// |                                                                                                          |
+			// |  Throws std::invalid_argument on error.                                                                  |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> void CArcFitsFile<T>::verifyView( const arc::gen3::CArcImageView<const T>& cView, arc::gen3::fits::CParam* pParam )
+			{
+				if ( cView.empty() )
 				{
-					m_i64Pixel = 1;
+					throwArcGen3InvalidArgument( "Invalid image view ( empty )."s );
 				}
 
-				fits_write_img( m_pFits,
-								( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
-								m_i64Pixel,
-								i64NElements,
-								pBuf,
-								&iStatus );
-
-				if ( iStatus )
+				if ( cView.cols() != static_cast< std::uint32_t >( pParam->getCols() ) || cView.rows() != static_cast< std::uint32_t >( pParam->getRows() ) )
 				{
-					throwFitsError( iStatus );
+					throwArcGen3InvalidArgument( "Image view size [ %u x %u ] does not match file image size [ %u x %u ].",
+												 cView.cols(), cView.rows(), static_cast< std::uint32_t >( pParam->getCols() ), static_cast< std::uint32_t >( pParam->getRows() ) );
 				}
+			}
 
-				//
-				// Update the start pixel
-				//
-				m_i64Pixel += i64NElements;
 
-				//
-				// Increment the image number and update the key
-				//
-				fits_update_key( m_pFits, TINT, "NAXIS3", &m_iFrame, nullptr, &iStatus );
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  writeView                                                                                               |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Writes an image view to the file image data. A contiguous view is written with a single call; a         |
+			// |  strided view is written one row at a time straight from the parent buffer. Does not flush.              |
+			// |                                                                                                          |
+			// |  <IN> -> cView    - The image view to write.                                                             |
+			// |  <IN> -> i64Pixel - The file pixel ( 1-based ) that receives the first view pixel.                       |
+			// |                                                                                                          |
+			// |  Throws std::runtime_error on error.                                                                     |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> void CArcFitsFile<T>::writeView( const arc::gen3::CArcImageView<const T>& cView, const std::int64_t i64Pixel )
+			{
+				std::int32_t iStatus = 0;
 
-				if ( iStatus )
-				{
-					throwFitsError( iStatus );
-				}
+				std::uint32_t uiBlocks = ( cView.isContiguous() ? 1 : cView.rows() );
 
-				//
-				// Force data flush for more real-time performance
-				//
-				fits_flush_file( m_pFits, &iStatus );
+				LONGLONG llBlockLength = static_cast< LONGLONG >( cView.isContiguous() ? cView.size() : cView.cols() );
 
-				if ( iStatus )
+				for ( std::uint32_t uiBlock = 0; uiBlock < uiBlocks; uiBlock++ )
 				{
-					throwFitsError( iStatus );
+					fits_write_img( m_pFits,
+									( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+									( static_cast< LONGLONG >( uiBlock ) * llBlockLength + i64Pixel ),
+									llBlockLength,
+									const_cast< T* >( cView.row( uiBlock ) ),
+									&iStatus );
+
+					if ( iStatus )
+					{
+						throwFitsError( iStatus );
+					}
 				}
 			}
 
 
 			// +----------------------------------------------------------------------------------------------------------+
-			// |  reWrite3D ( Data Cube )                                                                                 |
+			// |  readView                                                                                                |
 			// +----------------------------------------------------------------------------------------------------------+
-			// |  Re-writes an existing image in a FITS data cube. The image data MUST match in size to the exising       |
-			// |  images within the data cube. The image size is NOT checked for by this method.                          |
+			// |  Reads the file image data into an image view. A contiguous view is filled with a single call; a         |
+			// |  strided view is filled one row at a time.                                                               |
 			// |                                                                                                          |
-			// |  <IN> -> pBuf			- A pointer to the image data.                                                    |
-			// |  <IN> -> uiImageNumber	- The number of the data cube image to replace.                                   |
+			// |  <IN> -> cView    - The image view that receives the data.                                               |
+			// |  <IN> -> i64Pixel - The file pixel ( 1-based ) that is read into the first view pixel.                   |
 			// |                                                                                                          |
-			// |  Throws std::runtime_error, std::invalid_argument                                                        |
+			// |  Throws std::runtime_error on error.                                                                     |
 			// +----------------------------------------------------------------------------------------------------------+
-			template <typename T> void CArcFitsFile<T>::reWrite3D( T* pBuf, const std::uint32_t uiImageNumber )
+			template <typename T> void CArcFitsFile<T>::readView( const arc::gen3::CArcImageView<T>& cView, const std::int64_t i64Pixel )
 			{
-				std::int64_t i64NElements = 0;
-				std::int64_t i64Pixel = 0;
 				std::int32_t iStatus = 0;
 
-				verifyFileHandle();
+				std::uint32_t uiBlocks = ( cView.isContiguous() ? 1 : cView.rows() );
 
-				auto pParam = getParameters();
+				LONGLONG llBlockLength = static_cast< LONGLONG >( cView.isContiguous() ? cView.size() : cView.cols() );
 
-				//
-				// Verify parameters
-				//
-				if ( pParam->getNAxis() != 3 )
+				for ( std::uint32_t uiBlock = 0; uiBlock < uiBlocks; uiBlock++ )
 				{
-					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a FITS data cube."s );
+					fits_read_img( m_pFits,
+								   ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
+								   ( static_cast< LONGLONG >( uiBlock ) * llBlockLength + i64Pixel ),
+								   llBlockLength,
+								   nullptr,
+								   cView.row( uiBlock ),
+								   nullptr,
+								   &iStatus );
+
+					if ( iStatus )
+					{
+						throwFitsError( iStatus );
+					}
 				}
+			}
 
-				if ( pBuf == nullptr )
-				{
-					throwArcGen3InvalidArgument( "Invalid data buffer."s );
-				}
 
-				//
-				// Set number of pixels to write; also set the start position
-				//
-				i64NElements = static_cast< std::int64_t >( pParam->getCols() ) * static_cast< std::int64_t >( pParam->getRows() );
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  resetState                                                                                              |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Clears the cached image parameters and the flush counters. Called whenever the file handle changes.     |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T> void CArcFitsFile<T>::resetState( void )
+			{
+				m_bParamValid = false;
 
-				i64Pixel = i64NElements * uiImageNumber + 1;
+				m_u64UnflushedWrites = 0;
+				m_u64UnflushedBytes = 0;
+				m_tLastFlush = std::chrono::steady_clock::now();
 
-				fits_write_img( m_pFits,
-								( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
-								i64Pixel,
-								i64NElements,
-								pBuf,
-								&iStatus );
+				m_uiRiceTileRows = 0;
+			}
 
-				if ( iStatus )
+
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  setTileCompression                                                                                      |
+			// +----------------------------------------------------------------------------------------------------------+
+			// |  Sets up tile compression on a newly created file, before its image is created. Tiles are one image      |
+			// |  plane wide and m_uiTileRows rows high ( clipped to the image ).                                         |
+			// |                                                                                                          |
+			// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+			// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+			// |  <IN> -> iNAxis - The number of image axes.                                                              |
+			// |                                                                                                          |
+			// |  Returns the cfitsio status; zero on success.                                                            |
+			// +----------------------------------------------------------------------------------------------------------+
+			template <typename T>
+			std::int32_t CArcFitsFile<T>::setTileCompression( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::int32_t iNAxis )
+			{
+				std::int32_t iStatus = 0;
+				std::int32_t iType = RICE_1;
+
+				std::uint32_t uiTileRows = ( ( m_uiTileRows > 0 ) ? m_uiTileRows : 1 );
+
+				if ( m_eCompress == arc::gen3::fits::e_Compress::GZIP )
 				{
-					throwFitsError( iStatus );
+					iType = GZIP_1;
 				}
 
-				//
-				// Force data flush for more real-time performance
-				//
-				fits_flush_file( m_pFits, &iStatus );
-
-				if ( iStatus )
+				else if ( m_eCompress == arc::gen3::fits::e_Compress::HCOMPRESS )
 				{
-					throwFitsError( iStatus );
+					iType = HCOMPRESS_1;
+
+					uiTileRows = ( ( m_uiTileRows > 0 ) ? m_uiTileRows : HCOMPRESS_TILE_ROWS );
 				}
+
+				long a_lTile[] = { static_cast< long >( uiCols ), static_cast< long >( std::min( uiTileRows, uiRows ) ), 1 };
+
+				fits_set_compression_type( m_pFits, iType, &iStatus );
+
+				fits_set_tile_dim( m_pFits, iNAxis, a_lTile, &iStatus );
+
+				return iStatus;
 			}
 
 
 			// +----------------------------------------------------------------------------------------------------------+
-			// |  read3D ( Data Cube )                                                                                    |
+			// |  writeRiceTiles                                                                                          |
 			// +----------------------------------------------------------------------------------------------------------+
-			// |  Reads an image from a data cube file.                                                                   |
+			// |  Rice compresses a single image and writes it to the open tile compressed file. This produces the same   |
+			// |  table cfitsio would: each tile's pixels are offset by BZERO to signed values ( flipping the sign bit )  |
+			// |  and Rice coded with a block size of 32, and tile n is written to row n of the COMPRESSED_DATA column.   |
 			// |                                                                                                          |
-			// |  <IN>  -> uiImageNumber - The image number to read.                                                      |
+			// |  Tiles are compressed in batches sized to the memory budget. One thread per core compresses the tiles   |
+			// |  of a batch, then this thread writes them in order, since cfitsio file access is not thread safe.        |
 			// |                                                                                                          |
-			// |  Throws std::runtime_error, std::invalid_argument                                                        |
+			// |  <IN> -> pBuf   - Pointer to the image data.                                                             |
+			// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+			// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+			// |                                                                                                          |
+			// |  Throws std::runtime_error on error.                                                                     |
 			// +----------------------------------------------------------------------------------------------------------+
 			template <typename T>
-			std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>> CArcFitsFile<T>::read3D( const std::uint32_t uiImageNumber )
+			void CArcFitsFile<T>::writeRiceTiles( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
 			{
-				std::size_t  iNElements = 0;
-				std::int64_t i64Pixel = 0;
-				std::int32_t iStatus = 0;
+				using signed_t = std::conditional_t<( sizeof( T ) == sizeof( std::uint16_t ) ), short, int>;
 
-				verifyFileHandle();
+				constexpr T tSignBit = static_cast< T >( T( 1 ) << ( sizeof( T ) * 8 - 1 ) );
 
-				auto pParam = getParameters();
+				std::int32_t iStatus = 0;
+				std::int32_t iColumn = 0;
 
-				if ( pParam->getNAxis() != 3 )
-				{
-					throwArcGen3InvalidArgument( "Invalid NAXIS value. This method is only valid for a FITS data cube."s );
-				}
+				fits_get_colnum( m_pFits, CASEINSEN, const_cast< char* >( "COMPRESSED_DATA" ), &iColumn, &iStatus );
 
-				//
-				// Verify parameters
-				//
-				if ( ( uiImageNumber + 1 ) > pParam->getFrames() )
+				if ( iStatus )
 				{
-					throwArcGen3InvalidArgument( "Invalid image number. File contains %u images.", pParam->getFrames() );
+					throwFitsError( iStatus );
 				}
 
+				auto uiTiles = ( ( uiRows + m_uiRiceTileRows - 1 ) / m_uiRiceTileRows );
+
+				auto szTilePixels = ( static_cast< std::size_t >( uiCols ) * m_uiRiceTileRows );
+
 				//
-				// Set number of pixels to read
+				// Worst case Rice output, for a tile of noise: every pixel at full width plus the per block codes
 				//
-				iNElements = static_cast< std::size_t >( pParam->getCols() ) * static_cast< std::size_t >( pParam->getRows() );
+				auto szMaxBytes = ( szTilePixels * sizeof( T ) + szTilePixels / 8 + 64 );
 
-				i64Pixel = static_cast<std::int64_t>( iNElements * uiImageNumber + 1U );
+				auto uiBatch = static_cast< std::uint32_t >( std::clamp<std::uint64_t>( m_u64CompressBudget / szMaxBytes, 1, uiTiles ) );
 
-				std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>> pImgBuf( new T[ iNElements ], arc::gen3::fits::ArrayDeleter<T>() );
+				auto uiThreads = std::min( std::max( std::thread::hardware_concurrency(), 1U ), uiBatch );
 
-				if ( pImgBuf.get() == nullptr )
-				{
-					throwArcGen3Error( "Failed to allocate buffer for image pixel data."s );
-				}
+				std::vector<std::vector<unsigned char>> vTiles( uiBatch, std::vector<unsigned char>( szMaxBytes ) );
 
-				//
-				// Read the image data
-				//
-				fits_read_img( m_pFits,
-							   ( sizeof( T ) == sizeof( std::uint16_t ) ? TUSHORT : TUINT ),
-							   i64Pixel,
-							   static_cast<LONGLONG>( iNElements ),
-							   nullptr,
-							   pImgBuf.get(),
-							   nullptr,
-							   &iStatus );
+				std::vector<std::vector<signed_t>> vStage( uiThreads, std::vector<signed_t>( szTilePixels ) );
 
-				if ( iStatus )
+				std::vector<int> vLength( uiBatch, 0 );
+
+				for ( std::uint32_t uiFirst = 0; uiFirst < uiTiles; uiFirst += uiBatch )
 				{
-					throwFitsError( iStatus );
-				}
+					auto uiCount = std::min( uiBatch, uiTiles - uiFirst );
 
-				return pImgBuf;
-			}
+					std::atomic<std::uint32_t> uiNext( 0 );
 
+					auto fnWorker = [ & ]( std::uint32_t uiThread )
+					{
+						signed_t* pStage = vStage[ uiThread ].data();
 
-			// +----------------------------------------------------------------------------------------------------------+
-			// |  getBaseFile                                                                                             |
-			// +----------------------------------------------------------------------------------------------------------+
-			// |  Returns the underlying cfitsio file pointer. May return nullptr.                                        |
-			// +----------------------------------------------------------------------------------------------------------+
-			template <typename T> fitsfile* CArcFitsFile<T>::getBaseFile( void )
-			{
-				return m_pFits;
-			}
+						for ( auto uiIndex = uiNext++; uiIndex < uiCount; uiIndex = uiNext++ )
+						{
+							auto uiRow = ( ( uiFirst + uiIndex ) * m_uiRiceTileRows );
 
+							auto szCount = ( static_cast< std::size_t >( uiCols ) * std::min( m_uiRiceTileRows, uiRows - uiRow ) );
 
-			// +----------------------------------------------------------------------------------------------------------+
-			// |  maxTVal                                                                                                 |
-			// +----------------------------------------------------------------------------------------------------------+
-			// |  Determines the maximum value for a specific data type. Example, for std::uint16_t: 2^16 = 65536.        |
-			// +----------------------------------------------------------------------------------------------------------+
-			template <typename T> std::uint32_t CArcFitsFile<T>::maxTVal( void )
-			{
-				auto gExponent = ( ( sizeof( T ) == sizeof( arc::gen3::fits::BPP_32 ) ) ? 20 : ( sizeof( T ) * 8 ) );
+							const T* pTile = ( pBuf + static_cast< std::size_t >( uiRow ) * uiCols );
 
-				return static_cast< std::uint32_t >( std::pow( 2.0, gExponent ) );
-			}
+							for ( std::size_t i = 0; i < szCount; i++ )
+							{
+								pStage[ i ] = static_cast< signed_t >( pTile[ i ] ^ tSignBit );
+							}
 
+							vLength[ uiIndex ] = riceCompress( pStage, static_cast< int >( szCount ), vTiles[ uiIndex ].data(), static_cast< int >( szMaxBytes ) );
+						}
+					};
 
-			// +----------------------------------------------------------------------------------------------------------+
-			// |  verifyFileHandle                                                                                        |
-			// +----------------------------------------------------------------------------------------------------------+
-			// |  Ensures that the internal fits handle is valid.                                                         |
-			// |                                                                                                          |
-			// |  Throws std::runtime_error if the fits handle is not valid                                               |
-			// +----------------------------------------------------------------------------------------------------------+
-			template <typename T> constexpr void CArcFitsFile<T>::verifyFileHandle( void )
-			{
-				if ( m_pFits == nullptr )
-				{
-					throwArcGen3Error( "Invalid FITS handle, no file open"s );
-				}
+					std::vector<std::thread> vThreads;
 
-				return;
+					for ( std::uint32_t i = 1; i < uiThreads; i++ )
+					{
+						vThreads.emplace_back( fnWorker, i );
+					}
+
+					fnWorker( 0 );
+
+					for ( auto& tThread : vThreads )
+					{
+						tThread.join();
+					}
+
+					for ( std::uint32_t uiIndex = 0; uiIndex < uiCount; uiIndex++ )
+					{
+						if ( vLength[ uiIndex ] <= 0 )
+						{
+							throwArcGen3Error( "Failed to Rice compress tile %u!", ( uiFirst + uiIndex + 1 ) );
+						}
+
+						fits_write_col_byt( m_pFits,
+											iColumn,
+											static_cast< LONGLONG >( uiFirst + uiIndex + 1 ),
+											1,
+											static_cast< LONGLONG >( vLength[ uiIndex ] ),
+											vTiles[ uiIndex ].data(),
+											&iStatus );
+
+						if ( iStatus )
+						{
+							throwFitsError( iStatus );
+						}
+					}
+				}
 			}
 
 
@@ -2072,6 +5749,18 @@ namespace arc
 template class arc::gen3::CArcFitsFile<arc::gen3::fits::BPP_16>;
 template class arc::gen3::CArcFitsFile<arc::gen3::fits::BPP_32>;
 
+template class arc::gen3::fits::CMappedImage<arc::gen3::fits::BPP_16>;
+template class arc::gen3::fits::CMappedImage<arc::gen3::fits::BPP_32>;
+
+template class arc::gen3::fits::CCubeWriter<arc::gen3::fits::BPP_16>;
+template class arc::gen3::fits::CCubeWriter<arc::gen3::fits::BPP_32>;
+
+template class arc::gen3::fits::CTileCache<arc::gen3::fits::BPP_16>;
+template class arc::gen3::fits::CTileCache<arc::gen3::fits::BPP_32>;
+
+template class arc::gen3::fits::CFilePool<arc::gen3::fits::BPP_16>;
+template class arc::gen3::fits::CFilePool<arc::gen3::fits::BPP_32>;
+
 
 
 // +------------------------------------------------------------------------------------------------+
@@ -22,8 +22,13 @@
 #include <memory>
 #include <functional>
 #include <cmath>
+#include <string>
+#include <vector>
+#include <utility>
+#include <complex>
 
 #include <CArcImageDllMain.h>
+#include <CArcImageView.h>
 #include <CArcBase.h>
 
 
@@ -47,6 +52,78 @@ namespace arc
 			using BPP_32 = std::uint32_t;
 
 
+			/** @enum e_Rebin
+			 *  Defines how the pixels within each bin are combined by CArcImage::rebin.
+			 *  @var arc::gen3::image::e_Rebin::SUM
+			 *  Each output pixel is the sum of the pixels in its bin.
+			 *  @var arc::gen3::image::e_Rebin::MEAN
+			 *  Each output pixel is the mean of the pixels in its bin, rounded to the nearest integer.
+			 */
+			enum class e_Rebin : std::uint32_t
+			{
+				SUM = 0,
+				MEAN
+			};
+
+
+			/** @enum e_Mask
+			 *  Pixel mask flags set by CArcImage::createMask. A pixel may have more than one flag set.
+			 *  @var arc::gen3::image::e_Mask::SATURATED
+			 *  The pixel is at or above the saturation level.
+			 *  @var arc::gen3::image::e_Mask::HOT
+			 *  The pixel is brighter than all eight of its neighbours by more than the hot pixel threshold.
+			 *  @var arc::gen3::image::e_Mask::COSMIC
+			 *  The pixel is a sharp, significant Laplacian peak that is too narrow to be a star ( a cosmic-ray hit ).
+			 *  @var arc::gen3::image::e_Mask::BAD
+			 *  The pixel is marked in the persistent bad pixel map.
+			 *
+			 *  A mask is applied to later passes through the pMask parameter of the CArcImage view overloads of
+			 *  getStats, histogram, preview and previewLimits, which skip every pixel with a flag set.
+			 */
+			enum class e_Mask : std::uint8_t
+			{
+				SATURATED = 0x01,
+				HOT = 0x02,
+				COSMIC = 0x04,
+				BAD = 0x08
+			};
+
+
+			/** @enum e_Defect
+			 *  CArcImage::repairDefects defect type, which sets the direction it is interpolated across.
+			 *  @var arc::gen3::image::e_Defect::COLUMN
+			 *  Bad columns. Each pixel is linearly interpolated along its row from the good columns either side.
+			 *  @var arc::gen3::image::e_Defect::ROW
+			 *  Bad rows. Each pixel is linearly interpolated along its column from the good rows above and below.
+			 *  @var arc::gen3::image::e_Defect::BOX
+			 *  A bad block of pixels. Each pixel is a bilinear blend of the row and column interpolations, with the
+			 *  narrower direction of the block weighted more heavily.
+			 */
+			enum class e_Defect : std::uint32_t
+			{
+				COLUMN = 0,
+				ROW,
+				BOX
+			};
+
+
+			/** @enum e_Stretch
+			 *  CArcImage::preview display stretch.
+			 *  @var arc::gen3::image::e_Stretch::ZSCALE
+			 *  The IRAF zscale limits, from a line fit to the sorted pixel sample.
+			 *  @var arc::gen3::image::e_Stretch::PERCENTILE
+			 *  The limits are the low and high percentiles of the pixel sample.
+			 *  @var arc::gen3::image::e_Stretch::FIXED
+			 *  The limits are taken from the parameters, e.g. to hold one stretch across a series of frames.
+			 */
+			enum class e_Stretch : std::uint32_t
+			{
+				ZSCALE = 0,
+				PERCENTILE,
+				FIXED
+			};
+
+
 			/** @class CAvgStats
 			 *  Average image statistics info class
 			 */
@@ -175,6 +252,315 @@ namespace arc
 			};
 
 
+			/** @class CRoi
+			 *  Image region of interest. Covers columns [ uiCol1, uiCol2 ) and rows [ uiRow1, uiRow2 ). As with
+			 *  CArcImage::getStats, an equal start and end selects the single column or row.
+			 */
+			class GEN3_CARCIMAGE_API CRoi
+			{
+				public:
+
+					/** Default constructor
+					 */
+					CRoi( void ) = default;
+
+					/** Constructor
+					 *  @param uiCol1 - The start column.
+					 *  @param uiCol2 - The end column.
+					 *  @param uiRow1 - The start row.
+					 *  @param uiRow2 - The end row.
+					 */
+					CRoi( const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2 )
+					{
+						this->uiCol1 = uiCol1;
+						this->uiCol2 = uiCol2;
+						this->uiRow1 = uiRow1;
+						this->uiRow2 = uiRow2;
+					}
+
+					/** Default destructor
+					 */
+					~CRoi( void ) = default;
+
+					std::uint32_t uiCol1 = 0;		/**< The start column */
+					std::uint32_t uiCol2 = 0;		/**< The end column */
+					std::uint32_t uiRow1 = 0;		/**< The start row */
+					std::uint32_t uiRow2 = 0;		/**< The end row */
+			};
+
+
+			/** @class CPtcPoint
+			 *  One point on a photon transfer curve: the statistics of one flat pair over one amplifier.
+			 */
+			class GEN3_CARCIMAGE_API CPtcPoint
+			{
+				public:
+
+					/** Default constructor
+					 */
+					CPtcPoint( void ) = default;
+
+					/** Default destructor
+					 */
+					~CPtcPoint( void ) = default;
+
+					double gMean = 0.0;				/**< The bias subtracted mean signal of the pair ( DN ) */
+					double gDiffVariance = 0.0;		/**< The variance of the pair difference image ( DN^2 ) */
+					double gSignalVariance = 0.0;	/**< Half the difference variance less the bias read noise variance, i.e. the shot noise ( DN^2 ) */
+					double gGain = 0.0;				/**< The gain estimated from this pair alone ( e-/DN ). Zero if it cannot be calculated. */
+					std::uint64_t u64SaturatedCount = 0;	/**< The number of pixel positions saturated in either image. These are left out of the statistics. */
+					bool bSaturated = false;		/**< true if the saturated fraction of the pair is over the ptc() limit. Saturated points are not fitted. */
+			};
+
+
+			/** @class CPtc
+			 *  Photon transfer curve ( PTC ) result for one amplifier. The gain is found by a least squares fit of the
+			 *  pair variance ( half the difference variance ) against the mean signal, i.e. variance = mean / gain + c.
+			 */
+			class GEN3_CARCIMAGE_API CPtc
+			{
+				public:
+
+					/** Default constructor
+					 */
+					CPtc( void ) = default;
+
+					/** Default destructor
+					 */
+					~CPtc( void ) = default;
+
+					double gBiasMean = 0.0;			/**< The mean of the bias pair ( DN ) */
+					double gReadNoiseDN = 0.0;		/**< The read noise measured from the bias pair difference ( DN ) */
+					double gReadNoise = 0.0;		/**< The read noise ( e- ). Zero if the gain could not be fitted. */
+					double gGain = 0.0;				/**< The fitted gain ( e-/DN ). Zero if fewer than two usable points exist. */
+					double gSlope = 0.0;			/**< The fitted slope of variance against mean ( DN^-1 ) */
+					double gIntercept = 0.0;		/**< The fitted variance intercept ( DN^2 ) */
+					std::uint32_t uiFitPoints = 0;	/**< The number of points used in the fit */
+
+					std::vector<CPtcPoint> vPoints;	/**< One point per flat pair, in input order */
+			};
+
+
+			/** @class CMaskParams
+			 *  CArcImage::createMask detection settings. A threshold of zero disables that test.
+			 */
+			class GEN3_CARCIMAGE_API CMaskParams
+			{
+				public:
+
+					/** Default constructor
+					 */
+					CMaskParams( void ) = default;
+
+					/** Default destructor
+					 */
+					~CMaskParams( void ) = default;
+
+					double gSaturation = 0.0;		/**< The saturation level ( DN ). Zero uses the maximum pixel value for the image type. */
+					double gHotThreshold = 0.0;		/**< A pixel more than this many DN above the brightest of its eight neighbours is HOT */
+					double gCosmicSigma = 5.0;		/**< A Laplacian peak more than this many noise sigma is a COSMIC candidate */
+					double gCosmicContrast = 2.0;	/**< A COSMIC candidate must exceed its neighbour mean by this multiple of the neighbour signal */
+					double gBias = 0.0;				/**< The bias level used by the noise model ( DN ) */
+					double gGain = 1.0;				/**< The gain used by the noise model ( e-/DN ) */
+					double gReadNoise = 0.0;		/**< The read noise used by the noise model ( DN ) */
+			};
+
+
+			/** @class CDefect
+			 *  A known detector defect for CArcImage::repairDefects. Covers columns [ uiCol1, uiCol2 ) and rows
+			 *  [ uiRow1, uiRow2 ). A whole bad column, for example, is ( e_Defect::COLUMN, col, col + 1, 0, rows ).
+			 */
+			class GEN3_CARCIMAGE_API CDefect
+			{
+				public:
+
+					/** Default constructor
+					 */
+					CDefect( void ) = default;
+
+					/** Constructor
+					 *  @param eType  - The defect type.
+					 *  @param uiCol1 - The start column.
+					 *  @param uiCol2 - The end column ( exclusive ).
+					 *  @param uiRow1 - The start row.
+					 *  @param uiRow2 - The end row ( exclusive ).
+					 */
+					CDefect( const e_Defect eType, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2 )
+					{
+						this->eType = eType;
+						this->uiCol1 = uiCol1;
+						this->uiCol2 = uiCol2;
+						this->uiRow1 = uiRow1;
+						this->uiRow2 = uiRow2;
+					}
+
+					/** Default destructor
+					 */
+					~CDefect( void ) = default;
+
+					e_Defect eType = e_Defect::COLUMN;	/**< The defect type */
+					std::uint32_t uiCol1 = 0;			/**< The start column */
+					std::uint32_t uiCol2 = 0;			/**< The end column ( exclusive ) */
+					std::uint32_t uiRow1 = 0;			/**< The start row */
+					std::uint32_t uiRow2 = 0;			/**< The end row ( exclusive ) */
+			};
+
+
+			/** @class CSourceParams
+			 *  CArcImage::findSources detection settings.
+			 */
+			class GEN3_CARCIMAGE_API CSourceParams
+			{
+				public:
+
+					/** Default constructor
+					 */
+					CSourceParams( void ) = default;
+
+					/** Default destructor
+					 */
+					~CSourceParams( void ) = default;
+
+					double gThreshold = 5.0;			/**< Detection threshold, in background noise sigma above the background */
+					double gRadius = 0.0;				/**< Measurement aperture radius ( pixels ). Zero sizes the aperture from each source's footprint. */
+					std::uint32_t uiMinPixels = 3;		/**< Smallest number of connected pixels above the threshold that make a source */
+					std::uint32_t uiMaxSources = 0;		/**< Keep only this many of the brightest sources. Zero keeps them all. */
+			};
+
+
+			/** @class CSource
+			 *  A source ( star ) found by CArcImage::findSources. Positions are in view pixels, where the center of the
+			 *  first pixel is ( 0, 0 ).
+			 */
+			class GEN3_CARCIMAGE_API CSource
+			{
+				public:
+
+					/** Default constructor
+					 */
+					CSource( void ) = default;
+
+					/** Default destructor
+					 */
+					~CSource( void ) = default;
+
+					double gCol = 0.0;				/**< The flux weighted centroid column */
+					double gRow = 0.0;				/**< The flux weighted centroid row */
+					double gFlux = 0.0;				/**< The background subtracted flux within the aperture ( DN ) */
+					double gPeak = 0.0;				/**< The background subtracted peak pixel value ( DN ) */
+					double gFwhm = 0.0;				/**< The full width at half maximum, from the second moment of the flux ( pixels ) */
+					double gHfd = 0.0;				/**< The half flux diameter, 2 x the flux weighted mean radius ( pixels ) */
+					double gBackground = 0.0;		/**< The background level used ( DN ) */
+					std::uint32_t uiPixels = 0;		/**< The number of connected pixels above the detection threshold */
+			};
+
+
+			/** @class CPreviewParams
+			 *  CArcImage::preview display settings.
+			 */
+			class GEN3_CARCIMAGE_API CPreviewParams
+			{
+				public:
+
+					/** Default constructor
+					 */
+					CPreviewParams( void ) = default;
+
+					/** Default destructor
+					 */
+					~CPreviewParams( void ) = default;
+
+					e_Stretch eStretch = e_Stretch::ZSCALE;		/**< The stretch used to find the display limits */
+					double gContrast = 0.25;					/**< The zscale contrast. Smaller values widen the limits. */
+					double gLowPercent = 0.5;					/**< The percentile mapped to black by e_Stretch::PERCENTILE */
+					double gHighPercent = 99.5;					/**< The percentile mapped to white by e_Stretch::PERCENTILE */
+					double gLow = 0.0;							/**< The value mapped to black by e_Stretch::FIXED ( DN ) */
+					double gHigh = 0.0;							/**< The value mapped to white by e_Stretch::FIXED ( DN ) */
+					std::uint32_t uiSamples = 1000;				/**< The number of pixels sampled to find the display limits */
+			};
+
+
+			/** @class CSynthParams
+			 *  CArcImage::fillWithSynthetic frame model. Signal terms are in electrons and are converted to DN with the
+			 *  gain. The same seed and settings always give the same frame, whatever the number of threads used.
+			 */
+			class GEN3_CARCIMAGE_API CSynthParams
+			{
+				public:
+
+					/** Default constructor
+					 */
+					CSynthParams( void ) = default;
+
+					/** Default destructor
+					 */
+					~CSynthParams( void ) = default;
+
+					std::uint64_t u64Seed = 1;				/**< The random number seed */
+					double gBias = 1000.0;					/**< The bias level ( DN ) */
+					double gGain = 1.0;						/**< The gain ( e-/DN ) */
+					double gReadNoise = 5.0;				/**< The read noise ( e- ) */
+					double gDarkCurrent = 0.0;				/**< The dark current ( e-/pixel/s ) */
+					double gExposure = 0.0;					/**< The exposure time used for the dark current ( s ) */
+					double gSky = 0.0;						/**< The mean sky level ( e-/pixel ) */
+					std::uint32_t uiStars = 0;				/**< The number of stars, placed at random */
+					double gStarFwhm = 3.0;					/**< The gaussian star profile full width at half maximum ( pixels ) */
+					double gStarFluxMin = 1.0e3;			/**< The faintest star total flux ( e- ). Fluxes are log-uniform. */
+					double gStarFluxMax = 1.0e6;			/**< The brightest star total flux ( e- ) */
+					std::uint32_t uiCosmics = 0;			/**< The number of cosmic-ray hits, placed at random */
+					double gCosmicFlux = 5.0e3;				/**< The mean charge of a cosmic-ray hit ( e- ), spread along a short track */
+					std::uint32_t uiAmpCols = 1;			/**< The number of amplifier columns the frame is split into */
+					std::uint32_t uiAmpRows = 1;			/**< The number of amplifier rows the frame is split into */
+					std::vector<double> vAmpOffsets;		/**< The bias offset of each amplifier ( DN ), row by row from the first row. Missing entries are zero. */
+			};
+
+
+			/** @class CRegisterParams
+			 *  CArcImage::findShift and CArcImage::findShifts registration settings.
+			 */
+			class GEN3_CARCIMAGE_API CRegisterParams
+			{
+				public:
+
+					/** Default constructor
+					 */
+					CRegisterParams( void ) = default;
+
+					/** Default destructor
+					 */
+					~CRegisterParams( void ) = default;
+
+					std::uint32_t uiWindow = 512;		/**< The largest phase correlation window side ( pixels ). Rounded down to a power of two that fits both images. Must be at least 16. */
+					double gMinPeak = 0.05;				/**< A normalized correlation peak below this falls back to matching source centroids */
+					double gMatchRadius = 2.0;			/**< Sources closer than this after shifting are a match in the centroid fallback ( pixels ) */
+					CSourceParams cSources;				/**< The centroid fallback source detection settings. At most 32 sources are matched. */
+			};
+
+
+			/** @class CShift
+			 *  The offset of a frame from a reference frame, found by CArcImage::findShift. The frame pixel at
+			 *  ( col + gCol, row + gRow ) lies on the same point of the sky as the reference pixel at ( col, row ).
+			 */
+			class GEN3_CARCIMAGE_API CShift
+			{
+				public:
+
+					/** Default constructor
+					 */
+					CShift( void ) = default;
+
+					/** Default destructor
+					 */
+					~CShift( void ) = default;
+
+					double gCol = 0.0;				/**< The column offset ( pixels ) */
+					double gRow = 0.0;				/**< The row offset ( pixels ) */
+					double gPeak = 0.0;				/**< The normalized phase correlation peak, from 0 to 1. Higher is more certain. */
+					bool bCentroid = false;			/**< true if the offset came from the source centroid fallback */
+					std::uint32_t uiMatches = 0;	/**< The number of sources matched by the centroid fallback */
+			};
+
+
 			/** @struct ArrayDeleter
 			 *  Returned array deleter
 			 */
@@ -261,6 +647,27 @@ namespace arc
 			 */
 			static void fillWithRamp( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
 
+			/** Fills an image view with a synthetic frame: bias, per-amplifier offsets, read noise, dark current,
+			 *  sky, a random star field and cosmic-ray hits, with Poisson noise on the signal. The frame is in image
+			 *  order; use CArcDeinterlace::interlace() to put it into a controller readout order. Rows are generated
+			 *  in bands on separate threads, each row from its own seeded random stream, so the result depends only on
+			 *  the seed and settings.
+			 *  @param cView	- The image view.
+			 *  @param cParams	- The frame model.
+			 *  @throws std::invalid_argument
+			 */
+			static void fillWithSynthetic( const arc::gen3::CArcImageView<T>& cView, const arc::gen3::image::CSynthParams& cParams );
+
+			/** Fills the specified buffer with a synthetic frame. See above.
+			 *  @param pBuf		- Pointer to the image buffer.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param cParams	- The frame model.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static void fillWithSynthetic( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CSynthParams& cParams );
+
 			/** Verify a ramp synthetic image. Data has the form 0, 1, 2, ..., 65535, 0, 1, ....
 			 *  @param pBuf		- Pointer to the image data buffer.
 			 *  @param uiCols	- The image column size ( in pixels ).
@@ -311,7 +718,7 @@ namespace arc
 			 *  @throws std::runtime_error
 			 */
 			static std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
-			getRegion( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount );
+			getRegion( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows, std::size_t& uiCount );
 
 			/** Returns all or part of an image row.
 			 *  @param pBuf		- Pointer to the image data buffer.
@@ -372,6 +779,53 @@ namespace arc
 																								const std::uint32_t uiCols, const std::uint32_t uiRows,
 																								 std::uint32_t& uiCount );
 
+			/** Fills a caller supplied buffer with a row of pixel data where each value is the average over the specified
+			 *  range of columns. The buffer must hold at least ( uiRow2 - uiRow1 ) elements ( or one if the rows are equal ).
+			 *  Large areas are processed in parallel over bands of rows.
+			 *  @param pBuf		- Pointer to the image data buffer.
+			 *  @param uiCol1	- The start column.
+			 *  @param uiCol2	- The end column.
+			 *  @param uiRow1	- The start row.
+			 *  @param uiRow2	- The end row.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param pAreaBuf	- Pointer to the buffer that receives the row profile.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static void getRowArea( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2,
+									const std::uint32_t uiCols, const std::uint32_t uiRows, double* pAreaBuf );
+
+			/** Single precision version of getRowArea( ..., double* ).
+			 *  @see getRowArea( const T*, const std::uint32_t, const std::uint32_t, const std::uint32_t, const std::uint32_t, const std::uint32_t, const std::uint32_t, double* )
+			 */
+			static void getRowArea( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2,
+									const std::uint32_t uiCols, const std::uint32_t uiRows, float* pAreaBuf );
+
+			/** Fills a caller supplied buffer with a column of pixel data where each value is the average over the specified
+			 *  range of rows. The buffer must hold at least ( uiCol2 - uiCol1 ) elements ( or one if the columns are equal ).
+			 *  The image is read a row at a time into per-column accumulators, with large areas processed in parallel over
+			 *  bands of rows.
+			 *  @param pBuf		- Pointer to the image data buffer.
+			 *  @param uiCol1	- The start column.
+			 *  @param uiCol2	- The end column.
+			 *  @param uiRow1	- The start row.
+			 *  @param uiRow2	- The end row.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param pAreaBuf	- Pointer to the buffer that receives the column profile.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static void getColArea( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2,
+									const std::uint32_t uiCols, const std::uint32_t uiRows, double* pAreaBuf );
+
+			/** Single precision version of getColArea( ..., double* ).
+			 *  @see getColArea( const T*, const std::uint32_t, const std::uint32_t, const std::uint32_t, const std::uint32_t, const std::uint32_t, const std::uint32_t, double* )
+			 */
+			static void getColArea( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2,
+									const std::uint32_t uiCols, const std::uint32_t uiRows, float* pAreaBuf );
+
 			/** Calculates the image min, max, mean, variance, standard deviation, total pixel count and saturated
 			 *  pixel count over the specified image buffer cols and rows.
 			 *  @param pBuf		- Pointer to the image data buffer.
@@ -397,6 +851,22 @@ namespace arc
 			 */
 			static std::unique_ptr<arc::gen3::image::CStats> getStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
 
+			/** Calculates the statistics for a list of regions in a single pass over the image. The regions may overlap.
+			 *  Each image row is read once and its pixels are added to every region that covers it, so the memory cost
+			 *  does not grow with the number of regions. Large images are processed in parallel over bands of rows.
+			 *  @param pBuf			- Pointer to the image data buffer.
+			 *  @param pRois		- Pointer to an array of regions.
+			 *  @param uiRoiCount	- The number of regions in the array.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @return A std::unique_ptr to an array of uiRoiCount arc::gen3::image::CStats objects, in the same order as
+			 *  the regions.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::unique_ptr<arc::gen3::image::CStats[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CStats>>
+			getStats( const T* pBuf, const arc::gen3::image::CRoi* pRois, const std::uint32_t uiRoiCount, const std::uint32_t uiCols, const std::uint32_t uiRows );
+
 			/** Calculates the min, max, mean, variance, standard deviation, total pixel count and saturated pixel count for
 			 *  each image as well as the difference mean, variance and standard deviation over the specified image buffer
 			 *  cols and rows. This is used for photon transfer curves ( PTC ). The two images MUST be the same size or the
@@ -428,6 +898,50 @@ namespace arc
 			 */
 			static std::unique_ptr<arc::gen3::image::CDifStats> getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows );
 
+			/** Reduces a photon transfer curve ( PTC ) sequence. For every amplifier, the bias pair gives the bias level
+			 *  and read noise, and each flat pair gives one curve point ( mean signal against half the difference
+			 *  variance ). The flat pairs are processed in parallel. All images MUST be uiCols x uiRows.
+			 *  @param pBias1		- Pointer to the first bias image.
+			 *  @param pBias2		- Pointer to the second bias image.
+			 *  @param pFlats		- Pointer to an array of 2 x uiPairCount flat image pointers. Pair n is pFlats[ 2n ] and pFlats[ 2n + 1 ].
+			 *  @param uiPairCount	- The number of flat pairs.
+			 *  @param pAmps		- Pointer to an array of amplifier regions, or nullptr to treat the whole image as one amplifier.
+			 *  @param uiAmpCount	- The number of amplifier regions ( ignored if pAmps is nullptr ).
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param gMaxSaturated	- The largest fraction ( 0 - 1 ) of saturated pixels an amplifier may hold before the pair is
+			 *						  marked saturated and left out of the fit. Saturated pixels are never used in the statistics.
+			 *  @return A std::unique_ptr to an array of arc::gen3::image::CPtc objects, one per amplifier.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::unique_ptr<arc::gen3::image::CPtc[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CPtc>>
+			ptc( const T* pBias1, const T* pBias2, const T* const* pFlats, const std::uint32_t uiPairCount, const arc::gen3::image::CRoi* pAmps, const std::uint32_t uiAmpCount,
+				 const std::uint32_t uiCols, const std::uint32_t uiRows, const double gMaxSaturated = 0.01 );
+
+			/** Reduces a photon transfer curve ( PTC ) sequence stored in files. See above. Each image is read by the
+			 *  supplied loader, which keeps this library independent of the file format; e.g. for FITS files:
+			 *  [] ( const std::string& sFile, T* pBuf, std::uint32_t uiCols, std::uint32_t uiRows ) { CArcFitsFile<T>( sFile ).read( pBuf, uiCols, uiRows ); }
+			 *  Each worker thread holds one flat pair in memory at a time, so the loader must be thread-safe.
+			 *  @param sBias1		- The first bias image file.
+			 *  @param sBias2		- The second bias image file.
+			 *  @param vFlats		- The flat image files. Pair n is vFlats[ 2n ] and vFlats[ 2n + 1 ].
+			 *  @param pAmps		- Pointer to an array of amplifier regions, or nullptr to treat the whole image as one amplifier.
+			 *  @param uiAmpCount	- The number of amplifier regions ( ignored if pAmps is nullptr ).
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param fnLoad		- Function called as fnLoad( file, buffer, cols, rows ) to read one image.
+			 *  @param gMaxSaturated	- The largest fraction ( 0 - 1 ) of saturated pixels an amplifier may hold before the pair is
+			 *						  marked saturated and left out of the fit.
+			 *  @return A std::unique_ptr to an array of arc::gen3::image::CPtc objects, one per amplifier.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::unique_ptr<arc::gen3::image::CPtc[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CPtc>>
+			ptc( const std::string& sBias1, const std::string& sBias2, const std::vector<std::string>& vFlats, const arc::gen3::image::CRoi* pAmps, const std::uint32_t uiAmpCount,
+				 const std::uint32_t uiCols, const std::uint32_t uiRows, const std::function<void( const std::string&, T*, std::uint32_t, std::uint32_t )>& fnLoad,
+				 const double gMaxSaturated = 0.01 );
+
 			/** Calculates the histogram over the specified image buffer columns and rows.
 			 *  @param pBuf		- Pointer to the image buffer.
 			 *  @param uiCol1	- The start column.
@@ -482,6 +996,32 @@ namespace arc
 			 */
 			static void subtractHalves( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
 
+			/** Correlated double sampling. Subtracts the second half of an image from the first, as subtractHalves() does,
+			 *  but writes a signed result to a separate buffer so negative differences are kept rather than wrapped. For
+			 *  multiple read ( Fowler ) sampling the first half holds uiReads reset reads and the second half uiReads signal
+			 *  reads, each uiRows / ( 2 x uiReads ) rows high; every output pixel is the mean of its reset reads minus the
+			 *  mean of its signal reads, rounded to the nearest integer.
+			 *  @param pBuf		- Pointer to the image buffer.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ). Must be a multiple of 2 x uiReads.
+			 *  @param pDstBuf	- Pointer to a uiCols x ( uiRows / ( 2 x uiReads ) ) buffer that receives the result.
+			 *  @param uiReads	- The number of reads per half. Default: 1
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static void subtractHalves( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, std::int32_t* pDstBuf, const std::uint32_t uiReads = 1 );
+
+			/** Single precision version of the correlated double sampling subtractHalves(). The result is not rounded.
+			 *  @param pBuf		- Pointer to the image buffer.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ). Must be a multiple of 2 x uiReads.
+			 *  @param pDstBuf	- Pointer to a uiCols x ( uiRows / ( 2 x uiReads ) ) buffer that receives the result.
+			 *  @param uiReads	- The number of reads per half. Default: 1
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static void subtractHalves( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, float* pDstBuf, const std::uint32_t uiReads = 1 );
+
 			/** Divide two image buffers pixel by pixel.
 			 *  @param pBuf1	- Pointer to the first image buffer.
 			 *  @param pBuf2	- Pointer to the second image buffer.
@@ -511,6 +1051,358 @@ namespace arc
 			 */
 			static void copy( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiSize );
 
+			/** Software bins an image. Each uiColFactor x uiRowFactor block of pixels is summed or averaged into one
+			 *  output pixel. The output is ( uiCols / uiColFactor ) x ( uiRows / uiRowFactor ) pixels; partial blocks
+			 *  along the right and bottom edges are dropped. Output pixels are 32-bit so that 16-bit sums do not wrap;
+			 *  sums too large for 32-bits are clamped. Large images are processed in parallel over bands of rows.
+			 *  @param pSrcBuf		- Pointer to the source image buffer.
+			 *  @param uiCols		- The source image column size ( in pixels ).
+			 *  @param uiRows		- The source image row size ( in pixels ).
+			 *  @param uiColFactor	- The number of columns per bin.
+			 *  @param uiRowFactor	- The number of rows per bin.
+			 *  @param pDstBuf		- Pointer to the destination buffer. Must hold at least ( uiCols / uiColFactor ) * ( uiRows / uiRowFactor ) pixels.
+			 *  @param eMode		- Sum or average the pixels in each bin ( default = arc::gen3::image::e_Rebin::SUM ).
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static void rebin( const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiColFactor, const std::uint32_t uiRowFactor,
+							   std::uint32_t* pDstBuf, const arc::gen3::image::e_Rebin eMode = arc::gen3::image::e_Rebin::SUM );
+
+			/** Software bins an image into a new buffer. See rebin( ..., std::uint32_t* pDstBuf, ... ).
+			 *  @param pSrcBuf		- Pointer to the source image buffer.
+			 *  @param uiCols		- The source image column size ( in pixels ).
+			 *  @param uiRows		- The source image row size ( in pixels ).
+			 *  @param uiColFactor	- The number of columns per bin.
+			 *  @param uiRowFactor	- The number of rows per bin.
+			 *  @param uiNewCols	- Set to the column size of the returned image ( in pixels ).
+			 *  @param uiNewRows	- Set to the row size of the returned image ( in pixels ).
+			 *  @param eMode		- Sum or average the pixels in each bin ( default = arc::gen3::image::e_Rebin::SUM ).
+			 *  @return A std::unique_ptr to the binned 32-bit image.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
+			rebin( const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiColFactor, const std::uint32_t uiRowFactor,
+				   std::uint32_t& uiNewCols, std::uint32_t& uiNewRows, const arc::gen3::image::e_Rebin eMode = arc::gen3::image::e_Rebin::SUM );
+
+			/** Fills every pixel of an image view with the specified value.
+			 *  @param cView	- The image view.
+			 *  @param uiValue	- The value to fill the view with.
+			 *  @throws std::out_of_range
+			 */
+			static void fill( const arc::gen3::CArcImageView<T>& cView, const T uiValue );
+
+			/** Copies the source view into the destination view. The source view must be less than or equal in
+			 *  dimensions to the destination view. The views may have different strides.
+			 *  @param cDstView	- The destination image view. Result is placed in this view.
+			 *  @param cSrcView	- The source image view.
+			 *  @throws std::invalid_argument
+			 */
+			static void copy( const arc::gen3::CArcImageView<T>& cDstView, const arc::gen3::CArcImageView<const T>& cSrcView );
+
+			/** Adds two image views together pixel by pixel. The views must be the same size but may have different strides.
+			 *  @param cView1	- The first image view.
+			 *  @param cView2	- The second image view.
+			 *  @return A pointer to a contiguous 64-bit buffer the size of the views.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::unique_ptr<std::uint64_t[], arc::gen3::image::ArrayDeleter<std::uint64_t>> add( const arc::gen3::CArcImageView<const T>& cView1,
+																										  const arc::gen3::CArcImageView<const T>& cView2 );
+
+			/** Subtracts two image views pixel by pixel. View two is subtracted from view one. The views must be the same size.
+			 *  @param cView1	- The first image view.
+			 *  @param cView2	- The second image view.
+			 *  @return A pointer to a contiguous buffer the size of the views, with the same data type as the views.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>> subtract( const arc::gen3::CArcImageView<const T>& cView1, const arc::gen3::CArcImageView<const T>& cView2 );
+
+			/** Subtracts the bottom half of an image view from the top half in place. See subtractHalves( pBuf, uiCols, uiRows ).
+			 *  @param cView	- The image view. Must have an even number of rows. Result is placed in the first half.
+			 *  @throws std::invalid_argument
+			 */
+			static void subtractHalves( const arc::gen3::CArcImageView<T>& cView );
+
+			/** Correlated double sampling of an image view. See subtractHalves( pBuf, uiCols, uiRows, pDstBuf, uiReads ).
+			 *  @param cView	- The image view. Its rows must be a multiple of 2 x uiReads.
+			 *  @param pDstBuf	- Pointer to a contiguous cView.cols() x ( cView.rows() / ( 2 x uiReads ) ) buffer that receives the result.
+			 *  @param uiReads	- The number of reads per half. Default: 1
+			 *  @throws std::invalid_argument
+			 */
+			static void subtractHalves( const arc::gen3::CArcImageView<const T>& cView, std::int32_t* pDstBuf, const std::uint32_t uiReads = 1 );
+
+			/** Single precision version of subtractHalves( cView, std::int32_t*, uiReads ). The result is not rounded.
+			 */
+			static void subtractHalves( const arc::gen3::CArcImageView<const T>& cView, float* pDstBuf, const std::uint32_t uiReads = 1 );
+
+			/** Divides two image views pixel by pixel. The views must be the same size but may have different strides.
+			 *  @param cView1	- The first image view.
+			 *  @param cView2	- The second image view.
+			 *  @return A pointer to a contiguous buffer the size of the views, with the same data type as the views.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>> divide( const arc::gen3::CArcImageView<const T>& cView1, const arc::gen3::CArcImageView<const T>& cView2 );
+
+			/** Returns a row of pixel data where each value is the average of one row of the image view.
+			 *  @param cView	- The image view.
+			 *  @param pAreaBuf	- Pointer to the buffer that receives the row profile. Must hold cView.rows() elements.
+			 *  @throws std::invalid_argument
+			 */
+			static void getRowArea( const arc::gen3::CArcImageView<const T>& cView, double* pAreaBuf );
+
+			/** Single precision version of getRowArea( cView, double* ).
+			 */
+			static void getRowArea( const arc::gen3::CArcImageView<const T>& cView, float* pAreaBuf );
+
+			/** Returns a column of pixel data where each value is the average of one column of the image view.
+			 *  @param cView	- The image view.
+			 *  @param pAreaBuf	- Pointer to the buffer that receives the column profile. Must hold cView.cols() elements.
+			 *  @throws std::invalid_argument
+			 */
+			static void getColArea( const arc::gen3::CArcImageView<const T>& cView, double* pAreaBuf );
+
+			/** Single precision version of getColArea( cView, double* ).
+			 */
+			static void getColArea( const arc::gen3::CArcImageView<const T>& cView, float* pAreaBuf );
+
+			/** Calculates the image min, max, mean, variance, standard deviation, total pixel count and saturated
+			 *  pixel count over an entire image view. With a mask, only the unmasked pixels are counted.
+			 *  @param cView	- The image view.
+			 *  @param pMask	- Pointer to a cView.cols() x cView.rows() mask, e.g. from createMask(), whose flagged pixels are skipped, or nullptr ( default ).
+			 *  @return A std::unique_ptr to an arc::gen3::image::CStats object.
+			 *  @throws std::runtime_error
+			 */
+			static std::unique_ptr<arc::gen3::image::CStats> getStats( const arc::gen3::CArcImageView<const T>& cView, const std::uint8_t* pMask = nullptr );
+
+			/** Calculates the statistics for a list of regions of an image view in a single pass. See
+			 *  getStats( pBuf, pRois, uiRoiCount, uiCols, uiRows ). Region coordinates are relative to the view. With a
+			 *  mask, only the unmasked pixels are counted; a region with every pixel masked has all zero statistics.
+			 *  @param cView		- The image view.
+			 *  @param pRois		- Pointer to an array of regions.
+			 *  @param uiRoiCount	- The number of regions in the array.
+			 *  @param pMask		- Pointer to a cView.cols() x cView.rows() mask, e.g. from createMask(), whose flagged pixels are skipped, or nullptr ( default ).
+			 *  @return A std::unique_ptr to an array of uiRoiCount arc::gen3::image::CStats objects.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::unique_ptr<arc::gen3::image::CStats[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CStats>>
+			getStats( const arc::gen3::CArcImageView<const T>& cView, const arc::gen3::image::CRoi* pRois, const std::uint32_t uiRoiCount,
+					  const std::uint8_t* pMask = nullptr );
+
+			/** Calculates the statistics of two image views and of their difference, as used for photon transfer
+			 *  curves ( PTC ). See getDiffStats( pBuf1, pBuf2, uiCols, uiRows ). The views must be the same size.
+			 *  @param cView1	- The first image view.
+			 *  @param cView2	- The second image view.
+			 *  @return A std::unique_ptr to an arc::gen3::image::CDifStats object.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::unique_ptr<arc::gen3::image::CDifStats> getDiffStats( const arc::gen3::CArcImageView<const T>& cView1, const arc::gen3::CArcImageView<const T>& cView2 );
+
+			/** Calculates the histogram over an entire image view.
+			 *  @param cView	- The image view.
+			 *  @param uiCount	- The element count of the returned array.
+			 *  @param pMask	- Pointer to a cView.cols() x cView.rows() mask, e.g. from createMask(), whose flagged pixels are skipped, or nullptr ( default ).
+			 *  @return A std::unique_ptr to an array of unsigned integers. The size of the array depends on the image data type.
+			 *  @throws std::runtime_error
+			 */
+			static std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>> histogram( const arc::gen3::CArcImageView<const T>& cView, std::uint32_t& uiCount,
+																												 const std::uint8_t* pMask = nullptr );
+
+			/** Software bins an image view. See rebin( pSrcBuf, ..., pDstBuf, eMode ).
+			 *  @param cView		- The source image view.
+			 *  @param uiColFactor	- The number of columns per bin.
+			 *  @param uiRowFactor	- The number of rows per bin.
+			 *  @param pDstBuf		- Pointer to the destination buffer. Must hold ( cols / uiColFactor ) * ( rows / uiRowFactor ) pixels.
+			 *  @param eMode		- Sum or average the pixels in each bin ( default = arc::gen3::image::e_Rebin::SUM ).
+			 *  @throws std::invalid_argument
+			 */
+			static void rebin( const arc::gen3::CArcImageView<const T>& cView, const std::uint32_t uiColFactor, const std::uint32_t uiRowFactor,
+							   std::uint32_t* pDstBuf, const arc::gen3::image::e_Rebin eMode = arc::gen3::image::e_Rebin::SUM );
+
+			/** Builds a pixel mask for an image view. Each mask byte holds the arc::gen3::image::e_Mask flags of the
+			 *  matching view pixel. Every pixel is tested for saturation. Pixels with a full set of neighbours are also
+			 *  tested for HOT ( neighbour contrast ) and COSMIC ( Laplacian significance, using a noise model of
+			 *  sqrt( read noise^2 + signal / gain ) ). If a persistent bad pixel map is supplied, its non-zero entries
+			 *  are marked BAD in the same pass. Large views are split into row bands that run on separate threads.
+			 *
+			 *  The mask, with or without a bad pixel map, can then be passed as pMask to the view overloads of
+			 *  getStats(), histogram(), preview() and previewLimits(). rebin(), the profiles and findSources() do
+			 *  not take a mask.
+			 *  @param cView	- The image view.
+			 *  @param cParams	- The detection settings.
+			 *  @param pMask	- Pointer to a cView.cols() x cView.rows() buffer that receives the mask.
+			 *  @param pBadMap	- Pointer to a cView.cols() x cView.rows() persistent bad pixel map, or nullptr ( default ).
+			 *  @return The number of pixels with at least one flag set.
+			 *  @throws std::invalid_argument
+			 */
+			static std::uint64_t createMask( const arc::gen3::CArcImageView<const T>& cView, const arc::gen3::image::CMaskParams& cParams, std::uint8_t* pMask,
+											 const std::uint8_t* pBadMap = nullptr );
+
+			/** Builds a pixel mask for an entire image buffer. See above.
+			 *  @param pBuf		- Pointer to the image buffer.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param cParams	- The detection settings.
+			 *  @param pMask	- Pointer to a uiCols x uiRows buffer that receives the mask.
+			 *  @param pBadMap	- Pointer to a uiCols x uiRows persistent bad pixel map, or nullptr ( default ).
+			 *  @return The number of pixels with at least one flag set.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::uint64_t createMask( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CMaskParams& cParams,
+											 std::uint8_t* pMask, const std::uint8_t* pBadMap = nullptr );
+
+			/** Repairs known detector defects in place by interpolating over them from the surrounding good pixels.
+			 *  Only the defect pixels are written, and only they and their nearest good neighbours are read, so the
+			 *  cost follows the size of the defect list rather than the image. A defect on the image edge uses its one
+			 *  good side. Defects are repaired in list order, so a defect may be interpolated from pixels repaired by an
+			 *  earlier entry; e.g. list a bad column before a bad row that crosses it.
+			 *  @param cView	- The image view.
+			 *  @param vDefects	- The defects. Each must lie within the view and have at least one good side.
+			 *  @throws std::invalid_argument
+			 */
+			static void repairDefects( const arc::gen3::CArcImageView<T>& cView, const std::vector<arc::gen3::image::CDefect>& vDefects );
+
+			/** Repairs the part of each defect that lies within rows [ uiRow1, uiRow2 ) of an image view. See above. This
+			 *  lets the repair run inside another per-frame pass that works through the image in bands of rows, such as
+			 *  a deinterlace or calibration band, while those rows are still in cache. The rows above and below each
+			 *  repaired row that a ROW or BOX defect reads from must already be final.
+			 *  @param cView	- The image view.
+			 *  @param vDefects	- The defects. Each must lie within the view and have at least one good side.
+			 *  @param uiRow1	- The start row.
+			 *  @param uiRow2	- The end row ( exclusive ).
+			 *  @throws std::invalid_argument
+			 *  @throws std::out_of_range
+			 */
+			static void repairDefects( const arc::gen3::CArcImageView<T>& cView, const std::vector<arc::gen3::image::CDefect>& vDefects, const std::uint32_t uiRow1,
+									   const std::uint32_t uiRow2 );
+
+			/** Repairs known detector defects in an entire image buffer. See above.
+			 *  @param pBuf		- Pointer to the image buffer.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param vDefects	- The defects. Each must lie within the image and have at least one good side.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static void repairDefects( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::vector<arc::gen3::image::CDefect>& vDefects );
+
+			/** Finds and measures the sources ( stars ) in an image view. This is intended for small, frequently read
+			 *  windows such as focus and guide frames, which can be passed as a sub-view of the readout buffer. The
+			 *  background level and noise are estimated from a sparse pixel sample, the pixels above the threshold are
+			 *  grouped into 8-connected components, and each component is then measured within a circular aperture.
+			 *  Working storage is kept per thread and reused, so repeated calls on same sized frames do not allocate.
+			 *  @param cView	- The image view.
+			 *  @param cParams	- The detection settings.
+			 *  @param vSources	- Receives the sources, brightest first. Its capacity is reused between calls.
+			 *  @return The number of sources found.
+			 *  @throws std::invalid_argument
+			 */
+			static std::uint32_t findSources( const arc::gen3::CArcImageView<const T>& cView, const arc::gen3::image::CSourceParams& cParams,
+											  std::vector<arc::gen3::image::CSource>& vSources );
+
+			/** Finds and measures the sources ( stars ) in an entire image buffer. See above.
+			 *  @param pBuf		- Pointer to the image buffer.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param cParams	- The detection settings.
+			 *  @param vSources	- Receives the sources, brightest first. Its capacity is reused between calls.
+			 *  @return The number of sources found.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::uint32_t findSources( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CSourceParams& cParams,
+											  std::vector<arc::gen3::image::CSource>& vSources );
+
+			/** Builds an 8-bit quick look image from an image view. The display limits are found from a sparse pixel
+			 *  sample, then each output pixel is the mean of its block of view pixels, scaled linearly so the low limit
+			 *  is 0 and the high limit is 255. The view is read once, in row bands on separate threads. Masked pixels are
+			 *  left out of the limit sample, so hot pixels and cosmic rays do not stretch the display, but are still
+			 *  averaged into the preview.
+			 *  @param cView	- The image view.
+			 *  @param cParams	- The display settings.
+			 *  @param pDstBuf	- Pointer to a uiDstCols x uiDstRows buffer that receives the preview.
+			 *  @param uiDstCols	- The preview column size ( in pixels ). Must not exceed the view column size.
+			 *  @param uiDstRows	- The preview row size ( in pixels ). Must not exceed the view row size.
+			 *  @param pMask	- Pointer to a cView.cols() x cView.rows() mask, e.g. from createMask(), whose flagged pixels are skipped, or nullptr ( default ).
+			 *  @return The low and high display limits used ( DN ).
+			 *  @throws std::invalid_argument
+			 */
+			static std::pair<double, double> preview( const arc::gen3::CArcImageView<const T>& cView, const arc::gen3::image::CPreviewParams& cParams,
+													  std::uint8_t* pDstBuf, const std::uint32_t uiDstCols, const std::uint32_t uiDstRows, const std::uint8_t* pMask = nullptr );
+
+			/** Builds an 8-bit quick look image from an entire image buffer. See above.
+			 *  @param pBuf		- Pointer to the image buffer.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param cParams	- The display settings.
+			 *  @param pDstBuf	- Pointer to a uiDstCols x uiDstRows buffer that receives the preview.
+			 *  @param uiDstCols	- The preview column size ( in pixels ). Must not exceed uiCols.
+			 *  @param uiDstRows	- The preview row size ( in pixels ). Must not exceed uiRows.
+			 *  @param pMask	- Pointer to a uiCols x uiRows mask, e.g. from createMask(), or nullptr ( default ).
+			 *  @return The low and high display limits used ( DN ).
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::pair<double, double> preview( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CPreviewParams& cParams,
+													  std::uint8_t* pDstBuf, const std::uint32_t uiDstCols, const std::uint32_t uiDstRows, const std::uint8_t* pMask = nullptr );
+
+			/** Returns the display limits CArcImage::preview would use for an image view.
+			 *  @param cView	- The image view.
+			 *  @param cParams	- The display settings.
+			 *  @param pMask	- Pointer to a cView.cols() x cView.rows() mask, e.g. from createMask(), whose flagged pixels are skipped, or nullptr ( default ).
+			 *  @return The low and high display limits ( DN ).
+			 *  @throws std::invalid_argument
+			 */
+			static std::pair<double, double> previewLimits( const arc::gen3::CArcImageView<const T>& cView, const arc::gen3::image::CPreviewParams& cParams,
+															const std::uint8_t* pMask = nullptr );
+
+			/** Finds the sub-pixel offset of a frame from a reference frame, e.g. between dithered exposures. The central
+			 *  square of both images is windowed and phase correlated with an FFT, and the correlation peak is refined to
+			 *  sub-pixel precision. If the peak is too weak ( e.g. a sparse field with little structure ), the offset is
+			 *  instead found by matching the source centroids of the two images; if that also fails the phase
+			 *  correlation result is returned, and its gPeak shows how little it can be trusted. Both images and the
+			 *  correlation window must be at least 16 x 16 pixels.
+			 *  @param cRef		- The reference image view.
+			 *  @param cFrame	- The frame image view.
+			 *  @param cParams	- The registration settings.
+			 *  @return The offset of the frame from the reference.
+			 *  @throws std::invalid_argument
+			 */
+			static arc::gen3::image::CShift findShift( const arc::gen3::CArcImageView<const T>& cRef, const arc::gen3::CArcImageView<const T>& cFrame,
+													   const arc::gen3::image::CRegisterParams& cParams );
+
+			/** Finds the offsets of a list of frames from a reference frame. See above. The reference is transformed once
+			 *  and the frames are registered on separate threads. FFT plans are cached and shared by all calls.
+			 *  @param cRef		- The reference image view.
+			 *  @param vFrames	- The frame image views.
+			 *  @param cParams	- The registration settings.
+			 *  @param vShifts	- Receives the offset of each frame, in list order.
+			 *  @throws std::invalid_argument
+			 */
+			static void findShifts( const arc::gen3::CArcImageView<const T>& cRef, const std::vector<arc::gen3::CArcImageView<const T>>& vFrames,
+									const arc::gen3::image::CRegisterParams& cParams, std::vector<arc::gen3::image::CShift>& vShifts );
+
+			/** Resamples a list of frames onto the reference frame grid and adds them into an accumulator ( shift and add ).
+			 *  Each frame is shifted by its offset with bilinear interpolation. Accumulator pixels that a frame does not
+			 *  cover are left unchanged by it, and the weight buffer counts the frames added to each pixel, so the mean
+			 *  stack is pSumBuf / pWeightBuf. The accumulator is split into bands of rows on separate threads, and each
+			 *  band adds every frame in turn.
+			 *  @param vFrames		- The frame image views.
+			 *  @param vShifts		- The offset of each frame, e.g. from findShifts().
+			 *  @param pSumBuf		- Pointer to the uiCols x uiRows accumulator.
+			 *  @param pWeightBuf	- Pointer to a uiCols x uiRows buffer that counts the frames added to each pixel, or nullptr.
+			 *  @param uiCols		- The accumulator column size ( in pixels ).
+			 *  @param uiRows		- The accumulator row size ( in pixels ).
+			 *  @throws std::invalid_argument
+			 */
+			static void shiftAndAdd( const std::vector<arc::gen3::CArcImageView<const T>>& vFrames, const std::vector<arc::gen3::image::CShift>& vShifts, float* pSumBuf,
+									 float* pWeightBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+
 			/** Determines the maximum value for a specific data type. Example, for std::uint16_t: 2^16 = 65536.
 			 *  @return The maximum value for the data type currently in use.
 			 */
@@ -557,6 +1449,223 @@ namespace arc
 			 */
 			static constexpr void verifyRangeOrder( const std::uint32_t uiValue1, const std::uint32_t uiValue2 );
 
+			/** Verifies that two image views are not empty and have the same dimensions.
+			 *  @param cView1 - The first image view.
+			 *  @param cView2 - The second image view.
+			 *  @throws std::invalid_argument
+			 */
+			static void verifySameSize( const arc::gen3::CArcImageView<const T>& cView1, const arc::gen3::CArcImageView<const T>& cView2 );
+
+			/** Returns the number of row bands ( threads ) to use when processing the specified area. Small areas
+			 *  return one, meaning the work should be done on the calling thread.
+			 *  @param uiCols	- The number of columns in the area.
+			 *  @param uiRows	- The number of rows in the area.
+			 *  @return The number of row bands to split the area into.
+			 */
+			static std::uint32_t bandCount( const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+			/** Splits the specified row range into bands and calls the specified function once per band. Band zero is run
+			 *  on the calling thread; all others are run on their own thread. Returns once all bands are complete.
+			 *  @param uiRow1	- The start row.
+			 *  @param uiRow2	- The end row ( exclusive ).
+			 *  @param uiBands	- The number of bands to split the rows into.
+			 *  @param fnBand	- Function called as fnBand( start row, end row, band index ) for each band.
+			 */
+			static void forEachRowBand( const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiBands,
+										const std::function<void( std::uint32_t, std::uint32_t, std::uint32_t )>& fnBand );
+
+			/** Calls the specified function once for each index in [ 0, uiCount ), spreading the calls over up to one
+			 *  thread per core. Any exception thrown by the function is rethrown on the calling thread once all threads
+			 *  are complete.
+			 *  @param uiCount	- The number of indexes.
+			 *  @param fnIndex	- Function called as fnIndex( index ).
+			 *  @throws Any exception thrown by fnIndex.
+			 */
+			static void forEachIndex( const std::uint32_t uiCount, const std::function<void( std::uint32_t )>& fnIndex );
+
+			/** Calculates the PTC pair statistics of two images for each amplifier. The returned gMean is the mean of the
+			 *  pair before bias subtraction. Pixel positions saturated in either image are counted and skipped.
+			 *  @param pBuf1			- Pointer to the first image.
+			 *  @param pBuf2			- Pointer to the second image.
+			 *  @param vAmps			- The amplifier regions, as exclusive ranges ( see verifyRois() ).
+			 *  @param uiCols			- The image column size ( in pixels ).
+			 *  @param uiRows			- The image row size ( in pixels ).
+			 *  @param gMaxSaturated	- The saturated pixel fraction above which a point is marked saturated.
+			 *  @param pPoints			- Pointer to vAmps.size() points that receive the results.
+			 */
+			static void ptcPair( const T* pBuf1, const T* pBuf2, const std::vector<arc::gen3::image::CRoi>& vAmps, const std::uint32_t uiCols, const std::uint32_t uiRows,
+								 const double gMaxSaturated, arc::gen3::image::CPtcPoint* pPoints );
+
+			/** Subtracts the bias from each flat pair point and fits the photon transfer curve of each amplifier.
+			 *  @param vBias	- The bias pair point of each amplifier.
+			 *  @param vFlats	- The flat pair points, stored pair by pair with one point per amplifier.
+			 *  @return A std::unique_ptr to an array of arc::gen3::image::CPtc objects, one per amplifier.
+			 *  @throws std::runtime_error
+			 */
+			static std::unique_ptr<arc::gen3::image::CPtc[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CPtc>>
+			ptcFit( const std::vector<arc::gen3::image::CPtcPoint>& vBias, const std::vector<arc::gen3::image::CPtcPoint>& vFlats );
+
+			/** Measures one source within a circular aperture. The centroid is refined once within the aperture before
+			 *  the flux, FWHM and HFD are measured about it.
+			 *  @param cView		- The image view.
+			 *  @param gBackground	- The background level ( DN ).
+			 *  @param gRadius		- The aperture radius ( pixels ).
+			 *  @param cSource		- The source. gCol and gRow hold the starting position on entry.
+			 */
+			static void measureSource( const arc::gen3::CArcImageView<const T>& cView, const double gBackground, const double gRadius, arc::gen3::image::CSource& cSource );
+
+			/** Verifies that each defect lies within an image and has at least one good side to interpolate from.
+			 *  @param vDefects	- The defects.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @throws std::invalid_argument
+			 */
+			static void verifyDefects( const std::vector<arc::gen3::image::CDefect>& vDefects, const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+			/** Repairs one row of a defect. See repairDefects().
+			 *  @param cView	- The image view.
+			 *  @param cDefect	- The defect.
+			 *  @param uiRow	- The row to repair. Must lie within the defect.
+			 */
+			static void repairDefectRow( const arc::gen3::CArcImageView<T>& cView, const arc::gen3::image::CDefect& cDefect, const std::uint32_t uiRow );
+
+			/** Loads the square window at ( uiCol, uiRow ) of an image view for phase correlation and transforms it. The
+			 *  window mean is subtracted and a Hann taper applied, so the image edges do not dominate the spectrum.
+			 *  @param cView	- The image view.
+			 *  @param uiCol	- The window start column.
+			 *  @param uiRow	- The window start row.
+			 *  @param uiSize	- The window side ( pixels ). Must be a power of two.
+			 *  @param pSpectrum	- Pointer to a uiSize x uiSize buffer that receives the spectrum.
+			 */
+			static void phaseSpectrum( const arc::gen3::CArcImageView<const T>& cView, const std::uint32_t uiCol, const std::uint32_t uiRow, const std::uint32_t uiSize,
+									   std::complex<float>* pSpectrum );
+
+			/** Refines a whole pixel phase correlation peak to sub-pixel precision by evaluating the correlation between
+			 *  samples directly from the cross power spectrum.
+			 *  @param pCross	- Pointer to the uiSize x uiSize normalized cross power spectrum.
+			 *  @param uiSize	- The spectrum side.
+			 *  @param gCol		- The whole pixel peak column on entry, the refined column on return.
+			 *  @param gRow		- The whole pixel peak row on entry, the refined row on return.
+			 */
+			static void refinePeak( const std::complex<float>* pCross, const std::uint32_t uiSize, double& gCol, double& gRow );
+
+			/** Finds the offset of a frame from a reference by matching their source centroids.
+			 *  @param vRefSources		- The reference sources.
+			 *  @param vFrameSources	- The frame sources.
+			 *  @param gMatchRadius		- The match radius ( pixels ).
+			 *  @param cShift			- Receives the offset and match count. Unchanged if no sources match.
+			 *  @return true if at least one source matched.
+			 */
+			static bool centroidShift( const std::vector<arc::gen3::image::CSource>& vRefSources, const std::vector<arc::gen3::image::CSource>& vFrameSources,
+									   const double gMatchRadius, arc::gen3::image::CShift& cShift );
+
+			/** Fills a vector with an evenly spaced sample of the pixels in an image view. An odd step is used so the
+			 *  sample does not follow a column pattern. The vector's capacity is reused.
+			 *  @param cView		- The image view.
+			 *  @param u64Samples	- The number of pixels to sample. The whole view is used if it is smaller.
+			 *  @param vSample		- Receives the sample.
+			 *  @param pMask		- Pointer to a cView.cols() x cView.rows() mask whose flagged pixels are left out, or nullptr ( default ). If every sampled pixel is masked, the mask is ignored.
+			 */
+			static void samplePixels( const arc::gen3::CArcImageView<const T>& cView, const std::uint64_t u64Samples, std::vector<T>& vSample,
+									  const std::uint8_t* pMask = nullptr );
+
+			/** Returns the IRAF zscale display limits for a pixel sample.
+			 *  @param vSample		- The pixel sample. Sorted on return.
+			 *  @param gContrast	- The zscale contrast.
+			 *  @return The low and high display limits ( DN ).
+			 */
+			static std::pair<double, double> zscale( std::vector<T>& vSample, const double gContrast );
+
+			/** Returns the amplifier regions for a PTC reduction as exclusive ranges. A nullptr list returns the whole image.
+			 *  @param pAmps		- Pointer to an array of amplifier regions, or nullptr.
+			 *  @param uiAmpCount	- The number of amplifier regions.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @return The amplifier regions.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::vector<arc::gen3::image::CRoi> ptcAmps( const arc::gen3::image::CRoi* pAmps, const std::uint32_t uiAmpCount, const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+			/** Verifies that a PTC saturated pixel fraction is within 0 - 1.
+			 *  @param gMaxSaturated	- The saturated pixel fraction.
+			 *  @throws std::invalid_argument
+			 */
+			static void verifySaturatedFraction( const double gMaxSaturated );
+
+			/** Validates an image area using the same rules as getStats() and returns a view of it. An equal start and
+			 *  end column ( or row ) selects the single column ( or row ).
+			 *  @param pBuf		- Pointer to the image data buffer.
+			 *  @param uiCol1	- The start column.
+			 *  @param uiCol2	- The end column.
+			 *  @param uiRow1	- The start row.
+			 *  @param uiRow2	- The end row.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @return A view of the area.
+			 *  @throws std::runtime_error
+			 */
+			static arc::gen3::CArcImageView<const T> areaView( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1,
+																const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+			/** Validates a list of regions against the specified image size and converts each to an exclusive column
+			 *  and row range.
+			 *  @param pRois		- Pointer to an array of regions.
+			 *  @param uiRoiCount	- The number of regions in the array.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @return The converted regions.
+			 *  @throws std::runtime_error
+			 *  @throws std::invalid_argument
+			 */
+			static std::vector<arc::gen3::image::CRoi> verifyRois( const arc::gen3::image::CRoi* pRois, const std::uint32_t uiRoiCount, const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+			/** Calculates the statistics for a list of regions in a single pass over the specified view.
+			 *  @param cView	- The image view.
+			 *  @param vRois	- The regions, as exclusive column and row ranges relative to the view.
+			 *  @param pMask	- Pointer to a cView.cols() x cView.rows() mask whose flagged pixels are skipped, or nullptr.
+			 *  @return A std::unique_ptr to an array of arc::gen3::image::CStats objects, one per region.
+			 *  @throws std::runtime_error
+			 */
+			static std::unique_ptr<arc::gen3::image::CStats[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CStats>>
+			roiStats( const arc::gen3::CArcImageView<const T>& cView, const std::vector<arc::gen3::image::CRoi>& vRois, const std::uint8_t* pMask = nullptr );
+
+			/** Correlated double sampling kernel for the subtractHalves() overloads that write to a separate buffer.
+			 *  @param cView	- The image view.
+			 *  @param pDstBuf	- Pointer to the contiguous buffer that receives the result.
+			 *  @param uiReads	- The number of reads per half.
+			 *  @throws std::invalid_argument
+			 */
+			template <typename U>
+			static void cds( const arc::gen3::CArcImageView<const T>& cView, U* pDstBuf, const std::uint32_t uiReads );
+
+			/** Calculates the average of each row of the specified view. See getRowArea().
+			 *  @param cView	- The image view.
+			 *  @param pAreaBuf	- Pointer to the buffer that receives the row profile.
+			 *  @throws std::invalid_argument
+			 */
+			template <typename U>
+			static void rowProfile( const arc::gen3::CArcImageView<const T>& cView, U* pAreaBuf );
+
+			/** Calculates the average of each column of the specified view. See getColArea().
+			 *  @param cView	- The image view.
+			 *  @param pAreaBuf	- Pointer to the buffer that receives the column profile.
+			 *  @throws std::invalid_argument
+			 */
+			template <typename U>
+			static void colProfile( const arc::gen3::CArcImageView<const T>& cView, U* pAreaBuf );
+
+			/** Reduces one line of column sums produced by rebin() to output pixels. A non-zero F is the compile-time
+			 *  column factor, allowing the inner loop to be unrolled; zero uses uiColFactor.
+			 *  @param pLine		- Pointer to the column sums for one row of bins.
+			 *  @param uiNewCols	- The number of output pixels.
+			 *  @param uiColFactor	- The number of columns per bin.
+			 *  @param u64Divisor	- The value each bin sum is divided by ( one for a sum ).
+			 *  @param pDstBuf		- Pointer to the output row.
+			 */
+			template <std::uint32_t F>
+			static void rebinLine( const std::uint64_t* pLine, const std::uint32_t uiNewCols, const std::uint32_t uiColFactor, const std::uint64_t u64Divisor, std::uint32_t* pDstBuf );
+
 			/** Draws a semi-circle on the specified buffer.
 			 *  @param uiXCenter	- x position of circle center point.
 			 *  @param uiYCenter	- y position of circle center point.
@@ -20,6 +20,7 @@ namespace {
                                         // this is the remaining prescan after removing what we can
                                         // using the SXY (skip X,Y) command
     int const YQuadBorder = 2;          // border between Y amp images when using quad readout
+    int const NumSaveBuffers = 2;       // number of images that can wait to be written to FITS files
 
     std::string const TimingBoardFileName = "/home/arctic/leach/tim.lod";
 
@@ -202,6 +203,45 @@ namespace arcticICC {
         return CCDHeight + YQuadBorder;
     }
 
+    std::vector<arc::gen3::fits::AmpSection> CameraConfig::getAmpSections() const {
+        int const width = getBinnedWidth();
+        int const height = getBinnedHeight();
+        std::vector<arc::gen3::fits::AmpSection> sections;
+        if (getNumAmps() == 1) {
+            int const dataEnd = XBinnedPrescanPerAmp + winWidth;
+            sections.push_back({ReadoutAmpsNameMap.find(readoutAmps)->second,
+                {0, 0}, {width - 1, height - 1},
+                {XBinnedPrescanPerAmp, 0}, {dataEnd - 1, height - 1},
+                {dataEnd, 0}, {width - 1, height - 1},
+                dataEnd < width});
+            return sections;
+        }
+
+        // quad readout: each quadrant is prescan + data + overscan wide and data + border row high
+        int const ampWidth = width / 2;
+        int const ampHeight = height / 2;
+        int const dataWidth = winWidth / 2;
+        int const dataHeight = winHeight / 2;
+        int const overscanWidth = ampWidth - XBinnedPrescanPerAmp - dataWidth;
+        for (auto const amp : {ReadoutAmps::LL, ReadoutAmps::LR, ReadoutAmps::UL, ReadoutAmps::UR}) {
+            bool const isRight = (amp == ReadoutAmps::LR) || (amp == ReadoutAmps::UR);
+            bool const isUpper = (amp == ReadoutAmps::UL) || (amp == ReadoutAmps::UR);
+            int const col0 = isRight ? ampWidth : 0;
+            int const row0 = isUpper ? ampHeight : 0;
+            // the border row is at the center of the image
+            int const dataRow0 = isUpper ? ampHeight - dataHeight : 0;
+            // the prescan is at the outer edge, the overscan toward the center
+            int const dataCol0 = isRight ? overscanWidth : XBinnedPrescanPerAmp;
+            int const biasCol0 = isRight ? 0 : XBinnedPrescanPerAmp + dataWidth;
+            sections.push_back({ReadoutAmpsNameMap.find(amp)->second,
+                {col0, row0}, {col0 + ampWidth - 1, row0 + ampHeight - 1},
+                {dataCol0, dataRow0}, {dataCol0 + dataWidth - 1, dataRow0 + dataHeight - 1},
+                {biasCol0, dataRow0}, {biasCol0 + overscanWidth - 1, dataRow0 + dataHeight - 1},
+                overscanWidth > 0});
+        }
+        return sections;
+    }
+
 
     Camera::Camera() :
         _config(),
@@ -212,7 +252,10 @@ namespace arcticICC {
         _segmentExpSec(-1),
         _segmentStartTime(),
         _segmentStartValid(false),
-        _device()
+        _saveMEF(false),
+        _saveChecksum(false),
+        _device(),
+        _fitsWriter(CameraConfig::getMaxWidth(), CameraConfig::getMaxHeight(), NumSaveBuffers)
     {
         int const fullWidth = CameraConfig::getMaxWidth();
         int const fullHeight = CameraConfig::getMaxHeight();
@@ -428,31 +471,22 @@ namespace arcticICC {
         }
 
         try {
-	    arc::gen3::dlace::e_Alg deinterlaceAlgorithm = ReadoutAmpsDeinterlaceAlgorithmMap.find(_config.readoutAmps)->second; 
-            //Gotta create a *uint16 from the *uint8 returned by commonBufferVA().
-	    uint8_t *commonBufferVA_8=_device.commonBufferVA();
-	    uint16_t commonBufferVA_16= 0x0000 | *commonBufferVA_8;
-            arc::gen3::CArcDeinterlace deinterlacer;
-            std::cout << "deinterlacer.run(" << commonBufferVA_16 
-		    << ", " <<  _config.getBinnedHeight()
-		    << ", " << _config.getBinnedWidth() 
-		    << ", " << uint32_t(deinterlaceAlgorithm) 
-		    << ", " << "{}"
-		    << ")" << std::endl;
-            deinterlacer.run(&commonBufferVA_16,
-			    _config.getBinnedHeight(),
-			    _config.getBinnedWidth(),
-			    deinterlaceAlgorithm, 
-			    {}
-			    );
-
-
-            arc::gen3::CArcFitsFile cFits;
-            cFits.create(_expName.c_str(), _config.getBinnedHeight(), _config.getBinnedWidth());
-
-            cFits.write(&commonBufferVA_16);
-
-            std::cout << "saved image as \"" << _expName << "\"\n";
+            arc::gen3::dlace::e_Alg deinterlaceAlgorithm = ReadoutAmpsDeinterlaceAlgorithmMap.find(_config.readoutAmps)->second;
+            // the common buffer is reused by the next exposure, so the writer copies the image out
+            // and deinterlaces and writes the copy in the background
+            auto commonBuffer = reinterpret_cast<uint16_t const *>(_device.commonBufferVA());
+            std::cout << "_fitsWriter.submit(" << _config.getBinnedWidth()
+                << ", " << _config.getBinnedHeight()
+                << ", " << uint32_t(deinterlaceAlgorithm)
+                << ", \"" << _expName << "\")" << std::endl;
+            _fitsWriter.submit(commonBuffer,
+                _config.getBinnedWidth(),
+                _config.getBinnedHeight(),
+                deinterlaceAlgorithm,
+                _expName,
+                _saveMEF ? _config.getAmpSections() : std::vector<arc::gen3::fits::AmpSection>(),
+                _saveChecksum
+            );
         } catch(...) {
             _setIdle();
             throw;
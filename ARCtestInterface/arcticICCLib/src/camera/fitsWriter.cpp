@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "CArcFitsFile.h"
+
+#include "arcticICC/fitsWriter.h"
+
+namespace arcticICC {
+
+    FitsWriter::FitsWriter(int maxWidth, int maxHeight, int numBuffers, int numThreads) :
+        _maxPixels(maxWidth * maxHeight),
+        _buffers(),
+        _freeBuffers(),
+        _jobs(),
+        _numActive(0),
+        _stopping(false),
+        _errors(),
+        _mutex(),
+        _jobReady(),
+        _bufferFreed(),
+        _threads()
+    {
+        if ((maxWidth < 1) || (maxHeight < 1) || (numBuffers < 1) || (numThreads < 1)) {
+            std::ostringstream os;
+            os << "maxWidth=" << maxWidth << ", maxHeight=" << maxHeight << ", numBuffers=" << numBuffers
+                << " and numThreads=" << numThreads << " must all be >= 1";
+            throw std::runtime_error(os.str());
+        }
+        for (int i = 0; i < numBuffers; ++i) {
+            _buffers.emplace_back(new std::uint16_t[_maxPixels]);
+            _freeBuffers.push_back(i);
+        }
+        for (int i = 0; i < numThreads; ++i) {
+            _threads.emplace_back(&FitsWriter::_run, this);
+        }
+    }
+
+    FitsWriter::~FitsWriter() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _jobReady.notify_all();
+        for (auto &thread : _threads) {
+            thread.join();
+        }
+    }
+
+    std::future<void> FitsWriter::submit(
+        std::uint16_t const *data,
+        int width,
+        int height,
+        arc::gen3::dlace::e_Alg alg,
+        std::string const &fileName,
+        std::vector<arc::gen3::fits::AmpSection> const &amps,
+        bool checksum,
+        double timeoutSec,
+        Callback callback
+    ) {
+        if ((width < 1) || (height < 1) || (width > _maxPixels / height)) {
+            std::ostringstream os;
+            os << "frame width=" << width << " x height=" << height << " must be positive and fit in "
+                << _maxPixels << " pixels";
+            throw std::runtime_error(os.str());
+        }
+
+        int bufferIndex;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            auto haveBuffer = [this] { return !_freeBuffers.empty(); };
+            if (timeoutSec < 0) {
+                _bufferFreed.wait(lock, haveBuffer);
+            } else if (!_bufferFreed.wait_for(lock, std::chrono::duration<double>(timeoutSec), haveBuffer)) {
+                std::ostringstream os;
+                os << "cannot queue \"" << fileName << "\": all " << _buffers.size()
+                    << " frame buffers still in use after " << timeoutSec << " sec";
+                throw std::runtime_error(os.str());
+            }
+            bufferIndex = _freeBuffers.back();
+            _freeBuffers.pop_back();
+        }
+
+        // copy outside the lock so writer threads are not held up
+        std::memcpy(_buffers[bufferIndex].get(), data, std::size_t(width) * std::size_t(height) * sizeof(std::uint16_t));
+
+        std::future<void> future;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _jobs.push_back(Job{bufferIndex, width, height, alg, fileName, amps, checksum, std::promise<void>(), std::move(callback)});
+            future = _jobs.back().promise.get_future();
+        }
+        _jobReady.notify_one();
+        return future;
+    }
+
+    void FitsWriter::waitAll() {
+        std::vector<std::string> errors;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _bufferFreed.wait(lock, [this] { return _jobs.empty() && (_numActive == 0); });
+            errors.swap(_errors);
+        }
+        if (!errors.empty()) {
+            std::ostringstream os;
+            os << errors.size() << " FITS file(s) could not be written:";
+            for (auto const &error : errors) {
+                os << "\n" << error;
+            }
+            throw std::runtime_error(os.str());
+        }
+    }
+
+    int FitsWriter::getNumPending() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return int(_jobs.size()) + _numActive;
+    }
+
+    int FitsWriter::getNumFree() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return int(_freeBuffers.size());
+    }
+
+// private methods
+
+    void FitsWriter::_run() {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _jobReady.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+                if (_jobs.empty()) {
+                    return; // stopping and nothing left to write
+                }
+                job = std::move(_jobs.front());
+                _jobs.pop_front();
+                ++_numActive;
+            }
+
+            std::exception_ptr error;
+            try {
+                _write(job);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            if (error) {
+                job.promise.set_exception(error);
+            } else {
+                job.promise.set_value();
+            }
+            if (job.callback) {
+                try {
+                    job.callback(job.fileName, error);
+                } catch (std::exception const &e) {
+                    std::cout << "FitsWriter callback for \"" << job.fileName << "\" failed: " << e.what() << std::endl;
+                } catch (...) {
+                    std::cout << "FitsWriter callback for \"" << job.fileName << "\" failed" << std::endl;
+                }
+            }
+
+            // release the buffer last, so once waitAll returns every future is ready and every callback has run
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (error) {
+                    try {
+                        std::rethrow_exception(error);
+                    } catch (std::exception const &e) {
+                        _errors.push_back("\"" + job.fileName + "\": " + e.what());
+                    } catch (...) {
+                        _errors.push_back("\"" + job.fileName + "\": unknown error");
+                    }
+                }
+                _freeBuffers.push_back(job.bufferIndex);
+                --_numActive;
+            }
+            _bufferFreed.notify_all();
+        }
+    }
+
+    void FitsWriter::_write(Job &job) {
+        std::uint16_t *buffer = _buffers[job.bufferIndex].get();
+
+        arc::gen3::CArcDeinterlace deinterlacer;
+        deinterlacer.run(buffer, job.width, job.height, job.alg);
+
+        // a plain 16-bit image with no extra keywords, so skip cfitsio's per-pixel conversion
+        if (job.amps.empty()) {
+            arc::gen3::CArcFitsFile<>::writeDirect(job.fileName, buffer, job.width, job.height, nullptr, false, job.checksum);
+        } else {
+            arc::gen3::CArcFitsFile<>::writeMEF(job.fileName, buffer, job.width, job.height, job.amps, nullptr, job.checksum);
+        }
+
+        std::cout << "saved image as \"" << job.fileName << "\"\n";
+    }
+
+} // namespace
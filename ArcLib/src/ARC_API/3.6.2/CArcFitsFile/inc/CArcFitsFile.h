@@ -16,12 +16,21 @@
 #endif
 
 #include <filesystem>
+#include <fstream>
 #include <version>
+#include <chrono>
 #include <stdexcept>
 #include <cstdint>
 #include <utility>
 #include <memory>
 #include <string>
+#include <vector>
+#include <list>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 #ifdef __cpp_lib_variant
 	#include <variant>
@@ -32,6 +41,7 @@
 #include <CArcFitsFileDllMain.h>
 #include <CArcStringList.h>
 #include <CArcBase.h>
+#include <CArcImageView.h>
 
 #include <fitsio.h>		// This header MUST be last to prevent winnt.h constant error!
 
@@ -113,6 +123,52 @@ namespace arc
 			};
 
 
+			/** @enum arc::gen3::fits::e_Flush
+			 *  Defines when the write methods force buffered data out to the disk file.
+			 *  @var arc::gen3::fits::e_Flush::EVERY_WRITE	- Flush after every write ( default )
+			 *  @var arc::gen3::fits::e_Flush::FRAMES		- Flush after every N writes
+			 *  @var arc::gen3::fits::e_Flush::BYTES		- Flush once N bytes have been written since the last flush
+			 *  @var arc::gen3::fits::e_Flush::ON_CLOSE		- Only flush when the file is closed or flush() is called
+			 *  @var arc::gen3::fits::e_Flush::INTERVAL		- Flush on the first write N milliseconds or more after the last flush
+			 */
+			enum class e_Flush : std::int32_t
+			{
+				EVERY_WRITE = 0,
+				FRAMES,
+				BYTES,
+				ON_CLOSE,
+				INTERVAL
+			};
+
+
+			/** @enum arc::gen3::fits::e_Compress
+			 *  Defines the tile compression algorithms for new files. All are lossless for integer images.
+			 *  @var arc::gen3::fits::e_Compress::NONE		- Uncompressed ( default )
+			 *  @var arc::gen3::fits::e_Compress::RICE		- Rice; write() compresses the tiles in parallel
+			 *  @var arc::gen3::fits::e_Compress::GZIP		- GZIP; compressed by cfitsio
+			 *  @var arc::gen3::fits::e_Compress::HCOMPRESS	- H-compress; compressed by cfitsio
+			 */
+			enum class e_Compress : std::int32_t
+			{
+				NONE = 0,
+				RICE,
+				GZIP,
+				HCOMPRESS
+			};
+
+
+			/** @enum arc::gen3::fits::e_Compare
+			 *  Defines how far CArcFitsFile::compareData() goes once the images differ.
+			 *  @var arc::gen3::fits::e_Compare::FIRST_DIFF	- Stop at the first differing pixel ( default )
+			 *  @var arc::gen3::fits::e_Compare::ALL_DIFFS	- Compare every pixel and gather difference statistics
+			 */
+			enum class e_Compare : std::int32_t
+			{
+				FIRST_DIFF = 0,
+				ALL_DIFFS
+			};
+
+
 			/** Image parameters info class. */
 			class GEN3_CARCFITSFILE_API CParam
 			{
@@ -205,6 +261,386 @@ namespace arc
 			 */
 			constexpr auto MAKE_POINT( std::uint32_t uiColumn, std::uint32_t uiRow ) { return std::make_pair( uiColumn, uiRow ); }
 
+
+			/** @struct AmpSection
+			 *  One readout amplifier's part of a deinterlaced frame, written as an image extension by
+			 *  CArcFitsFile::writeMEF(). Points are 0-based { col, row } and inclusive, as for writeSubImage(). The data
+			 *  and bias sections are relative to the amplifier's region, and are written as the 1-based DATASEC and
+			 *  BIASSEC keywords.
+			 */
+			struct GEN3_CARCFITSFILE_API AmpSection
+			{
+				/** The extension name ( EXTNAME ) */
+				std::string m_sName;
+
+				/** The lower left point of the amplifier's region of the frame */
+				Point m_lowerLeft;
+
+				/** The upper right point of the amplifier's region of the frame */
+				Point m_upperRight;
+
+				/** The lower left point of the image data within the region */
+				Point m_dataLowerLeft;
+
+				/** The upper right point of the image data within the region */
+				Point m_dataUpperRight;
+
+				/** The lower left point of the overscan within the region */
+				Point m_biasLowerLeft;
+
+				/** The upper right point of the overscan within the region */
+				Point m_biasUpperRight;
+
+				/** true if the region has an overscan; BIASSEC is only written if it does */
+				bool m_bBias;
+			};
+
+
+			/** @struct CompareResult
+			 *  The result of CArcFitsFile::compareData(). Differences are this file's pixel value minus the passed
+			 *  file's. The statistics other than the first difference are only gathered for e_Compare::ALL_DIFFS.
+			 */
+			struct GEN3_CARCFITSFILE_API CompareResult
+			{
+				/** Returns true if the image data is identical. */
+				bool match( void ) const noexcept { return ( m_u64DiffCount == 0 ); }
+
+				/** The number of pixels compared; for FIRST_DIFF, at least up to the first difference */
+				std::uint64_t m_u64Pixels = 0;
+
+				/** The number of differing pixels; 0 or 1 for FIRST_DIFF */
+				std::uint64_t m_u64DiffCount = 0;
+
+				/** The { col, row } of the first differing pixel, in file order; { -1, -1 } if none */
+				Point m_firstDiff = { -1, -1 };
+
+				/** The frame of the first differing pixel; 0 for a single image */
+				std::uint32_t m_uiFirstDiffFrame = 0;
+
+				/** This file's value at the first differing pixel */
+				std::uint32_t m_uiThisValue = 0;
+
+				/** The passed file's value at the first differing pixel */
+				std::uint32_t m_uiPassedValue = 0;
+
+				/** The smallest difference */
+				std::int64_t m_i64MinDiff = 0;
+
+				/** The largest difference */
+				std::int64_t m_i64MaxDiff = 0;
+
+				/** The mean difference over all pixels */
+				double m_gMeanDiff = 0.0;
+			};
+
+
+			/** @class CMappedImage
+			 *  Read only memory mapping of the image data in an uncompressed FITS file. Nothing is read or copied up
+			 *  front; pages are loaded by the operating system as they are touched. The mapped pixels are in file
+			 *  order: big-endian and offset by BZERO. rawView() exposes them as is, and decode() converts any region
+			 *  into a caller buffer. The mapping stays valid after the CArcFitsFile that created it is closed.
+			 *  @see arc::gen3::CArcFitsFile::mapImage()
+			 */
+			template <typename T>
+			class GEN3_CARCFITSFILE_API CMappedImage
+			{
+				public:
+
+					/** Constructor. Normally called by CArcFitsFile::mapImage().
+					 *  @param tFileName - The FITS file name.
+					 *  @param u64Offset - The byte offset of the image data within the file.
+					 *  @param uiCols    - The image column size ( in pixels ).
+					 *  @param uiRows    - The image row size ( in pixels ).
+					 *  @param uiFrames  - The number of image frames ( 1 for a single image ).
+					 *  @param tZero     - The BZERO value, as a pixel value ( modulo 2^bits ).
+					 *  @throws std::runtime_error
+					 *  @throws std::invalid_argument
+					 */
+					CMappedImage( const std::filesystem::path& tFileName, const std::uint64_t u64Offset, const std::uint32_t uiCols, const std::uint32_t uiRows,
+								  const std::uint32_t uiFrames, const T tZero );
+
+					/** Destructor. Unmaps the file. */
+					~CMappedImage( void );
+
+					CMappedImage( const CMappedImage& ) = delete;
+					CMappedImage& operator=( const CMappedImage& ) = delete;
+
+					/** Returns the image column size ( in pixels ). */
+					std::uint32_t cols( void ) const noexcept { return m_uiCols; }
+
+					/** Returns the image row size ( in pixels ). */
+					std::uint32_t rows( void ) const noexcept { return m_uiRows; }
+
+					/** Returns the number of image frames ( 1 for a single image ). */
+					std::uint32_t frames( void ) const noexcept { return m_uiFrames; }
+
+					/** Returns the BZERO value, as a pixel value ( modulo 2^bits ). */
+					T zero( void ) const noexcept { return m_tZero; }
+
+					/** Returns a view of one frame's pixels exactly as stored in the file: big-endian and offset by BZERO.
+					 *  No pixels are read or copied. Use subView() for a region and decode() to convert it.
+					 *  @param uiFrame - The frame number, starting at 0.
+					 *  @return A view into the mapped file.
+					 *  @throws std::invalid_argument
+					 */
+					arc::gen3::CArcImageView<const T> rawView( const std::uint32_t uiFrame = 0 ) const;
+
+					/** Converts a region of one frame to native pixel values in a caller buffer. The region starts at
+					 *  { uiCol, uiRow } and has the size of the destination view.
+					 *  @param cView   - The destination view.
+					 *  @param uiCol   - The region start column.
+					 *  @param uiRow   - The region start row.
+					 *  @param uiFrame - The frame number, starting at 0.
+					 *  @throws std::invalid_argument
+					 */
+					void decode( const arc::gen3::CArcImageView<T>& cView, const std::uint32_t uiCol = 0, const std::uint32_t uiRow = 0, const std::uint32_t uiFrame = 0 ) const;
+
+					/** Converts one frame to native pixel values in a caller buffer.
+					 *  @param pBuf    - The destination buffer; must hold cols() x rows() pixels.
+					 *  @param uiFrame - The frame number, starting at 0.
+					 *  @throws std::invalid_argument
+					 */
+					void decode( T* pBuf, const std::uint32_t uiFrame = 0 ) const;
+
+				private:
+
+					/** Start of the mapping ( page aligned ) */
+					void* m_pMap;
+
+					/** Mapping length ( in bytes ) */
+					std::uint64_t m_u64MapBytes;
+
+					/** First pixel of the image data */
+					const T* m_pData;
+
+					/** Image column size ( in pixels ) */
+					std::uint32_t m_uiCols;
+
+					/** Image row size ( in pixels ) */
+					std::uint32_t m_uiRows;
+
+					/** Number of image frames */
+					std::uint32_t m_uiFrames;
+
+					/** BZERO value, as a pixel value */
+					T m_tZero;
+			};
+
+
+			/** @class CHeaderTemplate
+			 *  A precompiled set of header keywords. define() formats each keyword once as a fixed width 80 character
+			 *  card; the set methods only rewrite the value columns of a card, so a template can be defined at
+			 *  startup and re-bound for every exposure. CArcFitsFile::writeHeader() and CArcFitsFile::writeDirect()
+			 *  append all of the cards in one pass, without the per keyword type switch, value conversion and
+			 *  header search of writeKeyword().
+			 *
+			 *  A keyword with no value bound is written with an undefined ( blank ) value. HIERARCH keywords are not
+			 *  supported; use CArcFitsFile::writeKeyword() for those.
+			 */
+			class GEN3_CARCFITSFILE_API CHeaderTemplate
+			{
+				public:
+
+					/** Constructor */
+					CHeaderTemplate( void );
+
+					/** Adds a keyword to the template.
+					 *  @param sKey     - A FITS keyword of up to 8 characters ( A-Z, 0-9, '-' and '_' ). Ignored for
+					 *                    FITS_COMMENT_KEY and FITS_HISTORY_KEY; "DATE" for FITS_DATE_KEY.
+					 *  @param eType    - The keyword value type.
+					 *  @param sComment - The keyword comment. The text itself for FITS_COMMENT_KEY and FITS_HISTORY_KEY.
+					 *  @param uiWidth  - The maximum FITS_STRING_KEY value length, in characters, after quotes are
+					 *                    doubled ( 0 = 18 ). Ignored for other types.
+					 *  @return The keyword slot, used to bind its value.
+					 *  @throws std::invalid_argument
+					 */
+					std::uint32_t define( const std::string& sKey, const arc::gen3::fits::e_Type eType, const std::string& sComment = "",
+										  const std::uint32_t uiWidth = 0 );
+
+					/** Binds a FITS_STRING_KEY, FITS_COMMENT_KEY, FITS_HISTORY_KEY or FITS_DATE_KEY value.
+					 *  @param uiSlot - The slot returned by define().
+					 *  @param sValue - The value; must fit the width given to define().
+					 *  @throws std::invalid_argument
+					 */
+					void setString( const std::uint32_t uiSlot, const std::string& sValue );
+
+					/** Binds an integer ( FITS_INT_KEY through FITS_LONGLONG_KEY, except floating point ) value.
+					 *  @param uiSlot   - The slot returned by define().
+					 *  @param i64Value - The value.
+					 *  @throws std::invalid_argument
+					 */
+					void setInteger( const std::uint32_t uiSlot, const std::int64_t i64Value );
+
+					/** Binds a FITS_FLOAT_KEY or FITS_DOUBLE_KEY value.
+					 *  @param uiSlot  - The slot returned by define().
+					 *  @param gValue  - The value; must be finite.
+					 *  @throws std::invalid_argument
+					 */
+					void setDouble( const std::uint32_t uiSlot, const double gValue );
+
+					/** Binds a FITS_LOGICAL_KEY value.
+					 *  @param uiSlot - The slot returned by define().
+					 *  @param bValue - The value.
+					 *  @throws std::invalid_argument
+					 */
+					void setLogical( const std::uint32_t uiSlot, const bool bValue );
+
+					/** Binds the current system date and time ( UTC ) to a FITS_DATE_KEY.
+					 *  @param uiSlot - The slot returned by define().
+					 *  @throws std::invalid_argument
+					 */
+					void setDate( const std::uint32_t uiSlot );
+
+					/** Sets the number of blank keyword cards to reserve after the template, so that keywords can be added
+					 *  or updated after the image data is written without moving it. The blank cards are written before
+					 *  the END card.
+					 *  @param uiCards - The number of keyword cards to reserve.
+					 */
+					void reserve( const std::uint32_t uiCards ) noexcept;
+
+					/** Returns the number of reserved keyword cards. */
+					std::uint32_t getReserved( void ) const noexcept { return m_uiReserved; }
+
+					/** Returns the number of keywords in the template. */
+					std::uint32_t getCount( void ) const noexcept { return static_cast< std::uint32_t >( m_vTypes.size() ); }
+
+					/** Returns the formatted keyword cards, 80 characters each and not null terminated. */
+					const std::string& getCards( void ) const noexcept { return m_sCards; }
+
+				private:
+
+					/** Verifies a slot and its type.
+					 *  @param uiSlot  - The slot returned by define().
+					 *  @param fnValid - Returns true for the types that the caller can bind.
+					 *  @throws std::invalid_argument
+					 */
+					template <typename F>
+					void verifySlot( const std::uint32_t uiSlot, F&& fnValid ) const;
+
+					/** Writes a value into the value columns of a card.
+					 *  @param uiSlot     - The slot returned by define().
+					 *  @param sValue     - The formatted value.
+					 *  @param bRightJust - true to right justify the value ( numbers and logicals ).
+					 *  @throws std::invalid_argument
+					 */
+					void setValue( const std::uint32_t uiSlot, const std::string& sValue, const bool bRightJust );
+
+					/** The keyword value types, by slot */
+					std::vector<arc::gen3::fits::e_Type> m_vTypes;
+
+					/** The value column offset, within its card, by slot */
+					std::vector<std::uint32_t> m_vValueCol;
+
+					/** The value field width ( in characters ), by slot */
+					std::vector<std::uint32_t> m_vValueWidth;
+
+					/** The formatted cards */
+					std::string m_sCards;
+
+					/** The number of reserved keyword cards */
+					std::uint32_t m_uiReserved;
+			};
+
+
+			/** @class CCubeWriter
+			 *  Streaming data cube writer for continuous readout. The header is written once, with NAXIS3 set to the
+			 *  expected frame count, and the data space is preallocated. Each frame is then converted and written at its
+			 *  fixed offset, with no header update or flush per frame. When more frames arrive than expected, the
+			 *  preallocation doubles. close() writes the final NAXIS3 and trims the file to the frames written.
+			 *
+			 *  Until close(), NAXIS3 holds the preallocated frame count, and frames not yet written read as zero.
+			 *  Like CArcFitsFile::writeDirect(), this does not go through cfitsio.
+			 */
+			template <typename T>
+			class GEN3_CARCFITSFILE_API CCubeWriter
+			{
+				public:
+
+					/** Constructor. Creates the file, writes the header and preallocates the data.
+					 *  @param tFileName        - The file name. An existing file is replaced.
+					 *  @param uiCols           - The frame column size ( in pixels ).
+					 *  @param uiRows           - The frame row size ( in pixels ).
+					 *  @param uiExpectedFrames - The number of frames to preallocate space for ( at least 1 ).
+					 *  @param pHeader          - Optional keywords to add to the header. May be nullptr.
+					 *  @param bChecksum        - true to add CHECKSUM and DATASUM keywords, summed as each frame is written
+					 *                            and filled in by close().
+					 *  @throws std::runtime_error
+					 *  @throws std::invalid_argument
+					 */
+					CCubeWriter( const std::filesystem::path& tFileName, const std::uint32_t uiCols, const std::uint32_t uiRows,
+								 const std::uint32_t uiExpectedFrames, const arc::gen3::fits::CHeaderTemplate* pHeader = nullptr,
+								 const bool bChecksum = false );
+
+					/** Destructor. Calls close(); errors are ignored. */
+					~CCubeWriter( void );
+
+					CCubeWriter( const CCubeWriter& ) = delete;
+					CCubeWriter& operator=( const CCubeWriter& ) = delete;
+
+					/** Appends a frame to the cube.
+					 *  @param pBuf - Pointer to the frame; must hold cols() x rows() pixels.
+					 *  @throws std::runtime_error
+					 *  @throws std::invalid_argument
+					 */
+					void write( const T* pBuf );
+
+					/** Writes the final frame count to NAXIS3 ( and the checksums, if enabled ), trims the file to the
+					 *  frames written and closes it. Has no effect if the file is already closed.
+					 *  @throws std::runtime_error
+					 */
+					void close( void );
+
+					/** Returns the frame column size ( in pixels ). */
+					std::uint32_t cols( void ) const noexcept { return m_uiCols; }
+
+					/** Returns the frame row size ( in pixels ). */
+					std::uint32_t rows( void ) const noexcept { return m_uiRows; }
+
+					/** Returns the number of frames written. */
+					std::uint32_t frames( void ) const noexcept { return m_uiFrames; }
+
+					/** Returns the number of frames the file currently has space for. */
+					std::uint32_t capacity( void ) const noexcept { return m_uiCapacity; }
+
+				private:
+
+					/** The file name */
+					std::filesystem::path m_tFileName;
+
+					/** The open file; closed by close() */
+					std::fstream m_tFile;
+
+					/** Frame conversion buffer */
+					std::vector<T> m_vStaging;
+
+					/** The header, rewritten by close() */
+					std::string m_sHeader;
+
+					/** Frame column size ( in pixels ) */
+					std::uint32_t m_uiCols;
+
+					/** Frame row size ( in pixels ) */
+					std::uint32_t m_uiRows;
+
+					/** Number of frames written */
+					std::uint32_t m_uiFrames;
+
+					/** Number of frames preallocated */
+					std::uint32_t m_uiCapacity;
+
+					/** Header size ( in bytes ) */
+					std::uint64_t m_u64HeaderBytes;
+
+					/** Byte offset of the NAXIS3 card */
+					std::uint64_t m_u64Naxis3Offset;
+
+					/** Byte offset of the CHECKSUM card; 0 if checksums are disabled */
+					std::uint64_t m_u64ChecksumOffset;
+
+					/** Ones' complement sum of the frames written */
+					std::uint32_t m_uiDataSum;
+			};
+
 		}	// end fits namespace
 
 
@@ -329,6 +765,15 @@ namespace arc
 				 */
 				void updateKeyword( const std::string& sKey, void* pValue, arc::gen3::fits::e_Type eType, const std::string& sComment = "" );
 
+				/** Appends every keyword in a header template to the header and reserves its blank keyword space. Must
+				 *  be called before the first image write. The keywords are appended as is, so must not already be in
+				 *  the header.
+				 *  @param cHeader - The header template.
+				 *  @see arc::gen3::fits::CHeaderTemplate
+				 *  @throws std::runtime_error
+				 */
+				void writeHeader( const arc::gen3::fits::CHeaderTemplate& cHeader );
+
 				/** Returns the basic image parameters ( number of cols, rows, frames, dimensions and bits-per-pixel ).
 				 *  @returns Pointer to an arc::gen3::fits::CParam class that contains all the image parameters. May return nullptr.
 				 *  @throws std::runtime_error on error.
@@ -381,11 +826,44 @@ namespace arc
 				 */
 				void flush( void );
 
+				/** Sets when the write methods ( write, writeSubImage, write3D and reWrite3D ) flush the file. The
+				 *  default flushes after every write, which costs a disk round trip per data cube frame.
+				 *  @param eFlush  - The flush policy.
+				 *  @param u64Value - The number of writes ( FRAMES ), bytes ( BYTES ) or milliseconds ( INTERVAL )
+				 *                   between flushes. Ignored by EVERY_WRITE and ON_CLOSE.
+				 *  @throws std::invalid_argument
+				 */
+				void setFlushPolicy( arc::gen3::fits::e_Flush eFlush, const std::uint64_t u64Value = 0 );
+
+				/** Sets the tile compression used by later calls to create() and create3D(). Each tile holds whole
+				 *  image rows. For RICE, write() compresses a single image's tiles in parallel, holding at most
+				 *  u64MemoryBudget bytes of compressed tiles at once; other writes are compressed by cfitsio.
+				 *  @param eCompress       - The compression algorithm.
+				 *  @param uiTileRows      - Image rows per tile. 0 selects one row ( 16 for HCOMPRESS, which needs at
+				 *                           least 4 ).
+				 *  @param u64MemoryBudget - Maximum bytes of compressed tile buffers. 0 selects 64 MB.
+				 *  @throws std::invalid_argument
+				 */
+				void setCompression( arc::gen3::fits::e_Compress eCompress, const std::uint32_t uiTileRows = 0, const std::uint64_t u64MemoryBudget = 0 );
+
 				/** Compares this file image data to another. This method does not check headers, except for size values.
 				 *  @param cFitsFile - A reference to another valid FITS file.
 				 */
 				void compare( CArcFitsFile<T>& cFitsFile );
 
+				/** Compares this file image data to another, without reading either through cfitsio. Both files are
+				 *  memory mapped and compared in chunks on parallel threads, so the comparison runs at disk speed.
+				 *  Identical chunks are found with a byte compare; only differing chunks are decoded. Valid for the
+				 *  files mapImage() accepts. Single images and data cubes are supported.
+				 *  @param cFitsFile - A reference to another valid FITS file.
+				 *  @param eMode     - Whether to stop at the first difference or gather difference statistics.
+				 *  @return The comparison result. The images match if CompareResult::match() is true.
+				 *  @see arc::gen3::fits::CompareResult
+				 *  @throws std::runtime_error if the image dimensions do not match
+				 *  @throws std::invalid_argument if either file cannot be memory mapped
+				 */
+				arc::gen3::fits::CompareResult compareData( CArcFitsFile<T>& cFitsFile, const arc::gen3::fits::e_Compare eMode = arc::gen3::fits::e_Compare::FIRST_DIFF );
+
 				/** Resizes a single image file by modifying the NAXES keyword and increasing the image data portion of the file.
 				 *  @param uiCols - The number of cols the new FITS file will have.
 				 *  @param uiRows - The number of rows the new FITS file will have.
@@ -411,6 +889,55 @@ namespace arc
 				 */
 				void write( T* pBuf, const std::int64_t i64Bytes, const std::int64_t i64Pixel = 1 );
 
+				/** Writes an image view to a single image file. The view must match the file image dimensions. A
+				 *  contiguous view is written in one call; a strided view ( e.g. a sub-view of a larger buffer ) is
+				 *  written one row at a time, without first being copied.
+				 *  @param cView - The image view to write.
+				 *  @throws std::runtime_error
+				 *  @throws std::invalid_argument
+				 */
+				void write( const arc::gen3::CArcImageView<const T>& cView );
+
+				/** Writes a single image file without going through cfitsio. Produces the same bytes as create()
+				 *  followed by write(): the primary header is formatted here, and the pixels are offset by BZERO and
+				 *  byte swapped to big-endian in a vectorized pass into an aligned staging buffer that is written in
+				 *  large chunks. The file is preallocated where the file system supports it. An existing file is
+				 *  overwritten in place, reusing its disk space.
+				 *  @param tFileName - The file name. An existing file is replaced.
+				 *  @param pBuf      - Pointer to the image data.
+				 *  @param uiCols    - The image column size ( in pixels ).
+				 *  @param uiRows    - The image row size ( in pixels ).
+				 *  @param pHeader   - Optional keywords to add to the header, after the mandatory ones. May be nullptr.
+				 *  @param bDirectIO - true to bypass the operating system page cache ( O_DIRECT ), where supported.
+				 *  @param bChecksum - true to add CHECKSUM and DATASUM keywords. The data is summed as it is converted,
+				 *                     so the file is not read back.
+				 *  @throws std::runtime_error
+				 *  @throws std::invalid_argument
+				 */
+				static void writeDirect( const std::filesystem::path& tFileName, const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows,
+										 const arc::gen3::fits::CHeaderTemplate* pHeader = nullptr, const bool bDirectIO = false,
+										 const bool bChecksum = false );
+
+				/** Writes a deinterlaced frame as a multi-extension FITS file: a primary header with no data followed by one
+				 *  image extension per readout amplifier, each holding that amplifier's region with EXTNAME, DATASEC and
+				 *  BIASSEC keywords. Tools can then read a single amplifier without loading the whole frame. Like
+				 *  writeDirect(), this does not go through cfitsio, so the extensions are converted and written in
+				 *  parallel, one thread per amplifier, each at its precomputed offset in the file.
+				 *  @param tFileName - The file name. An existing file is replaced.
+				 *  @param pBuf      - Pointer to the deinterlaced frame.
+				 *  @param uiCols    - The frame column size ( in pixels ).
+				 *  @param uiRows    - The frame row size ( in pixels ).
+				 *  @param vAmps     - The amplifier regions, in extension order.
+				 *  @param pHeader   - Optional keywords to add to the primary header. May be nullptr.
+				 *  @param bChecksum - true to add CHECKSUM and DATASUM keywords to every HDU. Each extension's data is
+				 *                     summed as it is converted, so the file is not read back.
+				 *  @throws std::runtime_error
+				 *  @throws std::invalid_argument
+				 */
+				static void writeMEF( const std::filesystem::path& tFileName, const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows,
+									  const std::vector<arc::gen3::fits::AmpSection>& vAmps, const arc::gen3::fits::CHeaderTemplate* pHeader = nullptr,
+									  const bool bChecksum = false );
+
 				/** Writes a sub-image of the specified buffer to a single image file.
 				 *  @param pBuf				- The image buffer to write. Buffer access violation results in undefined behavior.
 				 *  @param lowerLeftPoint	- The lower left point { col, row } of the sub-image.
@@ -420,6 +947,16 @@ namespace arc
 				 */
 				void writeSubImage( T* pBuf, const arc::gen3::fits::Point& lowerLeftPoint, const arc::gen3::fits::Point& upperRightPoint );
 
+				/** Writes an image view as a sub-image of a single image file. The sub-image starts at { uiCol, uiRow }
+				 *  and has the size of the view. A strided view is written one row at a time, without first being copied.
+				 *  @param cView	- The image view to write.
+				 *  @param uiCol	- The sub-image start column.
+				 *  @param uiRow	- The sub-image start row.
+				 *  @throws std::runtime_error
+				 *  @throws std::invalid_argument
+				 */
+				void writeSubImage( const arc::gen3::CArcImageView<const T>& cView, const std::uint32_t uiCol, const std::uint32_t uiRow );
+
 				/** Reads a sub-image from a single image file.
 				 *  @param lowerLeftPoint	- The lower left point { col, row } of the sub-image.
 				 *  @param upperRightPoint	- The upper right point { col, row } of the sub-image.
@@ -429,6 +966,17 @@ namespace arc
 				 */
 				std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>> readSubImage( arc::gen3::fits::Point lowerLeftPoint, arc::gen3::fits::Point upperRightPoint );
 
+				/** Reads a sub-image from a single image file into the specified image view, without allocating. The
+				 *  sub-image starts at { uiCol, uiRow } and has the size of the view. A strided view is filled one row
+				 *  at a time.
+				 *  @param cView	- The image view that receives the sub-image.
+				 *  @param uiCol	- The sub-image start column.
+				 *  @param uiRow	- The sub-image start row.
+				 *  @throws std::runtime_error
+				 *  @throws std::invalid_argument
+				 */
+				void readSubImage( const arc::gen3::CArcImageView<T>& cView, const std::uint32_t uiCol, const std::uint32_t uiRow );
+
 				/** Read the image from a single image file.
 				 *  @return A pointer to the image data.
 				 *  @throws std::runtime_error
@@ -446,6 +994,14 @@ namespace arc
 				 */
 				void read( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
 
+				/** Read the image from a single image file into the specified image view. The view must match the file
+				 *  image dimensions. A strided view is filled one row at a time.
+				 *  @param cView - The image view that receives the image.
+				 *  @throws std::runtime_error
+				 *  @throws std::invalid_argument
+				 */
+				void read( const arc::gen3::CArcImageView<T>& cView );
+
 				/** Writes an image to the end of a data cube file.
 				 *  @param pBuf - The image buffer to write. Buffer access violation results in undefined behavior.
 				 *  @throws std::runtime_error
@@ -453,6 +1009,14 @@ namespace arc
 				 */
 				void write3D( T* pBuf );
 
+				/** Writes an image view to the end of a data cube file. The view must match the data cube image
+				 *  dimensions. A strided view is written one row at a time.
+				 *  @param cView - The image view to write.
+				 *  @throws std::runtime_error
+				 *  @throws std::invalid_argument
+				 */
+				void write3D( const arc::gen3::CArcImageView<const T>& cView );
+
 				/** Re-writes an existing image in a data cube file. The image data MUST match in size to the exising images
 				 *  within the data cube.
 				 *  @param pBuf				- The image buffer. Buffer access violation results in undefined behavior.
@@ -462,6 +1026,15 @@ namespace arc
 				 */
 				void reWrite3D( T* pBuf, const std::uint32_t uiImageNumber );
 
+				/** Re-writes an existing image in a data cube file from an image view. The view must match the data
+				 *  cube image dimensions. A strided view is written one row at a time.
+				 *  @param cView			- The image view to write.
+				 *  @param uiImageNumber	- The number of the data cube image to replace.
+				 *  @throws std::runtime_error
+				 *  @throws std::invalid_argument
+				 */
+				void reWrite3D( const arc::gen3::CArcImageView<const T>& cView, const std::uint32_t uiImageNumber );
+
 				/** Reads an image from a data cube file.
 				 *  @param uiImageNumber - The image number.
 				 *  @return A pointer to the image data.
@@ -470,6 +1043,25 @@ namespace arc
 				 */
 				std::unique_ptr<T[], arc::gen3::fits::ArrayDeleter<T>> read3D( const std::uint32_t uiImageNumber );
 
+				/** Reads an image from a data cube file into the specified image view, without allocating. The view
+				 *  must match the data cube image dimensions. A strided view is filled one row at a time.
+				 *  @param cView			- The image view that receives the image.
+				 *  @param uiImageNumber	- The image number.
+				 *  @throws std::runtime_error
+				 *  @throws std::invalid_argument
+				 */
+				void read3D( const arc::gen3::CArcImageView<T>& cView, const std::uint32_t uiImageNumber );
+
+				/** Memory maps the image data of the open file, read only, without reading or copying it. Valid for
+				 *  uncompressed disk files with BITPIX matching this class ( 16 or 32 ), BSCALE = 1 and an integer
+				 *  BZERO. Works for single images and data cubes.
+				 *  @return The mapped image.
+				 *  @see arc::gen3::fits::CMappedImage
+				 *  @throws std::runtime_error
+				 *  @throws std::invalid_argument
+				 */
+				std::unique_ptr<arc::gen3::fits::CMappedImage<T>> mapImage( void );
+
 				/** Returns the underlying cfitsio file pointer.
 				 *  @return A pointer to the internal cfitsio file pointer ( may be nullptr ).
 				 */
@@ -492,6 +1084,59 @@ namespace arc
 				 */
 				void throwFitsError( const std::int32_t iStatus );
 
+				/** Returns the image parameters, reading them from the file on first use after the file is created,
+				 *  opened or resized. Saves the write methods a header query per call.
+				 *  @return A pointer to the cached image parameters.
+				 *  @throws std::runtime_error on error.
+				 */
+				arc::gen3::fits::CParam* cachedParameters( void );
+
+				/** Records a completed write and flushes the file if the flush policy calls for it.
+				 *  @param u64Bytes - The number of bytes just written.
+				 *  @throws std::runtime_error on error.
+				 */
+				void flushIfDue( const std::uint64_t u64Bytes );
+
+				/** Verifies that an image view is not empty and matches the file image dimensions.
+				 *  @param cView  - The image view to check.
+				 *  @param pParam - The file image parameters.
+				 *  @throws std::invalid_argument
+				 */
+				void verifyView( const arc::gen3::CArcImageView<const T>& cView, arc::gen3::fits::CParam* pParam );
+
+				/** Writes an image view to the file image data, one call per row unless the view is contiguous.
+				 *  @param cView    - The image view to write.
+				 *  @param i64Pixel - The file pixel ( 1-based ) that receives the first view pixel.
+				 *  @throws std::runtime_error on error.
+				 */
+				void writeView( const arc::gen3::CArcImageView<const T>& cView, const std::int64_t i64Pixel );
+
+				/** Reads the file image data into an image view, one call per row unless the view is contiguous.
+				 *  @param cView    - The image view that receives the data.
+				 *  @param i64Pixel - The file pixel ( 1-based ) that is read into the first view pixel.
+				 *  @throws std::runtime_error on error.
+				 */
+				void readView( const arc::gen3::CArcImageView<T>& cView, const std::int64_t i64Pixel );
+
+				/** Clears the cached image parameters and the flush counters. */
+				void resetState( void );
+
+				/** Sets up tile compression on a newly created file, before its image is created.
+				 *  @param uiCols - The image column size ( in pixels ).
+				 *  @param uiRows - The image row size ( in pixels ).
+				 *  @param iNAxis - The number of image axes.
+				 *  @return The cfitsio status; zero on success.
+				 */
+				std::int32_t setTileCompression( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::int32_t iNAxis );
+
+				/** Rice compresses a single image in parallel, one batch of tiles at a time, and writes the tiles.
+				 *  @param pBuf   - Pointer to the image data.
+				 *  @param uiCols - The image column size ( in pixels ).
+				 *  @param uiRows - The image row size ( in pixels ).
+				 *  @throws std::runtime_error on error.
+				 */
+				void writeRiceTiles( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+
 				/** version() text holder */
 				static const std::string m_sVersion;
 
@@ -503,9 +1148,313 @@ namespace arc
 
 				/** cfitsio file pointer */
 				fitsfile* m_pFits;
+
+				/** Image parameters cached for the write methods */
+				arc::gen3::fits::CParam m_cParam;
+
+				/** True if m_cParam holds the current image parameters */
+				bool m_bParamValid;
+
+				/** Flush policy */
+				arc::gen3::fits::e_Flush m_eFlush;
+
+				/** Flush policy writes, bytes or milliseconds */
+				std::uint64_t m_u64FlushValue;
+
+				/** Writes since the last flush */
+				std::uint64_t m_u64UnflushedWrites;
+
+				/** Bytes written since the last flush */
+				std::uint64_t m_u64UnflushedBytes;
+
+				/** Time of the last flush */
+				std::chrono::steady_clock::time_point m_tLastFlush;
+
+				/** Tile compression for new files */
+				arc::gen3::fits::e_Compress m_eCompress;
+
+				/** Image rows per compressed tile; 0 for the default */
+				std::uint32_t m_uiTileRows;
+
+				/** Maximum bytes of compressed tile buffers held by writeRiceTiles */
+				std::uint64_t m_u64CompressBudget;
+
+				/** Image rows per tile if write() Rice compresses the open file itself; 0 otherwise */
+				std::uint32_t m_uiRiceTileRows;
 		};
 
 
+		namespace fits
+		{
+
+			/** @class CTileCache
+			 *  Tile cache for repeated sub-image reads of a single image file. The image is divided into fixed size
+			 *  square tiles ( smaller at the right and top edges ), each read from the file on first use and kept in a
+			 *  least recently used list bounded by a memory budget. Sub-image reads are assembled from the cached tiles
+			 *  into a caller buffer or view, so overlapping reads of the same region go back to the file only once.
+			 *
+			 *  With read-ahead enabled, the tiles bordering each read are loaded on a background thread.
+			 *
+			 *  The cache reads through the CArcFitsFile it was created with, which must stay open and must not be
+			 *  used by anything else while the cache exists. The cache is thread safe.
+			 */
+			template <typename T>
+			class GEN3_CARCFITSFILE_API CTileCache
+			{
+				public:
+
+					/** Default tile size ( in pixels ) */
+					static constexpr std::uint32_t DEFAULT_TILE_SIZE = 256;
+
+					/** Default memory budget ( in bytes ) */
+					static constexpr std::uint64_t DEFAULT_MEMORY_BUDGET = ( 64ULL * 1024 * 1024 );
+
+					/** Constructor
+					 *  @param cFile           - An open single image file.
+					 *  @param uiTileSize      - The tile column and row size ( in pixels ).
+					 *  @param u64MemoryBudget - The maximum bytes of tile data to keep. At least one tile is always kept.
+					 *  @param bReadAhead      - true to load the tiles bordering each read on a background thread.
+					 *  @throws std::runtime_error
+					 *  @throws std::invalid_argument
+					 */
+					CTileCache( arc::gen3::CArcFitsFile<T>& cFile, const std::uint32_t uiTileSize = DEFAULT_TILE_SIZE,
+								const std::uint64_t u64MemoryBudget = DEFAULT_MEMORY_BUDGET, const bool bReadAhead = false );
+
+					/** Destructor. Stops the read-ahead thread. */
+					~CTileCache( void );
+
+					CTileCache( const CTileCache& ) = delete;
+					CTileCache& operator=( const CTileCache& ) = delete;
+
+					/** Reads a sub-image into the specified image view. The sub-image starts at { uiCol, uiRow } and has
+					 *  the size of the view.
+					 *  @param cView - The image view that receives the sub-image.
+					 *  @param uiCol - The sub-image start column.
+					 *  @param uiRow - The sub-image start row.
+					 *  @throws std::runtime_error
+					 *  @throws std::invalid_argument
+					 */
+					void read( const arc::gen3::CArcImageView<T>& cView, const std::uint32_t uiCol, const std::uint32_t uiRow );
+
+					/** Reads a sub-image into the specified buffer.
+					 *  @param pBuf            - The destination buffer; must hold the sub-image pixels.
+					 *  @param lowerLeftPoint  - The lower left point { col, row } of the sub-image.
+					 *  @param upperRightPoint - The upper right point { col, row } of the sub-image.
+					 *  @throws std::runtime_error
+					 *  @throws std::invalid_argument
+					 */
+					void read( T* pBuf, const arc::gen3::fits::Point& lowerLeftPoint, const arc::gen3::fits::Point& upperRightPoint );
+
+					/** Removes all tiles from the cache and cancels any pending read-ahead. */
+					void clear( void );
+
+					/** Returns the image column size ( in pixels ). */
+					std::uint32_t cols( void ) const noexcept { return m_uiCols; }
+
+					/** Returns the image row size ( in pixels ). */
+					std::uint32_t rows( void ) const noexcept { return m_uiRows; }
+
+					/** Returns the tile column and row size ( in pixels ). */
+					std::uint32_t tileSize( void ) const noexcept { return m_uiTileSize; }
+
+					/** Returns the number of tiles currently cached. */
+					std::uint32_t getTileCount( void ) const;
+
+					/** Returns the number of tile lookups found in the cache. */
+					std::uint64_t getHits( void ) const;
+
+					/** Returns the number of tile lookups that read the file. */
+					std::uint64_t getMisses( void ) const;
+
+				private:
+
+					/** Shared tile pixels; a tile being copied stays alive if it is evicted meanwhile */
+					using tile_t = std::shared_ptr<const std::vector<T>>;
+
+					/** A cached tile and its key */
+					using entry_t = std::pair<std::uint64_t, tile_t>;
+
+					/** Returns a tile, from the cache or read from the file.
+					 *  @param uiTileCol - The tile column number.
+					 *  @param uiTileRow - The tile row number.
+					 *  @throws std::runtime_error
+					 */
+					tile_t getTile( const std::uint32_t uiTileCol, const std::uint32_t uiTileRow );
+
+					/** Reads a tile from the file and adds it to the cache, unless another thread has just done so.
+					 *  @param u64Key - The tile key ( row x tiles across + column ).
+					 *  @throws std::runtime_error
+					 */
+					tile_t loadTile( const std::uint64_t u64Key );
+
+					/** Adds a tile to the cache, evicting the least recently used tiles over the budget. The caller
+					 *  must hold m_mutex.
+					 *  @param u64Key - The tile key.
+					 *  @param pTile  - The tile pixels.
+					 *  @return The cached tile; a tile already cached under the key is kept.
+					 */
+					tile_t insertTile( const std::uint64_t u64Key, tile_t pTile );
+
+					/** Queues the uncached tiles bordering a tile range for read-ahead, replacing any earlier queue. */
+					void queueReadAhead( const std::uint32_t uiFirstCol, const std::uint32_t uiLastCol, const std::uint32_t uiFirstRow, const std::uint32_t uiLastRow );
+
+					/** Read-ahead thread. Loads queued tiles until stopped. */
+					void runReadAhead( void );
+
+					/** The file tiles are read from */
+					arc::gen3::CArcFitsFile<T>& m_cFile;
+
+					/** Image column size ( in pixels ) */
+					std::uint32_t m_uiCols;
+
+					/** Image row size ( in pixels ) */
+					std::uint32_t m_uiRows;
+
+					/** Tile column and row size ( in pixels ) */
+					std::uint32_t m_uiTileSize;
+
+					/** Number of tiles across the image */
+					std::uint32_t m_uiTileCols;
+
+					/** Number of tiles up the image */
+					std::uint32_t m_uiTileRows;
+
+					/** Maximum number of cached tiles */
+					std::size_t m_szMaxTiles;
+
+					/** Cached tiles, most recently used first */
+					std::list<entry_t> m_lTiles;
+
+					/** Cached tile lookup by key */
+					std::unordered_map<std::uint64_t, typename std::list<entry_t>::iterator> m_mTiles;
+
+					/** Tiles waiting for the read-ahead thread */
+					std::deque<std::uint64_t> m_dReadAhead;
+
+					/** Tile lookups found in the cache */
+					std::uint64_t m_u64Hits;
+
+					/** Tile lookups that read the file */
+					std::uint64_t m_u64Misses;
+
+					/** true once the destructor has been called */
+					bool m_bStop;
+
+					/** Guards the tiles, the read-ahead queue, the counters and m_bStop */
+					mutable std::mutex m_mutex;
+
+					/** Serializes reads of the file */
+					std::mutex m_fileMutex;
+
+					/** Signalled when read-ahead is queued or when stopping */
+					std::condition_variable m_cvReadAhead;
+
+					/** Read-ahead thread; not started if read-ahead is disabled */
+					std::thread m_tReadAhead;
+			};
+
+
+			/** @class CFilePool
+			 *  Pool of pre-created output files, to take file creation off the save path on file systems where it is
+			 *  slow ( e.g. NFS ). A background thread keeps a number of hidden files ready in the output directory,
+			 *  each holding a header skeleton and preallocated to the expected image size. write() fills a ready file
+			 *  with CArcFitsFile::writeDirect(), overwriting it in place, then renames it to the exposure name. The
+			 *  rename is atomic, so the final name only ever refers to a complete file. If no file is ready, write()
+			 *  writes the file directly.
+			 *
+			 *  A file can only be renamed within a file system, so output files on another file system than the pool
+			 *  directory are written directly, as is a file whose rename fails. The pool is thread safe.
+			 */
+			template <typename T>
+			class GEN3_CARCFITSFILE_API CFilePool
+			{
+				public:
+
+					/** Constructor. Starts the thread that creates the pool files.
+					 *  @param tDirectory - The directory the output files will be written to.
+					 *  @param uiCols     - The expected image column size ( in pixels ).
+					 *  @param uiRows     - The expected image row size ( in pixels ).
+					 *  @param uiCount    - The number of files to keep ready ( at least 1 ).
+					 *  @param pHeader    - The header template write() will be called with, used to size the header. May
+					 *                      be nullptr.
+					 *  @param bChecksum  - true if write() will add CHECKSUM and DATASUM keywords.
+					 *  @throws std::invalid_argument
+					 */
+					CFilePool( const std::filesystem::path& tDirectory, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiCount = 2,
+							   const arc::gen3::fits::CHeaderTemplate* pHeader = nullptr, const bool bChecksum = false );
+
+					/** Destructor. Stops the creator thread and removes the unused pool files. */
+					~CFilePool( void );
+
+					CFilePool( const CFilePool& ) = delete;
+					CFilePool& operator=( const CFilePool& ) = delete;
+
+					/** Writes a single image file through a ready pool file. An image of any size may be written; a size
+					 *  other than the expected one only loses the benefit of the preallocation. If the rename fails, the
+					 *  image is written directly to tFileName, and if that fails too the pool file holding it is kept and
+					 *  named in the error.
+					 *  @param tFileName - The file name. An existing file is replaced.
+					 *  @param pBuf      - Pointer to the image data.
+					 *  @param uiCols    - The image column size ( in pixels ).
+					 *  @param uiRows    - The image row size ( in pixels ).
+					 *  @param pHeader   - Optional keywords to add to the header. May be nullptr.
+					 *  @throws std::runtime_error
+					 *  @throws std::invalid_argument
+					 */
+					void write( const std::filesystem::path& tFileName, const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows,
+								const arc::gen3::fits::CHeaderTemplate* pHeader = nullptr );
+
+					/** Returns the number of files ready for use. */
+					std::uint32_t getReadyCount( void ) const;
+
+					/** Returns the number of writes that found no ready file. */
+					std::uint64_t getMissCount( void ) const;
+
+				private:
+
+					/** Creator thread. Keeps the pool full until stopped. */
+					void run( void );
+
+					/** The pool directory */
+					std::filesystem::path m_tDirectory;
+
+					/** The header skeleton written to each pool file */
+					std::string m_sHeader;
+
+					/** Expected file size ( in bytes ) */
+					std::uint64_t m_u64FileBytes;
+
+					/** The number of files to keep ready */
+					std::uint32_t m_uiCount;
+
+					/** true to add CHECKSUM and DATASUM keywords */
+					bool m_bChecksum;
+
+					/** Files ready for use */
+					std::deque<std::filesystem::path> m_dReady;
+
+					/** Writes that found no ready file */
+					std::uint64_t m_u64Misses;
+
+					/** true if the last file could not be created; cleared by write() to try again */
+					bool m_bFailed;
+
+					/** true once the destructor has been called */
+					bool m_bStop;
+
+					/** Guards all of the above except the sizes */
+					mutable std::mutex m_mutex;
+
+					/** Signalled when a file is taken or when stopping */
+					std::condition_variable m_cvRefill;
+
+					/** Creator thread */
+					std::thread m_tCreator;
+			};
+
+		}	// end fits namespace
+
+
 	}	// end gen3 namespace
 }		// end arc namespace
 
@@ -16,6 +16,15 @@
 #include <cstring>
 #include <memory>
 #include <cstdlib>
+#include <limits>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <vector>
+#include <bit>
+#include <complex>
+#include <numbers>
+#include <mutex>
 
 #include <CArcImage.h>
 
@@ -126,6 +135,28 @@ namespace arc
 		}
 
 
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  verifySameSize                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Verifies that two image views are not empty and have the same dimensions. Throws exception on error.    |
+		// |                                                                                                          |
+		// |  <IN> -> cView1 - The first image view.                                                                  |
+		// |  <IN> -> cView2 - The second image view.                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::verifySameSize( const arc::gen3::CArcImageView<const T>& cView1, const arc::gen3::CArcImageView<const T>& cView2 )
+		{
+			if ( cView1.empty() || cView2.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( cView1.cols() != cView2.cols() || cView1.rows() != cView2.rows() )
+			{
+				throwArcGen3InvalidArgument( "Image view sizes differ [ %u x %u, %u x %u ]!", cView1.cols(), cView1.rows(), cView2.cols(), cView2.rows() );
+			}
+		}
+
+
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  Constant - DEG2RAD                                                                                      |
 		// +----------------------------------------------------------------------------------------------------------+
@@ -135,1163 +166,5230 @@ namespace arc
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  GenIII image channel type                                                                               |
+		// |  Constant - MIN_BAND_PIXELS                                                                              |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Image channel insertion pointers.                                                                       |
+		// |  Minimum number of pixels per row band before an operation is split across threads. Anything smaller is  |
+		// |  faster on the calling thread than the cost of starting another.                                         |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T>
-		struct imageChannel_t
-		{
-			T* pStart;
-			T* pEnd;
-			T* pInserter;
-		};
+		constexpr std::uint64_t MIN_BAND_PIXELS = ( 1 << 18 );
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// | Library build and version info                                                                           |
+		// |  Constant - SOURCE_SAMPLE_PIXELS                                                                         |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> const std::string CArcImage<T>::m_sVersion = "ARC Gen III Image API Library.    "s +
+		// |  Number of pixels sampled by findSources to estimate the background level and noise.                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		constexpr std::uint64_t SOURCE_SAMPLE_PIXELS = 4096;
 
-		#ifdef _WINDOWS
-			CArcBase::formatString( "[ Compiler Version: %d, Built: %s ]", _MSC_VER, __TIMESTAMP__ );
-		#else
-			arc::gen3::CArcBase::formatString( "[ Compiler Version: %d.%d.%d, Built: %s %s ]", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__, __DATE__, __TIME__ );
-		#endif
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Constant - MIN_PARALLEL_SOURCES                                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Minimum number of sources before findSources measures them on separate threads.                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		constexpr std::uint32_t MIN_PARALLEL_SOURCES = 64;
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Destructor                                                                                              |
+		// |  Constant - MIN_PHASE_WINDOW                                                                             |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Destroys the class.                                                                                     |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Smallest phase correlation window side. findShifts() rejects images or windows smaller than this.       |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> CArcImage<T>::~CArcImage( void )
-		{
-		}
+		constexpr std::uint32_t MIN_PHASE_WINDOW = 16;
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  version                                                                                                 |
+		// |  Constant - MATCH_SOURCES                                                                                |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns a textual representation of the library version.                                                |
+		// |  Largest number of sources per image matched by the findShift centroid fallback.                         |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> const std::string CArcImage<T>::version( void )
+		constexpr std::uint32_t MATCH_SOURCES = 32;
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  pixelCount                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of pixels in a uiCols x uiRows image. The product is formed in 64 bits; a 32-bit     |
+		// |  product wraps at 4G pixels ( e.g. a 65536 x 65536 mosaic ).                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		constexpr std::size_t pixelCount( const std::uint32_t uiCols, const std::uint32_t uiRows )
 		{
-			return m_sVersion;
+			return ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  fill                                                                                                    |
+		// |  GenIII image channel type                                                                               |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Fills the specified buffer with the specified value.                                                    |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
-		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
-		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
-		// |  <IN> -> uiValue - The value to fill the buffer with.                                                    |
-		// |                                                                                                          |
-		// |  Throws std::invalid_argument, std::invalid_argument                                                     |
+		// |  Image channel insertion pointers.                                                                       |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::fill( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const T uiValue )
+		template <typename T>
+		struct imageChannel_t
 		{
-			if ( uiValue >= maxTVal() )
-			{
-				throwArcGen3OutOfRange( uiValue, std::make_pair( 0, ( maxTVal() - 1 ) ) );
-			}
+			T* pStart;
+			T* pEnd;
+			T* pInserter;
+		};
 
-			if ( pBuf != nullptr )
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Region statistics accumulator type                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Running pixel count, mean and sum of squared deviations ( M2 ) for one region, plus min, max and the    |
+		// |  saturated pixel count. Partial results ( a row segment or a whole band ) are combined with the parallel |
+		// |  form of Welford's algorithm, which avoids the cancellation of a naive sum of squares.                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		struct roiAccum_t
+		{
+			double gCount = 0.0;
+			double gMean = 0.0;
+			double gM2 = 0.0;
+			double gMin = std::numeric_limits<double>::max();
+			double gMax = 0.0;
+			double gSaturatedCount = 0.0;
+
+			void merge( const double gCountB, const double gMeanB, const double gM2B )
 			{
-				for ( std::uint32_t i = 0; i < ( uiCols * uiRows ); i++ )
+				if ( gCountB == 0.0 )
 				{
-					pBuf[ i ] = uiValue;
+					return;
 				}
+
+				double gTotal = ( gCount + gCountB );
+				double gDelta = ( gMeanB - gMean );
+
+				gMean += ( gDelta * gCountB / gTotal );
+				gM2 += ( gM2B + gDelta * gDelta * gCount * gCountB / gTotal );
+				gCount = gTotal;
 			}
 
-			else
+			void merge( const roiAccum_t& rAccum )
 			{
-				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+				merge( rAccum.gCount, rAccum.gMean, rAccum.gM2 );
+
+				gMin = std::min( gMin, rAccum.gMin );
+				gMax = std::max( gMax, rAccum.gMax );
+				gSaturatedCount += rAccum.gSaturatedCount;
 			}
-		}
+		};
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  fill                                                                                                    |
+		// |  Source footprint accumulator type                                                                       |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Fills the specified buffer with the specified value.                                                    |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
-		// |  <IN> -> uiBytes - The number of bytes in the image data buffer.                                         |
-		// |  <IN> -> uiValue - The value to fill the buffer with.                                                    |
-		// |                                                                                                          |
-		// |  Throws std::invalid_argument, std::invalid_argument                                                     |
+		// |  Background subtracted sums, peak, pixel count and bounding box of one connected component. Components   |
+		// |  that turn out to touch are merged.                                                                      |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::fill( T* pBuf, const std::uint32_t uiBytes, const T uiValue )
+		struct sourceAccum_t
 		{
-			if ( uiValue >= maxTVal() )
-			{
-				throwArcGen3OutOfRange( uiValue, std::make_pair( 0, ( maxTVal() - 1 ) ) );
-			}
-
-			if ( pBuf != nullptr )
+			double gSum = 0.0;
+			double gSumCol = 0.0;
+			double gSumRow = 0.0;
+			double gPeak = 0.0;
+			std::uint32_t uiPixels = 0;
+			std::uint32_t uiCol1 = std::numeric_limits<std::uint32_t>::max();
+			std::uint32_t uiCol2 = 0;
+			std::uint32_t uiRow1 = std::numeric_limits<std::uint32_t>::max();
+			std::uint32_t uiRow2 = 0;
+
+			void add( const std::uint32_t uiCol, const std::uint32_t uiRow, const double gValue )
 			{
-				for ( std::uint32_t i = 0; i < ( uiBytes / sizeof( T ) ); i++ )
-				{
-					pBuf[ i ] = uiValue;
-				}
+				gSum += gValue;
+				gSumCol += ( gValue * uiCol );
+				gSumRow += ( gValue * uiRow );
+				gPeak = std::max( gPeak, gValue );
+				uiPixels++;
+				uiCol1 = std::min( uiCol1, uiCol );
+				uiCol2 = std::max( uiCol2, uiCol );
+				uiRow1 = std::min( uiRow1, uiRow );
+				uiRow2 = std::max( uiRow2, uiRow );
 			}
 
-			else
+			void merge( const sourceAccum_t& rAccum )
 			{
-				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+				gSum += rAccum.gSum;
+				gSumCol += rAccum.gSumCol;
+				gSumRow += rAccum.gSumRow;
+				gPeak = std::max( gPeak, rAccum.gPeak );
+				uiPixels += rAccum.uiPixels;
+				uiCol1 = std::min( uiCol1, rAccum.uiCol1 );
+				uiCol2 = std::max( uiCol2, rAccum.uiCol2 );
+				uiRow1 = std::min( uiRow1, rAccum.uiRow1 );
+				uiRow2 = std::max( uiRow2, rAccum.uiRow2 );
 			}
-		}
+		};
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  fillWithGradient                                                                                        |
+		// |  Synthetic frame random number generator type                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Fills the specified buffer with a gradient pattern.                                                     |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
-		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
-		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
-		// |                                                                                                          |
-		// |  Throws std::invalid_argument on error.                                                                  |
+		// |  xoshiro256** seeded through splitmix64. It is small, fast and gives the same stream on every platform,  |
+		// |  unlike the standard library distributions, whose output is implementation defined.                      |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::fillWithGradient( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		struct synthRandom_t
 		{
-			if ( pBuf != nullptr )
+			std::uint64_t u64State[ 4 ] = { 0, 0, 0, 0 };
+
+			explicit synthRandom_t( std::uint64_t u64Seed )
 			{
-				zeroMemory( pBuf, ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
+				for ( auto& u64Word : u64State )
+				{
+					u64Seed += 0x9E3779B97F4A7C15ULL;
 
-				T uiValue = 0;
+					std::uint64_t u64Mix = u64Seed;
 
-				for ( std::remove_const_t<decltype( uiRows )> r = 0; r < uiRows; r++ )
-				{
-					for ( std::remove_const_t<decltype( uiCols )> c = 0; c < uiCols; c++ )
-					{
-						pBuf[ c + r * uiCols ] = uiValue;
-					}
+					u64Mix = ( ( u64Mix ^ ( u64Mix >> 30 ) ) * 0xBF58476D1CE4E5B9ULL );
+					u64Mix = ( ( u64Mix ^ ( u64Mix >> 27 ) ) * 0x94D049BB133111EBULL );
 
-					uiValue += static_cast< T >( ( maxTVal() - 1 ) / uiRows );
+					u64Word = ( u64Mix ^ ( u64Mix >> 31 ) );
 				}
 			}
 
-			else
+			std::uint64_t next( void )
 			{
-				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+				std::uint64_t u64Result = ( std::rotl( u64State[ 1 ] * 5, 7 ) * 9 );
+				std::uint64_t u64Shift = ( u64State[ 1 ] << 17 );
+
+				u64State[ 2 ] ^= u64State[ 0 ];
+				u64State[ 3 ] ^= u64State[ 1 ];
+				u64State[ 1 ] ^= u64State[ 2 ];
+				u64State[ 0 ] ^= u64State[ 3 ];
+				u64State[ 2 ] ^= u64Shift;
+				u64State[ 3 ] = std::rotl( u64State[ 3 ], 45 );
+
+				return u64Result;
 			}
-		}
 
+			// Uniform on [ 0, 1 )
+			double uniform( void )
+			{
+				return ( static_cast< double >( next() >> 11 ) * ( 1.0 / 9007199254740992.0 ) );
+			}
 
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  fillWithSmiley                                                                                          |
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  Fills the specified buffer with zeroes and puts a smiley face at the center.                            |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
-		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
-		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
-		// |                                                                                                          |
-		// |  Throws std::invalid_argument on error.                                                                  |
-		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::fillWithSmiley( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
-		{
-			if ( pBuf != nullptr )
+			// Standard normal, by the Marsaglia and Tsang ziggurat method ( 128 layers ). Nearly every draw is one
+			// random number, a table lookup and a multiply; only the rare edge and tail cases call exp() or log().
+			struct ziggurat_t
 			{
-				zeroMemory( pBuf, ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
+				std::uint32_t uiK[ 128 ];
+				double gW[ 128 ];
+				double gF[ 128 ];
 
-				std::uint32_t uiRadius = static_cast<std::uint32_t>( std::fmin( ( uiRows / 2.0 ), ( uiCols / 2.0 ) ) - 10.0 );
+				ziggurat_t( void )
+				{
+					const double gM1 = 2147483648.0;
+					const double gV = 9.91256303526217e-3;
 
-				//  Draw Head
-				// +---------------------------------------------------------------------------- +
-				drawGradientFillCircle(	uiRadius,
-										uiCols,
-										uiRows,
-										pBuf );
+					double gD = 3.442619855899;
+					double gT = gD;
+					double gQ = ( gV / std::exp( -0.5 * gD * gD ) );
 
-				//  Draw Left Eye
-				// +---------------------------------------------------------------------------- +
-				std::uint32_t uiRowFactor = static_cast< std::uint32_t >( uiRadius / 2.5 );
+					uiK[ 0 ] = static_cast< std::uint32_t >( ( gD / gQ ) * gM1 );
+					uiK[ 1 ] = 0;
 
-				drawFillCircle( ( uiCols / 2 ) - uiRowFactor,
-								( uiRows / 2 ) + uiRowFactor,
-								( uiRadius / 5 ),
-								uiCols,
-								pBuf );
+					gW[ 0 ] = ( gQ / gM1 );
+					gW[ 127 ] = ( gD / gM1 );
 
-				//  Draw Right Eye
-				// +---------------------------------------------------------------------------- +
-				drawFillCircle( ( uiCols / 2 ) + uiRowFactor,
-								( uiRows / 2 ) + uiRowFactor,
-								( uiRadius / 5 ),
-								uiCols,
-								pBuf );
+					gF[ 0 ] = 1.0;
+					gF[ 127 ] = std::exp( -0.5 * gD * gD );
 
-				//  Draw Mouth
-				// +---------------------------------------------------------------------------- +
-				for ( decltype( uiRadius ) i = 0; i < ( uiRadius / 2 ); i++ )
+					for ( int i = 126; i >= 1; i-- )
+					{
+						gD = std::sqrt( -2.0 * std::log( gV / gD + std::exp( -0.5 * gD * gD ) ) );
+
+						uiK[ i + 1 ] = static_cast< std::uint32_t >( ( gD / gT ) * gM1 );
+
+						gT = gD;
+
+						gF[ i ] = std::exp( -0.5 * gD * gD );
+						gW[ i ] = ( gD / gM1 );
+					}
+				}
+			};
+
+			double normal( void )
+			{
+				static const ziggurat_t cTable;
+
+				constexpr double TAIL = 3.442619855899;
+
+				for ( ;; )
 				{
-					drawSemiCircle( ( uiCols / 2 ),
-									( uiRows / 2 ) - ( uiRowFactor / 2 ),
-									i,
-									180,
-									360,
-									uiCols,
-									pBuf );
+					auto iHz = static_cast< std::int32_t >( next() >> 32 );
+					auto uiLayer = static_cast< std::uint32_t >( iHz & 127 );
+
+					double gX = ( iHz * cTable.gW[ uiLayer ] );
+
+					if ( static_cast< std::uint32_t >( std::abs( static_cast< std::int64_t >( iHz ) ) ) < cTable.uiK[ uiLayer ] )
+					{
+						return gX;
+					}
+
+					if ( uiLayer == 0 )
+					{
+						double gTailX = 0.0, gTailY = 0.0;
+
+						do
+						{
+							gTailX = ( -std::log( 1.0 - uniform() ) / TAIL );
+							gTailY = -std::log( 1.0 - uniform() );
+						} while ( ( gTailY + gTailY ) < ( gTailX * gTailX ) );
+
+						return ( ( iHz > 0 ) ? ( TAIL + gTailX ) : ( -TAIL - gTailX ) );
+					}
+
+					if ( ( cTable.gF[ uiLayer ] + uniform() * ( cTable.gF[ uiLayer - 1 ] - cTable.gF[ uiLayer ] ) ) < std::exp( -0.5 * gX * gX ) )
+					{
+						return gX;
+					}
 				}
 			}
 
-			else
+			// Poisson, exact below a mean of 30 and a normal approximation above
+			double poisson( const double gMean )
 			{
-				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+				if ( gMean <= 0.0 )
+				{
+					return 0.0;
+				}
+
+				if ( gMean >= 30.0 )
+				{
+					return std::max( std::round( gMean + std::sqrt( gMean ) * normal() ), 0.0 );
+				}
+
+				double gLimit = std::exp( -gMean );
+				double gProduct = uniform();
+				double gCount = 0.0;
+
+				while ( gProduct > gLimit )
+				{
+					gProduct *= uniform();
+					gCount += 1.0;
+				}
+
+				return gCount;
 			}
-		}
+		};
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  fillWithRamp                                                                                            |
+		// |  FFT plan type                                                                                           |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Fills the specified buffer with a ramp image. Data has the form 0, 1, 2, ..., 65535, 0, 1, ....         |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf	 - Pointer to the image data buffer.                                                      |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
-		// |                                                                                                          |
-		// |  Throws std::invalid_argument on error.                                                                  |
+		// |  Bit reversal and twiddle tables for an in place, radix-2 complex FFT of one power of two size. Plans    |
+		// |  never change once built, so one cached plan per size is shared by every thread. The complex products    |
+		// |  are written out by hand; std::complex multiplication calls a library routine to handle infinities.      |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::fillWithRamp( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		struct fftPlan_t
 		{
-			if ( pBuf != nullptr )
+			std::uint32_t uiSize = 0;
+			std::vector<std::uint32_t> vReverse;
+			std::vector<std::complex<float>> vTwiddle;
+
+			explicit fftPlan_t( const std::uint32_t uiPoints ) : uiSize( uiPoints ), vReverse( uiPoints ), vTwiddle( uiPoints / 2 )
 			{
-				T uiValue = 0;
+				auto iBits = std::countr_zero( uiPoints );
 
-				for ( std::uint32_t i = 0; i < ( uiCols * uiRows ); i++ )
+				for ( std::uint32_t i = 0; i < uiPoints; i++ )
 				{
-					pBuf[ i ] = uiValue;
+					std::uint32_t uiReversed = 0;
 
-					uiValue++;
+					for ( int iBit = 0; iBit < iBits; iBit++ )
+					{
+						uiReversed |= ( ( ( i >> iBit ) & 1U ) << ( iBits - 1 - iBit ) );
+					}
 
-					if ( uiValue >= maxTVal() ) { uiValue = 0; }
+					vReverse[ i ] = uiReversed;
 				}
 
-				containsValidRamp( pBuf, uiCols, uiRows );
+				for ( std::uint32_t k = 0; k < ( uiPoints / 2 ); k++ )
+				{
+					double gAngle = ( -2.0 * std::numbers::pi * static_cast< double >( k ) / static_cast< double >( uiPoints ) );
+
+					vTwiddle[ k ] = std::complex<float>( static_cast< float >( std::cos( gAngle ) ), static_cast< float >( std::sin( gAngle ) ) );
+				}
 			}
 
-			else
+			// One dimensional transform of uiSize points. The inverse is not scaled.
+			void transform( std::complex<float>* pData, const bool bInverse ) const
 			{
-				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
-			}
-		}
+				for ( std::uint32_t i = 0; i < uiSize; i++ )
+				{
+					if ( i < vReverse[ i ] )
+					{
+						std::swap( pData[ i ], pData[ vReverse[ i ] ] );
+					}
+				}
 
+				const float fSign = ( bInverse ? -1.0f : 1.0f );
 
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  containsValidRamp                                                                                       |
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  Verify a ramp synthetic image. Data has the form 0, 1, 2, ..., 65535, 0, 1, ....                        |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf	 - Pointer to the image data buffer.                                                      |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
-		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::containsValidRamp( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
-		{
-			if ( pBuf != nullptr )
+				for ( std::uint32_t uiLength = 2; uiLength <= uiSize; uiLength <<= 1 )
+				{
+					auto uiHalf = ( uiLength / 2 );
+					auto uiStep = ( uiSize / uiLength );
+
+					for ( std::uint32_t i = 0; i < uiSize; i += uiLength )
+					{
+						for ( std::uint32_t k = 0; k < uiHalf; k++ )
+						{
+							const auto& cTwiddle = vTwiddle[ k * uiStep ];
+
+							float fTwRe = cTwiddle.real();
+							float fTwIm = ( fSign * cTwiddle.imag() );
+
+							auto cU = pData[ i + k ];
+							auto cV = pData[ i + k + uiHalf ];
+
+							float fVRe = ( cV.real() * fTwRe - cV.imag() * fTwIm );
+							float fVIm = ( cV.real() * fTwIm + cV.imag() * fTwRe );
+
+							pData[ i + k ] = std::complex<float>( cU.real() + fVRe, cU.imag() + fVIm );
+							pData[ i + k + uiHalf ] = std::complex<float>( cU.real() - fVRe, cU.imag() - fVIm );
+						}
+					}
+				}
+			}
+
+			// Two dimensional transform of a uiSize x uiSize block: every row, then every column through vColumn
+			void transform2d( std::complex<float>* pData, const bool bInverse, std::vector<std::complex<float>>& vColumn ) const
 			{
-				T uiValue = pBuf[ 0 ];
+				for ( std::size_t row = 0; row < uiSize; row++ )
+				{
+					transform( pData + row * uiSize, bInverse );
+				}
 
-				std::uint32_t uiPixel = 0;
+				vColumn.resize( uiSize );
 
-				for ( std::uint32_t r = 0; r < uiRows; r++ )
+				for ( std::size_t col = 0; col < uiSize; col++ )
 				{
-					for ( std::uint32_t c = 0; c < uiCols; c++ )
+					for ( std::size_t row = 0; row < uiSize; row++ )
 					{
-						if ( pBuf[ uiPixel ] != uiValue )
-						{
-							throwArcGen3Error( "Invalid ramp image. Expected %u at col %u row %u, found %u",
-									uiValue,
-									c,
-									r,
-									pBuf[ uiPixel ] );
-						}
+						vColumn[ row ] = pData[ row * uiSize + col ];
+					}
 
-						uiPixel++;
-						uiValue++;
+					transform( vColumn.data(), bInverse );
 
-						if ( uiValue >= maxTVal() )
-						{
-							uiValue = pBuf[ c + r * uiCols + 1 ];
-						}
+					for ( std::size_t row = 0; row < uiSize; row++ )
+					{
+						pData[ row * uiSize + col ] = vColumn[ row ];
 					}
 				}
 			}
 
-			else
+			static const fftPlan_t& get( const std::uint32_t uiPoints )
 			{
-				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+				static std::mutex mPlans;
+				static std::vector<std::unique_ptr<fftPlan_t>> vPlans;
+
+				std::lock_guard<std::mutex> lock( mPlans );
+
+				for ( const auto& pPlan : vPlans )
+				{
+					if ( pPlan->uiSize == uiPoints )
+					{
+						return *pPlan;
+					}
+				}
+
+				vPlans.push_back( std::make_unique<fftPlan_t>( uiPoints ) );
+
+				return *vPlans.back();
 			}
-		}
+		};
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  countPixels                                                                                             |
+		// | Library build and version info                                                                           |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Count the number of pixels having the specified value.                                                  |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf	   - Pointer to the image data buffer.                                                    |
-		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
-		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
-		// |  <IN> -> uwValue - The pixel value to include in the count.                                              |
+		template <typename T> const std::string CArcImage<T>::m_sVersion = "ARC Gen III Image API Library.    "s +
+
+		#ifdef _WINDOWS
+			CArcBase::formatString( "[ Compiler Version: %d, Built: %s ]", _MSC_VER, __TIMESTAMP__ );
+		#else
+			arc::gen3::CArcBase::formatString( "[ Compiler Version: %d.%d.%d, Built: %s %s ]", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__, __DATE__, __TIME__ );
+		#endif
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Destructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Destroys the class.                                                                                     |
 		// |                                                                                                          |
 		// |  Throws std::runtime_error on error.                                                                     |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T>
-		std::uint32_t CArcImage<T>::countPixels( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint16_t uwValue )
+		template <typename T> CArcImage<T>::~CArcImage( void )
 		{
-			return countPixels( pBuf, ( uiCols * uiRows ), uwValue );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  countPixels                                                                                             |
+		// |  version                                                                                                 |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Count the number of pixels having the specified value.                                                  |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf	    - Pointer to the image data buffer.                                                   |
-		// |  <IN> -> uiBufSize - The image buffer size ( in pixels ).                                                |
-		// |  <IN> -> uwValue   - The pixel value to include in the count.                                            |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Returns a textual representation of the library version.                                                |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T>
-		std::uint32_t CArcImage<T>::countPixels( const T* pBuf, const std::uint32_t uiBufSize, const std::uint16_t uwValue )
+		template <typename T> const std::string CArcImage<T>::version( void )
 		{
-			std::uint32_t uiCount = 0;
-
-			verifyBuffer( pBuf );
-
-			if ( pBuf != nullptr )
-			{
-				for ( std::remove_const_t<decltype( uiBufSize )> i = 0; i < uiBufSize; i++ )
-				{
-					if ( pBuf[ i ] == uwValue )
-					{
-						uiCount++;
-					}
-				}
-			}
-			
-			return uiCount;
+			return m_sVersion;
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getPixel                                                                                                |
+		// |  bandCount                                                                                               |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns the value of a pixel at the specified row and column.                                           |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf		- Pointer to the image data buffer.                                                   |
-		// |  <IN> -> uiCol		- The pixel column number.                                                            |
-		// |  <IN> -> uiRow		- The pixel row number.                                                               |
-		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
-		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
+		// |  Returns the number of row bands ( threads ) to use when processing the specified area. Small areas      |
+		// |  return one, meaning the work should be done on the calling thread.                                      |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <IN> -> uiCols - The number of columns in the area.                                                     |
+		// |  <IN> -> uiRows - The number of rows in the area.                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> T
-		CArcImage<T>::getPixel( const T* pBuf, const std::uint32_t uiCol, const std::uint32_t uiRow, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T> std::uint32_t CArcImage<T>::bandCount( const std::uint32_t uiCols, const std::uint32_t uiRows )
 		{
-			verifyBuffer( pBuf );
+			auto u64Bands = ( ( static_cast< std::uint64_t >( uiCols ) * uiRows ) / MIN_BAND_PIXELS );
 
-			verifyColumn( uiCol, uiCols );
+			u64Bands = std::min<std::uint64_t>( u64Bands, std::max( std::thread::hardware_concurrency(), 1U ) );
 
-			verifyRow( uiRow, uiRows );
+			u64Bands = std::min<std::uint64_t>( u64Bands, uiRows );
 
-			return pBuf[ uiCol + ( uiRow * uiCols ) ];
+			return static_cast< std::uint32_t >( std::max<std::uint64_t>( u64Bands, 1 ) );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getRegion                                                                                               |
+		// |  forEachRowBand                                                                                          |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |   Returns a region of an image.                                                                          |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf		- Pointer to the image data buffer.                                                   |
-		// |  <IN> -> uiCol1	- The start column.                                                                   |
-		// |  <IN> -> uiCol2	- The end column.                                                                     |
-		// |  <IN> -> uiRow1	- The start row.                                                                      |
-		// |  <IN> -> uiRow2	- The end row.                                                                        |
-		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
-		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
-		// |  <OUT>-> uiCount	- The pixel count of the returned array.                                              |
+		// |  Splits the specified row range into bands and calls the specified function once per band. Band zero is  |
+		// |  run on the calling thread; all others are run on their own thread. Returns once all bands complete.     |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <IN> -> uiRow1  - The start row.                                                                        |
+		// |  <IN> -> uiRow2  - The end row ( exclusive ).                                                            |
+		// |  <IN> -> uiBands - The number of bands to split the rows into.                                           |
+		// |  <IN> -> fnBand  - Function called as fnBand( start row, end row, band index ) for each band.            |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T>  std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
-		CArcImage<T>::getRegion( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1,
-								 const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount )
+		template <typename T>
+		void CArcImage<T>::forEachRowBand( const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiBands,
+										   const std::function<void( std::uint32_t, std::uint32_t, std::uint32_t )>& fnBand )
 		{
-			verifyBuffer( pBuf );
-
-			verifyColumn( uiCol1, uiCols );
-
-			verifyColumn( uiCol2, uiCols );
-
-			verifyRow( uiRow1, uiRows );
+			if ( uiBands <= 1 || ( uiRow2 - uiRow1 ) < uiBands )
+			{
+				fnBand( uiRow1, uiRow2, 0 );
 
-			verifyRow( uiRow2, uiRows );
+				return;
+			}
 
-			verifyRangeOrder( uiCol1, uiCol2 );
+			auto uiBandRows = ( ( uiRow2 - uiRow1 ) / uiBands );
+			auto uiExtraRows = ( ( uiRow2 - uiRow1 ) % uiBands );
 
-			verifyRangeOrder( uiRow1, uiRow2 );
+			std::vector<std::thread> vThreads;
 
-			uiCount = ( ( uiCol2 - uiCol1 ) * ( uiRow2 - uiRow1 ) );
+			vThreads.reserve( uiBands - 1 );
 
-			std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>> pRegion( new T[ uiCount ], arc::gen3::image::ArrayDeleter<T>() );
+			// The first band gets the left over rows and is run on this thread
+			auto uiStart = ( uiRow1 + uiBandRows + uiExtraRows );
 
-			if ( pRegion == nullptr )
+			for ( std::uint32_t uiBand = 1; uiBand < uiBands; uiBand++ )
 			{
-				throwArcGen3Error( "Failed to allocate region data buffer!"s );
+				vThreads.emplace_back( fnBand, uiStart, uiStart + uiBandRows, uiBand );
+
+				uiStart += uiBandRows;
 			}
 
-			auto uiRegionIndex = 0U;
+			fnBand( uiRow1, uiRow1 + uiBandRows + uiExtraRows, 0 );
 
-			for ( auto r = uiRow1; r < uiRow2; r++ )
+			for ( auto& tThread : vThreads )
 			{
-				for ( auto c = uiCol1; c < uiCol2; c++ )
-				{
-					pRegion[ uiRegionIndex ] = pBuf[ c + r * uiCols ];
-
-					uiRegionIndex++;
-				}
+				tThread.join();
 			}
-
-			return pRegion;
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getRow                                                                                                  |
+		// |  forEachIndex                                                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns all or part of a image row.                                                                     |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
-		// |  <IN> -> uiCol1  - The start column.                                                                     |
-		// |  <IN> -> uiCol2  - The end column.                                                                       |
-		// |  <IN> -> uiRow   - The row to read from.                                                                 |
-		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
-		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
-		// |  <IN> -> uiCount - The pixel count of the returned array.                                                |
+		// |  Calls the specified function once for each index in [ 0, uiCount ). Up to one thread per core pulls     |
+		// |  the next index from a shared counter, so uneven work ( e.g. files of different sizes ) stays balanced.  |
+		// |  The first exception thrown stops further indexes from starting and is rethrown on the calling thread.   |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <IN> -> uiCount - The number of indexes.                                                                |
+		// |  <IN> -> fnIndex - Function called as fnIndex( index ).                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
-		CArcImage<T>::getRow( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount )
+		template <typename T>
+		void CArcImage<T>::forEachIndex( const std::uint32_t uiCount, const std::function<void( std::uint32_t )>& fnIndex )
 		{
-			verifyBuffer( pBuf );
+			auto uiThreads = std::min( std::max( std::thread::hardware_concurrency(), 1U ), uiCount );
 
-			verifyRangeOrder( uiCol1, uiCol2 );
+			std::atomic<std::uint32_t> uiNext( 0 );
 
-			verifyRow( uiRow, uiRows );
+			std::atomic<bool> bFailed( false );
 
-			uiCount = ( ( uiCol2 - uiCol1 ) == 0 ? 1 : ( uiCol2 - uiCol1 ) );
+			std::exception_ptr pException;
 
-			std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>> pRow( new T[ uiCount ], arc::gen3::image::ArrayDeleter<T>() );
+			auto fnWorker = [ & ]( void )
+			{
+				for ( auto uiIndex = uiNext++; uiIndex < uiCount && !bFailed; uiIndex = uiNext++ )
+				{
+					try
+					{
+						fnIndex( uiIndex );
+					}
+					catch ( ... )
+					{
+						if ( !bFailed.exchange( true ) )
+						{
+							pException = std::current_exception();
+						}
+					}
+				}
+			};
 
-			if ( pRow == nullptr )
+			std::vector<std::thread> vThreads;
+
+			for ( std::uint32_t i = 1; i < uiThreads; i++ )
 			{
-				throwArcGen3Error( "Failed to allocate row data buffer!"s );
+				vThreads.emplace_back( fnWorker );
 			}
 
-			copyMemory( reinterpret_cast< void* >( pRow.get() ),
-						reinterpret_cast< void* >( const_cast< T* >( &pBuf[ uiCol1 + uiRow * uiCols ] ) ),
-						( uiCount * sizeof( T ) ) );
+			fnWorker();
 
-			return pRow;
+			for ( auto& tThread : vThreads )
+			{
+				tThread.join();
+			}
+
+			if ( pException )
+			{
+				std::rethrow_exception( pException );
+			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getCol                                                                                                  |
+		// |  fill                                                                                                    |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns all or part of a image row.                                                                     |
+		// |  Fills the specified buffer with the specified value.                                                    |
 		// |                                                                                                          |
 		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
-		// |  <IN> -> uiCol   - The column to read from                                                               |
-		// |  <IN> -> uiRow1  - The start row.                                                                        |
-		// |  <IN> -> uiRow2  - The end row.                                                                          |
 		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
-		// |  <IN> -> uiCount - The pixel count of the returned array.                                                |
+		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// |  <IN> -> uiValue - The value to fill the buffer with.                                                    |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Throws std::invalid_argument, std::invalid_argument                                                     |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
-		CArcImage<T>::getCol( const T* pBuf, const std::uint32_t uiCol, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, std::uint32_t& uiCount )
+		template <typename T> void CArcImage<T>::fill( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const T uiValue )
 		{
-			verifyBuffer( pBuf );
-
-			verifyRangeOrder( uiRow1, uiRow2 );
-
-			verifyColumn( uiCol, uiCols );
-
-			uiCount = ( ( uiRow2 - uiRow1 ) == 0 ? 1 : ( uiRow2 - uiRow1 ) );
-
-			std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>> pCol( new T[ uiCount ], arc::gen3::image::ArrayDeleter<T>() );
+			if ( uiValue >= maxTVal() )
+			{
+				throwArcGen3OutOfRange( uiValue, std::make_pair( 0, ( maxTVal() - 1 ) ) );
+			}
 
-			if ( pCol == nullptr )
+			if ( pBuf != nullptr )
 			{
-				throwArcGen3Error( "Failed to allocate row data buffer!"s );
+				std::fill_n( pBuf, pixelCount( uiCols, uiRows ), uiValue );
 			}
 
-			for ( std::uint32_t row = uiRow1, i = 0; row < uiRow2; row++, i++ )
+			else
 			{
-				pCol.get()[ i ] = pBuf[ uiCol + row * uiCols ];
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
 			}
-			
-			return pCol;
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getRowArea                                                                                              |
+		// |  fill                                                                                                    |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns a row of pixel data where each value is the average over the specified range of columns.        |
+		// |  Fills the specified buffer with the specified value.                                                    |
 		// |                                                                                                          |
 		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
-		// |  <IN> -> uiCol1  - The start column.                                                                     |
-		// |  <IN> -> uiCol2  - The end column.                                                                       |
-		// |  <IN> -> uiRow1  - The start row.                                                                        |
-		// |  <IN> -> uiRow2  - The end row.                                                                          |
-		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                 |
-		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
-		// |  <IN> -> uiCount - The pixel count of the returned array.                                                |
+		// |  <IN> -> uiBytes - The number of bytes in the image data buffer.                                         |
+		// |  <IN> -> uiValue - The value to fill the buffer with.                                                    |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Throws std::invalid_argument, std::invalid_argument                                                     |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<double[], arc::gen3::image::ArrayDeleter<double>>
-		CArcImage<T>::getRowArea( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1,
-								  const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount )
+		template <typename T> void CArcImage<T>::fill( T* pBuf, const std::uint32_t uiBytes, const T uiValue )
 		{
-			double  gRowSum = 0.0;
-
-			verifyRow( uiRow1, uiRows );
+			if ( uiValue >= maxTVal() )
+			{
+				throwArcGen3OutOfRange( uiValue, std::make_pair( 0, ( maxTVal() - 1 ) ) );
+			}
 
-			verifyRow( uiRow2, uiRows );
+			if ( pBuf != nullptr )
+			{
+				std::fill_n( pBuf, ( uiBytes / sizeof( T ) ), uiValue );
+			}
 
-			verifyColumn( uiCol1, uiCols );
+			else
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+			}
+		}
 
-			verifyColumn( uiCol2, uiCols );
 
-			verifyRangeOrder( uiCol1, uiCol2 );
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  fillWithGradient                                                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills the specified buffer with a gradient pattern.                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
+		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
+		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::fillWithGradient( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			if ( pBuf != nullptr )
+			{
+				zeroMemory( pBuf, ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
 
-			verifyRangeOrder( uiRow1, uiRow2 );
+				T uiValue = 0;
 
-			verifyBuffer( pBuf );
+				for ( std::remove_const_t<decltype( uiRows )> r = 0; r < uiRows; r++ )
+				{
+					for ( std::remove_const_t<decltype( uiCols )> c = 0; c < uiCols; c++ )
+					{
+						pBuf[ pixelCount( uiCols, r ) + c ] = uiValue;
+					}
 
-			uiCount = ( ( uiRow2 - uiRow1 ) == 0 ? 1 : ( uiRow2 - uiRow1 ) );
-			
-			std::unique_ptr<double[], arc::gen3::image::ArrayDeleter<double>> pAreaBuf( new double[ uiCount ], arc::gen3::image::ArrayDeleter<double>() );
+					uiValue += static_cast< T >( ( maxTVal() - 1 ) / uiRows );
+				}
+			}
 
-			if ( pAreaBuf == nullptr )
+			else
 			{
-				throwArcGen3Error( "Failed to allocate row data buffer!"s );
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
 			}
+		}
 
-			for ( std::uint32_t row = uiRow1, i = 0; row < uiRow2; row++, i++ )
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  fillWithSmiley                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills the specified buffer with zeroes and puts a smiley face at the center.                            |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
+		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
+		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::fillWithSmiley( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			if ( pBuf != nullptr )
 			{
-				gRowSum = 0;
+				zeroMemory( pBuf, ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
+
+				std::uint32_t uiRadius = static_cast<std::uint32_t>( std::fmin( ( uiRows / 2.0 ), ( uiCols / 2.0 ) ) - 10.0 );
+
+				//  Draw Head
+				// +---------------------------------------------------------------------------- +
+				drawGradientFillCircle(	uiRadius,
+										uiCols,
+										uiRows,
+										pBuf );
+
+				//  Draw Left Eye
+				// +---------------------------------------------------------------------------- +
+				std::uint32_t uiRowFactor = static_cast< std::uint32_t >( uiRadius / 2.5 );
+
+				drawFillCircle( ( uiCols / 2 ) - uiRowFactor,
+								( uiRows / 2 ) + uiRowFactor,
+								( uiRadius / 5 ),
+								uiCols,
+								pBuf );
+
+				//  Draw Right Eye
+				// +---------------------------------------------------------------------------- +
+				drawFillCircle( ( uiCols / 2 ) + uiRowFactor,
+								( uiRows / 2 ) + uiRowFactor,
+								( uiRadius / 5 ),
+								uiCols,
+								pBuf );
 
-				for ( std::uint32_t col = uiCol1; col < uiCol2; col++ )
+				//  Draw Mouth
+				// +---------------------------------------------------------------------------- +
+				for ( decltype( uiRadius ) i = 0; i < ( uiRadius / 2 ); i++ )
 				{
-					gRowSum += pBuf[ col + row * uiCols ];
+					drawSemiCircle( ( uiCols / 2 ),
+									( uiRows / 2 ) - ( uiRowFactor / 2 ),
+									i,
+									180,
+									360,
+									uiCols,
+									pBuf );
 				}
+			}
 
-				pAreaBuf.get()[ i ] = gRowSum / ( static_cast< double >( uiCol2 - uiCol1 ) );
+			else
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
 			}
+		}
 
-			return pAreaBuf;
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  fillWithRamp                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills the specified buffer with a ramp image. Data has the form 0, 1, 2, ..., 65535, 0, 1, ....         |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	 - Pointer to the image data buffer.                                                      |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::fillWithRamp( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			if ( pBuf != nullptr )
+			{
+				T uiValue = 0;
+
+				for ( std::size_t i = 0; i < pixelCount( uiCols, uiRows ); i++ )
+				{
+					pBuf[ i ] = uiValue;
+
+					uiValue++;
+
+					if ( uiValue >= maxTVal() ) { uiValue = 0; }
+				}
+
+				containsValidRamp( pBuf, uiCols, uiRows );
+			}
+
+			else
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getColArea                                                                                              |
+		// |  containsValidRamp                                                                                       |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Returns a column of pixel data where each value is the average over the specified range of rows.        |
+		// |  Verify a ramp synthetic image. Data has the form 0, 1, 2, ..., 65535, 0, 1, ....                        |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
-		// |  <IN> -> uiCol1  - The start column.                                                                     |
-		// |  <IN> -> uiCol2  - The end column.                                                                       |
-		// |  <IN> -> uiRow1  - The start row.                                                                        |
-		// |  <IN> -> uiRow2  - The end row.                                                                          |
-		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                 |
-		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
-		// |  <IN> -> uiCount - The pixel count of the returned array.                                                |
+		// |  <IN> -> pBuf	 - Pointer to the image data buffer.                                                      |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
 		// |                                                                                                          |
 		// |  Throws std::runtime_error on error.                                                                     |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<double[], arc::gen3::image::ArrayDeleter<double>>
-		CArcImage<T>::getColArea( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1,
-								  const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount )
+		template <typename T> void CArcImage<T>::containsValidRamp( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
 		{
-			double  gColSum = 0.0;
+			if ( pBuf != nullptr )
+			{
+				T uiValue = pBuf[ 0 ];
 
-			verifyRow( uiRow1, uiRows );
-				
-			verifyRow( uiRow2, uiRows );
+				std::size_t uiPixel = 0;
 
-			verifyColumn( uiCol1, uiCols );
+				for ( std::uint32_t r = 0; r < uiRows; r++ )
+				{
+					for ( std::uint32_t c = 0; c < uiCols; c++ )
+					{
+						if ( pBuf[ uiPixel ] != uiValue )
+						{
+							throwArcGen3Error( "Invalid ramp image. Expected %u at col %u row %u, found %u",
+									uiValue,
+									c,
+									r,
+									pBuf[ uiPixel ] );
+						}
 
-			verifyColumn( uiCol2, uiCols );
+						uiPixel++;
+						uiValue++;
 
-			verifyRangeOrder( uiCol1, uiCol2 );
+						if ( uiValue >= maxTVal() )
+						{
+							uiValue = pBuf[ pixelCount( uiCols, r ) + c + 1 ];
+						}
+					}
+				}
+			}
 
-			verifyRangeOrder( uiRow1, uiRow2 );
+			else
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+			}
+		}
 
-			verifyBuffer( pBuf );
 
-			uiCount = ( ( uiCol2 - uiCol1 ) == 0 ? 1 : ( uiCol2 - uiCol1 ) );
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  fillWithSynthetic                                                                                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills an image view with a synthetic frame, in image order. Each pixel is                               |
+		// |                                                                                                          |
+		// |      bias + amplifier offset + ( Poisson( sky + dark x exposure + stars ) + read noise ) / gain          |
+		// |                                                                                                          |
+		// |  rounded and clipped to the pixel range. Above a mean of 30 e- the Poisson and read noise terms are      |
+		// |  drawn together as one normal deviate. Star positions and fluxes come from the seed; each row then       |
+		// |  draws its noise from its own stream, seeded from the seed and row number, so rows can be generated in   |
+		// |  bands on separate threads without changing the result. Cosmic-ray hits are added last, without noise,   |
+		// |  as short straight tracks of one to four pixels with exponentially distributed charge.                   |
+		// |                                                                                                          |
+		// |  <IN> -> cView   - The image view.                                                                       |
+		// |  <IN> -> cParams - The frame model.                                                                      |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::fillWithSynthetic( const arc::gen3::CArcImageView<T>& cView, const arc::gen3::image::CSynthParams& cParams )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
 
-			std::unique_ptr<double[], arc::gen3::image::ArrayDeleter<double>> pAreaBuf( new double[ uiCount ], arc::gen3::image::ArrayDeleter<double>() );
+			if ( cParams.gGain <= 0.0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid gain [ %f ]! Must be greater than zero!", cParams.gGain );
+			}
 
-			if ( pAreaBuf == nullptr )
+			if ( cParams.gReadNoise < 0.0 || cParams.gDarkCurrent < 0.0 || cParams.gExposure < 0.0 || cParams.gSky < 0.0 || cParams.gCosmicFlux < 0.0 )
 			{
-				throwArcGen3Error( "Failed to allocate column data buffer!"s );
+				throwArcGen3InvalidArgument( "Invalid frame model! Read noise, dark current, exposure, sky and cosmic-ray charge must not be negative!"s );
+			}
+
+			if ( cParams.uiStars > 0 && ( cParams.gStarFwhm <= 0.0 || cParams.gStarFluxMin <= 0.0 || cParams.gStarFluxMax < cParams.gStarFluxMin ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid star model! FWHM and fluxes must be greater than zero, and the minimum flux not above the maximum!"s );
+			}
+
+			if ( cParams.uiAmpCols == 0 || cParams.uiAmpCols > cView.cols() || cParams.uiAmpRows == 0 || cParams.uiAmpRows > cView.rows() )
+			{
+				throwArcGen3InvalidArgument( "Invalid amplifier grid [ %u x %u ]!", cParams.uiAmpCols, cParams.uiAmpRows );
+			}
+
+			struct synthStar_t
+			{
+				double gCol;
+				double gRow;
+				double gAmplitude;
+			};
+
+			auto uiCols = cView.cols();
+			auto uiRows = cView.rows();
+
+			synthRandom_t cRandom( cParams.u64Seed );
+
+			//
+			// Place the stars, sorted by row so each row only visits the stars that reach it
+			//
+			const double gSigma = ( cParams.gStarFwhm / 2.3548 );
+			const double gInvTwoSigma2 = ( 1.0 / ( 2.0 * gSigma * gSigma ) );
+			const auto iStarRadius = static_cast< std::int64_t >( std::ceil( 4.0 * gSigma ) );
+
+			std::vector<synthStar_t> vStars( cParams.uiStars );
+
+			for ( auto& cStar : vStars )
+			{
+				cStar.gCol = ( cRandom.uniform() * uiCols );
+				cStar.gRow = ( cRandom.uniform() * uiRows );
+
+				double gFlux = ( cParams.gStarFluxMin * std::exp( cRandom.uniform() * std::log( cParams.gStarFluxMax / cParams.gStarFluxMin ) ) );
+
+				cStar.gAmplitude = ( gFlux * gInvTwoSigma2 / 3.14159265358979 );
+			}
+
+			std::sort( vStars.begin(), vStars.end(), []( const synthStar_t& cA, const synthStar_t& cB ) { return ( cA.gRow < cB.gRow ); } );
+
+			std::vector<std::uint32_t> vAmpColStart( static_cast< std::size_t >( cParams.uiAmpCols ) + 1 );
+
+			for ( std::uint32_t uiAmp = 0; uiAmp <= cParams.uiAmpCols; uiAmp++ )
+			{
+				vAmpColStart[ uiAmp ] = static_cast< std::uint32_t >( ( static_cast< std::uint64_t >( uiAmp ) * uiCols ) / cParams.uiAmpCols );
 			}
 
-			for ( std::uint32_t col = uiCol1, i = 0; col < uiCol2; col++, i++ )
+			const double gBase = ( cParams.gSky + cParams.gDarkCurrent * cParams.gExposure );
+			const double gReadVar = ( cParams.gReadNoise * cParams.gReadNoise );
+			const double gBaseNoise = std::sqrt( gBase + gReadVar );
+			const double gInvGain = ( 1.0 / cParams.gGain );
+			const double gMax = static_cast< double >( maxTVal() - 1 );
+
+			forEachRowBand( 0, uiRows, bandCount( uiCols, uiRows ), [ & ]( std::uint32_t uiBandRow1, std::uint32_t uiBandRow2, std::uint32_t )
 			{
-				gColSum = 0;
+				std::vector<double> vSignal( uiCols );
+
+				for ( auto row = uiBandRow1; row < uiBandRow2; row++ )
+				{
+					std::fill( vSignal.begin(), vSignal.end(), gBase );
+
+					auto itStar = std::lower_bound( vStars.begin(), vStars.end(), ( static_cast< double >( row ) - static_cast< double >( iStarRadius ) ),
+													[]( const synthStar_t& cStar, double gRow ) { return ( cStar.gRow < gRow ); } );
+
+					for ( ; itStar != vStars.end() && itStar->gRow <= ( static_cast< double >( row ) + static_cast< double >( iStarRadius ) ); itStar++ )
+					{
+						double gDy = ( static_cast< double >( row ) - itStar->gRow );
+						double gRowAmplitude = ( itStar->gAmplitude * std::exp( -gDy * gDy * gInvTwoSigma2 ) );
+
+						auto iCol1 = std::max<std::int64_t>( static_cast< std::int64_t >( itStar->gCol ) - iStarRadius, 0 );
+						auto iCol2 = std::min<std::int64_t>( static_cast< std::int64_t >( itStar->gCol ) + iStarRadius, static_cast< std::int64_t >( uiCols ) - 1 );
+
+						for ( auto col = iCol1; col <= iCol2; col++ )
+						{
+							double gDx = ( static_cast< double >( col ) - itStar->gCol );
+
+							vSignal[ static_cast< std::size_t >( col ) ] += ( gRowAmplitude * std::exp( -gDx * gDx * gInvTwoSigma2 ) );
+						}
+					}
+
+					synthRandom_t cRowRandom( cParams.u64Seed ^ ( ( static_cast< std::uint64_t >( row ) + 1 ) * 0xD1B54A32D192ED03ULL ) );
+
+					auto uiAmpRow = static_cast< std::uint32_t >( ( static_cast< std::uint64_t >( row ) * cParams.uiAmpRows ) / uiRows );
+
+					T* pRow = cView.row( row );
+
+					for ( std::uint32_t uiAmpCol = 0; uiAmpCol < cParams.uiAmpCols; uiAmpCol++ )
+					{
+						auto uiAmp = static_cast< std::size_t >( uiAmpRow ) * cParams.uiAmpCols + uiAmpCol;
+
+						double gLevel = ( cParams.gBias + ( ( uiAmp < cParams.vAmpOffsets.size() ) ? cParams.vAmpOffsets[ uiAmp ] : 0.0 ) );
+
+						for ( auto col = vAmpColStart[ uiAmpCol ]; col < vAmpColStart[ uiAmpCol + 1 ]; col++ )
+						{
+							double gMean = vSignal[ col ];
+							double gElectrons = 0.0;
+
+							if ( gMean >= 30.0 )
+							{
+								gElectrons = ( gMean + ( ( gMean == gBase ) ? gBaseNoise : std::sqrt( gMean + gReadVar ) ) * cRowRandom.normal() );
+							}
+
+							else
+							{
+								gElectrons = ( cRowRandom.poisson( gMean ) + cParams.gReadNoise * cRowRandom.normal() );
+							}
+
+							pRow[ col ] = static_cast< T >( std::clamp( std::round( gLevel + gElectrons * gInvGain ), 0.0, gMax ) );
+						}
+					}
+				}
+			} );
+
+			//
+			// Cosmic-ray hits
+			//
+			for ( std::uint32_t uiHit = 0; uiHit < cParams.uiCosmics; uiHit++ )
+			{
+				double gCol = std::floor( cRandom.uniform() * uiCols );
+				double gRow = std::floor( cRandom.uniform() * uiRows );
+				double gAngle = ( cRandom.uniform() * 2.0 * 3.14159265358979 );
+				double gCharge = ( -cParams.gCosmicFlux * std::log( 1.0 - cRandom.uniform() ) );
+
+				auto uiLength = static_cast< std::uint32_t >( 1 + ( cRandom.next() % 4 ) );
+
+				double gStepDN = ( gCharge * gInvGain / uiLength );
+
+				for ( std::uint32_t uiStep = 0; uiStep < uiLength; uiStep++ )
+				{
+					double gTrackCol = std::round( gCol + uiStep * std::cos( gAngle ) );
+					double gTrackRow = std::round( gRow + uiStep * std::sin( gAngle ) );
+
+					if ( gTrackCol < 0.0 || gTrackCol >= uiCols || gTrackRow < 0.0 || gTrackRow >= uiRows )
+					{
+						break;
+					}
+
+					T& tPixel = cView( static_cast< std::uint32_t >( gTrackCol ), static_cast< std::uint32_t >( gTrackRow ) );
+
+					tPixel = static_cast< T >( std::min( std::round( static_cast< double >( tPixel ) + gStepDN ), gMax ) );
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  fillWithSynthetic                                                                                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills the specified buffer with a synthetic frame. See above.                                           |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf    - Pointer to the image data buffer.                                                     |
+		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
+		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// |  <IN> -> cParams - The frame model.                                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::fillWithSynthetic( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CSynthParams& cParams )
+		{
+			verifyBuffer( pBuf );
+
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			fillWithSynthetic( arc::gen3::CArcImageView<T>( pBuf, uiCols, uiRows ), cParams );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  countPixels                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Count the number of pixels having the specified value. The image may hold more than 4G pixels; the      |
+		// |  count saturates at the largest 32-bit value.                                                            |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	   - Pointer to the image data buffer.                                                    |
+		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
+		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// |  <IN> -> uwValue - The pixel value to include in the count.                                              |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint32_t CArcImage<T>::countPixels( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint16_t uwValue )
+		{
+			verifyBuffer( pBuf );
+
+			const T* arcGen3Restrict pPixel = pBuf;
+
+			std::size_t uiLength = pixelCount( uiCols, uiRows );
+
+			std::uint64_t u64Count = 0;
+
+			for ( std::size_t i = 0; i < uiLength; i++ )
+			{
+				u64Count += ( ( pPixel[ i ] == uwValue ) ? 1 : 0 );
+			}
+
+			return static_cast< std::uint32_t >( std::min( u64Count, static_cast< std::uint64_t >( std::numeric_limits<std::uint32_t>::max() ) ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  countPixels                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Count the number of pixels having the specified value.                                                  |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	    - Pointer to the image data buffer.                                                   |
+		// |  <IN> -> uiBufSize - The image buffer size ( in pixels ).                                                |
+		// |  <IN> -> uwValue   - The pixel value to include in the count.                                            |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint32_t CArcImage<T>::countPixels( const T* pBuf, const std::uint32_t uiBufSize, const std::uint16_t uwValue )
+		{
+			std::uint32_t uiCount = 0;
+
+			verifyBuffer( pBuf );
+
+			if ( pBuf != nullptr )
+			{
+				for ( std::remove_const_t<decltype( uiBufSize )> i = 0; i < uiBufSize; i++ )
+				{
+					if ( pBuf[ i ] == uwValue )
+					{
+						uiCount++;
+					}
+				}
+			}
+			
+			return uiCount;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getPixel                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the value of a pixel at the specified row and column.                                           |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf		- Pointer to the image data buffer.                                                   |
+		// |  <IN> -> uiCol		- The pixel column number.                                                            |
+		// |  <IN> -> uiRow		- The pixel row number.                                                               |
+		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> T
+		CArcImage<T>::getPixel( const T* pBuf, const std::uint32_t uiCol, const std::uint32_t uiRow, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyBuffer( pBuf );
+
+			verifyColumn( uiCol, uiCols );
+
+			verifyRow( uiRow, uiRows );
+
+			return pBuf[ pixelCount( uiCols, uiRow ) + uiCol ];
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getRegion                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |   Returns a region of an image.                                                                          |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf		- Pointer to the image data buffer.                                                   |
+		// |  <IN> -> uiCol1	- The start column.                                                                   |
+		// |  <IN> -> uiCol2	- The end column.                                                                     |
+		// |  <IN> -> uiRow1	- The start row.                                                                      |
+		// |  <IN> -> uiRow2	- The end row.                                                                        |
+		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
+		// |  <OUT>-> uiCount	- The pixel count of the returned array.                                              |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>  std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
+		CArcImage<T>::getRegion( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1,
+								 const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows, std::size_t& uiCount )
+		{
+			verifyBuffer( pBuf );
+
+			verifyColumn( uiCol1, uiCols );
+
+			verifyColumn( uiCol2, uiCols );
+
+			verifyRow( uiRow1, uiRows );
+
+			verifyRow( uiRow2, uiRows );
+
+			verifyRangeOrder( uiCol1, uiCol2 );
+
+			verifyRangeOrder( uiRow1, uiRow2 );
+
+			uiCount = pixelCount( ( uiCol2 - uiCol1 ), ( uiRow2 - uiRow1 ) );
+
+			std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>> pRegion( new T[ uiCount ], arc::gen3::image::ArrayDeleter<T>() );
+
+			if ( pRegion == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate region data buffer!"s );
+			}
+
+			std::size_t uiRegionIndex = 0;
+
+			for ( auto r = uiRow1; r < uiRow2; r++ )
+			{
+				for ( auto c = uiCol1; c < uiCol2; c++ )
+				{
+					pRegion[ uiRegionIndex ] = pBuf[ pixelCount( uiCols, r ) + c ];
+
+					uiRegionIndex++;
+				}
+			}
+
+			return pRegion;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getRow                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns all or part of a image row.                                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
+		// |  <IN> -> uiCol1  - The start column.                                                                     |
+		// |  <IN> -> uiCol2  - The end column.                                                                       |
+		// |  <IN> -> uiRow   - The row to read from.                                                                 |
+		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
+		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// |  <IN> -> uiCount - The pixel count of the returned array.                                                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
+		CArcImage<T>::getRow( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount )
+		{
+			verifyBuffer( pBuf );
+
+			verifyRangeOrder( uiCol1, uiCol2 );
+
+			verifyRow( uiRow, uiRows );
+
+			uiCount = ( ( uiCol2 - uiCol1 ) == 0 ? 1 : ( uiCol2 - uiCol1 ) );
+
+			std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>> pRow( new T[ uiCount ], arc::gen3::image::ArrayDeleter<T>() );
+
+			if ( pRow == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate row data buffer!"s );
+			}
+
+			copyMemory( reinterpret_cast< void* >( pRow.get() ),
+						reinterpret_cast< void* >( const_cast< T* >( &pBuf[ pixelCount( uiCols, uiRow ) + uiCol1 ] ) ),
+						( uiCount * sizeof( T ) ) );
+
+			return pRow;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getCol                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns all or part of a image row.                                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
+		// |  <IN> -> uiCol   - The column to read from                                                               |
+		// |  <IN> -> uiRow1  - The start row.                                                                        |
+		// |  <IN> -> uiRow2  - The end row.                                                                          |
+		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
+		// |  <IN> -> uiCount - The pixel count of the returned array.                                                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
+		CArcImage<T>::getCol( const T* pBuf, const std::uint32_t uiCol, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, std::uint32_t& uiCount )
+		{
+			verifyBuffer( pBuf );
+
+			verifyRangeOrder( uiRow1, uiRow2 );
+
+			verifyColumn( uiCol, uiCols );
+
+			uiCount = ( ( uiRow2 - uiRow1 ) == 0 ? 1 : ( uiRow2 - uiRow1 ) );
+
+			std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>> pCol( new T[ uiCount ], arc::gen3::image::ArrayDeleter<T>() );
+
+			if ( pCol == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate row data buffer!"s );
+			}
+
+			for ( std::uint32_t row = uiRow1, i = 0; row < uiRow2; row++, i++ )
+			{
+				pCol.get()[ i ] = pBuf[ pixelCount( uiCols, row ) + uiCol ];
+			}
+			
+			return pCol;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getRowArea                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns a row of pixel data where each value is the average over the specified range of columns.        |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
+		// |  <IN> -> uiCol1  - The start column.                                                                     |
+		// |  <IN> -> uiCol2  - The end column.                                                                       |
+		// |  <IN> -> uiRow1  - The start row.                                                                        |
+		// |  <IN> -> uiRow2  - The end row.                                                                          |
+		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
+		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// |  <IN> -> uiCount - The pixel count of the returned array.                                                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<double[], arc::gen3::image::ArrayDeleter<double>>
+		CArcImage<T>::getRowArea( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1,
+								  const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount )
+		{
+			auto cView = areaView( pBuf, uiCol1, uiCol2, uiRow1, uiRow2, uiCols, uiRows );
+
+			uiCount = cView.rows();
+
+			std::unique_ptr<double[], arc::gen3::image::ArrayDeleter<double>> pAreaBuf( new double[ uiCount ], arc::gen3::image::ArrayDeleter<double>() );
+
+			if ( pAreaBuf == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate row data buffer!"s );
+			}
+
+			rowProfile( cView, pAreaBuf.get() );
+
+			return pAreaBuf;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getRowArea                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills a caller supplied buffer with a row of pixel data where each value is the average over the        |
+		// |  specified range of columns. The buffer must hold ( uiRow2 - uiRow1 ) elements, or one if equal.         |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf	    - Pointer to the image data buffer.                                                   |
+		// |  <IN>  -> uiCol1   - The start column.                                                                   |
+		// |  <IN>  -> uiCol2   - The end column.                                                                     |
+		// |  <IN>  -> uiRow1   - The start row.                                                                      |
+		// |  <IN>  -> uiRow2   - The end row.                                                                        |
+		// |  <IN>  -> uiCols   - The image column size ( in pixels ).                                                |
+		// |  <IN>  -> uiRows   - The image row size ( in pixels ).                                                   |
+		// |  <OUT> -> pAreaBuf - Pointer to the buffer that receives the row profile.                                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::getRowArea( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2,
+									   const std::uint32_t uiCols, const std::uint32_t uiRows, double* pAreaBuf )
+		{
+			rowProfile( areaView( pBuf, uiCol1, uiCol2, uiRow1, uiRow2, uiCols, uiRows ), pAreaBuf );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getRowArea                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Single precision version of getRowArea. See above.                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::getRowArea( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2,
+									   const std::uint32_t uiCols, const std::uint32_t uiRows, float* pAreaBuf )
+		{
+			rowProfile( areaView( pBuf, uiCol1, uiCol2, uiRow1, uiRow2, uiCols, uiRows ), pAreaBuf );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getColArea                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns a column of pixel data where each value is the average over the specified range of rows.        |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
+		// |  <IN> -> uiCol1  - The start column.                                                                     |
+		// |  <IN> -> uiCol2  - The end column.                                                                       |
+		// |  <IN> -> uiRow1  - The start row.                                                                        |
+		// |  <IN> -> uiRow2  - The end row.                                                                          |
+		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
+		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// |  <IN> -> uiCount - The pixel count of the returned array.                                                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<double[], arc::gen3::image::ArrayDeleter<double>>
+		CArcImage<T>::getColArea( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1,
+								  const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount )
+		{
+			auto cView = areaView( pBuf, uiCol1, uiCol2, uiRow1, uiRow2, uiCols, uiRows );
+
+			uiCount = cView.cols();
+
+			std::unique_ptr<double[], arc::gen3::image::ArrayDeleter<double>> pAreaBuf( new double[ uiCount ], arc::gen3::image::ArrayDeleter<double>() );
+
+			if ( pAreaBuf == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate column data buffer!"s );
+			}
+
+			colProfile( cView, pAreaBuf.get() );
+
+			return pAreaBuf;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getColArea                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills a caller supplied buffer with a column of pixel data where each value is the average over the     |
+		// |  specified range of rows. The buffer must hold ( uiCol2 - uiCol1 ) elements, or one if equal.            |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf	    - Pointer to the image data buffer.                                                   |
+		// |  <IN>  -> uiCol1   - The start column.                                                                   |
+		// |  <IN>  -> uiCol2   - The end column.                                                                     |
+		// |  <IN>  -> uiRow1   - The start row.                                                                      |
+		// |  <IN>  -> uiRow2   - The end row.                                                                        |
+		// |  <IN>  -> uiCols   - The image column size ( in pixels ).                                                |
+		// |  <IN>  -> uiRows   - The image row size ( in pixels ).                                                   |
+		// |  <OUT> -> pAreaBuf - Pointer to the buffer that receives the column profile.                             |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::getColArea( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2,
+									   const std::uint32_t uiCols, const std::uint32_t uiRows, double* pAreaBuf )
+		{
+			colProfile( areaView( pBuf, uiCol1, uiCol2, uiRow1, uiRow2, uiCols, uiRows ), pAreaBuf );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getColArea                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Single precision version of getColArea. See above.                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::getColArea( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2,
+									   const std::uint32_t uiCols, const std::uint32_t uiRows, float* pAreaBuf )
+		{
+			colProfile( areaView( pBuf, uiCol1, uiCol2, uiRow1, uiRow2, uiCols, uiRows ), pAreaBuf );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  areaView                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Validates an image area using the same rules as getStats() and returns a view of it. An equal start     |
+		// |  and end column ( or row ) selects the single column ( or row ).                                         |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
+		// |  <IN> -> uiCol1  - The start column.                                                                     |
+		// |  <IN> -> uiCol2  - The end column.                                                                       |
+		// |  <IN> -> uiRow1  - The start row.                                                                        |
+		// |  <IN> -> uiRow2  - The end row.                                                                          |
+		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
+		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		arc::gen3::CArcImageView<const T> CArcImage<T>::areaView( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1,
+																  const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyRow( uiRow1, uiRows );
+
+			verifyRow( uiRow2, uiRows );
+
+			verifyColumn( uiCol1, uiCols );
+
+			verifyColumn( uiCol2, uiCols );
+
+			verifyRangeOrder( uiCol1, uiCol2 );
+
+			verifyRangeOrder( uiRow1, uiRow2 );
+
+			verifyBuffer( pBuf );
+
+			auto uiColEnd = ( ( uiCol2 == uiCol1 ) ? ( uiCol1 + 1 ) : uiCol2 );
+			auto uiRowEnd = ( ( uiRow2 == uiRow1 ) ? ( uiRow1 + 1 ) : uiRow2 );
+
+			return arc::gen3::CArcImageView<const T>( pBuf, uiCols, uiRows ).subView( uiCol1, uiRow1, ( uiColEnd - uiCol1 ), ( uiRowEnd - uiRow1 ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  rowProfile                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the average of each row of the specified view. Each row is summed as a contiguous run of     |
+		// |  pixels, and bands of rows are handed to separate threads for large views.                               |
+		// |                                                                                                          |
+		// |  <IN>  -> cView    - The image view.                                                                     |
+		// |  <OUT> -> pAreaBuf - Pointer to the buffer that receives the row profile.                                |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> template <typename U>
+		void CArcImage<T>::rowProfile( const arc::gen3::CArcImageView<const T>& cView, U* pAreaBuf )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( pAreaBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid row profile buffer ( nullptr )!"s );
+			}
+
+			auto uiWidth = cView.cols();
+
+			auto gWidth = static_cast< double >( uiWidth );
+
+			forEachRowBand( 0, cView.rows(), bandCount( uiWidth, cView.rows() ), [ & ]( std::uint32_t uiBandRow1, std::uint32_t uiBandRow2, std::uint32_t )
+			{
+				for ( auto row = uiBandRow1; row < uiBandRow2; row++ )
+				{
+					const T* pRow = cView.row( row );
+
+					std::uint64_t u64RowSum = 0;
+
+					for ( std::uint32_t col = 0; col < uiWidth; col++ )
+					{
+						u64RowSum += pRow[ col ];
+					}
+
+					pAreaBuf[ row ] = static_cast< U >( static_cast< double >( u64RowSum ) / gWidth );
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  colProfile                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the average of each column of the specified view. The view is streamed a row at a time into  |
+		// |  a vector of per-column accumulators, so every read is sequential in memory. For large views each band   |
+		// |  of rows gets its own accumulators, which are summed once all bands complete.                            |
+		// |                                                                                                          |
+		// |  <IN>  -> cView    - The image view.                                                                     |
+		// |  <OUT> -> pAreaBuf - Pointer to the buffer that receives the column profile.                             |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> template <typename U>
+		void CArcImage<T>::colProfile( const arc::gen3::CArcImageView<const T>& cView, U* pAreaBuf )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( pAreaBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid column profile buffer ( nullptr )!"s );
+			}
+
+			std::size_t uiWidth = cView.cols();
+
+			auto uiBands = bandCount( cView.cols(), cView.rows() );
+
+			std::vector<std::uint64_t> vAccum( uiWidth * uiBands, 0 );
+
+			forEachRowBand( 0, cView.rows(), uiBands, [ & ]( std::uint32_t uiBandRow1, std::uint32_t uiBandRow2, std::uint32_t uiBand )
+			{
+				std::uint64_t* pAccum = ( vAccum.data() + uiBand * uiWidth );
+
+				for ( auto row = uiBandRow1; row < uiBandRow2; row++ )
+				{
+					const T* pRow = cView.row( row );
+
+					for ( std::size_t i = 0; i < uiWidth; i++ )
+					{
+						pAccum[ i ] += pRow[ i ];
+					}
+				}
+			} );
+
+			auto gHeight = static_cast< double >( cView.rows() );
+
+			for ( std::size_t i = 0; i < uiWidth; i++ )
+			{
+				std::uint64_t u64ColSum = 0;
+
+				for ( std::uint32_t uiBand = 0; uiBand < uiBands; uiBand++ )
+				{
+					u64ColSum += vAccum[ uiBand * uiWidth + i ];
+				}
+
+				pAreaBuf[ i ] = static_cast< U >( static_cast< double >( u64ColSum ) / gHeight );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getStats                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the image min, max, mean, variance, standard deviation, total pixel count and saturated      |
+		// |  pixel count over the specified image buffer cols and rows.                                              |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	 - Pointer to the image data buffer.                                                      |
+		// |  <IN> -> uiCol1 - The start column.                                                                      |
+		// |  <IN> -> uiCol2 - The end column.                                                                        |
+		// |  <IN> -> uiRow1 - The start row.                                                                         |
+		// |  <IN> -> uiRow2 - The end row.                                                                           |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::image::CStats>
+		CArcImage<T>::getStats( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			double gDevSqrdSum = 0.0;
+			double gVal = 0.0;
+			double gSum = 0.0;
+
+			std::remove_const_t<decltype( uiRow2 )> uiLocalRow2 = uiRow2;
+			std::remove_const_t<decltype( uiCol2 )> uiLocalCol2 = uiCol2;
+
+			verifyRow( uiRow1, uiRows );
+				
+			verifyRow( uiRow2, uiRows );
+
+			verifyColumn( uiCol1, uiCols );
+
+			verifyColumn( uiCol2, uiCols );
+				
+			verifyRangeOrder( uiCol1, uiCol2 );
+
+			verifyRangeOrder( uiRow1, uiRow2 );
+
+			verifyBuffer( pBuf );
+
+			double gMaxBpp = maxTVal();
+
+			std::unique_ptr<arc::gen3::image::CStats> pStats( new arc::gen3::image::CStats() );
+
+			if ( pStats == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate stats data buffer!"s );
+			}
+
+			pStats->gMin = gMaxBpp;
+			
+			if ( uiRow1 == uiRow2 ) { uiLocalRow2++; }
+			if ( uiCol1 == uiCol2 ) { uiLocalCol2++; }
+
+			double gTotalPixelCount = ( static_cast< double >( uiLocalRow2 - uiRow1 ) * static_cast< double >( uiLocalCol2 - uiCol1 ) );
+
+			pStats->gTotalPixels = gTotalPixelCount;
+
+			for ( std::uint32_t i = uiRow1; i < uiLocalRow2; i++ )
+			{
+				for ( std::uint32_t j = uiCol1; j < uiLocalCol2; j++ )
+				{
+					gVal = static_cast< double >( pBuf[ pixelCount( uiCols, i ) + j ] );
+
+					//
+					// Determine min/max values
+					//
+					if ( gVal < pStats->gMin )
+					{
+						pStats->gMin = gVal;
+					}
+
+					else if ( gVal > pStats->gMax )
+					{
+						pStats->gMax = gVal;
+					}
+
+					//
+					// Monitor for saturated pixels
+					//
+					//if ( gVal >= ( T_SIZE( T ) - 1 ) )
+					if ( gVal >= ( maxTVal() - 1 ) )
+					{
+						pStats->gSaturatedCount++;
+					}
+
+					gSum += gVal;
+				}
+			}
+
+			// Calculate mean
+			pStats->gMean = gSum / gTotalPixelCount;
+
+			for ( std::uint32_t i = uiRow1; i < uiLocalRow2; i++ )
+			{
+				for ( std::uint32_t j = uiCol1; j < uiLocalCol2; j++ )
+				{
+					double gPixVal = static_cast< double >( pBuf[ pixelCount( uiCols, i ) + j ] );
+					
+					gDevSqrdSum += std::pow( ( gPixVal - pStats->gMean ), 2 );
+				}
+			}
+
+			pStats->gVariance = gDevSqrdSum / gTotalPixelCount;
+			pStats->gStdDev = std::sqrt( pStats->gVariance );
+
+			return pStats;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getStats                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the image min, max, mean, variance, standard deviation, total pixel count and saturated      |
+		// |  pixel count over the entire image.                                                                      |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	 - Pointer to the image data buffer.                                                      |
+		// |  <IN> -> uiCol1 - The start column.                                                                      |
+		// |  <IN> -> uiCol2 - The end column.                                                                        |
+		// |  <IN> -> uiRow1 - The start row.                                                                         |
+		// |  <IN> -> uiRow2 - The end row.                                                                           |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::unique_ptr<arc::gen3::image::CStats> CArcImage<T>::getStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			return getStats( pBuf, 0, uiCols, 0, uiRows, uiCols, uiRows );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getStats                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the statistics for a list of regions in a single pass over the image. The regions may        |
+		// |  overlap. See roiStats() for details.                                                                    |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	     - Pointer to the image data buffer.                                                   |
+		// |  <IN> -> pRois	     - Pointer to an array of regions.                                                     |
+		// |  <IN> -> uiRoiCount - The number of regions in the array.                                                |
+		// |  <IN> -> uiCols     - The image column size ( in pixels ).                                               |
+		// |  <IN> -> uiRows     - The image row size ( in pixels ).                                                  |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::image::CStats[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CStats>>
+		CArcImage<T>::getStats( const T* pBuf, const arc::gen3::image::CRoi* pRois, const std::uint32_t uiRoiCount, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyBuffer( pBuf );
+
+			auto vRois = verifyRois( pRois, uiRoiCount, uiCols, uiRows );
+
+			return roiStats( arc::gen3::CArcImageView<const T>( pBuf, uiCols, uiRows ), vRois );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  verifyRois                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Validates a list of regions using the same rules as getStats() and returns a copy of it in which every  |
+		// |  region is an exclusive column/row range. An equal start and end selects the single column ( or row ).   |
+		// |                                                                                                          |
+		// |  <IN> -> pRois	     - Pointer to an array of regions.                                                     |
+		// |  <IN> -> uiRoiCount - The number of regions in the array.                                                |
+		// |  <IN> -> uiCols     - The image column size ( in pixels ).                                               |
+		// |  <IN> -> uiRows     - The image row size ( in pixels ).                                                  |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::vector<arc::gen3::image::CRoi>
+		CArcImage<T>::verifyRois( const arc::gen3::image::CRoi* pRois, const std::uint32_t uiRoiCount, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			if ( pRois == nullptr || uiRoiCount == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid region list! Must contain at least one region!"s );
+			}
+
+			std::vector<arc::gen3::image::CRoi> vRois( pRois, pRois + uiRoiCount );
+
+			for ( auto& cRoi : vRois )
+			{
+				verifyRow( cRoi.uiRow1, uiRows );
+
+				verifyRow( cRoi.uiRow2, uiRows );
+
+				verifyColumn( cRoi.uiCol1, uiCols );
+
+				verifyColumn( cRoi.uiCol2, uiCols );
+
+				verifyRangeOrder( cRoi.uiCol1, cRoi.uiCol2 );
+
+				verifyRangeOrder( cRoi.uiRow1, cRoi.uiRow2 );
+
+				if ( cRoi.uiRow1 == cRoi.uiRow2 ) { cRoi.uiRow2++; }
+				if ( cRoi.uiCol1 == cRoi.uiCol2 ) { cRoi.uiCol2++; }
+			}
+
+			return vRois;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  roiStats                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the statistics for a list of regions of a view in a single pass. Each view row is read once  |
+		// |  and the part of it covered by each region is summed while the row is still in cache. Every band of      |
+		// |  rows keeps its own accumulators, which are combined at the end. Masked pixels are skipped, and a region |
+		// |  with no unmasked pixels keeps all zero statistics.                                                      |
+		// |                                                                                                          |
+		// |  <IN> -> cView - The image view.                                                                         |
+		// |  <IN> -> vRois - The regions, as exclusive ranges relative to the view ( see verifyRois() ).             |
+		// |  <IN> -> pMask - Pointer to a cView.cols() x cView.rows() mask, or nullptr.                              |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::image::CStats[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CStats>>
+		CArcImage<T>::roiStats( const arc::gen3::CArcImageView<const T>& cView, const std::vector<arc::gen3::image::CRoi>& vRois, const std::uint8_t* pMask )
+		{
+			auto uiRoiCount = static_cast< std::uint32_t >( vRois.size() );
+
+			std::uint32_t uiFirstRow = cView.rows();
+			std::uint32_t uiLastRow = 0;
+
+			for ( const auto& cRoi : vRois )
+			{
+				uiFirstRow = std::min( uiFirstRow, cRoi.uiRow1 );
+				uiLastRow = std::max( uiLastRow, cRoi.uiRow2 );
+			}
+
+			// The squares of 16-bit pixels sum exactly in 64-bits; 32-bit pixels use a double
+			using sqrSum_t = std::conditional_t<( sizeof( T ) == sizeof( arc::gen3::image::BPP_16 ) ), std::uint64_t, double>;
+
+			double gSaturated = static_cast< double >( maxTVal() - 1 );
+
+			auto uiBands = bandCount( cView.cols(), ( uiLastRow - uiFirstRow ) );
+
+			std::vector<roiAccum_t> vAccum( static_cast< std::size_t >( uiBands ) * uiRoiCount );
+
+			forEachRowBand( uiFirstRow, uiLastRow, uiBands, [ & ]( std::uint32_t uiBandRow1, std::uint32_t uiBandRow2, std::uint32_t uiBand )
+			{
+				roiAccum_t* pAccum = ( vAccum.data() + static_cast< std::size_t >( uiBand ) * uiRoiCount );
+
+				for ( auto row = uiBandRow1; row < uiBandRow2; row++ )
+				{
+					const T* pRow = cView.row( row );
+
+					const std::uint8_t* pMaskRow = ( ( pMask != nullptr ) ? ( pMask + static_cast< std::size_t >( row ) * cView.cols() ) : nullptr );
+
+					for ( std::uint32_t r = 0; r < uiRoiCount; r++ )
+					{
+						const auto& cRoi = vRois[ r ];
+
+						if ( row < cRoi.uiRow1 || row >= cRoi.uiRow2 )
+						{
+							continue;
+						}
+
+						std::uint64_t u64Sum = 0;
+						sqrSum_t tSqrSum = 0;
+						T tMin = std::numeric_limits<T>::max();
+						T tMax = 0;
+						std::uint64_t u64Saturated = 0;
+						std::uint64_t u64Count = 0;
+
+						for ( auto col = cRoi.uiCol1; col < cRoi.uiCol2; col++ )
+						{
+							if ( pMaskRow != nullptr && pMaskRow[ col ] != 0 )
+							{
+								continue;
+							}
+
+							T tVal = pRow[ col ];
+
+							u64Sum += tVal;
+							tSqrSum += static_cast< sqrSum_t >( tVal ) * tVal;
+							tMin = std::min( tMin, tVal );
+							tMax = std::max( tMax, tVal );
+							u64Saturated += ( ( tVal >= gSaturated ) ? 1 : 0 );
+							u64Count++;
+						}
+
+						if ( u64Count == 0 )
+						{
+							continue;
+						}
+
+						double gCount = static_cast< double >( u64Count );
+						double gMean = ( static_cast< double >( u64Sum ) / gCount );
+
+						pAccum[ r ].merge( gCount, gMean, std::max( static_cast< double >( tSqrSum ) - static_cast< double >( u64Sum ) * gMean, 0.0 ) );
+
+						pAccum[ r ].gMin = std::min( pAccum[ r ].gMin, static_cast< double >( tMin ) );
+						pAccum[ r ].gMax = std::max( pAccum[ r ].gMax, static_cast< double >( tMax ) );
+						pAccum[ r ].gSaturatedCount += static_cast< double >( u64Saturated );
+					}
+				}
+			} );
+
+			std::unique_ptr<arc::gen3::image::CStats[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CStats>>
+			pStats( new arc::gen3::image::CStats[ uiRoiCount ], arc::gen3::image::ArrayDeleter<arc::gen3::image::CStats>() );
+
+			if ( pStats == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate stats data buffer!"s );
+			}
+
+			for ( std::uint32_t r = 0; r < uiRoiCount; r++ )
+			{
+				roiAccum_t cTotal;
+
+				for ( std::uint32_t uiBand = 0; uiBand < uiBands; uiBand++ )
+				{
+					cTotal.merge( vAccum[ static_cast< std::size_t >( uiBand ) * uiRoiCount + r ] );
+				}
+
+				if ( cTotal.gCount == 0.0 )
+				{
+					continue;
+				}
+
+				auto& cStats = pStats.get()[ r ];
+
+				cStats.gTotalPixels = cTotal.gCount;
+				cStats.gMin = cTotal.gMin;
+				cStats.gMax = cTotal.gMax;
+				cStats.gMean = cTotal.gMean;
+				cStats.gVariance = ( cTotal.gM2 / cTotal.gCount );
+				cStats.gStdDev = std::sqrt( cStats.gVariance );
+				cStats.gSaturatedCount = cTotal.gSaturatedCount;
+			}
+
+			return pStats;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getDiffStats                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the min, max, mean, variance, standard deviation, total pixel count and saturated pixel      |
+		// |  count for each image as well as the difference mean, variance and standard deviation over the specified |
+		// |  image buffer cols and rows. This is used for photon transfer curves( PTC ).The two images MUST be the   |
+		// |  same size or the methods behavior is undefined as this cannot be verified using the given parameters.   |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
+		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
+		// |  <IN> -> uiCol1 - The start column.                                                                      |
+		// |  <IN> -> uiCol2 - The end column.                                                                        |
+		// |  <IN> -> uiRow1 - The start row.                                                                         |
+		// |  <IN> -> uiRow2 - The end row.                                                                           |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::image::CDifStats>
+		CArcImage<T>::getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			double gSum		= 0.0;
+			double gDifSum	= 0.0;
+			double gVal1	= 0.0;
+			double gVal2	= 0.0;
+
+			std::remove_const_t<decltype( uiRow2 )> uiLocalRow2 = uiRow2;
+			std::remove_const_t<decltype( uiCol2 )> uiLocalCol2 = uiCol2;
+
+			verifyRow( uiRow1, uiRows );
+
+			verifyRow( uiRow2, uiRows );
+
+			verifyColumn( uiCol1, uiCols );
+
+			verifyColumn( uiCol2, uiCols );
+
+			verifyRangeOrder( uiCol1, uiCol2 );
+
+			verifyRangeOrder( uiRow1, uiRow2 );
+
+			verifyBuffer( pBuf1 );
+
+			verifyBuffer( pBuf2 );
+
+			if ( uiRow1 == uiRow2 ) { uiLocalRow2++; }
+			if ( uiCol1 == uiCol2 ) { uiLocalCol2++; }
+
+			double gTotalPixelCount = ( static_cast< double >( uiLocalRow2 - uiRow1 ) * static_cast<double>( uiLocalCol2 - uiCol1 ) );
+
+			std::unique_ptr<arc::gen3::image::CDifStats> pDifStats( new arc::gen3::image::CDifStats() );
+
+			pDifStats->cStats1.set( *getStats( pBuf1, uiCol1, uiLocalCol2, uiRow1, uiLocalRow2, uiCols, uiRows ).get() );
+
+			pDifStats->cStats2.set( *getStats( pBuf2, uiCol1, uiLocalCol2, uiRow1, uiLocalRow2, uiCols, uiRows ).get() );
+
+			for ( std::uint32_t i = uiRow1; i < uiLocalRow2; i++ )
+			{
+				for ( std::uint32_t j = uiCol1; j < uiLocalCol2; j++ )
+				{
+					gVal1 = static_cast< double >( pBuf1[ pixelCount( uiCols, i ) + j ] );
+
+					gVal2 = static_cast< double >( pBuf2[ pixelCount( uiCols, i ) + j ] );
+
+					gSum += ( gVal1 - gVal2 );
+
+					gDifSum += ( std::pow( ( pDifStats->cStats2.gMean - gVal2 ) - ( pDifStats->cStats1.gMean - gVal1 ), 2 ) );
+				}
+			}
+
+			pDifStats->cDiffStats.gMean = std::fabs( gSum / gTotalPixelCount );
+			pDifStats->cDiffStats.gVariance = gDifSum / gTotalPixelCount;
+			pDifStats->cDiffStats.gStdDev = std::sqrt( pDifStats->cDiffStats.gVariance );
+
+			return pDifStats;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getDiffStats                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the min, max, mean, variance, standard deviation, total pixel count and saturated pixel      |
+		// |  count for each image as well as the difference mean, variance and standard deviation over the entire    |
+		// |  image buffer. This is used for photon transfer curves( PTC ).The two images MUST be the same size or    |
+		// |  the methods behavior is undefined as this cannot be verified using the given parameters.                |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
+		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::image::CDifStats>
+		CArcImage<T>::getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			return getDiffStats( pBuf1, pBuf2, 0, uiCols, 0, uiRows, uiCols, uiRows );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  ptc                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Reduces a photon transfer curve ( PTC ) sequence held in memory. The bias pair is measured first, then  |
+		// |  the flat pairs are spread over the available cores. See ptcFit() for the reduction.                     |
+		// |                                                                                                          |
+		// |  <IN> -> pBias1	 - Pointer to the first bias image.                                                   |
+		// |  <IN> -> pBias2	 - Pointer to the second bias image.                                                  |
+		// |  <IN> -> pFlats	 - Pointer to 2 x uiPairCount flat image pointers. Pair n is pFlats[ 2n ], [ 2n + 1 ].|
+		// |  <IN> -> uiPairCount - The number of flat pairs.                                                         |
+		// |  <IN> -> pAmps	     - Pointer to the amplifier regions, or nullptr for the whole image.                   |
+		// |  <IN> -> uiAmpCount  - The number of amplifier regions.                                                  |
+		// |  <IN> -> uiCols	 - The image column size ( in pixels ).                                               |
+		// |  <IN> -> uiRows	 - The image row size ( in pixels ).                                                  |
+		// |  <IN> -> gMaxSaturated - The saturated pixel fraction above which a pair is left out of the fit.         |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::image::CPtc[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CPtc>>
+		CArcImage<T>::ptc( const T* pBias1, const T* pBias2, const T* const* pFlats, const std::uint32_t uiPairCount, const arc::gen3::image::CRoi* pAmps,
+						   const std::uint32_t uiAmpCount, const std::uint32_t uiCols, const std::uint32_t uiRows, const double gMaxSaturated )
+		{
+			verifySaturatedFraction( gMaxSaturated );
+
+			verifyBuffer( pBias1 );
+
+			verifyBuffer( pBias2 );
+
+			if ( pFlats == nullptr || uiPairCount == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid flat pair list! Must contain at least one pair!"s );
+			}
+
+			for ( std::uint32_t i = 0; i < ( 2 * uiPairCount ); i++ )
+			{
+				verifyBuffer( pFlats[ i ] );
+			}
+
+			auto vAmps = ptcAmps( pAmps, uiAmpCount, uiCols, uiRows );
+
+			std::vector<arc::gen3::image::CPtcPoint> vBias( vAmps.size() );
+
+			std::vector<arc::gen3::image::CPtcPoint> vFlats( vAmps.size() * uiPairCount );
+
+			ptcPair( pBias1, pBias2, vAmps, uiCols, uiRows, gMaxSaturated, vBias.data() );
+
+			forEachIndex( uiPairCount, [ & ]( std::uint32_t uiPair )
+			{
+				ptcPair( pFlats[ 2 * uiPair ], pFlats[ 2 * uiPair + 1 ], vAmps, uiCols, uiRows, gMaxSaturated, ( vFlats.data() + uiPair * vAmps.size() ) );
+			} );
+
+			return ptcFit( vBias, vFlats );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  ptc                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Reduces a photon transfer curve ( PTC ) sequence stored in files. Each worker thread reads one flat     |
+		// |  pair at a time through the supplied loader and reduces it, so memory use is bounded by the core count   |
+		// |  rather than the length of the sequence.                                                                 |
+		// |                                                                                                          |
+		// |  <IN> -> sBias1	 - The first bias image file.                                                         |
+		// |  <IN> -> sBias2	 - The second bias image file.                                                        |
+		// |  <IN> -> vFlats	 - The flat image files. Pair n is vFlats[ 2n ] and vFlats[ 2n + 1 ].                 |
+		// |  <IN> -> pAmps	     - Pointer to the amplifier regions, or nullptr for the whole image.                   |
+		// |  <IN> -> uiAmpCount  - The number of amplifier regions.                                                  |
+		// |  <IN> -> uiCols	 - The image column size ( in pixels ).                                               |
+		// |  <IN> -> uiRows	 - The image row size ( in pixels ).                                                  |
+		// |  <IN> -> fnLoad	 - Function called as fnLoad( file, buffer, cols, rows ) to read one image.           |
+		// |  <IN> -> gMaxSaturated - The saturated pixel fraction above which a pair is left out of the fit.         |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::image::CPtc[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CPtc>>
+		CArcImage<T>::ptc( const std::string& sBias1, const std::string& sBias2, const std::vector<std::string>& vFlats, const arc::gen3::image::CRoi* pAmps,
+						   const std::uint32_t uiAmpCount, const std::uint32_t uiCols, const std::uint32_t uiRows,
+						   const std::function<void( const std::string&, T*, std::uint32_t, std::uint32_t )>& fnLoad, const double gMaxSaturated )
+		{
+			if ( !fnLoad )
+			{
+				throwArcGen3InvalidArgument( "Invalid image loader ( empty function )!"s );
+			}
+
+			verifySaturatedFraction( gMaxSaturated );
+
+			if ( vFlats.empty() || ( vFlats.size() % 2 ) != 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid flat file list! Must contain a non-zero, even number of files, not %u!", static_cast< std::uint32_t >( vFlats.size() ) );
+			}
+
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			auto vAmps = ptcAmps( pAmps, uiAmpCount, uiCols, uiRows );
+
+			auto uiPairCount = static_cast< std::uint32_t >( vFlats.size() / 2 );
+
+			std::size_t uiPixels = ( static_cast< std::size_t >( uiCols ) * uiRows );
+
+			std::vector<arc::gen3::image::CPtcPoint> vBiasPoints( vAmps.size() );
+
+			std::vector<arc::gen3::image::CPtcPoint> vFlatPoints( vAmps.size() * uiPairCount );
+
+			//
+			// Each pair is loaded into its own buffers, so the bias pair can share the flat pair code path
+			//
+			auto fnPair = [ & ]( const std::string& sFile1, const std::string& sFile2, arc::gen3::image::CPtcPoint* pPoints )
+			{
+				std::unique_ptr<T[]> pBuf1( new T[ uiPixels ] );
+				std::unique_ptr<T[]> pBuf2( new T[ uiPixels ] );
+
+				fnLoad( sFile1, pBuf1.get(), uiCols, uiRows );
+
+				fnLoad( sFile2, pBuf2.get(), uiCols, uiRows );
+
+				ptcPair( pBuf1.get(), pBuf2.get(), vAmps, uiCols, uiRows, gMaxSaturated, pPoints );
+			};
+
+			fnPair( sBias1, sBias2, vBiasPoints.data() );
+
+			forEachIndex( uiPairCount, [ & ]( std::uint32_t uiPair )
+			{
+				fnPair( vFlats[ 2 * uiPair ], vFlats[ 2 * uiPair + 1 ], ( vFlatPoints.data() + uiPair * vAmps.size() ) );
+			} );
+
+			return ptcFit( vBiasPoints, vFlatPoints );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  ptcAmps                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the amplifier regions for a PTC reduction as exclusive ranges. A nullptr list returns a single  |
+		// |  region covering the whole image.                                                                        |
+		// |                                                                                                          |
+		// |  <IN> -> pAmps	     - Pointer to the amplifier regions, or nullptr.                                       |
+		// |  <IN> -> uiAmpCount  - The number of amplifier regions.                                                  |
+		// |  <IN> -> uiCols	 - The image column size ( in pixels ).                                               |
+		// |  <IN> -> uiRows	 - The image row size ( in pixels ).                                                  |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::vector<arc::gen3::image::CRoi>
+		CArcImage<T>::ptcAmps( const arc::gen3::image::CRoi* pAmps, const std::uint32_t uiAmpCount, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			if ( pAmps == nullptr )
+			{
+				verifyColumns( uiCols );
+
+				verifyRows( uiRows );
+
+				return { arc::gen3::image::CRoi( 0, uiCols, 0, uiRows ) };
+			}
+
+			return verifyRois( pAmps, uiAmpCount, uiCols, uiRows );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  verifySaturatedFraction                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Verifies that a PTC saturated pixel fraction is within 0 - 1. Throws exception on error.                |
+		// |                                                                                                          |
+		// |  <IN> -> gMaxSaturated - The saturated pixel fraction.                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::verifySaturatedFraction( const double gMaxSaturated )
+		{
+			if ( !( gMaxSaturated >= 0.0 && gMaxSaturated <= 1.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid saturated pixel fraction [ %f ]! Must be within 0 - 1!", gMaxSaturated );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  ptcPair                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the pair mean and difference variance of two images over each amplifier in a single pass.    |
+		// |  The difference is accumulated as a signed integer; its squares are summed exactly in 64-bits for 16-bit |
+		// |  pixels and in a double for 32-bit pixels.                                                               |
+		// |                                                                                                          |
+		// |  Pixel positions that are saturated in either image are counted and left out of the sums, so a few hot   |
+		// |  pixels do not bias the point. The point is only marked saturated once the saturated fraction of the     |
+		// |  amplifier is over gMaxSaturated.                                                                        |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf1   - Pointer to the first image.                                                          |
+		// |  <IN>  -> pBuf2   - Pointer to the second image.                                                         |
+		// |  <IN>  -> vAmps   - The amplifier regions, as exclusive ranges.                                          |
+		// |  <IN>  -> uiCols  - The image column size ( in pixels ).                                                 |
+		// |  <IN>  -> uiRows  - The image row size ( in pixels ).                                                    |
+		// |  <IN>  -> gMaxSaturated - The saturated pixel fraction above which the point is marked saturated.        |
+		// |  <OUT> -> pPoints - Pointer to vAmps.size() points that receive the results.                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::ptcPair( const T* pBuf1, const T* pBuf2, const std::vector<arc::gen3::image::CRoi>& vAmps, const std::uint32_t uiCols, const std::uint32_t uiRows,
+									const double gMaxSaturated, arc::gen3::image::CPtcPoint* pPoints )
+		{
+			using sqrSum_t = std::conditional_t<( sizeof( T ) == sizeof( arc::gen3::image::BPP_16 ) ), std::uint64_t, double>;
+
+			const T tSaturated = static_cast< T >( maxTVal() - 1 );
+
+			arc::gen3::CArcImageView<const T> cView1( pBuf1, uiCols, uiRows );
+			arc::gen3::CArcImageView<const T> cView2( pBuf2, uiCols, uiRows );
+
+			for ( std::size_t a = 0; a < vAmps.size(); a++ )
+			{
+				const auto& cAmp = vAmps[ a ];
+
+				std::uint64_t u64Sum = 0;
+				std::int64_t i64DiffSum = 0;
+				sqrSum_t tDiffSqrSum = 0;
+				std::uint64_t u64SaturatedCount = 0;
+
+				for ( auto row = cAmp.uiRow1; row < cAmp.uiRow2; row++ )
+				{
+					const T* pRow1 = cView1.row( row );
+					const T* pRow2 = cView2.row( row );
+
+					for ( auto col = cAmp.uiCol1; col < cAmp.uiCol2; col++ )
+					{
+						if ( pRow1[ col ] >= tSaturated || pRow2[ col ] >= tSaturated )
+						{
+							u64SaturatedCount++;
+
+							continue;
+						}
+
+						auto i64Diff = ( static_cast< std::int64_t >( pRow1[ col ] ) - static_cast< std::int64_t >( pRow2[ col ] ) );
+
+						u64Sum += ( static_cast< std::uint64_t >( pRow1[ col ] ) + pRow2[ col ] );
+						i64DiffSum += i64Diff;
+						tDiffSqrSum += static_cast< sqrSum_t >( i64Diff ) * i64Diff;
+					}
+				}
+
+				auto u64Pixels = ( static_cast< std::uint64_t >( cAmp.uiCol2 - cAmp.uiCol1 ) * ( cAmp.uiRow2 - cAmp.uiRow1 ) );
+
+				pPoints[ a ] = arc::gen3::image::CPtcPoint();
+
+				pPoints[ a ].u64SaturatedCount = u64SaturatedCount;
+				pPoints[ a ].bSaturated = ( static_cast< double >( u64SaturatedCount ) > ( gMaxSaturated * static_cast< double >( u64Pixels ) ) );
+
+				//
+				// A fully saturated amplifier has nothing left to measure
+				//
+				if ( u64SaturatedCount < u64Pixels )
+				{
+					double gCount = static_cast< double >( u64Pixels - u64SaturatedCount );
+					double gDiffMean = ( static_cast< double >( i64DiffSum ) / gCount );
+
+					pPoints[ a ].gMean = ( static_cast< double >( u64Sum ) / ( 2.0 * gCount ) );
+					pPoints[ a ].gDiffVariance = std::max( ( static_cast< double >( tDiffSqrSum ) / gCount ) - ( gDiffMean * gDiffMean ), 0.0 );
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  ptcFit                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Finishes a PTC reduction for each amplifier. The bias pair gives the bias level and the read noise      |
+		// |  ( the difference variance is twice the single image variance ). Each flat point is bias subtracted and  |
+		// |  its shot noise variance found by removing the read noise variance. The unsaturated points with a        |
+		// |  positive signal are then fitted with a straight line, variance = mean / gain + intercept.               |
+		// |                                                                                                          |
+		// |  <IN> -> vBias  - The bias pair point of each amplifier.                                                 |
+		// |  <IN> -> vFlats - The flat pair points, stored pair by pair with one point per amplifier.                |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::image::CPtc[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CPtc>>
+		CArcImage<T>::ptcFit( const std::vector<arc::gen3::image::CPtcPoint>& vBias, const std::vector<arc::gen3::image::CPtcPoint>& vFlats )
+		{
+			auto uiAmpCount = vBias.size();
+			auto uiPairCount = ( vFlats.size() / uiAmpCount );
+
+			std::unique_ptr<arc::gen3::image::CPtc[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CPtc>>
+			pPtc( new arc::gen3::image::CPtc[ uiAmpCount ], arc::gen3::image::ArrayDeleter<arc::gen3::image::CPtc>() );
+
+			if ( pPtc == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate PTC data buffer!"s );
+			}
+
+			for ( std::size_t a = 0; a < uiAmpCount; a++ )
+			{
+				auto& cPtc = pPtc.get()[ a ];
+
+				double gReadVariance = ( vBias[ a ].gDiffVariance / 2.0 );
+
+				cPtc.gBiasMean = vBias[ a ].gMean;
+				cPtc.gReadNoiseDN = std::sqrt( gReadVariance );
+
+				cPtc.vPoints.reserve( uiPairCount );
+
+				std::uint32_t uiN = 0;
+
+				double gSumX = 0.0, gSumY = 0.0, gSumXX = 0.0, gSumXY = 0.0;
+
+				for ( std::size_t p = 0; p < uiPairCount; p++ )
+				{
+					auto cPoint = vFlats[ p * uiAmpCount + a ];
+
+					cPoint.gMean -= cPtc.gBiasMean;
+					cPoint.gSignalVariance = ( ( cPoint.gDiffVariance / 2.0 ) - gReadVariance );
+					cPoint.gGain = ( ( cPoint.gSignalVariance > 0.0 ) ? ( cPoint.gMean / cPoint.gSignalVariance ) : 0.0 );
+
+					if ( !cPoint.bSaturated && cPoint.gMean > 0.0 )
+					{
+						double gY = ( cPoint.gDiffVariance / 2.0 );
+
+						uiN++;
+						gSumX += cPoint.gMean;
+						gSumY += gY;
+						gSumXX += ( cPoint.gMean * cPoint.gMean );
+						gSumXY += ( cPoint.gMean * gY );
+					}
+
+					cPtc.vPoints.push_back( cPoint );
+				}
+
+				cPtc.uiFitPoints = uiN;
+
+				double gN = static_cast< double >( uiN );
+				double gDenom = ( gN * gSumXX - gSumX * gSumX );
+
+				if ( uiN >= 2 && gDenom > 0.0 )
+				{
+					cPtc.gSlope = ( ( gN * gSumXY - gSumX * gSumY ) / gDenom );
+					cPtc.gIntercept = ( ( gSumY - cPtc.gSlope * gSumX ) / gN );
+
+					if ( cPtc.gSlope > 0.0 )
+					{
+						cPtc.gGain = ( 1.0 / cPtc.gSlope );
+						cPtc.gReadNoise = ( cPtc.gReadNoiseDN * cPtc.gGain );
+					}
+				}
+			}
+
+			return pPtc;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  histogram                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the histogram over the specified image buffer columns and rows.                              |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf		- Pointer to the image buffer.                                                        |
+		// |  <IN> -> uiCol1	- The start column.                                                                   |
+		// |  <IN> -> uiCol2	- The end column.                                                                     |
+		// |  <IN> -> uiRow1	- The start row.                                                                      |
+		// |  <IN> -> uiRow2	- The end row.                                                                        |
+		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiCount	- The element count of the returned array. The size of the array depends on the       |
+		// |                      image data type.                                                                    |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
+		CArcImage<T>::histogram( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1,
+								 const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount )
+		{
+			std::remove_const_t<decltype( uiRow2 )> uiLocalRow2 = uiRow2;
+			std::remove_const_t<decltype( uiCol2 )> uiLocalCol2 = uiCol2;
+
+			verifyRow( uiRow1, uiRows );
+
+			verifyRow( uiRow2, uiRows );
+
+			verifyColumn( uiCol1, uiCols );
+
+			verifyColumn( uiCol2, uiCols );
+
+			verifyRangeOrder( uiCol1, uiCol2 );
+
+			verifyRangeOrder( uiRow1, uiRow2 );
+
+			verifyBuffer( pBuf );
+
+			std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
+			pHist( new std::uint32_t[ maxTVal() ], arc::gen3::image::ArrayDeleter<std::uint32_t>() );
+
+			if ( pHist == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate histogram data buffer!"s );
+			}
+
+			uiCount = maxTVal();
+
+			zeroMemory( pHist.get(), uiCount * sizeof( std::uint32_t ) );
+
+			if ( uiRow1 == uiRow2 ) { uiLocalRow2++; }
+			if ( uiCol1 == uiCol2 ) { uiLocalCol2++; }
+
+			for ( std::uint32_t i = uiRow1; i < uiLocalRow2; i++ )
+			{
+				for ( std::uint32_t j = uiCol1; j < uiLocalCol2; j++ )
+				{
+					pHist.get()[ pBuf[ pixelCount( uiCols, i ) + j ] ]++;
+				}
+			}
+			
+			return pHist;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  histogram                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the histogram over the entire image buffer.                                                  |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf		- Pointer to the image buffer.                                                        |
+		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiCount	- The element count of the returned array. The size of the array depends on the       |
+		// |                      image data type.                                                                    |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
+		CArcImage<T>::histogram( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount )
+		{
+			return histogram( pBuf, 0, uiCols, 0, uiRows, uiCols, uiRows, uiCount );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  add                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Adds two image buffers together pixel by pixel. The result is a pointer to a 64-bit buffer.             |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
+		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<std::uint64_t[], arc::gen3::image::ArrayDeleter<std::uint64_t>>
+		CArcImage<T>::add( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyBuffer( pBuf1 );
+	
+			verifyBuffer( pBuf2 );
+
+			std::size_t uiLength = pixelCount( uiCols, uiRows );
+
+			std::unique_ptr< std::uint64_t[], arc::gen3::image::ArrayDeleter< std::uint64_t > > pAdd( new std::uint64_t[ uiLength ], arc::gen3::image::ArrayDeleter< std::uint64_t >() );
+
+			if ( pAdd == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate addition data buffer!"s );
+			}
+
+			const T* arcGen3Restrict pIn1 = pBuf1;
+			const T* arcGen3Restrict pIn2 = pBuf2;
+			std::uint64_t* arcGen3Restrict pOut = pAdd.get();
+
+			for ( std::size_t i = 0; i < uiLength; i++ )
+			{
+				pOut[ i ] = static_cast< std::uint64_t >( pIn1[ i ] ) + static_cast< std::uint64_t >( pIn2[ i ] );
+			}
+
+			return pAdd;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtract                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Subtracts two image buffers pixel by pixel. The result is a pointer to a buffer with the same data      |
+		// |  type as the two images being subtracted. Buffer two is subtracted from buffer one.                      |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
+		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
+		CArcImage<T>::subtract( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyBuffer( pBuf1 );
+	
+			verifyBuffer( pBuf2 );
+
+			std::size_t uiLength = pixelCount( uiCols, uiRows );
+
+			std::unique_ptr< T[], arc::gen3::image::ArrayDeleter< T > > pSub( new T[ uiLength ], arc::gen3::image::ArrayDeleter< T >() );
+
+			if ( pSub == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate subtraction data buffer!"s );
+			}
+
+			const T* arcGen3Restrict pIn1 = pBuf1;
+			const T* arcGen3Restrict pIn2 = pBuf2;
+			T* arcGen3Restrict pOut = pSub.get();
+
+			for ( std::size_t i = 0; i < uiLength; i++ )
+			{
+				pOut[ i ] = static_cast< T >( pIn1[ i ] - pIn2[ i ] );
+			}
+
+			return pSub;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtractHalves                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Subtracts one half of an image from the other. The first half of the image buffer is replaced with      |
+		// |  the new image. Large images are split into bands of rows on separate threads.                           |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	 - Pointer to the image buffer. Result is placed in this buffer.                          |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::subtractHalves( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyBuffer( pBuf );
+
+			if ( ( uiRows % 2 ) != 0 )
+			{
+				throwArcGen3InvalidArgument( "Image must have an even number of rows [ %u ]", uiRows );
+			}
+
+			auto uiHalfRows = ( uiRows / 2 );
+
+			std::size_t uiHalfLength = pixelCount( uiCols, uiHalfRows );
+
+			forEachRowBand( 0, uiHalfRows, bandCount( uiCols, uiRows ), [ & ]( std::uint32_t uiBandRow1, std::uint32_t uiBandRow2, std::uint32_t )
+			{
+				std::size_t uiStart = pixelCount( uiCols, uiBandRow1 );
+				std::size_t uiLength = pixelCount( uiCols, ( uiBandRow2 - uiBandRow1 ) );
+
+				T* arcGen3Restrict pBuf1 = ( pBuf + uiStart );
+
+				const T* arcGen3Restrict pBuf2 = ( pBuf + uiHalfLength + uiStart );
+
+				for ( std::size_t i = 0; i < uiLength; i++ )
+				{
+					pBuf1[ i ] = static_cast< T >( pBuf1[ i ] - pBuf2[ i ] );
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtractHalves                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Correlated double sampling. Subtracts the second half of an image from the first into a signed 32-bit   |
+		// |  buffer. For multiple read ( Fowler ) sampling the first half holds uiReads reset reads and the second   |
+		// |  half uiReads signal reads; each output pixel is the mean of its reset reads minus the mean of its       |
+		// |  signal reads, rounded to the nearest integer.                                                           |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf    - Pointer to the image buffer.                                                         |
+		// |  <IN>  -> uiCols  - The image column size ( in pixels ).                                                 |
+		// |  <IN>  -> uiRows  - The image row size ( in pixels ). Must be a multiple of 2 x uiReads.                 |
+		// |  <OUT> -> pDstBuf - Pointer to a uiCols x ( uiRows / ( 2 x uiReads ) ) buffer that receives the result.  |
+		// |  <IN>  -> uiReads - The number of reads per half.                                                        |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::subtractHalves( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, std::int32_t* pDstBuf, const std::uint32_t uiReads )
+		{
+			verifyBuffer( pBuf );
+
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			cds( arc::gen3::CArcImageView<const T>( pBuf, uiCols, uiRows ), pDstBuf, uiReads );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtractHalves                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Single precision version of the correlated double sampling subtractHalves. See above. The result is     |
+		// |  not rounded.                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::subtractHalves( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, float* pDstBuf, const std::uint32_t uiReads )
+		{
+			verifyBuffer( pBuf );
+
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			cds( arc::gen3::CArcImageView<const T>( pBuf, uiCols, uiRows ), pDstBuf, uiReads );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  cds                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Correlated double sampling kernel. The output is split into bands of rows on separate threads. A single |
+		// |  read pair is differenced straight into the output in 32-bit modular arithmetic, which is exact for any  |
+		// |  difference that fits in an std::int32_t and lets the compiler vectorize the loop. Multiple reads are    |
+		// |  differenced into a 64-bit row accumulator, one read at a time, before being scaled into the output.     |
+		// |  The input rows are taken from the view, so a strided view is read in place.                             |
+		// |                                                                                                          |
+		// |  <IN>  -> cView   - The image view.                                                                      |
+		// |  <OUT> -> pDstBuf - Pointer to the contiguous buffer that receives the result.                           |
+		// |  <IN>  -> uiReads - The number of reads per half.                                                        |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> template <typename U>
+		void CArcImage<T>::cds( const arc::gen3::CArcImageView<const T>& cView, U* pDstBuf, const std::uint32_t uiReads )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( pDstBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid destination buffer ( nullptr )!"s );
+			}
+
+			if ( uiReads == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid read count [ %u ]! Must be greater than zero!", uiReads );
+			}
+
+			auto uiCols = cView.cols();
+			auto uiRows = cView.rows();
+
+			if ( ( uiRows % ( 2 * static_cast< std::uint64_t >( uiReads ) ) ) != 0 )
+			{
+				throwArcGen3InvalidArgument( "Image rows [ %u ] must be a multiple of twice the read count [ %u ]!", uiRows, uiReads );
+			}
+
+			auto uiFrameRows = static_cast< std::uint32_t >( uiRows / ( 2 * static_cast< std::uint64_t >( uiReads ) ) );
+
+			auto uiHalfRows = ( uiFrameRows * uiReads );
+
+			forEachRowBand( 0, uiFrameRows, bandCount( uiCols, uiRows ), [ & ]( std::uint32_t uiBandRow1, std::uint32_t uiBandRow2, std::uint32_t )
+			{
+				std::vector<std::int64_t> vSum( ( uiReads > 1 ) ? uiCols : 0 );
+
+				for ( auto row = uiBandRow1; row < uiBandRow2; row++ )
+				{
+					U* arcGen3Restrict pOut = ( pDstBuf + pixelCount( uiCols, row ) );
+
+					if ( uiReads == 1 )
+					{
+						const T* arcGen3Restrict pReset = cView.row( row );
+						const T* arcGen3Restrict pSignal = cView.row( uiHalfRows + row );
+
+						for ( std::size_t col = 0; col < uiCols; col++ )
+						{
+							auto iDiff = static_cast< std::int32_t >( static_cast< std::uint32_t >( pReset[ col ] ) - static_cast< std::uint32_t >( pSignal[ col ] ) );
+
+							pOut[ col ] = static_cast< U >( iDiff );
+						}
+
+						continue;
+					}
+
+					std::int64_t* arcGen3Restrict pSum = vSum.data();
+
+					std::fill( vSum.begin(), vSum.end(), 0 );
+
+					for ( std::uint32_t uiRead = 0; uiRead < uiReads; uiRead++ )
+					{
+						const T* arcGen3Restrict pReset = cView.row( ( uiRead * uiFrameRows ) + row );
+						const T* arcGen3Restrict pSignal = cView.row( uiHalfRows + ( uiRead * uiFrameRows ) + row );
+
+						for ( std::size_t col = 0; col < uiCols; col++ )
+						{
+							pSum[ col ] += ( static_cast< std::int64_t >( pReset[ col ] ) - static_cast< std::int64_t >( pSignal[ col ] ) );
+						}
+					}
+
+					if constexpr ( std::is_floating_point_v<U> )
+					{
+						const double gScale = ( 1.0 / static_cast< double >( uiReads ) );
+
+						for ( std::size_t col = 0; col < uiCols; col++ )
+						{
+							pOut[ col ] = static_cast< U >( static_cast< double >( pSum[ col ] ) * gScale );
+						}
+					}
+
+					else
+					{
+						const auto i64Reads = static_cast< std::int64_t >( uiReads );
+						const auto i64Half = ( i64Reads / 2 );
+
+						for ( std::size_t col = 0; col < uiCols; col++ )
+						{
+							auto i64Sum = pSum[ col ];
+
+							pOut[ col ] = static_cast< U >( ( i64Sum >= 0 ) ? ( ( i64Sum + i64Half ) / i64Reads ) : -( ( i64Half - i64Sum ) / i64Reads ) );
+						}
+					}
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  divide                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Divides two image buffers pixel by pixel.                                                               |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf1	 - Pointer to the first image buffer. Result is placed in this buffer.                    |
+		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
+		CArcImage<T>::divide( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyBuffer( pBuf1 );
+	
+			verifyBuffer( pBuf2 );
+
+			std::size_t uiLength = pixelCount( uiCols, uiRows );
+
+			std::unique_ptr< T[], arc::gen3::image::ArrayDeleter< T > > pDiv( new T[ uiLength ], arc::gen3::image::ArrayDeleter< T >() );
+
+			if ( pDiv == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate division data buffer!"s );
+			}
+
+			const T* arcGen3Restrict pIn1 = pBuf1;
+			const T* arcGen3Restrict pIn2 = pBuf2;
+			T* arcGen3Restrict pOut = pDiv.get();
+
+			for ( std::size_t i = 0; i < uiLength; i++ )
+			{
+				pOut[ i ] = ( ( pIn2[ i ] != 0 ) ? static_cast< T >( pIn1[ i ] / pIn2[ i ] ) : T( 0 ) );
+			}
+
+			return pDiv;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  copy                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Copies the source image buffer to the destination image buffer. The source buffer must be less than or  |
+		// |  equal in dimensions to the destination buffer.                                                          |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf - Pointer to the destination image buffer. Result is placed in this buffer.             |
+		// |  <IN> -> pSrcBuf - Pointer to the source image buffer.                                                   |
+		// |  <IN> -> uiCols  - The number of image columns to copy ( in pixels ).                                    |
+		// |  <IN> -> uiRows  - The number of image rows to copy ( in pixels ).                                       |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::copy( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyBuffer( pDstBuf );
+
+			verifyBuffer( pSrcBuf );
+
+			copyMemory( pDstBuf, const_cast< T* >( pSrcBuf ), ( pixelCount( uiCols, uiRows ) * sizeof( T ) ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  copy                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Copies the source image buffer to the destination image buffer. The source buffer must be less than or  |
+		// |  equal in dimensions to the destination buffer.                                                          |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf	- Pointer to the destination image buffer. Result is placed in this buffer.           |
+		// |  <IN> -> pSrcBuf	- Pointer to the source image buffer.                                                 |
+		// |  <IN> -> uiSize	- The number of image bytes to copy.                                                  |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::copy( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiSize )
+		{
+			verifyBuffer( pDstBuf );
+	
+			verifyBuffer( pSrcBuf );
+
+			copyMemory( pDstBuf, const_cast< T* >( pSrcBuf ), uiSize );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  rebin                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Software bins an image. Each uiColFactor x uiRowFactor block of pixels is summed or averaged into one   |
+		// |  output pixel. Partial blocks along the right and bottom edges are dropped. See the view version below.  |
+		// |                                                                                                          |
+		// |  <IN>  -> pSrcBuf	   - Pointer to the source image buffer.                                               |
+		// |  <IN>  -> uiCols	   - The source image column size ( in pixels ).                                       |
+		// |  <IN>  -> uiRows	   - The source image row size ( in pixels ).                                          |
+		// |  <IN>  -> uiColFactor - The number of columns per bin.                                                   |
+		// |  <IN>  -> uiRowFactor - The number of rows per bin.                                                      |
+		// |  <OUT> -> pDstBuf	   - Pointer to the destination buffer.                                                |
+		// |  <IN>  -> eMode	   - Sum or average the pixels in each bin.                                            |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::rebin( const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiColFactor, const std::uint32_t uiRowFactor,
+								  std::uint32_t* pDstBuf, const arc::gen3::image::e_Rebin eMode )
+		{
+			verifyBuffer( pSrcBuf );
+
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			rebin( arc::gen3::CArcImageView<const T>( pSrcBuf, uiCols, uiRows ), uiColFactor, uiRowFactor, pDstBuf, eMode );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  rebin                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Software bins an image into a new buffer. See above.                                                    |
+		// |                                                                                                          |
+		// |  <IN>  -> pSrcBuf	   - Pointer to the source image buffer.                                               |
+		// |  <IN>  -> uiCols	   - The source image column size ( in pixels ).                                       |
+		// |  <IN>  -> uiRows	   - The source image row size ( in pixels ).                                          |
+		// |  <IN>  -> uiColFactor - The number of columns per bin.                                                   |
+		// |  <IN>  -> uiRowFactor - The number of rows per bin.                                                      |
+		// |  <OUT> -> uiNewCols   - The column size of the returned image ( in pixels ).                             |
+		// |  <OUT> -> uiNewRows   - The row size of the returned image ( in pixels ).                                |
+		// |  <IN>  -> eMode	   - Sum or average the pixels in each bin.                                            |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
+		CArcImage<T>::rebin( const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiColFactor, const std::uint32_t uiRowFactor,
+							 std::uint32_t& uiNewCols, std::uint32_t& uiNewRows, const arc::gen3::image::e_Rebin eMode )
+		{
+			if ( uiColFactor == 0 || uiRowFactor == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid bin factor [ %u x %u ]! Cannot be zero!", uiColFactor, uiRowFactor );
+			}
+
+			uiNewCols = ( uiCols / uiColFactor );
+			uiNewRows = ( uiRows / uiRowFactor );
+
+			std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
+			pBinBuf( new std::uint32_t[ std::max<std::size_t>( static_cast< std::size_t >( uiNewCols ) * uiNewRows, 1 ) ], arc::gen3::image::ArrayDeleter<std::uint32_t>() );
+
+			if ( pBinBuf == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate rebin data buffer!"s );
+			}
+
+			rebin( pSrcBuf, uiCols, uiRows, uiColFactor, uiRowFactor, pBinBuf.get(), eMode );
+
+			return pBinBuf;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  rebinLine                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Reduces one line of column sums produced by rebin() to output pixels. A non-zero F is the compile-time  |
+		// |  column factor, which lets the compiler unroll the inner loop; zero uses uiColFactor.                    |
+		// |                                                                                                          |
+		// |  <IN>  -> pLine	   - Pointer to the column sums for one row of bins.                                   |
+		// |  <IN>  -> uiNewCols   - The number of output pixels.                                                     |
+		// |  <IN>  -> uiColFactor - The number of columns per bin.                                                   |
+		// |  <IN>  -> u64Divisor  - The value each bin sum is divided by ( one for a sum ).                          |
+		// |  <OUT> -> pDstBuf	   - Pointer to the output row.                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> template <std::uint32_t F>
+		void CArcImage<T>::rebinLine( const std::uint64_t* pLine, const std::uint32_t uiNewCols, const std::uint32_t uiColFactor, const std::uint64_t u64Divisor, std::uint32_t* pDstBuf )
+		{
+			const std::uint32_t uiFactor = ( ( F == 0 ) ? uiColFactor : F );
+
+			const std::uint64_t u64Half = ( u64Divisor / 2 );
+
+			constexpr std::uint64_t u64Max = std::numeric_limits<std::uint32_t>::max();
+
+			for ( std::size_t col = 0; col < uiNewCols; col++, pLine += uiFactor )
+			{
+				std::uint64_t u64Sum = 0;
+
+				for ( std::uint32_t k = 0; k < uiFactor; k++ )
+				{
+					u64Sum += pLine[ k ];
+				}
+
+				if ( u64Divisor > 1 )
+				{
+					u64Sum = ( ( u64Sum + u64Half ) / u64Divisor );
+				}
+
+				pDstBuf[ col ] = static_cast< std::uint32_t >( std::min( u64Sum, u64Max ) );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  fill                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills every pixel of an image view with a specific value. Only the pixels inside the view are written.  |
+		// |                                                                                                          |
+		// |  <IN> -> cView   - The image view.                                                                       |
+		// |  <IN> -> uiValue - The value to fill the view with.                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument, std::out_of_range on error.                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::fill( const arc::gen3::CArcImageView<T>& cView, const T uiValue )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( uiValue >= maxTVal() )
+			{
+				throwArcGen3OutOfRange( uiValue, std::make_pair( 0, ( maxTVal() - 1 ) ) );
+			}
+
+			for ( std::uint32_t row = 0; row < cView.rows(); row++ )
+			{
+				std::fill( cView.row( row ), ( cView.row( row ) + cView.cols() ), uiValue );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  copy                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Copies the source image view into the top-left corner of the destination image view, one row at a       |
+		// |  time. The source view must be less than or equal in dimensions to the destination view.                 |
+		// |                                                                                                          |
+		// |  <IN> -> cDstView - The destination image view. Result is placed in this view.                           |
+		// |  <IN> -> cSrcView - The source image view.                                                               |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::copy( const arc::gen3::CArcImageView<T>& cDstView, const arc::gen3::CArcImageView<const T>& cSrcView )
+		{
+			if ( cDstView.empty() || cSrcView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( cSrcView.cols() > cDstView.cols() || cSrcView.rows() > cDstView.rows() )
+			{
+				throwArcGen3InvalidArgument( "Source view [ %u x %u ] is larger than destination view [ %u x %u ]!",
+											 cSrcView.cols(), cSrcView.rows(), cDstView.cols(), cDstView.rows() );
+			}
+
+			std::size_t uiRowBytes = ( static_cast< std::size_t >( cSrcView.cols() ) * sizeof( T ) );
+
+			for ( std::uint32_t row = 0; row < cSrcView.rows(); row++ )
+			{
+				copyMemory( cDstView.row( row ), const_cast< T* >( cSrcView.row( row ) ), uiRowBytes );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  add                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Adds two image views together pixel by pixel, one row at a time. The result is a pointer to a           |
+		// |  contiguous 64-bit buffer the size of the views.                                                         |
+		// |                                                                                                          |
+		// |  <IN> -> cView1 - The first image view.                                                                  |
+		// |  <IN> -> cView2 - The second image view. Must be the same size as the first.                             |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<std::uint64_t[], arc::gen3::image::ArrayDeleter<std::uint64_t>>
+		CArcImage<T>::add( const arc::gen3::CArcImageView<const T>& cView1, const arc::gen3::CArcImageView<const T>& cView2 )
+		{
+			verifySameSize( cView1, cView2 );
+
+			std::unique_ptr< std::uint64_t[], arc::gen3::image::ArrayDeleter< std::uint64_t > > pAdd( new std::uint64_t[ cView1.size() ], arc::gen3::image::ArrayDeleter< std::uint64_t >() );
+
+			if ( pAdd == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate addition data buffer!"s );
+			}
+
+			for ( std::uint32_t row = 0; row < cView1.rows(); row++ )
+			{
+				const T* arcGen3Restrict pIn1 = cView1.row( row );
+				const T* arcGen3Restrict pIn2 = cView2.row( row );
+				std::uint64_t* arcGen3Restrict pOut = ( pAdd.get() + pixelCount( cView1.cols(), row ) );
+
+				for ( std::uint32_t col = 0; col < cView1.cols(); col++ )
+				{
+					pOut[ col ] = static_cast< std::uint64_t >( pIn1[ col ] ) + static_cast< std::uint64_t >( pIn2[ col ] );
+				}
+			}
+
+			return pAdd;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtract                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Subtracts two image views pixel by pixel, one row at a time. View two is subtracted from view one. The  |
+		// |  result is a pointer to a contiguous buffer the size of the views.                                       |
+		// |                                                                                                          |
+		// |  <IN> -> cView1 - The first image view.                                                                  |
+		// |  <IN> -> cView2 - The second image view. Must be the same size as the first.                             |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
+		CArcImage<T>::subtract( const arc::gen3::CArcImageView<const T>& cView1, const arc::gen3::CArcImageView<const T>& cView2 )
+		{
+			verifySameSize( cView1, cView2 );
+
+			std::unique_ptr< T[], arc::gen3::image::ArrayDeleter< T > > pSub( new T[ cView1.size() ], arc::gen3::image::ArrayDeleter< T >() );
+
+			if ( pSub == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate subtraction data buffer!"s );
+			}
+
+			for ( std::uint32_t row = 0; row < cView1.rows(); row++ )
+			{
+				const T* arcGen3Restrict pIn1 = cView1.row( row );
+				const T* arcGen3Restrict pIn2 = cView2.row( row );
+				T* arcGen3Restrict pOut = ( pSub.get() + pixelCount( cView1.cols(), row ) );
+
+				for ( std::uint32_t col = 0; col < cView1.cols(); col++ )
+				{
+					pOut[ col ] = static_cast< T >( pIn1[ col ] - pIn2[ col ] );
+				}
+			}
+
+			return pSub;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtractHalves                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Subtracts the bottom half of an image view from the top half in place. Large views are split into       |
+		// |  bands of rows on separate threads.                                                                      |
+		// |                                                                                                          |
+		// |  <IN> -> cView - The image view. Result is placed in the first half of the view.                         |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::subtractHalves( const arc::gen3::CArcImageView<T>& cView )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( ( cView.rows() % 2 ) != 0 )
+			{
+				throwArcGen3InvalidArgument( "Image view must have an even number of rows [ %u ]", cView.rows() );
+			}
+
+			auto uiHalfRows = ( cView.rows() / 2 );
+
+			forEachRowBand( 0, uiHalfRows, bandCount( cView.cols(), cView.rows() ), [ & ]( std::uint32_t uiBandRow1, std::uint32_t uiBandRow2, std::uint32_t )
+			{
+				for ( auto row = uiBandRow1; row < uiBandRow2; row++ )
+				{
+					T* arcGen3Restrict pBuf1 = cView.row( row );
+
+					const T* arcGen3Restrict pBuf2 = cView.row( uiHalfRows + row );
+
+					for ( std::uint32_t col = 0; col < cView.cols(); col++ )
+					{
+						pBuf1[ col ] = static_cast< T >( pBuf1[ col ] - pBuf2[ col ] );
+					}
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtractHalves                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Correlated double sampling of an image view into a signed 32-bit buffer. See the pointer version.       |
+		// |                                                                                                          |
+		// |  <IN>  -> cView   - The image view.                                                                      |
+		// |  <OUT> -> pDstBuf - Pointer to a contiguous cols x ( rows / ( 2 x uiReads ) ) buffer for the result.     |
+		// |  <IN>  -> uiReads - The number of reads per half.                                                        |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::subtractHalves( const arc::gen3::CArcImageView<const T>& cView, std::int32_t* pDstBuf, const std::uint32_t uiReads )
+		{
+			cds( cView, pDstBuf, uiReads );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtractHalves                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Single precision version of the image view correlated double sampling. See above.                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::subtractHalves( const arc::gen3::CArcImageView<const T>& cView, float* pDstBuf, const std::uint32_t uiReads )
+		{
+			cds( cView, pDstBuf, uiReads );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  divide                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Divides two image views pixel by pixel, one row at a time. Pixels divided by zero are set to zero. The  |
+		// |  result is a pointer to a contiguous buffer the size of the views.                                       |
+		// |                                                                                                          |
+		// |  <IN> -> cView1 - The first image view.                                                                  |
+		// |  <IN> -> cView2 - The second image view. Must be the same size as the first.                             |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
+		CArcImage<T>::divide( const arc::gen3::CArcImageView<const T>& cView1, const arc::gen3::CArcImageView<const T>& cView2 )
+		{
+			verifySameSize( cView1, cView2 );
+
+			std::unique_ptr< T[], arc::gen3::image::ArrayDeleter< T > > pDiv( new T[ cView1.size() ], arc::gen3::image::ArrayDeleter< T >() );
+
+			if ( pDiv == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate division data buffer!"s );
+			}
+
+			for ( std::uint32_t row = 0; row < cView1.rows(); row++ )
+			{
+				const T* arcGen3Restrict pIn1 = cView1.row( row );
+				const T* arcGen3Restrict pIn2 = cView2.row( row );
+				T* arcGen3Restrict pOut = ( pDiv.get() + pixelCount( cView1.cols(), row ) );
+
+				for ( std::uint32_t col = 0; col < cView1.cols(); col++ )
+				{
+					pOut[ col ] = ( ( pIn2[ col ] != 0 ) ? static_cast< T >( pIn1[ col ] / pIn2[ col ] ) : T( 0 ) );
+				}
+			}
+
+			return pDiv;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getRowArea                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills a caller supplied buffer with the average of each row of an image view. The buffer must hold      |
+		// |  cView.rows() elements.                                                                                  |
+		// |                                                                                                          |
+		// |  <IN>  -> cView    - The image view.                                                                     |
+		// |  <OUT> -> pAreaBuf - Pointer to the buffer that receives the row profile.                                |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::getRowArea( const arc::gen3::CArcImageView<const T>& cView, double* pAreaBuf )
+		{
+			rowProfile( cView, pAreaBuf );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getRowArea                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Single precision version of getRowArea. See above.                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::getRowArea( const arc::gen3::CArcImageView<const T>& cView, float* pAreaBuf )
+		{
+			rowProfile( cView, pAreaBuf );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getColArea                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills a caller supplied buffer with the average of each column of an image view. The buffer must hold   |
+		// |  cView.cols() elements.                                                                                  |
+		// |                                                                                                          |
+		// |  <IN>  -> cView    - The image view.                                                                     |
+		// |  <OUT> -> pAreaBuf - Pointer to the buffer that receives the column profile.                             |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::getColArea( const arc::gen3::CArcImageView<const T>& cView, double* pAreaBuf )
+		{
+			colProfile( cView, pAreaBuf );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getColArea                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Single precision version of getColArea. See above.                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::getColArea( const arc::gen3::CArcImageView<const T>& cView, float* pAreaBuf )
+		{
+			colProfile( cView, pAreaBuf );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getStats                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the statistics over an entire image view, skipping masked pixels.                            |
+		// |                                                                                                          |
+		// |  <IN> -> cView - The image view.                                                                         |
+		// |  <IN> -> pMask - Pointer to a cView.cols() x cView.rows() mask, or nullptr.                              |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::image::CStats> CArcImage<T>::getStats( const arc::gen3::CArcImageView<const T>& cView, const std::uint8_t* pMask )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			auto pRoiStats = roiStats( cView, { arc::gen3::image::CRoi( 0, cView.cols(), 0, cView.rows() ) }, pMask );
+
+			std::unique_ptr<arc::gen3::image::CStats> pStats( new arc::gen3::image::CStats( pRoiStats.get()[ 0 ] ) );
+
+			if ( pStats == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate stats data buffer!"s );
+			}
+
+			return pStats;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getStats                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the statistics for a list of regions of an image view in a single pass. The region           |
+		// |  coordinates are relative to the view. Masked pixels are skipped.                                        |
+		// |                                                                                                          |
+		// |  <IN> -> cView      - The image view.                                                                    |
+		// |  <IN> -> pRois	     - Pointer to an array of regions.                                                     |
+		// |  <IN> -> uiRoiCount - The number of regions in the array.                                                |
+		// |  <IN> -> pMask      - Pointer to a cView.cols() x cView.rows() mask, or nullptr.                         |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::image::CStats[], arc::gen3::image::ArrayDeleter<arc::gen3::image::CStats>>
+		CArcImage<T>::getStats( const arc::gen3::CArcImageView<const T>& cView, const arc::gen3::image::CRoi* pRois, const std::uint32_t uiRoiCount,
+								const std::uint8_t* pMask )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			auto vRois = verifyRois( pRois, uiRoiCount, cView.cols(), cView.rows() );
+
+			return roiStats( cView, vRois, pMask );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getDiffStats                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the statistics of two image views and the mean, variance and standard deviation of their     |
+		// |  difference. This is used for photon transfer curves ( PTC ). Unlike the pointer versions, the view      |
+		// |  sizes are checked.                                                                                      |
+		// |                                                                                                          |
+		// |  <IN> -> cView1 - The first image view.                                                                  |
+		// |  <IN> -> cView2 - The second image view. Must be the same size as the first.                             |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::image::CDifStats>
+		CArcImage<T>::getDiffStats( const arc::gen3::CArcImageView<const T>& cView1, const arc::gen3::CArcImageView<const T>& cView2 )
+		{
+			double gSum		= 0.0;
+			double gDifSum	= 0.0;
+
+			verifySameSize( cView1, cView2 );
+
+			double gTotalPixelCount = static_cast< double >( cView1.size() );
+
+			std::unique_ptr<arc::gen3::image::CDifStats> pDifStats( new arc::gen3::image::CDifStats() );
+
+			pDifStats->cStats1.set( *getStats( cView1 ).get() );
+
+			pDifStats->cStats2.set( *getStats( cView2 ).get() );
+
+			for ( std::uint32_t row = 0; row < cView1.rows(); row++ )
+			{
+				const T* pIn1 = cView1.row( row );
+				const T* pIn2 = cView2.row( row );
+
+				for ( std::uint32_t col = 0; col < cView1.cols(); col++ )
+				{
+					auto gVal1 = static_cast< double >( pIn1[ col ] );
+
+					auto gVal2 = static_cast< double >( pIn2[ col ] );
+
+					gSum += ( gVal1 - gVal2 );
+
+					gDifSum += ( std::pow( ( pDifStats->cStats2.gMean - gVal2 ) - ( pDifStats->cStats1.gMean - gVal1 ), 2 ) );
+				}
+			}
+
+			pDifStats->cDiffStats.gMean = std::fabs( gSum / gTotalPixelCount );
+			pDifStats->cDiffStats.gVariance = gDifSum / gTotalPixelCount;
+			pDifStats->cDiffStats.gStdDev = std::sqrt( pDifStats->cDiffStats.gVariance );
+
+			return pDifStats;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  histogram                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the histogram over an entire image view, skipping masked pixels.                             |
+		// |                                                                                                          |
+		// |  <IN> -> cView   - The image view.                                                                       |
+		// |  <IN> -> uiCount - The element count of the returned array. The size of the array depends on the image   |
+		// |                    data type.                                                                            |
+		// |  <IN> -> pMask   - Pointer to a cView.cols() x cView.rows() mask, or nullptr.                            |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
+		CArcImage<T>::histogram( const arc::gen3::CArcImageView<const T>& cView, std::uint32_t& uiCount, const std::uint8_t* pMask )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
+			pHist( new std::uint32_t[ maxTVal() ], arc::gen3::image::ArrayDeleter<std::uint32_t>() );
+
+			if ( pHist == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate histogram data buffer!"s );
+			}
+
+			uiCount = maxTVal();
+
+			zeroMemory( pHist.get(), uiCount * sizeof( std::uint32_t ) );
+
+			for ( std::uint32_t row = 0; row < cView.rows(); row++ )
+			{
+				const T* pRow = cView.row( row );
+
+				if ( pMask == nullptr )
+				{
+					for ( std::uint32_t col = 0; col < cView.cols(); col++ )
+					{
+						pHist.get()[ pRow[ col ] ]++;
+					}
+				}
+				else
+				{
+					const std::uint8_t* pMaskRow = ( pMask + static_cast< std::size_t >( row ) * cView.cols() );
+
+					for ( std::uint32_t col = 0; col < cView.cols(); col++ )
+					{
+						pHist.get()[ pRow[ col ] ] += ( ( pMaskRow[ col ] == 0 ) ? 1 : 0 );
+					}
+				}
+			}
+
+			return pHist;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  rebin                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Software bins an image view. Each uiColFactor x uiRowFactor block of pixels is summed or averaged into  |
+		// |  one output pixel. Partial blocks along the right and bottom edges are dropped. The destination is a     |
+		// |  contiguous ( cView.cols() / uiColFactor ) x ( cView.rows() / uiRowFactor ) buffer.                      |
+		// |                                                                                                          |
+		// |  Each output row is built by first adding the uiRowFactor source rows into a line of 64-bit column sums  |
+		// |  ( a straight, vectorizable pass over contiguous memory ), then reducing every uiColFactor sums in that  |
+		// |  line to one pixel. Column factors of 2, 3 and 4 use unrolled reductions.                                |
+		// |                                                                                                          |
+		// |  <IN>  -> cView	   - The source image view.                                                            |
+		// |  <IN>  -> uiColFactor - The number of columns per bin.                                                   |
+		// |  <IN>  -> uiRowFactor - The number of rows per bin.                                                      |
+		// |  <OUT> -> pDstBuf	   - Pointer to the destination buffer.                                                |
+		// |  <IN>  -> eMode	   - Sum or average the pixels in each bin.                                            |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::rebin( const arc::gen3::CArcImageView<const T>& cView, const std::uint32_t uiColFactor, const std::uint32_t uiRowFactor,
+								  std::uint32_t* pDstBuf, const arc::gen3::image::e_Rebin eMode )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( pDstBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid rebin destination buffer ( nullptr )!"s );
+			}
+
+			if ( uiColFactor == 0 || uiColFactor > cView.cols() )
+			{
+				throwArcGen3InvalidArgument( "Invalid column bin factor [ %u ]! Must be between 1 and %u!", uiColFactor, cView.cols() );
+			}
+
+			if ( uiRowFactor == 0 || uiRowFactor > cView.rows() )
+			{
+				throwArcGen3InvalidArgument( "Invalid row bin factor [ %u ]! Must be between 1 and %u!", uiRowFactor, cView.rows() );
+			}
+
+			auto uiNewCols = ( cView.cols() / uiColFactor );
+			auto uiNewRows = ( cView.rows() / uiRowFactor );
+
+			std::size_t uiLineLength = ( static_cast< std::size_t >( uiNewCols ) * uiColFactor );
+
+			std::uint64_t u64Divisor = ( ( eMode == arc::gen3::image::e_Rebin::MEAN ) ? ( static_cast< std::uint64_t >( uiColFactor ) * uiRowFactor ) : 1 );
+
+			auto uiBands = std::min( bandCount( cView.cols(), ( uiNewRows * uiRowFactor ) ), uiNewRows );
+
+			forEachRowBand( 0, uiNewRows, uiBands, [ & ]( std::uint32_t uiBandRow1, std::uint32_t uiBandRow2, std::uint32_t )
+			{
+				std::vector<std::uint64_t> vLine( uiLineLength );
+
+				for ( auto newRow = uiBandRow1; newRow < uiBandRow2; newRow++ )
+				{
+					std::fill( vLine.begin(), vLine.end(), 0 );
+
+					std::uint64_t* pLine = vLine.data();
+
+					for ( std::uint32_t k = 0; k < uiRowFactor; k++ )
+					{
+						const T* pRow = cView.row( newRow * uiRowFactor + k );
+
+						for ( std::size_t i = 0; i < uiLineLength; i++ )
+						{
+							pLine[ i ] += pRow[ i ];
+						}
+					}
+
+					std::uint32_t* pDstRow = ( pDstBuf + static_cast< std::size_t >( newRow ) * uiNewCols );
+
+					switch ( uiColFactor )
+					{
+						case 2:  rebinLine<2>( pLine, uiNewCols, uiColFactor, u64Divisor, pDstRow ); break;
+						case 3:  rebinLine<3>( pLine, uiNewCols, uiColFactor, u64Divisor, pDstRow ); break;
+						case 4:  rebinLine<4>( pLine, uiNewCols, uiColFactor, u64Divisor, pDstRow ); break;
+						default: rebinLine<0>( pLine, uiNewCols, uiColFactor, u64Divisor, pDstRow ); break;
+					}
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  createMask                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Builds a pixel mask for an image view. Each view row is processed together with the rows above and      |
+		// |  below it. The saturation and bad pixel map tests cover every pixel; the HOT and COSMIC tests cover the  |
+		// |  pixels with a full set of eight neighbours. The inner loops are branch free single precision code so    |
+		// |  the compiler can vectorize them, and large views are split into row bands on separate threads.          |
+		// |                                                                                                          |
+		// |  HOT    - The pixel exceeds the brightest of its eight neighbours by more than gHotThreshold.            |
+		// |  COSMIC - The Laplacian ( 4 x pixel - N - S - E - W ) exceeds gCosmicSigma times its noise, where the    |
+		// |           pixel noise is sqrt( read noise^2 + ( neighbour mean - bias ) / gain ), and the pixel exceeds  |
+		// |           its neighbour mean by gCosmicContrast times the neighbour signal, which rejects star cores.    |
+		// |                                                                                                          |
+		// |  <IN>  -> cView   - The image view.                                                                      |
+		// |  <IN>  -> cParams - The detection settings.                                                              |
+		// |  <OUT> -> pMask   - Pointer to a cView.cols() x cView.rows() buffer that receives the mask.              |
+		// |  <IN>  -> pBadMap - Pointer to a cView.cols() x cView.rows() persistent bad pixel map, or nullptr.       |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcImage<T>::createMask( const arc::gen3::CArcImageView<const T>& cView, const arc::gen3::image::CMaskParams& cParams, std::uint8_t* pMask,
+												const std::uint8_t* pBadMap )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( pMask == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid mask buffer ( nullptr )!"s );
+			}
+
+			if ( cParams.gGain <= 0.0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid gain [ %f ]! Must be greater than zero!", cParams.gGain );
+			}
+
+			constexpr auto uySaturated = static_cast< std::uint8_t >( arc::gen3::image::e_Mask::SATURATED );
+			constexpr auto uyHot = static_cast< std::uint8_t >( arc::gen3::image::e_Mask::HOT );
+			constexpr auto uyCosmic = static_cast< std::uint8_t >( arc::gen3::image::e_Mask::COSMIC );
+			constexpr auto uyBad = static_cast< std::uint8_t >( arc::gen3::image::e_Mask::BAD );
+
+			double gSaturation = ( ( cParams.gSaturation > 0.0 ) ? cParams.gSaturation : static_cast< double >( maxTVal() - 1 ) );
+
+			auto uiBands = bandCount( cView.cols(), cView.rows() );
+
+			std::vector<std::uint64_t> vFlagged( uiBands, 0 );
+
+			forEachRowBand( 0, cView.rows(), uiBands, [ & ]( std::uint32_t uiBandRow1, std::uint32_t uiBandRow2, std::uint32_t uiBand )
+			{
+				//
+				// Everything the inner loops read is copied to locals here. The uint8_t mask stores may alias any
+				// captured variable, which would otherwise force a reload on every pixel and block vectorization.
+				//
+				const std::uint32_t uiCols = cView.cols();
+				const std::uint32_t uiRows = cView.rows();
+
+				const bool bNeighbours = ( ( cParams.gHotThreshold > 0.0 || cParams.gCosmicSigma > 0.0 ) && uiCols >= 3 && uiRows >= 3 );
+
+				const T tSaturation = static_cast< T >( std::min( std::ceil( gSaturation ), static_cast< double >( std::numeric_limits<T>::max() ) ) );
+				const float fContrast = static_cast< float >( cParams.gCosmicContrast );
+				const float fBias = static_cast< float >( cParams.gBias );
+				const float fInvGain = static_cast< float >( 1.0 / cParams.gGain );
+				const float fReadVar = static_cast< float >( cParams.gReadNoise * cParams.gReadNoise );
+
+				// A disabled test gets an infinite threshold ( never exceeded ), which keeps the inner loop free of branches
+				const float fHotLimit = ( ( cParams.gHotThreshold > 0.0 ) ? static_cast< float >( cParams.gHotThreshold ) : std::numeric_limits<float>::infinity() );
+
+				// The Laplacian of independent pixels has 4^2 + 4 = 20 times the single pixel variance
+				const float fCosmicLimit = ( ( cParams.gCosmicSigma > 0.0 ) ? static_cast< float >( cParams.gCosmicSigma * cParams.gCosmicSigma * 20.0 ) : std::numeric_limits<float>::infinity() );
+
+				// 16-bit pixels convert through int32, which has a SIMD conversion to float; unsigned int does not
+				using cvt_t = std::conditional_t<( sizeof( T ) == sizeof( arc::gen3::image::BPP_16 ) ), std::int32_t, T>;
+
+				auto fnFloat = []( const T tVal ) { return static_cast< float >( static_cast< cvt_t >( tVal ) ); };
+
+				// Compared by value, so the compiler emits a SIMD max rather than a branch
+				auto fnMax = []( const float fA, const float fB ) { return ( ( fA > fB ) ? fA : fB ); };
+
+				std::uint64_t u64Flagged = 0;
+
+				for ( auto row = uiBandRow1; row < uiBandRow2; row++ )
+				{
+					const T* pRow = cView.row( row );
+
+					std::uint8_t* pMaskRow = ( pMask + static_cast< std::size_t >( row ) * uiCols );
+
+					for ( std::uint32_t col = 0; col < uiCols; col++ )
+					{
+						pMaskRow[ col ] = static_cast< std::uint8_t >( ( pRow[ col ] >= tSaturation ) * uySaturated );
+					}
+
+					if ( pBadMap != nullptr )
+					{
+						const std::uint8_t* pBadRow = ( pBadMap + static_cast< std::size_t >( row ) * uiCols );
+
+						for ( std::uint32_t col = 0; col < uiCols; col++ )
+						{
+							pMaskRow[ col ] |= static_cast< std::uint8_t >( ( pBadRow[ col ] != 0 ) * uyBad );
+						}
+					}
+
+					if ( bNeighbours && row > 0 && row < ( uiRows - 1 ) )
+					{
+						const T* pUp = cView.row( row - 1 );
+						const T* pDown = cView.row( row + 1 );
+
+						for ( std::uint32_t col = 1; col < ( uiCols - 1 ); col++ )
+						{
+							float fPixel = fnFloat( pRow[ col ] );
+
+							float fN = fnFloat( pUp[ col ] );
+							float fS = fnFloat( pDown[ col ] );
+							float fW = fnFloat( pRow[ col - 1 ] );
+							float fE = fnFloat( pRow[ col + 1 ] );
+							float fNW = fnFloat( pUp[ col - 1 ] );
+							float fNE = fnFloat( pUp[ col + 1 ] );
+							float fSW = fnFloat( pDown[ col - 1 ] );
+							float fSE = fnFloat( pDown[ col + 1 ] );
+
+							float fSum4 = ( fN + fS + fW + fE );
+							float fMean8 = ( ( fSum4 + fNW + fNE + fSW + fSE ) * 0.125f );
+							float fMax8 = fnMax( fnMax( fnMax( fN, fS ), fnMax( fW, fE ) ), fnMax( fnMax( fNW, fNE ), fnMax( fSW, fSE ) ) );
+
+							float fSignal = fnMax( fMean8 - fBias, 0.0f );
+							float fLaplacian = ( 4.0f * fPixel - fSum4 );
+
+							int iHot = ( ( fPixel - fMax8 ) > fHotLimit );
+
+							int iCosmic = ( ( fLaplacian > 0.0f ) & ( ( fLaplacian * fLaplacian ) > ( fCosmicLimit * ( fReadVar + fSignal * fInvGain ) ) ) &
+											( ( fPixel - fMean8 ) > ( fContrast * fSignal ) ) );
+
+							pMaskRow[ col ] |= static_cast< std::uint8_t >( iHot * uyHot + iCosmic * uyCosmic );
+						}
+					}
+
+					for ( std::uint32_t col = 0; col < uiCols; col++ )
+					{
+						u64Flagged += ( pMaskRow[ col ] != 0 );
+					}
+				}
+
+				vFlagged[ uiBand ] = u64Flagged;
+			} );
+
+			std::uint64_t u64Flagged = 0;
+
+			for ( auto u64Count : vFlagged )
+			{
+				u64Flagged += u64Count;
+			}
+
+			return u64Flagged;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  createMask                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Builds a pixel mask for an entire image buffer. See above.                                              |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf    - Pointer to the image buffer.                                                         |
+		// |  <IN>  -> uiCols  - The image column size ( in pixels ).                                                 |
+		// |  <IN>  -> uiRows  - The image row size ( in pixels ).                                                    |
+		// |  <IN>  -> cParams - The detection settings.                                                              |
+		// |  <OUT> -> pMask   - Pointer to a uiCols x uiRows buffer that receives the mask.                          |
+		// |  <IN>  -> pBadMap - Pointer to a uiCols x uiRows persistent bad pixel map, or nullptr.                   |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcImage<T>::createMask( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CMaskParams& cParams,
+												std::uint8_t* pMask, const std::uint8_t* pBadMap )
+		{
+			verifyBuffer( pBuf );
+
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			return createMask( arc::gen3::CArcImageView<const T>( pBuf, uiCols, uiRows ), cParams, pMask, pBadMap );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  repairDefects                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Repairs known detector defects in place by interpolating over them from the surrounding good pixels.    |
+		// |  Defects are repaired in list order. See repairDefectRow() for the interpolation.                        |
+		// |                                                                                                          |
+		// |  <IN> -> cView    - The image view.                                                                      |
+		// |  <IN> -> vDefects - The defects.                                                                         |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::repairDefects( const arc::gen3::CArcImageView<T>& cView, const std::vector<arc::gen3::image::CDefect>& vDefects )
+		{
+			repairDefects( cView, vDefects, 0, cView.rows() );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  repairDefects                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Repairs the part of each defect that lies within rows [ uiRow1, uiRow2 ) of an image view, so the       |
+		// |  repair can be run band by band inside another per-frame pass.                                           |
+		// |                                                                                                          |
+		// |  <IN> -> cView    - The image view.                                                                      |
+		// |  <IN> -> vDefects - The defects.                                                                         |
+		// |  <IN> -> uiRow1   - The start row.                                                                       |
+		// |  <IN> -> uiRow2   - The end row ( exclusive ).                                                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::out_of_range on error.                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::repairDefects( const arc::gen3::CArcImageView<T>& cView, const std::vector<arc::gen3::image::CDefect>& vDefects, const std::uint32_t uiRow1,
+										  const std::uint32_t uiRow2 )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( uiRow2 > cView.rows() )
+			{
+				throwArcGen3OutOfRange( uiRow2, std::make_pair( 0U, cView.rows() ) );
+			}
+
+			if ( uiRow1 > uiRow2 )
+			{
+				throwArcGen3OutOfRange( uiRow1, std::make_pair( 0U, uiRow2 ) );
+			}
+
+			verifyDefects( vDefects, cView.cols(), cView.rows() );
+
+			for ( const auto& cDefect : vDefects )
+			{
+				auto uiLastRow = std::min( cDefect.uiRow2, uiRow2 );
+
+				for ( auto row = std::max( cDefect.uiRow1, uiRow1 ); row < uiLastRow; row++ )
+				{
+					repairDefectRow( cView, cDefect, row );
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  repairDefects                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Repairs known detector defects in an entire image buffer. See above.                                    |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf     - Pointer to the image buffer.                                                         |
+		// |  <IN> -> uiCols   - The image column size ( in pixels ).                                                 |
+		// |  <IN> -> uiRows   - The image row size ( in pixels ).                                                    |
+		// |  <IN> -> vDefects - The defects.                                                                         |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::repairDefects( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::vector<arc::gen3::image::CDefect>& vDefects )
+		{
+			verifyBuffer( pBuf );
+
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			repairDefects( arc::gen3::CArcImageView<T>( pBuf, uiCols, uiRows ), vDefects );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  verifyDefects                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Verifies that each defect lies within an image and has at least one good side to interpolate from.      |
+		// |                                                                                                          |
+		// |  <IN> -> vDefects - The defects.                                                                         |
+		// |  <IN> -> uiCols   - The image column size ( in pixels ).                                                 |
+		// |  <IN> -> uiRows   - The image row size ( in pixels ).                                                    |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::verifyDefects( const std::vector<arc::gen3::image::CDefect>& vDefects, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			for ( std::uint32_t i = 0; i < static_cast< std::uint32_t >( vDefects.size() ); i++ )
+			{
+				const auto& cDefect = vDefects[ i ];
+
+				if ( cDefect.uiCol1 >= cDefect.uiCol2 || cDefect.uiCol2 > uiCols || cDefect.uiRow1 >= cDefect.uiRow2 || cDefect.uiRow2 > uiRows )
+				{
+					throwArcGen3InvalidArgument( "Invalid defect %u [ cols %u - %u, rows %u - %u ]! Must be a non-empty area within the %u x %u image!",
+												 i, cDefect.uiCol1, cDefect.uiCol2, cDefect.uiRow1, cDefect.uiRow2, uiCols, uiRows );
+				}
+
+				const bool bHorz = ( cDefect.uiCol1 > 0 || cDefect.uiCol2 < uiCols );
+				const bool bVert = ( cDefect.uiRow1 > 0 || cDefect.uiRow2 < uiRows );
+
+				bool bGoodSide = false;
+
+				switch ( cDefect.eType )
+				{
+					case arc::gen3::image::e_Defect::COLUMN: bGoodSide = bHorz; break;
+					case arc::gen3::image::e_Defect::ROW: bGoodSide = bVert; break;
+					case arc::gen3::image::e_Defect::BOX: bGoodSide = ( bHorz || bVert ); break;
+
+					default:
+					{
+						throwArcGen3InvalidArgument( "Invalid defect %u type [ %u ]!", i, static_cast< std::uint32_t >( cDefect.eType ) );
+					}
+				}
+
+				if ( !bGoodSide )
+				{
+					throwArcGen3InvalidArgument( "Invalid defect %u! It has no good pixels to interpolate from!", i );
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  repairDefectRow                                                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Repairs one row of a defect. COLUMN defects are interpolated along the row between the good columns     |
+		// |  either side, ROW defects along each column between the good rows above and below. BOX defects blend     |
+		// |  the two as ( H x height + V x width ) / ( width + height ), which favours the narrower direction. Where |
+		// |  a defect touches the image edge the one good side is used. The vertical interpolation is a single       |
+		// |  weighted sum of two rows, so it vectorizes along the row.                                               |
+		// |                                                                                                          |
+		// |  <IN> -> cView   - The image view.                                                                       |
+		// |  <IN> -> cDefect - The defect.                                                                           |
+		// |  <IN> -> uiRow   - The row to repair. Must lie within the defect.                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::repairDefectRow( const arc::gen3::CArcImageView<T>& cView, const arc::gen3::image::CDefect& cDefect, const std::uint32_t uiRow )
+		{
+			const bool bLeft = ( cDefect.uiCol1 > 0 );
+			const bool bRight = ( cDefect.uiCol2 < cView.cols() );
+			const bool bAbove = ( cDefect.uiRow1 > 0 );
+			const bool bBelow = ( cDefect.uiRow2 < cView.rows() );
+
+			const bool bHorz = ( cDefect.eType != arc::gen3::image::e_Defect::ROW && ( bLeft || bRight ) );
+			const bool bVert = ( cDefect.eType != arc::gen3::image::e_Defect::COLUMN && ( bAbove || bBelow ) );
+
+			const std::size_t uiCol1 = cDefect.uiCol1;
+			const std::size_t uiCol2 = cDefect.uiCol2;
+
+			T* arcGen3Restrict pRow = cView.row( uiRow );
+
+			// Horizontal: a line from the left to the right good column, which are uiCol2 - uiCol1 + 1 apart
+			double gLeft = 0.0;
+			double gStep = 0.0;
+
+			if ( bHorz )
+			{
+				gLeft = static_cast< double >( pRow[ bLeft ? ( uiCol1 - 1 ) : uiCol2 ] );
+
+				double gRight = static_cast< double >( pRow[ bRight ? uiCol2 : ( uiCol1 - 1 ) ] );
+
+				gStep = ( ( gRight - gLeft ) / static_cast< double >( uiCol2 - uiCol1 + 1 ) );
+			}
+
+			if ( !bVert )
+			{
+				for ( std::size_t col = uiCol1; col < uiCol2; col++ )
+				{
+					pRow[ col ] = static_cast< T >( gLeft + gStep * static_cast< double >( col - uiCol1 + 1 ) + 0.5 );
+				}
+
+				return;
+			}
+
+			// Vertical: a weighted sum of the good rows above and below, which are uiRow2 - uiRow1 + 1 apart
+			const T* arcGen3Restrict pAbove = cView.row( bAbove ? ( cDefect.uiRow1 - 1 ) : cDefect.uiRow2 );
+			const T* arcGen3Restrict pBelow = cView.row( bBelow ? cDefect.uiRow2 : ( cDefect.uiRow1 - 1 ) );
+
+			const double gBelowWeight = ( static_cast< double >( uiRow - cDefect.uiRow1 + 1 ) / static_cast< double >( cDefect.uiRow2 - cDefect.uiRow1 + 1 ) );
+			const double gAboveWeight = ( 1.0 - gBelowWeight );
+
+			if ( !bHorz )
+			{
+				for ( std::size_t col = uiCol1; col < uiCol2; col++ )
+				{
+					pRow[ col ] = static_cast< T >( static_cast< double >( pAbove[ col ] ) * gAboveWeight + static_cast< double >( pBelow[ col ] ) * gBelowWeight + 0.5 );
+				}
+
+				return;
+			}
+
+			const double gWidth = static_cast< double >( uiCol2 - uiCol1 );
+			const double gHeight = static_cast< double >( cDefect.uiRow2 - cDefect.uiRow1 );
+
+			const double gHorzWeight = ( gHeight / ( gWidth + gHeight ) );
+			const double gVertWeight = ( 1.0 - gHorzWeight );
+
+			for ( std::size_t col = uiCol1; col < uiCol2; col++ )
+			{
+				double gHorz = ( gLeft + gStep * static_cast< double >( col - uiCol1 + 1 ) );
+				double gVert = ( static_cast< double >( pAbove[ col ] ) * gAboveWeight + static_cast< double >( pBelow[ col ] ) * gBelowWeight );
+
+				pRow[ col ] = static_cast< T >( gHorz * gHorzWeight + gVert * gVertWeight + 0.5 );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  findSources                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Finds and measures the sources ( stars ) in an image view.                                              |
+		// |                                                                                                          |
+		// |  The background is the median of a sparse pixel sample and the noise is 1.4826 x its median absolute     |
+		// |  deviation, neither of which is pulled up by the sources themselves. Pixels above the threshold are      |
+		// |  labelled in a single raster pass using only the previous row of labels; touching labels are joined      |
+		// |  with a union-find table whose roots carry the running footprint sums, so no full frame label image is   |
+		// |  needed. Each footprint is then measured in a circular aperture around its moment centroid.              |
+		// |                                                                                                          |
+		// |  <IN>  -> cView    - The image view.                                                                     |
+		// |  <IN>  -> cParams  - The detection settings.                                                             |
+		// |  <OUT> -> vSources - Receives the sources, brightest first. Its capacity is reused between calls.        |
+		// |                                                                                                          |
+		// |  Returns the number of sources found.                                                                    |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint32_t CArcImage<T>::findSources( const arc::gen3::CArcImageView<const T>& cView, const arc::gen3::image::CSourceParams& cParams,
+												 std::vector<arc::gen3::image::CSource>& vSources )
+		{
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
+
+			if ( cParams.gThreshold <= 0.0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid threshold [ %f ]! Must be greater than zero!", cParams.gThreshold );
+			}
+
+			if ( cParams.gRadius < 0.0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid radius [ %f ]! Must not be negative!", cParams.gRadius );
+			}
+
+			thread_local std::vector<T> vSample;
+			thread_local std::vector<std::uint32_t> vPrevLabels;
+			thread_local std::vector<std::uint32_t> vLabels;
+			thread_local std::vector<std::uint32_t> vParent;
+			thread_local std::vector<sourceAccum_t> vAccum;
+			thread_local std::vector<std::uint32_t> vRoots;
+			thread_local std::vector<double> vRadius;
+
+			vSources.clear();
+
+			auto uiCols = cView.cols();
+			auto uiRows = cView.rows();
+
+			//
+			// Estimate the background and noise
+			//
+			samplePixels( cView, SOURCE_SAMPLE_PIXELS, vSample );
+
+			auto itMiddle = ( vSample.begin() + static_cast< std::ptrdiff_t >( vSample.size() / 2 ) );
+
+			std::nth_element( vSample.begin(), itMiddle, vSample.end() );
+
+			T tMedian = *itMiddle;
+
+			for ( auto& tValue : vSample )
+			{
+				tValue = ( ( tValue > tMedian ) ? static_cast< T >( tValue - tMedian ) : static_cast< T >( tMedian - tValue ) );
+			}
+
+			std::nth_element( vSample.begin(), itMiddle, vSample.end() );
+
+			// A one DN noise floor keeps noiseless or heavily quantized frames from detecting every pixel above the median
+			double gBackground = static_cast< double >( tMedian );
+			double gSigma = std::max( ( 1.4826 * static_cast< double >( *itMiddle ) ), 1.0 );
+			double gLevel = std::floor( gBackground + cParams.gThreshold * gSigma );
+
+			if ( gLevel >= static_cast< double >( maxTVal() - 1 ) )
+			{
+				return 0;
+			}
+
+			const T tLevel = static_cast< T >( gLevel );
+
+			//
+			// Label the 8-connected components above the threshold. Label zero is the background.
+			//
+			vPrevLabels.assign( uiCols, 0 );
+			vLabels.assign( uiCols, 0 );
+
+			vParent.assign( 1, 0 );
+			vAccum.assign( 1, sourceAccum_t() );
+
+			auto fnFind = [ & ]( std::uint32_t uiLabel )
+			{
+				while ( vParent[ uiLabel ] != uiLabel )
+				{
+					vParent[ uiLabel ] = vParent[ vParent[ uiLabel ] ];
+
+					uiLabel = vParent[ uiLabel ];
+				}
+
+				return uiLabel;
+			};
+
+			auto fnJoin = [ & ]( std::uint32_t uiRoot, std::uint32_t uiLabel )
+			{
+				if ( uiLabel == 0 )
+				{
+					return uiRoot;
+				}
+
+				uiLabel = fnFind( uiLabel );
+
+				if ( uiRoot == 0 )
+				{
+					return uiLabel;
+				}
+
+				if ( uiLabel != uiRoot )
+				{
+					vAccum[ uiRoot ].merge( vAccum[ uiLabel ] );
+
+					vParent[ uiLabel ] = uiRoot;
+				}
+
+				return uiRoot;
+			};
+
+			for ( std::uint32_t row = 0; row < uiRows; row++ )
+			{
+				const T* pRow = cView.row( row );
+
+				for ( std::uint32_t col = 0; col < uiCols; col++ )
+				{
+					if ( pRow[ col ] <= tLevel )
+					{
+						vLabels[ col ] = 0;
+
+						continue;
+					}
+
+					std::uint32_t uiRoot = 0;
+
+					if ( col > 0 )
+					{
+						uiRoot = fnJoin( uiRoot, vLabels[ col - 1 ] );
+						uiRoot = fnJoin( uiRoot, vPrevLabels[ col - 1 ] );
+					}
+
+					uiRoot = fnJoin( uiRoot, vPrevLabels[ col ] );
+
+					if ( col < ( uiCols - 1 ) )
+					{
+						uiRoot = fnJoin( uiRoot, vPrevLabels[ col + 1 ] );
+					}
+
+					if ( uiRoot == 0 )
+					{
+						uiRoot = static_cast< std::uint32_t >( vParent.size() );
+
+						vParent.push_back( uiRoot );
+						vAccum.emplace_back();
+					}
+
+					vAccum[ uiRoot ].add( col, row, ( static_cast< double >( pRow[ col ] ) - gBackground ) );
+
+					vLabels[ col ] = uiRoot;
+				}
+
+				vPrevLabels.swap( vLabels );
+			}
+
+			//
+			// Keep the brightest qualifying footprints
+			//
+			vRoots.clear();
+
+			for ( std::uint32_t uiLabel = 1; uiLabel < vParent.size(); uiLabel++ )
+			{
+				if ( vParent[ uiLabel ] == uiLabel && vAccum[ uiLabel ].uiPixels >= std::max( cParams.uiMinPixels, 1U ) )
+				{
+					vRoots.push_back( uiLabel );
+				}
+			}
+
+			std::sort( vRoots.begin(), vRoots.end(), [ & ]( std::uint32_t uiA, std::uint32_t uiB )
+			{
+				return ( vAccum[ uiA ].gSum > vAccum[ uiB ].gSum );
+			} );
+
+			if ( cParams.uiMaxSources > 0 && vRoots.size() > cParams.uiMaxSources )
+			{
+				vRoots.resize( cParams.uiMaxSources );
+			}
+
+			vSources.resize( vRoots.size() );
+			vRadius.resize( vRoots.size() );
+
+			for ( std::size_t i = 0; i < vRoots.size(); i++ )
+			{
+				const sourceAccum_t& rAccum = vAccum[ vRoots[ i ] ];
+
+				vSources[ i ].gCol = ( rAccum.gSumCol / rAccum.gSum );
+				vSources[ i ].gRow = ( rAccum.gSumRow / rAccum.gSum );
+				vSources[ i ].uiPixels = rAccum.uiPixels;
+
+				vRadius[ i ] = ( ( cParams.gRadius > 0.0 ) ? cParams.gRadius :
+							     std::max( 3.0, static_cast< double >( std::max( rAccum.uiCol2 - rAccum.uiCol1, rAccum.uiRow2 - rAccum.uiRow1 ) + 1 ) ) );
+			}
+
+			//
+			// Measure. The radius list is passed by pointer; thread_local names inside the lambda would refer to the
+			// worker thread's own ( empty ) copies.
+			//
+			const double* pRadius = vRadius.data();
+
+			auto fnMeasure = [ &cView, &vSources, pRadius, gBackground ]( std::uint32_t uiIndex )
+			{
+				measureSource( cView, gBackground, pRadius[ uiIndex ], vSources[ uiIndex ] );
+			};
+
+			auto uiCount = static_cast< std::uint32_t >( vSources.size() );
+
+			if ( uiCount >= MIN_PARALLEL_SOURCES )
+			{
+				forEachIndex( uiCount, fnMeasure );
+			}
+
+			else
+			{
+				for ( std::uint32_t i = 0; i < uiCount; i++ )
+				{
+					fnMeasure( i );
+				}
+			}
+
+			// The aperture flux can reorder sources whose footprint sums were close
+			std::stable_sort( vSources.begin(), vSources.end(), []( const arc::gen3::image::CSource& cA, const arc::gen3::image::CSource& cB )
+			{
+				return ( cA.gFlux > cB.gFlux );
+			} );
+
+			return uiCount;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  findSources                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Finds and measures the sources ( stars ) in an entire image buffer. See above.                          |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf     - Pointer to the image buffer.                                                        |
+		// |  <IN>  -> uiCols   - The image column size ( in pixels ).                                                |
+		// |  <IN>  -> uiRows   - The image row size ( in pixels ).                                                   |
+		// |  <IN>  -> cParams  - The detection settings.                                                             |
+		// |  <OUT> -> vSources - Receives the sources, brightest first. Its capacity is reused between calls.        |
+		// |                                                                                                          |
+		// |  Returns the number of sources found.                                                                    |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint32_t CArcImage<T>::findSources( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CSourceParams& cParams,
+												 std::vector<arc::gen3::image::CSource>& vSources )
+		{
+			verifyBuffer( pBuf );
+
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			return findSources( arc::gen3::CArcImageView<const T>( pBuf, uiCols, uiRows ), cParams, vSources );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  samplePixels                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills a vector with an evenly spaced sample of the pixels in an image view. An odd step keeps the       |
+		// |  sample from following a column pattern. The vector's capacity is reused. Masked pixels are left out,    |
+		// |  unless that would leave no sample at all.                                                               |
+		// |                                                                                                          |
+		// |  <IN>  -> cView      - The image view.                                                                   |
+		// |  <IN>  -> u64Samples - The number of pixels to sample. The whole view is used if it is smaller.          |
+		// |  <OUT> -> vSample    - Receives the sample.                                                              |
+		// |  <IN>  -> pMask      - Pointer to a cView.cols() x cView.rows() mask, or nullptr.                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::samplePixels( const arc::gen3::CArcImageView<const T>& cView, const std::uint64_t u64Samples, std::vector<T>& vSample,
+										 const std::uint8_t* pMask )
+		{
+			auto uiCols = cView.cols();
+
+			auto u64Step = ( std::max<std::uint64_t>( cView.size() / std::max<std::uint64_t>( u64Samples, 1 ), 1 ) | 1 );
+
+			vSample.clear();
+
+			for ( std::uint64_t u64Index = 0; u64Index < cView.size(); u64Index += u64Step )
+			{
+				if ( pMask == nullptr || pMask[ u64Index ] == 0 )
+				{
+					vSample.push_back( cView( static_cast< std::uint32_t >( u64Index % uiCols ), static_cast< std::uint32_t >( u64Index / uiCols ) ) );
+				}
+			}
+
+			if ( vSample.empty() && pMask != nullptr )
+			{
+				samplePixels( cView, u64Samples, vSample, nullptr );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  zscale                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the IRAF zscale display limits for a pixel sample. A line is fitted to the sorted sample with   |
+		// |  up to five rounds of 2.5 sigma rejection, each rejected point also rejecting its 1% neighbourhood. The  |
+		// |  limits are then the median -/+ the fitted slope / contrast over the lower and upper halves of the       |
+		// |  sample, clipped to the sample range. If over half the sample is rejected, the sample range is used.     |
+		// |                                                                                                          |
+		// |  <IN> -> vSample   - The pixel sample. Sorted on return.                                                 |
+		// |  <IN> -> gContrast - The zscale contrast.                                                                |
+		// |                                                                                                          |
+		// |  Returns the low and high display limits ( DN ).                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::pair<double, double> CArcImage<T>::zscale( std::vector<T>& vSample, const double gContrast )
+		{
+			constexpr auto MAX_ITERATIONS = 5;
+			constexpr auto REJECT_SIGMA = 2.5;
+
+			thread_local std::vector<std::uint8_t> vBad;
+			thread_local std::vector<std::uint8_t> vGrown;
+
+			std::sort( vSample.begin(), vSample.end() );
+
+			auto uiCount = vSample.size();
+
+			auto gMin = static_cast< double >( vSample.front() );
+			auto gMax = static_cast< double >( vSample.back() );
+
+			auto uiMinGood = std::max<std::size_t>( 5, uiCount / 2 );
+			auto uiGrow = std::max<std::size_t>( 1, uiCount / 100 );
+
+			vBad.assign( uiCount, 0 );
+
+			auto uiGood = uiCount;
+			auto uiLastGood = ( uiCount + 1 );
+
+			double gSlope = 0.0;
+
+			for ( auto i = 0; i < MAX_ITERATIONS && uiGood < uiLastGood && uiGood >= uiMinGood; i++ )
+			{
+				double gN = 0.0, gSumX = 0.0, gSumY = 0.0, gSumXX = 0.0, gSumXY = 0.0;
+
+				for ( std::size_t x = 0; x < uiCount; x++ )
+				{
+					if ( vBad[ x ] == 0 )
+					{
+						auto gX = static_cast< double >( x );
+						auto gY = static_cast< double >( vSample[ x ] );
+
+						gN += 1.0;
+						gSumX += gX;
+						gSumY += gY;
+						gSumXX += ( gX * gX );
+						gSumXY += ( gX * gY );
+					}
+				}
+
+				double gDenom = ( gN * gSumXX - gSumX * gSumX );
+
+				if ( gDenom <= 0.0 )
+				{
+					break;
+				}
+
+				gSlope = ( ( gN * gSumXY - gSumX * gSumY ) / gDenom );
+
+				double gIntercept = ( ( gSumY - gSlope * gSumX ) / gN );
+
+				double gSumR2 = 0.0;
+
+				for ( std::size_t x = 0; x < uiCount; x++ )
+				{
+					if ( vBad[ x ] == 0 )
+					{
+						double gResidual = ( static_cast< double >( vSample[ x ] ) - ( gIntercept + gSlope * static_cast< double >( x ) ) );
+
+						gSumR2 += ( gResidual * gResidual );
+					}
+				}
+
+				double gLimit = ( REJECT_SIGMA * std::sqrt( gSumR2 / gN ) );
+
+				for ( std::size_t x = 0; x < uiCount; x++ )
+				{
+					if ( std::abs( static_cast< double >( vSample[ x ] ) - ( gIntercept + gSlope * static_cast< double >( x ) ) ) > gLimit )
+					{
+						vBad[ x ] = 1;
+					}
+				}
+
+				// Grow each rejected point over a uiGrow wide window centered on it
+				vGrown.assign( uiCount, 0 );
+
+				for ( std::size_t x = 0; x < uiCount; x++ )
+				{
+					if ( vBad[ x ] != 0 )
+					{
+						auto uiFirst = ( ( x >= ( uiGrow - 1 ) / 2 ) ? ( x - ( uiGrow - 1 ) / 2 ) : 0 );
+						auto uiLast = std::min( ( x + uiGrow / 2 ), ( uiCount - 1 ) );
+
+						std::fill( vGrown.begin() + static_cast< std::ptrdiff_t >( uiFirst ), vGrown.begin() + static_cast< std::ptrdiff_t >( uiLast + 1 ), std::uint8_t( 1 ) );
+					}
+				}
+
+				vBad.swap( vGrown );
+
+				uiLastGood = uiGood;
+				uiGood = static_cast< std::size_t >( std::count( vBad.begin(), vBad.end(), std::uint8_t( 0 ) ) );
+			}
+
+			if ( uiGood < uiMinGood )
+			{
+				return std::make_pair( gMin, std::max( gMax, gMin + 1.0 ) );
+			}
+
+			gSlope /= gContrast;
+
+			auto uiCenter = ( ( uiCount - 1 ) / 2 );
+
+			double gMedian = ( ( uiCount % 2 ) ? static_cast< double >( vSample[ uiCenter ] ) :
+							   ( 0.5 * ( static_cast< double >( vSample[ uiCenter ] ) + static_cast< double >( vSample[ uiCenter + 1 ] ) ) ) );
+
+			double gLow = std::max( gMin, ( gMedian - static_cast< double >( uiCenter ) * gSlope ) );
+			double gHigh = std::min( gMax, ( gMedian + static_cast< double >( uiCount - uiCenter - 1 ) * gSlope ) );
+
+			return std::make_pair( gLow, std::max( gHigh, gLow + 1.0 ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  measureSource                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Measures one source within a circular aperture, clipped to the view. The first pass refines the         |
+		// |  centroid; the second measures about it. Only positive pixels weight the centroid, which keeps it        |
+		// |  stable on faint sources, while the flux and profile moments use every pixel so the noise averages out.  |
+		// |                                                                                                          |
+		// |  FWHM = 2.3548 x sqrt( sum( w r^2 ) / ( 2 sum( w ) ) ), exact for a gaussian profile.                    |
+		// |  HFD  = 2 x sum( w r ) / sum( w ), the flux weighted mean radius estimate of the half flux diameter.     |
+		// |                                                                                                          |
+		// |  <IN>     -> cView       - The image view.                                                               |
+		// |  <IN>     -> gBackground - The background level ( DN ).                                                  |
+		// |  <IN>     -> gRadius     - The aperture radius ( pixels ).                                               |
+		// |  <IN/OUT> -> cSource     - The source. gCol and gRow hold the starting position on entry.                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::measureSource( const arc::gen3::CArcImageView<const T>& cView, const double gBackground, const double gRadius, arc::gen3::image::CSource& cSource )
+		{
+			const double gRadius2 = ( gRadius * gRadius );
+
+			for ( int iPass = 0; iPass < 2; iPass++ )
+			{
+				double gCol0 = cSource.gCol;
+				double gRow0 = cSource.gRow;
+
+				auto uiCol1 = static_cast< std::uint32_t >( std::max( std::ceil( gCol0 - gRadius ), 0.0 ) );
+				auto uiCol2 = static_cast< std::uint32_t >( std::min( std::floor( gCol0 + gRadius ), static_cast< double >( cView.cols() - 1 ) ) );
+				auto uiRow1 = static_cast< std::uint32_t >( std::max( std::ceil( gRow0 - gRadius ), 0.0 ) );
+				auto uiRow2 = static_cast< std::uint32_t >( std::min( std::floor( gRow0 + gRadius ), static_cast< double >( cView.rows() - 1 ) ) );
+
+				double gFlux = 0.0;
+				double gPeak = 0.0;
+				double gSum = 0.0;
+				double gSumCol = 0.0;
+				double gSumRow = 0.0;
+				double gSumR = 0.0;
+				double gSumR2 = 0.0;
+
+				for ( auto row = uiRow1; row <= uiRow2; row++ )
+				{
+					const T* pRow = cView.row( row );
+
+					double gDy = ( static_cast< double >( row ) - gRow0 );
+
+					for ( auto col = uiCol1; col <= uiCol2; col++ )
+					{
+						double gDx = ( static_cast< double >( col ) - gCol0 );
+						double gR2 = ( gDx * gDx + gDy * gDy );
+
+						if ( gR2 > gRadius2 )
+						{
+							continue;
+						}
+
+						double gValue = ( static_cast< double >( pRow[ col ] ) - gBackground );
+
+						gFlux += gValue;
+						gSumR += ( gValue * std::sqrt( gR2 ) );
+						gSumR2 += ( gValue * gR2 );
+
+						if ( gValue > 0.0 )
+						{
+							gPeak = std::max( gPeak, gValue );
+							gSum += gValue;
+							gSumCol += ( gValue * col );
+							gSumRow += ( gValue * row );
+						}
+					}
+				}
 
-				for ( std::uint32_t row = uiRow1; row < uiRow2; row++ )
+				if ( gSum <= 0.0 || gFlux <= 0.0 )
 				{
-					gColSum += pBuf[ col + row * uiCols ];
+					break;
 				}
 
-				pAreaBuf.get()[ i ] = gColSum / ( static_cast< double >( uiRow2 - uiRow1 ) );
+				cSource.gCol = ( gSumCol / gSum );
+				cSource.gRow = ( gSumRow / gSum );
+				cSource.gFlux = gFlux;
+				cSource.gPeak = gPeak;
+				cSource.gFwhm = ( 2.3548 * std::sqrt( std::max( gSumR2, 0.0 ) / ( 2.0 * gFlux ) ) );
+				cSource.gHfd = ( 2.0 * std::max( gSumR, 0.0 ) / gFlux );
 			}
 
-			return pAreaBuf;
+			cSource.gBackground = gBackground;
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getStats                                                                                                |
+		// |  preview                                                                                                 |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Calculates the image min, max, mean, variance, standard deviation, total pixel count and saturated      |
-		// |  pixel count over the specified image buffer cols and rows.                                              |
+		// |  Builds an 8-bit quick look image from an image view. The display limits are found from a sparse pixel   |
+		// |  sample. Each output row then sums its block of view rows into a single precision row buffer, which      |
+		// |  the compiler vectorizes, and each output pixel averages its span of that buffer and is scaled so the    |
+		// |  low limit is 0 and the high limit is 255. Output rows are split into bands on separate threads.         |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf	 - Pointer to the image data buffer.                                                      |
-		// |  <IN> -> uiCol1 - The start column.                                                                      |
-		// |  <IN> -> uiCol2 - The end column.                                                                        |
-		// |  <IN> -> uiRow1 - The start row.                                                                         |
-		// |  <IN> -> uiRow2 - The end row.                                                                           |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  Blocks are as even as the sizes allow; a block boundary falls at view column ( x * cols / dstCols ).    |
+		// |  Masked pixels are only left out of the limit sample.                                                    |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <IN>  -> cView     - The image view.                                                                    |
+		// |  <IN>  -> cParams   - The display settings.                                                              |
+		// |  <OUT> -> pDstBuf   - Pointer to a uiDstCols x uiDstRows buffer that receives the preview.               |
+		// |  <IN>  -> uiDstCols - The preview column size ( in pixels ). Must not exceed the view column size.       |
+		// |  <IN>  -> uiDstRows - The preview row size ( in pixels ). Must not exceed the view row size.             |
+		// |  <IN>  -> pMask     - Pointer to a cView.cols() x cView.rows() mask, or nullptr.                         |
+		// |                                                                                                          |
+		// |  Returns the low and high display limits used ( DN ).                                                    |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<arc::gen3::image::CStats>
-		CArcImage<T>::getStats( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		std::pair<double, double> CArcImage<T>::preview( const arc::gen3::CArcImageView<const T>& cView, const arc::gen3::image::CPreviewParams& cParams,
+														 std::uint8_t* pDstBuf, const std::uint32_t uiDstCols, const std::uint32_t uiDstRows, const std::uint8_t* pMask )
 		{
-			double gDevSqrdSum = 0.0;
-			double gVal = 0.0;
-			double gSum = 0.0;
+			if ( pDstBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid preview buffer ( nullptr )!"s );
+			}
 
-			std::remove_const_t<decltype( uiRow2 )> uiLocalRow2 = uiRow2;
-			std::remove_const_t<decltype( uiCol2 )> uiLocalCol2 = uiCol2;
+			if ( uiDstCols == 0 || uiDstCols > cView.cols() )
+			{
+				throwArcGen3InvalidArgument( "Invalid preview column count [ %u ]! Must be 1 - %u!", uiDstCols, cView.cols() );
+			}
 
-			verifyRow( uiRow1, uiRows );
-				
-			verifyRow( uiRow2, uiRows );
+			if ( uiDstRows == 0 || uiDstRows > cView.rows() )
+			{
+				throwArcGen3InvalidArgument( "Invalid preview row count [ %u ]! Must be 1 - %u!", uiDstRows, cView.rows() );
+			}
 
-			verifyColumn( uiCol1, uiCols );
+			auto pairLimits = previewLimits( cView, cParams, pMask );
 
-			verifyColumn( uiCol2, uiCols );
-				
-			verifyRangeOrder( uiCol1, uiCol2 );
+			auto uiCols = cView.cols();
+			auto uiRows = cView.rows();
 
-			verifyRangeOrder( uiRow1, uiRow2 );
+			std::vector<std::uint32_t> vColStart( static_cast< std::size_t >( uiDstCols ) + 1 );
 
-			verifyBuffer( pBuf );
+			for ( std::uint32_t x = 0; x <= uiDstCols; x++ )
+			{
+				vColStart[ x ] = static_cast< std::uint32_t >( ( static_cast< std::uint64_t >( x ) * uiCols ) / uiDstCols );
+			}
 
-			double gMaxBpp = maxTVal();
+			const float fLow = static_cast< float >( pairLimits.first );
+			const float fScale = static_cast< float >( 255.0 / std::max( ( pairLimits.second - pairLimits.first ), std::numeric_limits<double>::min() ) );
 
-			std::unique_ptr<arc::gen3::image::CStats> pStats( new arc::gen3::image::CStats() );
+			auto uiBands = std::min( bandCount( uiCols, uiRows ), uiDstRows );
 
-			if ( pStats == nullptr )
+			forEachRowBand( 0, uiDstRows, uiBands, [ & ]( std::uint32_t uiBandRow1, std::uint32_t uiBandRow2, std::uint32_t )
 			{
-				throwArcGen3Error( "Failed to allocate stats data buffer!"s );
-			}
+				std::vector<float> vLine( uiCols );
 
-			pStats->gMin = gMaxBpp;
-			
-			if ( uiRow1 == uiRow2 ) { uiLocalRow2++; }
-			if ( uiCol1 == uiCol2 ) { uiLocalCol2++; }
+				float* pLine = vLine.data();
 
-			double gTotalPixelCount = ( static_cast< double >( uiLocalRow2 - uiRow1 ) * static_cast< double >( uiLocalCol2 - uiCol1 ) );
+				const std::uint32_t* pColStart = vColStart.data();
 
-			pStats->gTotalPixels = gTotalPixelCount;
+				const std::size_t uiLineCols = uiCols;
+				const std::uint32_t uiLineDstCols = uiDstCols;
 
-			for ( std::uint32_t i = uiRow1; i < uiLocalRow2; i++ )
-			{
-				for ( std::uint32_t j = uiCol1; j < uiLocalCol2; j++ )
+				for ( auto y = uiBandRow1; y < uiBandRow2; y++ )
 				{
-					gVal = static_cast< double >( pBuf[ j + i * uiCols ] );
+					auto uiRow1 = static_cast< std::uint32_t >( ( static_cast< std::uint64_t >( y ) * uiRows ) / uiDstRows );
+					auto uiRow2 = static_cast< std::uint32_t >( ( static_cast< std::uint64_t >( y + 1 ) * uiRows ) / uiDstRows );
 
-					//
-					// Determine min/max values
-					//
-					if ( gVal < pStats->gMin )
-					{
-						pStats->gMin = gVal;
-					}
+					std::fill( vLine.begin(), vLine.end(), 0.0f );
 
-					else if ( gVal > pStats->gMax )
+					for ( auto row = uiRow1; row < uiRow2; row++ )
 					{
-						pStats->gMax = gVal;
+						const T* pRow = cView.row( row );
+
+						// Pixel values fit in 20 bits, so the signed conversion ( which vectorizes ) is exact
+						for ( std::size_t col = 0; col < uiLineCols; col++ )
+						{
+							pLine[ col ] += static_cast< float >( static_cast< std::int32_t >( pRow[ col ] ) );
+						}
 					}
 
-					//
-					// Monitor for saturated pixels
-					//
-					//if ( gVal >= ( T_SIZE( T ) - 1 ) )
-					if ( gVal >= ( maxTVal() - 1 ) )
+					std::uint8_t* pDstRow = ( pDstBuf + static_cast< std::size_t >( y ) * uiLineDstCols );
+
+					const float fRowCount = static_cast< float >( uiRow2 - uiRow1 );
+
+					for ( std::uint32_t x = 0; x < uiLineDstCols; x++ )
 					{
-						pStats->gSaturatedCount++;
-					}
+						float fSum = 0.0f;
 
-					gSum += gVal;
-				}
-			}
+						for ( auto col = pColStart[ x ]; col < pColStart[ x + 1 ]; col++ )
+						{
+							fSum += pLine[ col ];
+						}
 
-			// Calculate mean
-			pStats->gMean = gSum / gTotalPixelCount;
+						float fValue = ( ( fSum / ( fRowCount * static_cast< float >( pColStart[ x + 1 ] - pColStart[ x ] ) ) - fLow ) * fScale );
 
-			for ( std::uint32_t i = uiRow1; i < uiLocalRow2; i++ )
-			{
-				for ( std::uint32_t j = uiCol1; j < uiLocalCol2; j++ )
-				{
-					double gPixVal = static_cast< double >( pBuf[ j + i * uiCols ] );
-					
-					gDevSqrdSum += std::pow( ( gPixVal - pStats->gMean ), 2 );
+						pDstRow[ x ] = static_cast< std::uint8_t >( std::min( std::max( fValue, 0.0f ), 255.0f ) + 0.5f );
+					}
 				}
-			}
-
-			pStats->gVariance = gDevSqrdSum / gTotalPixelCount;
-			pStats->gStdDev = std::sqrt( pStats->gVariance );
+			} );
 
-			return pStats;
+			return pairLimits;
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getStats                                                                                                |
+		// |  preview                                                                                                 |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Calculates the image min, max, mean, variance, standard deviation, total pixel count and saturated      |
-		// |  pixel count over the entire image.                                                                      |
+		// |  Builds an 8-bit quick look image from an entire image buffer. See above.                                |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf	 - Pointer to the image data buffer.                                                      |
-		// |  <IN> -> uiCol1 - The start column.                                                                      |
-		// |  <IN> -> uiCol2 - The end column.                                                                        |
-		// |  <IN> -> uiRow1 - The start row.                                                                         |
-		// |  <IN> -> uiRow2 - The end row.                                                                           |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN>  -> pBuf      - Pointer to the image buffer.                                                       |
+		// |  <IN>  -> uiCols    - The image column size ( in pixels ).                                               |
+		// |  <IN>  -> uiRows    - The image row size ( in pixels ).                                                  |
+		// |  <IN>  -> cParams   - The display settings.                                                              |
+		// |  <OUT> -> pDstBuf   - Pointer to a uiDstCols x uiDstRows buffer that receives the preview.               |
+		// |  <IN>  -> uiDstCols - The preview column size ( in pixels ). Must not exceed uiCols.                     |
+		// |  <IN>  -> uiDstRows - The preview row size ( in pixels ). Must not exceed uiRows.                        |
+		// |  <IN>  -> pMask     - Pointer to a uiCols x uiRows mask, or nullptr.                                     |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Returns the low and high display limits used ( DN ).                                                    |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument on error.                                              |
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T>
-		std::unique_ptr<arc::gen3::image::CStats> CArcImage<T>::getStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		std::pair<double, double> CArcImage<T>::preview( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CPreviewParams& cParams,
+														 std::uint8_t* pDstBuf, const std::uint32_t uiDstCols, const std::uint32_t uiDstRows, const std::uint8_t* pMask )
 		{
-			return getStats( pBuf, 0, uiCols, 0, uiRows, uiCols, uiRows );
+			verifyBuffer( pBuf );
+
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			return preview( arc::gen3::CArcImageView<const T>( pBuf, uiCols, uiRows ), cParams, pDstBuf, uiDstCols, uiDstRows, pMask );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getDiffStats                                                                                            |
+		// |  previewLimits                                                                                           |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Calculates the min, max, mean, variance, standard deviation, total pixel count and saturated pixel      |
-		// |  count for each image as well as the difference mean, variance and standard deviation over the specified |
-		// |  image buffer cols and rows. This is used for photon transfer curves( PTC ).The two images MUST be the   |
-		// |  same size or the methods behavior is undefined as this cannot be verified using the given parameters.   |
+		// |  Returns the display limits preview() would use for an image view. Masked pixels are not sampled.        |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
-		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
-		// |  <IN> -> uiCol1 - The start column.                                                                      |
-		// |  <IN> -> uiCol2 - The end column.                                                                        |
-		// |  <IN> -> uiRow1 - The start row.                                                                         |
-		// |  <IN> -> uiRow2 - The end row.                                                                           |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN> -> cView   - The image view.                                                                       |
+		// |  <IN> -> cParams - The display settings.                                                                 |
+		// |  <IN> -> pMask   - Pointer to a cView.cols() x cView.rows() mask, or nullptr.                            |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Returns the low and high display limits ( DN ).                                                         |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<arc::gen3::image::CDifStats>
-		CArcImage<T>::getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		std::pair<double, double> CArcImage<T>::previewLimits( const arc::gen3::CArcImageView<const T>& cView, const arc::gen3::image::CPreviewParams& cParams,
+															   const std::uint8_t* pMask )
 		{
-			double gSum		= 0.0;
-			double gDifSum	= 0.0;
-			double gVal1	= 0.0;
-			double gVal2	= 0.0;
-
-			std::remove_const_t<decltype( uiRow2 )> uiLocalRow2 = uiRow2;
-			std::remove_const_t<decltype( uiCol2 )> uiLocalCol2 = uiCol2;
-
-			verifyRow( uiRow1, uiRows );
-
-			verifyRow( uiRow2, uiRows );
+			if ( cView.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid image view ( empty )!"s );
+			}
 
-			verifyColumn( uiCol1, uiCols );
+			thread_local std::vector<T> vSample;
 
-			verifyColumn( uiCol2, uiCols );
+			std::pair<double, double> pairLimits;
 
-			verifyRangeOrder( uiCol1, uiCol2 );
+			switch ( cParams.eStretch )
+			{
+				case arc::gen3::image::e_Stretch::ZSCALE:
+				{
+					if ( cParams.gContrast <= 0.0 )
+					{
+						throwArcGen3InvalidArgument( "Invalid zscale contrast [ %f ]! Must be greater than zero!", cParams.gContrast );
+					}
 
-			verifyRangeOrder( uiRow1, uiRow2 );
+					samplePixels( cView, std::max( cParams.uiSamples, 1U ), vSample, pMask );
 
-			verifyBuffer( pBuf1 );
+					pairLimits = zscale( vSample, cParams.gContrast );
+				}
+				break;
 
-			verifyBuffer( pBuf2 );
+				case arc::gen3::image::e_Stretch::PERCENTILE:
+				{
+					if ( cParams.gLowPercent < 0.0 || cParams.gHighPercent > 100.0 || cParams.gLowPercent >= cParams.gHighPercent )
+					{
+						throwArcGen3InvalidArgument( "Invalid percentiles [ %f, %f ]! Must be 0 - 100 and low < high!", cParams.gLowPercent, cParams.gHighPercent );
+					}
 
-			if ( uiRow1 == uiRow2 ) { uiLocalRow2++; }
-			if ( uiCol1 == uiCol2 ) { uiLocalCol2++; }
+					samplePixels( cView, std::max( cParams.uiSamples, 1U ), vSample, pMask );
 
-			double gTotalPixelCount = ( static_cast< double >( uiLocalRow2 - uiRow1 ) * static_cast<double>( uiLocalCol2 - uiCol1 ) );
+					std::sort( vSample.begin(), vSample.end() );
 
-			std::unique_ptr<arc::gen3::image::CDifStats> pDifStats( new arc::gen3::image::CDifStats() );
+					auto gLast = static_cast< double >( vSample.size() - 1 );
 
-			pDifStats->cStats1.set( *getStats( pBuf1, uiCol1, uiLocalCol2, uiRow1, uiLocalRow2, uiCols, uiRows ).get() );
+					auto gLow = static_cast< double >( vSample[ static_cast< std::size_t >( std::lround( gLast * cParams.gLowPercent / 100.0 ) ) ] );
+					auto gHigh = static_cast< double >( vSample[ static_cast< std::size_t >( std::lround( gLast * cParams.gHighPercent / 100.0 ) ) ] );
 
-			pDifStats->cStats2.set( *getStats( pBuf2, uiCol1, uiLocalCol2, uiRow1, uiLocalRow2, uiCols, uiRows ).get() );
+					pairLimits = std::make_pair( gLow, std::max( gHigh, gLow + 1.0 ) );
+				}
+				break;
 
-			for ( std::uint32_t i = uiRow1; i < uiLocalRow2; i++ )
-			{
-				for ( std::uint32_t j = uiCol1; j < uiLocalCol2; j++ )
+				case arc::gen3::image::e_Stretch::FIXED:
 				{
-					gVal1 = static_cast< double >( pBuf1[ j + i * uiCols ] );
-
-					gVal2 = static_cast< double >( pBuf2[ j + i * uiCols ] );
+					if ( cParams.gLow >= cParams.gHigh )
+					{
+						throwArcGen3InvalidArgument( "Invalid display limits [ %f, %f ]! Low must be less than high!", cParams.gLow, cParams.gHigh );
+					}
 
-					gSum += ( gVal1 - gVal2 );
+					pairLimits = std::make_pair( cParams.gLow, cParams.gHigh );
+				}
+				break;
 
-					gDifSum += ( std::pow( ( pDifStats->cStats2.gMean - gVal2 ) - ( pDifStats->cStats1.gMean - gVal1 ), 2 ) );
+				default:
+				{
+					throwArcGen3InvalidArgument( "Invalid stretch [ %u ]!", static_cast< std::uint32_t >( cParams.eStretch ) );
 				}
 			}
 
-			pDifStats->cDiffStats.gMean = std::fabs( gSum / gTotalPixelCount );
-			pDifStats->cDiffStats.gVariance = gDifSum / gTotalPixelCount;
-			pDifStats->cDiffStats.gStdDev = std::sqrt( pDifStats->cDiffStats.gVariance );
-
-			return pDifStats;
+			return pairLimits;
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getDiffStats                                                                                            |
+		// |  findShift                                                                                               |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Calculates the min, max, mean, variance, standard deviation, total pixel count and saturated pixel      |
-		// |  count for each image as well as the difference mean, variance and standard deviation over the entire    |
-		// |  image buffer. This is used for photon transfer curves( PTC ).The two images MUST be the same size or    |
-		// |  the methods behavior is undefined as this cannot be verified using the given parameters.                |
+		// |  Finds the sub-pixel offset of a frame from a reference frame. See findShifts().                         |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
-		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN> -> cRef    - The reference image view.                                                             |
+		// |  <IN> -> cFrame  - The frame image view.                                                                 |
+		// |  <IN> -> cParams - The registration settings.                                                            |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Returns the offset of the frame from the reference.                                                     |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<arc::gen3::image::CDifStats>
-		CArcImage<T>::getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		arc::gen3::image::CShift CArcImage<T>::findShift( const arc::gen3::CArcImageView<const T>& cRef, const arc::gen3::CArcImageView<const T>& cFrame,
+														  const arc::gen3::image::CRegisterParams& cParams )
 		{
-			return getDiffStats( pBuf1, pBuf2, 0, uiCols, 0, uiRows, uiCols, uiRows );
+			std::vector<arc::gen3::image::CShift> vShifts;
+
+			findShifts( cRef, { cFrame }, cParams, vShifts );
+
+			return vShifts.front();
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  histogram                                                                                               |
+		// |  findShifts                                                                                              |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Calculates the histogram over the specified image buffer columns and rows.                              |
+		// |  Finds the offsets of a list of frames from a reference frame by phase correlation. The largest power of |
+		// |  two square that fits every image ( up to uiWindow ) is taken from the same place in each, centered on   |
+		// |  their common area, and transformed. The reference spectrum is computed once. For each frame the         |
+		// |  normalized cross power spectrum is inverse transformed, giving a sharp peak at the offset, which is     |
+		// |  then refined to sub-pixel precision by refinePeak(). Frames whose normalized peak is below gMinPeak     |
+		// |  fall back to centroidShift(). The reference sources for the fallback are only found if a frame needs    |
+		// |  them, and then only once.                                                                               |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf		- Pointer to the image buffer.                                                        |
-		// |  <IN> -> uiCol1	- The start column.                                                                   |
-		// |  <IN> -> uiCol2	- The end column.                                                                     |
-		// |  <IN> -> uiRow1	- The start row.                                                                      |
-		// |  <IN> -> uiRow2	- The end row.                                                                        |
-		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
-		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
-		// |  <IN> -> uiCount	- The element count of the returned array. The size of the array depends on the       |
-		// |                      image data type.                                                                    |
+		// |  <IN>  -> cRef    - The reference image view.                                                            |
+		// |  <IN>  -> vFrames - The frame image views.                                                               |
+		// |  <IN>  -> cParams - The registration settings.                                                           |
+		// |  <OUT> -> vShifts - Receives the offset of each frame, in list order.                                    |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Throws std::invalid_argument on error.                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
-		CArcImage<T>::histogram( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1,
-								 const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount )
+		template <typename T>
+		void CArcImage<T>::findShifts( const arc::gen3::CArcImageView<const T>& cRef, const std::vector<arc::gen3::CArcImageView<const T>>& vFrames,
+									   const arc::gen3::image::CRegisterParams& cParams, std::vector<arc::gen3::image::CShift>& vShifts )
 		{
-			std::remove_const_t<decltype( uiRow2 )> uiLocalRow2 = uiRow2;
-			std::remove_const_t<decltype( uiCol2 )> uiLocalCol2 = uiCol2;
+			if ( cRef.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid reference image view ( empty )!"s );
+			}
 
-			verifyRow( uiRow1, uiRows );
+			if ( cParams.gMatchRadius <= 0.0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid match radius [ %f ]! Must be greater than zero!", cParams.gMatchRadius );
+			}
 
-			verifyRow( uiRow2, uiRows );
+			auto uiCommonCols = cRef.cols();
+			auto uiCommonRows = cRef.rows();
 
-			verifyColumn( uiCol1, uiCols );
+			for ( std::uint32_t i = 0; i < static_cast< std::uint32_t >( vFrames.size() ); i++ )
+			{
+				if ( vFrames[ i ].empty() )
+				{
+					throwArcGen3InvalidArgument( "Invalid frame %u image view ( empty )!", i );
+				}
 
-			verifyColumn( uiCol2, uiCols );
+				uiCommonCols = std::min( uiCommonCols, vFrames[ i ].cols() );
+				uiCommonRows = std::min( uiCommonRows, vFrames[ i ].rows() );
+			}
 
-			verifyRangeOrder( uiCol1, uiCol2 );
+			vShifts.assign( vFrames.size(), arc::gen3::image::CShift() );
 
-			verifyRangeOrder( uiRow1, uiRow2 );
+			auto uiFit = std::min( { cParams.uiWindow, uiCommonCols, uiCommonRows } );
 
-			verifyBuffer( pBuf );
+			if ( uiFit < MIN_PHASE_WINDOW )
+			{
+				throwArcGen3InvalidArgument( "Invalid phase correlation window [ %u x %u ]! Images and window must be at least %u pixels!",
+											 uiFit, uiFit, MIN_PHASE_WINDOW );
+			}
+
+			const std::uint32_t uiSize = std::bit_floor( uiFit );
+
+			const std::uint32_t uiCol = ( ( uiCommonCols - uiSize ) / 2 );
+			const std::uint32_t uiRow = ( ( uiCommonRows - uiSize ) / 2 );
+
+			const std::size_t uiPoints = pixelCount( uiSize, uiSize );
+
+			std::vector<std::complex<float>> vRefSpectrum( uiPoints );
+
+			phaseSpectrum( cRef, uiCol, uiRow, uiSize, vRefSpectrum.data() );
+
+			auto cSourceParams = cParams.cSources;
+
+			if ( cSourceParams.uiMaxSources == 0 || cSourceParams.uiMaxSources > MATCH_SOURCES )
+			{
+				cSourceParams.uiMaxSources = MATCH_SOURCES;
+			}
+
+			std::vector<arc::gen3::image::CSource> vRefSources;
+
+			std::once_flag cRefSourcesFound;
+
+			forEachIndex( static_cast< std::uint32_t >( vFrames.size() ), [ & ]( std::uint32_t uiFrame )
+			{
+				auto& cShift = vShifts[ uiFrame ];
+
+				std::vector<std::complex<float>> vSpectrum( uiPoints );
+				std::vector<std::complex<float>> vColumn;
+
+				phaseSpectrum( vFrames[ uiFrame ], uiCol, uiRow, uiSize, vSpectrum.data() );
+
+				// Normalized cross power spectrum, frame x conj( reference ). A copy is kept for refinePeak().
+				for ( std::size_t i = 0; i < uiPoints; i++ )
+				{
+					float fRe = ( vSpectrum[ i ].real() * vRefSpectrum[ i ].real() + vSpectrum[ i ].imag() * vRefSpectrum[ i ].imag() );
+					float fIm = ( vSpectrum[ i ].imag() * vRefSpectrum[ i ].real() - vSpectrum[ i ].real() * vRefSpectrum[ i ].imag() );
+
+					float fMagnitude = std::sqrt( fRe * fRe + fIm * fIm );
+
+					vSpectrum[ i ] = ( ( fMagnitude > 0.0f ) ? std::complex<float>( fRe / fMagnitude, fIm / fMagnitude ) : std::complex<float>() );
+				}
+
+				std::vector<std::complex<float>> vCross( vSpectrum );
+
+				fftPlan_t::get( uiSize ).transform2d( vSpectrum.data(), true, vColumn );
 
-			std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
-			pHist( new std::uint32_t[ maxTVal() ], arc::gen3::image::ArrayDeleter<std::uint32_t>() );
+				std::size_t uiPeak = 0;
 
-			if ( pHist == nullptr )
-			{
-				throwArcGen3Error( "Failed to allocate histogram data buffer!"s );
-			}
+				for ( std::size_t i = 1; i < uiPoints; i++ )
+				{
+					if ( vSpectrum[ i ].real() > vSpectrum[ uiPeak ].real() )
+					{
+						uiPeak = i;
+					}
+				}
 
-			uiCount = maxTVal();
+				auto uiPeakCol = static_cast< std::uint32_t >( uiPeak % uiSize );
+				auto uiPeakRow = static_cast< std::uint32_t >( uiPeak / uiSize );
 
-			zeroMemory( pHist.get(), uiCount * sizeof( std::uint32_t ) );
+				// The correlation wraps around, so peaks past the middle are negative offsets
+				cShift.gCol = ( ( uiPeakCol >= ( uiSize / 2 ) ) ? ( static_cast< double >( uiPeakCol ) - uiSize ) : uiPeakCol );
+				cShift.gRow = ( ( uiPeakRow >= ( uiSize / 2 ) ) ? ( static_cast< double >( uiPeakRow ) - uiSize ) : uiPeakRow );
+				cShift.gPeak = ( static_cast< double >( vSpectrum[ uiPeak ].real() ) / static_cast< double >( uiPoints ) );
 
-			if ( uiRow1 == uiRow2 ) { uiLocalRow2++; }
-			if ( uiCol1 == uiCol2 ) { uiLocalCol2++; }
+				refinePeak( vCross.data(), uiSize, cShift.gCol, cShift.gRow );
 
-			for ( std::uint32_t i = uiRow1; i < uiLocalRow2; i++ )
-			{
-				for ( std::uint32_t j = uiCol1; j < uiLocalCol2; j++ )
+				if ( cShift.gPeak < cParams.gMinPeak )
 				{
-					pHist.get()[ pBuf[ j + i * uiCols ] ]++;
-				}
-			}
-			
-			return pHist;
-		}
+					std::call_once( cRefSourcesFound, [ & ]( void ) { findSources( cRef, cSourceParams, vRefSources ); } );
 
+					std::vector<arc::gen3::image::CSource> vFrameSources;
 
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  histogram                                                                                               |
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  Calculates the histogram over the entire image buffer.                                                  |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf		- Pointer to the image buffer.                                                        |
-		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
-		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
-		// |  <IN> -> uiCount	- The element count of the returned array. The size of the array depends on the       |
-		// |                      image data type.                                                                    |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
-		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
-		CArcImage<T>::histogram( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount )
-		{
-			return histogram( pBuf, 0, uiCols, 0, uiRows, uiCols, uiRows, uiCount );
+					findSources( vFrames[ uiFrame ], cSourceParams, vFrameSources );
+
+					centroidShift( vRefSources, vFrameSources, cParams.gMatchRadius, cShift );
+				}
+			} );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  add                                                                                                     |
+		// |  shiftAndAdd                                                                                             |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Adds two image buffers together pixel by pixel. The result is a pointer to a 64-bit buffer.             |
+		// |  Resamples a list of frames onto the reference frame grid and adds them into an accumulator. A shift is  |
+		// |  the same for every pixel, so each frame's bilinear weights are fixed and each accumulator row is a      |
+		// |  weighted sum of four offset runs of two frame rows, which the compiler can vectorize. The accumulator   |
+		// |  is split into bands of rows on separate threads; each band adds every frame in turn, so no two threads  |
+		// |  ever write the same pixel.                                                                              |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
-		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN>  -> vFrames    - The frame image views.                                                            |
+		// |  <IN>  -> vShifts    - The offset of each frame.                                                         |
+		// |  <OUT> -> pSumBuf    - Pointer to the uiCols x uiRows accumulator.                                       |
+		// |  <OUT> -> pWeightBuf - Pointer to a uiCols x uiRows frame count buffer, or nullptr.                      |
+		// |  <IN>  -> uiCols     - The accumulator column size ( in pixels ).                                        |
+		// |  <IN>  -> uiRows     - The accumulator row size ( in pixels ).                                           |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Throws std::invalid_argument on error.                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<std::uint64_t[], arc::gen3::image::ArrayDeleter<std::uint64_t>>
-		CArcImage<T>::add( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		void CArcImage<T>::shiftAndAdd( const std::vector<arc::gen3::CArcImageView<const T>>& vFrames, const std::vector<arc::gen3::image::CShift>& vShifts, float* pSumBuf,
+										float* pWeightBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
 		{
-			verifyBuffer( pBuf1 );
-	
-			verifyBuffer( pBuf2 );
-
-			std::uint32_t uiLength = ( uiCols * uiRows );
-
-			std::unique_ptr< std::uint64_t[], arc::gen3::image::ArrayDeleter< std::uint64_t > > pAdd( new std::uint64_t[ uiLength ], arc::gen3::image::ArrayDeleter< std::uint64_t >() );
+			if ( pSumBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid accumulator buffer ( nullptr )!"s );
+			}
 
-			if ( pAdd == nullptr )
+			if ( uiCols == 0 || uiRows == 0 )
 			{
-				throwArcGen3Error( "Failed to allocate addition data buffer!"s );
+				throwArcGen3InvalidArgument( "Invalid accumulator size [ %u x %u ]!", uiCols, uiRows );
 			}
 
-			for ( decltype( uiLength ) i = 0; i < uiLength; i++ )
+			if ( vFrames.size() != vShifts.size() )
 			{
-				pAdd.get()[ i ] = static_cast< std::uint64_t >( pBuf1[ i ] ) + static_cast< std::uint64_t >( pBuf2[ i ] );
+				throwArcGen3InvalidArgument( "Frame and shift counts differ [ %u, %u ]!", static_cast< std::uint32_t >( vFrames.size() ),
+											 static_cast< std::uint32_t >( vShifts.size() ) );
 			}
 
-			return pAdd;
-		}
+			// Per frame: whole pixel offset, bilinear fractions and whether the second tap is needed
+			struct frameStep_t
+			{
+				std::int64_t i64Col = 0;
+				std::int64_t i64Row = 0;
+				std::int64_t i64ColTap = 0;
+				std::int64_t i64RowTap = 0;
+				float fCol = 0.0f;
+				float fRow = 0.0f;
+			};
 
+			std::vector<frameStep_t> vSteps( vFrames.size() );
 
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  subtract                                                                                                |
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  Subtracts two image buffers pixel by pixel. The result is a pointer to a buffer with the same data      |
-		// |  type as the two images being subtracted. Buffer two is subtracted from buffer one.                      |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
-		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
-		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
-		CArcImage<T>::subtract( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
-		{
-			verifyBuffer( pBuf1 );
-	
-			verifyBuffer( pBuf2 );
+			for ( std::uint32_t i = 0; i < static_cast< std::uint32_t >( vFrames.size() ); i++ )
+			{
+				const auto& cShift = vShifts[ i ];
 
-			std::uint32_t uiLength = ( uiCols * uiRows );
+				if ( vFrames[ i ].empty() )
+				{
+					throwArcGen3InvalidArgument( "Invalid frame %u image view ( empty )!", i );
+				}
 
-			std::unique_ptr< T[], arc::gen3::image::ArrayDeleter< T > > pSub( new T[ uiLength ], arc::gen3::image::ArrayDeleter< T >() );
+				if ( !std::isfinite( cShift.gCol ) || !std::isfinite( cShift.gRow ) || std::fabs( cShift.gCol ) > 1.0e9 || std::fabs( cShift.gRow ) > 1.0e9 )
+				{
+					throwArcGen3InvalidArgument( "Invalid frame %u shift [ %f, %f ]!", i, cShift.gCol, cShift.gRow );
+				}
 
-			if ( pSub == nullptr )
-			{
-				throwArcGen3Error( "Failed to allocate subtraction data buffer!"s );
+				auto& cStep = vSteps[ i ];
+
+				double gCol = std::floor( cShift.gCol );
+				double gRow = std::floor( cShift.gRow );
+
+				cStep.i64Col = static_cast< std::int64_t >( gCol );
+				cStep.i64Row = static_cast< std::int64_t >( gRow );
+				cStep.fCol = static_cast< float >( cShift.gCol - gCol );
+				cStep.fRow = static_cast< float >( cShift.gRow - gRow );
+				cStep.i64ColTap = ( ( cStep.fCol > 0.0f ) ? 1 : 0 );
+				cStep.i64RowTap = ( ( cStep.fRow > 0.0f ) ? 1 : 0 );
 			}
 
-			for ( decltype( uiLength ) i = 0; i < uiLength; i++ )
+			forEachRowBand( 0, uiRows, bandCount( uiCols, uiRows ), [ & ]( std::uint32_t uiBandRow1, std::uint32_t uiBandRow2, std::uint32_t )
 			{
-				pSub.get()[ i ] = pBuf1[ i ] - pBuf2[ i ];
-			}
+				for ( auto row = uiBandRow1; row < uiBandRow2; row++ )
+				{
+					for ( std::size_t i = 0; i < vFrames.size(); i++ )
+					{
+						const auto& cFrame = vFrames[ i ];
+						const auto& cStep = vSteps[ i ];
 
-			return pSub;
+						// The frame rows and accumulator columns covered by both taps
+						std::int64_t i64Row = ( static_cast< std::int64_t >( row ) + cStep.i64Row );
+
+						if ( i64Row < 0 || ( i64Row + cStep.i64RowTap ) >= static_cast< std::int64_t >( cFrame.rows() ) )
+						{
+							continue;
+						}
+
+						std::int64_t i64Col1 = std::max<std::int64_t>( 0, -cStep.i64Col );
+						std::int64_t i64Col2 = std::min<std::int64_t>( uiCols, ( static_cast< std::int64_t >( cFrame.cols() ) - cStep.i64ColTap - cStep.i64Col ) );
+
+						if ( i64Col1 >= i64Col2 )
+						{
+							continue;
+						}
+
+						auto uiLength = static_cast< std::size_t >( i64Col2 - i64Col1 );
+
+						const T* arcGen3Restrict pA = ( cFrame.row( static_cast< std::uint32_t >( i64Row ) ) + ( i64Col1 + cStep.i64Col ) );
+						const T* arcGen3Restrict pB = ( cFrame.row( static_cast< std::uint32_t >( i64Row + cStep.i64RowTap ) ) + ( i64Col1 + cStep.i64Col ) );
+						const T* arcGen3Restrict pATap = ( pA + cStep.i64ColTap );
+						const T* arcGen3Restrict pBTap = ( pB + cStep.i64ColTap );
+
+						const float fA = ( ( 1.0f - cStep.fCol ) * ( 1.0f - cStep.fRow ) );
+						const float fATap = ( cStep.fCol * ( 1.0f - cStep.fRow ) );
+						const float fB = ( ( 1.0f - cStep.fCol ) * cStep.fRow );
+						const float fBTap = ( cStep.fCol * cStep.fRow );
+
+						std::size_t uiOffset = ( pixelCount( uiCols, row ) + static_cast< std::size_t >( i64Col1 ) );
+
+						float* arcGen3Restrict pSum = ( pSumBuf + uiOffset );
+
+						for ( std::size_t col = 0; col < uiLength; col++ )
+						{
+							pSum[ col ] += ( fA * static_cast< float >( static_cast< std::int32_t >( pA[ col ] ) ) +
+											 fATap * static_cast< float >( static_cast< std::int32_t >( pATap[ col ] ) ) +
+											 fB * static_cast< float >( static_cast< std::int32_t >( pB[ col ] ) ) +
+											 fBTap * static_cast< float >( static_cast< std::int32_t >( pBTap[ col ] ) ) );
+						}
+
+						if ( pWeightBuf != nullptr )
+						{
+							float* arcGen3Restrict pWeight = ( pWeightBuf + uiOffset );
+
+							for ( std::size_t col = 0; col < uiLength; col++ )
+							{
+								pWeight[ col ] += 1.0f;
+							}
+						}
+					}
+				}
+			} );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  subtractHalves                                                                                          |
+		// |  phaseSpectrum                                                                                           |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Subtracts one half of an image from the other. The first half of the image buffer is replaced with      |
-		// |  the new image.                                                                                          |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf	 - Pointer to the image buffer. Result is placed in this buffer.                          |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  Loads the square window at ( uiCol, uiRow ) of an image view for phase correlation and transforms it.   |
+		// |  The window mean is subtracted and a separable Hann taper applied, so the hard window edges do not add   |
+		// |  a spurious zero offset peak to the correlation.                                                         |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// |  <IN>  -> cView     - The image view.                                                                    |
+		// |  <IN>  -> uiCol     - The window start column.                                                           |
+		// |  <IN>  -> uiRow     - The window start row.                                                              |
+		// |  <IN>  -> uiSize    - The window side ( pixels ). Must be a power of two.                                |
+		// |  <OUT> -> pSpectrum - Pointer to a uiSize x uiSize buffer that receives the spectrum.                    |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::subtractHalves( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		void CArcImage<T>::phaseSpectrum( const arc::gen3::CArcImageView<const T>& cView, const std::uint32_t uiCol, const std::uint32_t uiRow, const std::uint32_t uiSize,
+										  std::complex<float>* pSpectrum )
 		{
-			verifyBuffer( pBuf );
+			auto cWindow = cView.subView( uiCol, uiRow, uiSize, uiSize );
 
-			if ( ( uiRows % 2 ) != 0 )
+			std::vector<float> vHann( uiSize );
+
+			for ( std::uint32_t i = 0; i < uiSize; i++ )
 			{
-				throwArcGen3InvalidArgument( "Image must have an even number of rows [ %u ]", uiRows );
+				vHann[ i ] = static_cast< float >( 0.5 - 0.5 * std::cos( 2.0 * std::numbers::pi * static_cast< double >( i ) / static_cast< double >( uiSize ) ) );
 			}
 
-			T* pBuf1 = pBuf;
+			double gSum = 0.0;
+
+			for ( std::uint32_t row = 0; row < uiSize; row++ )
+			{
+				const T* pRow = cWindow.row( row );
+
+				for ( std::uint32_t col = 0; col < uiSize; col++ )
+				{
+					gSum += static_cast< double >( pRow[ col ] );
+				}
+			}
 
-			T* pBuf2 = pBuf + ( static_cast< std::uint64_t >( ( uiRows / 2 ) ) * static_cast<std::uint64_t>( uiCols ) );
+			const auto fMean = static_cast< float >( gSum / static_cast< double >( pixelCount( uiSize, uiSize ) ) );
 
-			for ( std::uint32_t i = 0; i < ( ( uiRows / 2 ) * uiCols ); i++ )
+			for ( std::uint32_t row = 0; row < uiSize; row++ )
 			{
-				pBuf1[ i ] -= pBuf2[ i ];
+				const T* pRow = cWindow.row( row );
+
+				std::complex<float>* pOut = ( pSpectrum + pixelCount( uiSize, row ) );
+
+				for ( std::uint32_t col = 0; col < uiSize; col++ )
+				{
+					pOut[ col ] = std::complex<float>( ( static_cast< float >( pRow[ col ] ) - fMean ) * vHann[ col ] * vHann[ row ], 0.0f );
+				}
 			}
+
+			std::vector<std::complex<float>> vColumn;
+
+			fftPlan_t::get( uiSize ).transform2d( pSpectrum, false, vColumn );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  divide                                                                                                  |
+		// |  refinePeak                                                                                              |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Divides two image buffers pixel by pixel.                                                               |
-		// |                                                                                                          |
-		// |  <IN> -> pBuf1	 - Pointer to the first image buffer. Result is placed in this buffer.                    |
-		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  Refines a whole pixel phase correlation peak to sub-pixel precision. A parabola through the sampled     |
+		// |  peak is biased toward the nearest whole pixel, so the correlation is instead evaluated between the      |
+		// |  samples straight from the cross power spectrum, as a continuous sum of its frequencies. It is searched  |
+		// |  along one axis at a time: the spectrum is first collapsed onto that axis at the current position on     |
+		// |  the other ( one pass over the spectrum ), then the one dimensional sum is searched on a coarse and      |
+		// |  then a fine grid. Columns, rows and columns again are refined, which converges for the near separable   |
+		// |  peaks of a windowed image.                                                                              |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <IN>     -> pCross - Pointer to the uiSize x uiSize normalized cross power spectrum.                    |
+		// |  <IN>     -> uiSize - The spectrum side.                                                                 |
+		// |  <IN/OUT> -> gCol   - The whole pixel peak column on entry, the refined column on return.                |
+		// |  <IN/OUT> -> gRow   - The whole pixel peak row on entry, the refined row on return.                      |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
-		CArcImage<T>::divide( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		void CArcImage<T>::refinePeak( const std::complex<float>* pCross, const std::uint32_t uiSize, double& gCol, double& gRow )
 		{
-			verifyBuffer( pBuf1 );
-	
-			verifyBuffer( pBuf2 );
+			const double gOmega = ( 2.0 * std::numbers::pi / static_cast< double >( uiSize ) );
 
-			std::uint32_t uiLength = ( uiCols * uiRows );
+			// Signed frequency of spectrum index k
+			auto fnFrequency = [ & ]( std::uint32_t k )
+			{
+				return ( ( k < ( uiSize / 2 ) ) ? static_cast< double >( k ) : ( static_cast< double >( k ) - uiSize ) );
+			};
 
-			std::unique_ptr< T[], arc::gen3::image::ArrayDeleter< T > > pDiv( new T[ uiLength ], arc::gen3::image::ArrayDeleter< T >() );
+			std::vector<std::complex<double>> vPhase( uiSize );
+			std::vector<std::complex<double>> vAxis( uiSize );
 
-			if ( pDiv == nullptr )
+			// vAxis[ k ] = sum over the other axis of the spectrum, phase shifted to gOther
+			auto fnCollapse = [ & ]( bool bCols, double gOther )
 			{
-				throwArcGen3Error( "Failed to allocate division data buffer!"s );
-			}
+				for ( std::uint32_t k = 0; k < uiSize; k++ )
+				{
+					vPhase[ k ] = std::polar( 1.0, gOmega * fnFrequency( k ) * gOther );
+				}
+
+				std::fill( vAxis.begin(), vAxis.end(), std::complex<double>() );
+
+				for ( std::uint32_t row = 0; row < uiSize; row++ )
+				{
+					const std::complex<float>* pRow = ( pCross + pixelCount( uiSize, row ) );
+
+					for ( std::uint32_t col = 0; col < uiSize; col++ )
+					{
+						auto cValue = std::complex<double>( pRow[ col ].real(), pRow[ col ].imag() );
+
+						if ( bCols )
+						{
+							vAxis[ col ] += ( cValue * vPhase[ row ] );
+						}
+
+						else
+						{
+							vAxis[ row ] += ( cValue * vPhase[ col ] );
+						}
+					}
+				}
+			};
 
-			for ( decltype( uiLength ) i = 0; i < uiLength; i++ )
+			auto fnValue = [ & ]( double gPosition )
 			{
-				if ( pBuf2[ i ] != 0 )
+				double gSum = 0.0;
+
+				for ( std::uint32_t k = 0; k < uiSize; k++ )
 				{
-					pDiv.get()[ i ] = pBuf1[ i ] / pBuf2[ i ];
+					gSum += ( vAxis[ k ] * std::polar( 1.0, gOmega * fnFrequency( k ) * gPosition ) ).real();
 				}
 
-				else
+				return gSum;
+			};
+
+			auto fnSearch = [ & ]( double gStart )
+			{
+				double gBest = gStart;
+
+				for ( double gStep : { 0.05, 0.002 } )
 				{
-					pDiv.get()[ i ] = 0;
+					double gCenter = gBest;
+					double gBestValue = -std::numeric_limits<double>::max();
+
+					for ( int i = -25; i <= 25; i++ )
+					{
+						double gPosition = ( gCenter + i * gStep );
+						double gValue = fnValue( gPosition );
+
+						if ( gValue > gBestValue )
+						{
+							gBestValue = gValue;
+							gBest = gPosition;
+						}
+					}
 				}
-			}
 
-			return pDiv;
-		}
+				return gBest;
+			};
 
+			fnCollapse( true, gRow );
 
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  copy                                                                                                    |
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  Copies the source image buffer to the destination image buffer. The source buffer must be less than or  |
-		// |  equal in dimensions to the destination buffer.                                                          |
-		// |                                                                                                          |
-		// |  <IN> -> pDstBuf - Pointer to the destination image buffer. Result is placed in this buffer.             |
-		// |  <IN> -> pSrcBuf - Pointer to the source image buffer.                                                   |
-		// |  <IN> -> uiCols  - The number of image columns to copy ( in pixels ).                                    |
-		// |  <IN> -> uiRows  - The number of image rows to copy ( in pixels ).                                       |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
-		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::copy( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
-		{
-			verifyBuffer( pDstBuf );
+			gCol = fnSearch( gCol );
 
-			verifyBuffer( pSrcBuf );
+			fnCollapse( false, gCol );
+
+			gRow = fnSearch( gRow );
 
-			copy( pDstBuf, pSrcBuf, ( uiCols * uiRows * static_cast< std::uint32_t >( sizeof( T ) ) ) );
+			fnCollapse( true, gRow );
+
+			gCol = fnSearch( gCol );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  copy                                                                                                    |
+		// |  centroidShift                                                                                           |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Copies the source image buffer to the destination image buffer. The source buffer must be less than or  |
-		// |  equal in dimensions to the destination buffer.                                                          |
+		// |  Finds the offset of a frame from a reference by matching their source centroids. Every pairing of a     |
+		// |  reference and a frame source is tried as a candidate offset, and scored by how many reference sources   |
+		// |  then have a frame source within gMatchRadius. The best candidate is refined to the mean offset of its   |
+		// |  matched pairs.                                                                                          |
 		// |                                                                                                          |
-		// |  <IN> -> pDstBuf	- Pointer to the destination image buffer. Result is placed in this buffer.           |
-		// |  <IN> -> pSrcBuf	- Pointer to the source image buffer.                                                 |
-		// |  <IN> -> uiSize	- The number of image bytes to copy.                                                  |
+		// |  <IN>  -> vRefSources   - The reference sources.                                                         |
+		// |  <IN>  -> vFrameSources - The frame sources.                                                             |
+		// |  <IN>  -> gMatchRadius  - The match radius ( pixels ).                                                   |
+		// |  <OUT> -> cShift        - Receives the offset and match count. Unchanged if no sources match.            |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Returns true if at least one source matched.                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::copy( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiSize )
+		template <typename T>
+		bool CArcImage<T>::centroidShift( const std::vector<arc::gen3::image::CSource>& vRefSources, const std::vector<arc::gen3::image::CSource>& vFrameSources,
+										  const double gMatchRadius, arc::gen3::image::CShift& cShift )
 		{
-			verifyBuffer( pDstBuf );
-	
-			verifyBuffer( pSrcBuf );
+			const double gRadius2 = ( gMatchRadius * gMatchRadius );
 
-			copyMemory( pDstBuf, const_cast< T* >( pSrcBuf ), uiSize );
+			// Counts the reference sources with a frame source within the radius of their shifted position, and
+			// sums the offsets to the nearest such source.
+			auto fnMatch = [ & ]( double gCol, double gRow, double& gSumCol, double& gSumRow )
+			{
+				std::uint32_t uiMatches = 0;
+
+				gSumCol = gSumRow = 0.0;
+
+				for ( const auto& cRef : vRefSources )
+				{
+					double gBest = gRadius2;
+					double gBestCol = 0.0;
+					double gBestRow = 0.0;
+					bool bFound = false;
+
+					for ( const auto& cFrame : vFrameSources )
+					{
+						double gCol2 = ( cFrame.gCol - cRef.gCol - gCol );
+						double gRow2 = ( cFrame.gRow - cRef.gRow - gRow );
+						double gDistance2 = ( gCol2 * gCol2 + gRow2 * gRow2 );
+
+						if ( gDistance2 <= gBest )
+						{
+							gBest = gDistance2;
+							gBestCol = ( cFrame.gCol - cRef.gCol );
+							gBestRow = ( cFrame.gRow - cRef.gRow );
+							bFound = true;
+						}
+					}
+
+					if ( bFound )
+					{
+						gSumCol += gBestCol;
+						gSumRow += gBestRow;
+						uiMatches++;
+					}
+				}
+
+				return uiMatches;
+			};
+
+			std::uint32_t uiBestMatches = 0;
+			double gBestCol = 0.0;
+			double gBestRow = 0.0;
+
+			for ( const auto& cRef : vRefSources )
+			{
+				for ( const auto& cFrame : vFrameSources )
+				{
+					double gSumCol = 0.0, gSumRow = 0.0;
+
+					auto uiMatches = fnMatch( cFrame.gCol - cRef.gCol, cFrame.gRow - cRef.gRow, gSumCol, gSumRow );
+
+					if ( uiMatches > uiBestMatches )
+					{
+						uiBestMatches = uiMatches;
+						gBestCol = ( gSumCol / uiMatches );
+						gBestRow = ( gSumRow / uiMatches );
+					}
+				}
+			}
+
+			if ( uiBestMatches == 0 )
+			{
+				return false;
+			}
+
+			cShift.gCol = gBestCol;
+			cShift.gRow = gBestRow;
+			cShift.bCentroid = true;
+			cShift.uiMatches = uiBestMatches;
+
+			return true;
 		}
 
 
@@ -1337,7 +5435,7 @@ namespace arc
 					std::uint32_t uiX = static_cast< std::uint32_t >( uiRadius * std::cos( angle * DEG2RAD ) + uiXCenter );
 					std::uint32_t uiY = static_cast< std::uint32_t >( uiRadius * std::sin( angle * DEG2RAD ) + uiYCenter );
 
-					pBuf[ uiX + uiY * uiCols ] = static_cast< T >( uiColor );
+					pBuf[ pixelCount( uiCols, uiY ) + uiX ] = static_cast< T >( uiColor );
 				}
 			}
 
@@ -1375,7 +5473,7 @@ namespace arc
 						std::uint32_t uiX = static_cast< std::uint32_t >( r * std::cos( angle * DEG2RAD ) + uiXCenter );
 						std::uint32_t uiY = static_cast< std::uint32_t >( r * std::sin( angle * DEG2RAD ) + uiYCenter );
 
-						pBuf[ uiX + uiY * uiCols ] = static_cast< T >( uiColor );
+						pBuf[ pixelCount( uiCols, uiY ) + uiX ] = static_cast< T >( uiColor );
 					}
 				}
 			}
@@ -1443,7 +5541,7 @@ namespace arc
 					std::uint32_t uiX = static_cast< std::uint32_t >( uiRadius * std::cos( angle * DEG2RAD ) + uiXCenter );
 					std::uint32_t uiY = static_cast< std::uint32_t >( uiRadius * std::sin( angle * DEG2RAD ) + uiYCenter );
 
-					pBuf[ uiX + uiY * uiCols ] = static_cast< T >( uiColor );
+					pBuf[ pixelCount( uiCols, uiY ) + uiX ] = static_cast< T >( uiColor );
 				}
 			}
 